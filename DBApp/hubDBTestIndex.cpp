@@ -0,0 +1,150 @@
+#include <hubDB/DBRandomBufferMgr.h>
+#include <hubDB/DBBLinkIndex.h>
+using namespace HubDB::Manager;
+using namespace HubDB::Index;
+using namespace HubDB::Exception;
+
+#include <log4cxx/logger.h>
+#include <log4cxx/propertyconfigurator.h>
+#include <log4cxx/helpers/exception.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+
+// Teilt die Wurzel eines DBBLinkIndex, während ein Cursor auf ihr steht,
+// und prüft das Zurücknehmen eines gescheiterten Stapels
+
+const string indexFileName = "hubDBTestIndex.idx";
+const uint dupCnt = 20;
+const uint keyCnt = 2000;
+
+static bool check(bool ok, const string & msg)
+{
+  cout << (ok ? "OK     " : "FEHLER ") << msg << endl;
+  return ok;
+}
+
+static TID makeTID(uint page, uint slot)
+{
+  TID tid;
+  tid.page = page;
+  tid.slot = slot;
+  return tid;
+}
+
+// Duplikate des Schlüssels 1 liegen im Wurzelblatt, vor dem zweiten Stapel wird die Wurzel geteilt
+static bool testCursor(DBBufferMgr & bufMgr, DBFile & file)
+{
+  DBBLinkIndex index(bufMgr, file, INT, WRITE, false);
+  DBIntType val(1);
+  for (uint i = 0; i < dupCnt; ++i)
+    index.insert(val, makeTID(i, 0));
+
+  DBTIDBatch tids, all;
+  index.openCursor(val);
+  index.nextBatch(tids, 5);
+  all.insert(all.end(), tids.begin(), tids.end());
+
+  uint blocks = bufMgr.getBlockCount(file);
+  for (uint i = 0; i < keyCnt; ++i)
+    index.insert(DBIntType(1000 + i), makeTID(1000 + i, 0));
+  bool ok = check(bufMgr.getBlockCount(file) > blocks + 1, "Wurzel geteilt");
+
+  while (index.nextBatch(tids, 5) == true)
+    all.insert(all.end(), tids.begin(), tids.end());
+  index.closeCursor();
+
+  bool found = all.size() == dupCnt;
+  for (uint i = 0; found == true && i < dupCnt; ++i)
+    found = all[i] == makeTID(i, 0);
+  return check(found, "nextBatch() liefert nach dem Teilen alle " + TO_STR(dupCnt) + " TIDs") && ok;
+}
+
+// der geordnete Cursor steht nach dem ersten Schlüssel noch im Wurzelblatt
+static bool testOrderedCursor(DBBufferMgr & bufMgr, DBFile & file)
+{
+  DBBLinkIndex index(bufMgr, file, INT, WRITE, true);
+  for (uint i = 0; i < 10; ++i)
+    index.insert(DBIntType(i), makeTID(i, 0));
+
+  string key, prev;
+  DBTIDBatch tids;
+  index.openOrderedCursor();
+  index.nextOrdered(prev, tids);
+  uint cnt = 1;
+
+  for (uint i = 10; i < keyCnt; ++i)
+    index.insert(DBIntType(i), makeTID(i, 0));
+
+  bool ordered = true;
+  while (index.nextOrdered(key, tids) == true) {
+    ordered = ordered && prev < key && tids.size() == 1;
+    prev = key;
+    ++cnt;
+  }
+  index.closeCursor();
+  return check(ordered == true && cnt == keyCnt, "nextOrdered() liefert nach dem Teilen alle " + TO_STR(keyCnt) + " Schlüssel geordnet");
+}
+
+// ein Duplikat mitten im Stapel darf keine Einträge des Stapels zurücklassen
+static bool testInsertSorted(DBBufferMgr & bufMgr, DBFile & file)
+{
+  DBBLinkIndex index(bufMgr, file, INT, WRITE, true);
+  index.insert(DBIntType(keyCnt / 2), makeTID(0, 1));
+
+  vector<const DBAttrType *> vals;
+  vector<TID> tids;
+  for (uint i = 0; i < keyCnt; ++i) {
+    vals.push_back(new DBIntType(i));
+    tids.push_back(makeTID(i, 0));
+  }
+  bool thrown = false;
+  try {
+    index.insertSorted(vals, tids);
+  } catch (DBException & e) {
+    thrown = true;
+  }
+  for (uint i = 0; i < vals.size(); ++i)
+    delete vals[i];
+  bool ok = check(thrown, "insertSorted() meldet das Duplikat");
+
+  uint cnt = 0;
+  for (uint i = 0; i < keyCnt; ++i) {
+    DBListTID l;
+    index.find(DBIntType(i), l);
+    cnt += l.size();
+  }
+  DBListTID l;
+  index.find(DBIntType(keyCnt / 2), l);
+  return check(cnt == 1 && l.size() == 1 && l.front() == makeTID(0, 1), "insertSorted() entfernt die bereits eingefügten Einträge") && ok;
+}
+
+static bool runTest(DBBufferMgr & bufMgr, bool (*test)(DBBufferMgr &, DBFile &))
+{
+  bufMgr.createFile(indexFileName);
+  DBFile & file = bufMgr.openFile(indexFileName);
+  bool ok = test(bufMgr, file);
+  bufMgr.closeFile(file);
+  bufMgr.dropFile(indexFileName);
+  return ok;
+}
+
+int main()
+{
+  int rc = EXIT_SUCCESS;
+  try{
+    File f("log4c++.hubDB.properties.server");
+    PropertyConfigurator::configure(f);
+    DBRandomBufferMgr bufMgr(false);
+    bool ok = runTest(bufMgr, testCursor);
+    ok = runTest(bufMgr, testOrderedCursor) && ok;
+    ok = runTest(bufMgr, testInsertSorted) && ok;
+    if (ok == false)
+      rc = EXIT_FAILURE;
+  }catch(DBException & e){
+    cout << e.what() << endl;
+    rc = EXIT_FAILURE;
+  }catch(Exception &){
+    rc = EXIT_FAILURE;
+  }
+  return rc;
+}
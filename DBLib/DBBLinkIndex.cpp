@@ -0,0 +1,846 @@
+#include <hubDB/DBBLinkIndex.h>
+#include <hubDB/DBFileBlock.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Index;
+using namespace HubDB::Exception;
+
+LoggerPtr DBBLinkIndex::logger(Logger::getLogger("HubDB.Index.DBBLinkIndex"));
+
+// registerClass()-Methode am Ende dieser Datei: macht die Klasse der Factory bekannt
+int rBLinkIdx = DBBLinkIndex::registerClass();
+
+// die Wurzel bleibt immer Block 0 und ist nie rechter Nachbar oder Kind, daher ist 0 als "kein Verweis" frei
+const BlockNo DBBLinkIndex::rootBlockNo(0);
+const BlockNo DBBLinkIndex::noLink(0);
+const uint DBBLinkIndex::noHighKey(0xFFFFFFFF);
+
+extern "C" void *createDBBLinkIndex(int nArgs, va_list ap);
+
+/**
+ * Ausgabe des Indexes zum Debuggen
+ */
+string DBBLinkIndex::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBBLinkIndex]" << endl;
+  ss << DBIndex::toString(linePrefix + "\t") << endl;
+  ss << linePrefix << "cursorOpen: " << cursorOpen << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+/**
+ * Konstruktor
+ * @param bufferMgr Referenz auf Buffermanager
+ * @param file Referenz auf Dateiobjekt
+ * @param attrType Typ des Indexattributs
+ * @param mode Accesstyp: READ, WRITE - siehe DBTypes.h
+ * @param unique ist Attribute unique
+ */
+DBBLinkIndex::DBBLinkIndex(DBBufferMgr &bufferMgr, DBFile &file,
+                           enum AttrTypeEnum attrType, ModType mode, bool unique) :
+        DBIndex(bufferMgr, file, attrType, mode, unique),
+        cursorOpen(false),
+        cursorBlockNo(noLink) {
+  if (logger != NULL) {
+    LOG4CXX_INFO(logger, "DBBLinkIndex()");
+  }
+
+  // anders als beim DBSeqIndex wird die Wurzel nicht dauerhaft fixiert,
+  // sonst müssten Schreiber auf alle Leser warten
+  if (bufMgr.getBlockCount(file) == 0) {
+    initializeIndex();
+  }
+
+  if (logger != NULL) {
+    LOG4CXX_DEBUG(logger, "this:\n" + toString("\t"));
+  }
+}
+
+/**
+ * Destruktor
+ */
+DBBLinkIndex::~DBBLinkIndex() {
+  LOG4CXX_INFO(logger, "~DBBLinkIndex()");
+  unfixBACBs(false);
+}
+
+/**
+ * Freigeben aller vom Index fixierten Blöcke im BufferManager (nach einem Fehler)
+ * @param setDirty
+ */
+void DBBLinkIndex::unfixBACBs(bool setDirty) {
+  LOG4CXX_INFO(logger, "unfixBACBs()");
+  while (!bacbStack.empty()) {
+    try {
+      if (bacbStack.top().getModified() && setDirty) {
+        bacbStack.top().setDirty();
+      }
+      bufMgr.unfixBlock(bacbStack.top());
+    } catch (DBException e) {
+    }
+    bacbStack.pop();
+  }
+}
+
+/**
+ * Prüft, dass zwischen zwei Operationen kein Knoten fixiert ist
+ */
+void DBBLinkIndex::checkBacbStackInvariant() {
+  if (!bacbStack.empty()) {
+    throw DBIndexException("BACB Stack is invalid");
+  }
+}
+
+/**
+ * Erstellt Indexdatei mit leerer Wurzel (Blatt).
+ */
+void DBBLinkIndex::initializeIndex() {
+  LOG4CXX_INFO(logger, "initializeIndex()");
+  if (bufMgr.getBlockCount(file) != 0) {
+    throw DBIndexException("can not initialize existing table");
+  }
+
+  Node root;
+  root.level = 0;
+  root.rightLink = noLink;
+  root.hasHighKey = false;
+
+  DBBACB rootBlock = bufMgr.fixNewBlock(file);
+  root.write(rootBlock.getDataPtr());
+  rootBlock.setModified();
+  bufMgr.unfixBlock(rootBlock);
+}
+
+/**
+ * Schlüssel eines Werts, VARCHAR mit Nullbyte, damit kein Schlüssel Präfix eines anderen ist
+ */
+std::string DBBLinkIndex::searchKey(const DBAttrType &val) const {
+  std::string key = val.normalizedKey();
+  if (DBAttrType::getKeySize4Type(attrType) == 0)
+    key.push_back('\0');
+  return key;
+}
+
+/**
+ * Schlüssel eines Eintrags: bei Duplikaten wird die TID (big endian) angehängt
+ */
+std::string DBBLinkIndex::entryKey(const std::string &search, const TID &tid) const {
+  if (unique)
+    return search;
+  std::string key(search);
+  for (int i = 3; i >= 0; --i)
+    key.push_back((char) (tid.page >> (8 * i)));
+  for (int i = 3; i >= 0; --i)
+    key.push_back((char) (tid.slot >> (8 * i)));
+  return key;
+}
+
+/**
+ * Sucht alle TIDs zu einem Schlüssel
+ * @param val  zu suchender Schluesselwert
+ * @param tids Rückgabe, nach TID sortiert
+ */
+void DBBLinkIndex::find(const DBAttrType &val, DBListTID &tids) {
+  LOG4CXX_INFO(logger, "find()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+  tids.clear();
+  DBTIDBatch batch;
+  openCursor(val);
+  while (nextBatch(batch)) {
+    tids.insert(tids.end(), batch.begin(), batch.end());
+  }
+  closeCursor();
+}
+
+/**
+ * Einfügen eines Schlüsselwertes zusammen mit einer TID
+ * @param val Schlüsselwert
+ * @param tid
+ */
+void DBBLinkIndex::insert(const DBAttrType &val, const TID &tid) {
+  LOG4CXX_INFO(logger, "insert()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+  LOG4CXX_DEBUG(logger, "tid: " + tid.toString());
+
+  checkBacbStackInvariant();
+
+  stack<BlockNo> path;
+  insertEntry(entryKey(searchKey(val), tid), tid, 0, path);
+
+  checkBacbStackInvariant();
+}
+
+/**
+ * Einfügen sortierter Einträge: alle aufeinanderfolgenden Einträge, die in
+ * dasselbe Blatt gehören und darin Platz haben, werden mit einem Abstieg
+ * eingefügt. Erst der Eintrag, der das Blatt überlaufen lässt, wird über
+ * insertEntry() eingefügt, das den Knoten teilt.
+ * @param vals aufsteigend sortierte Schlüsselwerte
+ * @param tids
+ */
+void DBBLinkIndex::insertSorted(const vector<const DBAttrType *> &vals, const vector<TID> &tids) {
+  LOG4CXX_INFO(logger, "insertSorted()");
+  LOG4CXX_DEBUG(logger, "entries: " + TO_STR(vals.size()));
+
+  checkBacbStackInvariant();
+
+  uint i = 0;
+  try {
+    while (i < vals.size()) {
+      std::string key = entryKey(searchKey(*vals[i]), tids[i]);
+      stack<BlockNo> path;
+      Node node;
+      descend(key, 0, LOCK_EXCLUSIVE, node, &path);
+      bool modified = false;
+      bool overflow = false;
+      while (true) {
+        uint pos = node.lowerBound(key);
+        if (pos < node.entries.size() && node.entries[pos].key == key) {
+          if (modified == true) {
+            node.write(bacbStack.top().getDataPtr());
+            bacbStack.top().setModified();
+          }
+          unfixNode();
+          if (isUnique())
+            throw DBIndexUniqueKeyException("Attr already in index");
+          throw DBIndexUniqueKeyException("Attr, tidToInsert already in index");
+        }
+        node.entries.insert(node.entries.begin() + pos, NodeEntry(key, tids[i]));
+        if (node.encodedSize() > file.getBlockSize()) {
+          node.entries.erase(node.entries.begin() + pos);
+          overflow = true;
+          break;
+        }
+        modified = true;
+        if (++i == vals.size())
+          break;
+        std::string next = entryKey(searchKey(*vals[i]), tids[i]);
+        if (next < key || node.beyond(next))
+          break;
+        key = next;
+      }
+      if (modified == true) {
+        node.write(bacbStack.top().getDataPtr());
+        bacbStack.top().setModified();
+      }
+      unfixNode();
+      if (overflow == true) {
+        insertEntry(key, tids[i], 0, path);
+        ++i;
+      }
+    }
+  } catch (DBException e) {
+    // a rejected entry leaves the index as it was before the batch
+    for (uint u = 0; u < i; ++u)
+      remove(*vals[u], DBListTID(1, tids[u]));
+    throw e;
+  }
+
+  checkBacbStackInvariant();
+}
+
+/**
+ * Entfernt alle übergebenen TIDs unter dem angegebenen Schlüssel.
+ * Leere Knoten bleiben bestehen.
+ * @param val Der zu löschende Wert
+ * @param tids Die zu entfernenden TIDs
+ */
+void DBBLinkIndex::remove(const DBAttrType &val, const DBListTID &tids) {
+  LOG4CXX_INFO(logger, "remove()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+
+  checkBacbStackInvariant();
+
+  if (unique && tids.size() > 1) {
+    throw DBIndexUniqueKeyException("trying to remove multiple keys in a unique index");
+  }
+
+  std::string search = searchKey(val);
+  DBListTID::const_iterator i = tids.begin();
+  while (i != tids.end()) {
+    std::string key = entryKey(search, *i);
+    Node node;
+    descend(key, 0, LOCK_EXCLUSIVE, node, NULL);
+    uint pos = node.lowerBound(key);
+    if (pos == node.entries.size() || node.entries[pos].key != key || !(node.entries[pos].value == *i)) {
+      unfixNode();
+      throw DBIndexException("key not found (val:\n" + val.toString("\t") + ")");
+    }
+    node.entries.erase(node.entries.begin() + pos);
+    node.write(bacbStack.top().getDataPtr());
+    bacbStack.top().setModified();
+    unfixNode();
+    ++i;
+  }
+
+  checkBacbStackInvariant();
+}
+
+/**
+ * Öffnet einen Cursor auf alle TIDs zum Schlüssel val.
+ * Die Blätter werden erst in nextBatch() gelesen.
+ * @param val Schlüsselwert
+ */
+void DBBLinkIndex::openCursor(const DBAttrType &val) {
+  LOG4CXX_INFO(logger, "openCursor()");
+  closeCursor();
+  cursorOpen = true;
+  cursorKey = searchKey(val);
+  cursorNextKey = cursorKey;
+  cursorBlockNo = noLink;
+}
+
+/**
+ * Liefert die nächsten (höchstens maxTids) TIDs des Cursors.
+ *
+ * Zwischen zwei Aufrufen ist kein Blatt fixiert. Gemerkt werden das Blatt und der
+ * nächste zu liefernde Schlüssel; wurde das Blatt inzwischen geteilt, liegt dieser
+ * rechts davon und wird über die rechten Verweise gefunden.
+ *
+ * @param tids Puffer, wird geleert und gefüllt (nach TID sortiert)
+ * @param maxTids maximale Anzahl TIDs pro Stapel
+ * @return false, falls keine TIDs mehr vorhanden sind
+ */
+bool DBBLinkIndex::nextBatch(DBTIDBatch &tids, uint maxTids) {
+  LOG4CXX_INFO(logger, "nextBatch()");
+
+  checkBacbStackInvariant();
+
+  tids.clear();
+  if (!cursorOpen)
+    return false;
+
+  Node node;
+  fixCursorLeaf(node);
+
+  while (cursorOpen && tids.size() < maxTids) {
+    uint pos = node.lowerBound(cursorNextKey);
+    bool done = false;
+    while (!done && pos < node.entries.size() && tids.size() < maxTids) {
+      const NodeEntry &entry = node.entries[pos];
+      if (entry.key.compare(0, cursorKey.size(), cursorKey) != 0) {
+        done = true;
+      } else {
+        tids.push_back(entry.value);
+        ++pos;
+      }
+    }
+
+    if (done) {
+      cursorOpen = false;
+    } else if (pos < node.entries.size()) {
+      // Puffer voll, beim nächsten Aufruf hier weiterlesen
+      cursorNextKey = node.entries[pos].key;
+    } else if (!node.hasHighKey || node.highKey.compare(0, cursorKey.size(), cursorKey) > 0) {
+      // rechts kann kein Schlüssel mit diesem Wert mehr liegen
+      cursorOpen = false;
+    } else {
+      cursorNextKey = node.highKey;
+      if (tids.size() < maxTids) {
+        BlockNo right = node.rightLink;
+        unfixNode();
+        cursorBlockNo = right;
+        fixNode(cursorBlockNo, LOCK_SHARED, node);
+      } else {
+        cursorBlockNo = node.rightLink;
+      }
+    }
+  }
+  unfixNode();
+
+  checkBacbStackInvariant();
+
+  LOG4CXX_DEBUG(logger, "tids: " + TO_STR(tids.size()));
+  return !tids.empty();
+}
+
+/**
+ * Fixiert das Blatt, in dessen Bereich der nächste Schlüssel des Cursors liegt.
+ *
+ * Das gemerkte Blatt kann inzwischen ein innerer Knoten sein: beim Teilen der Wurzel
+ * wandert ihr Inhalt in neue Knoten, Block 0 bleibt die Wurzel. Dann wird erneut
+ * von der Wurzel abgestiegen.
+ *
+ * @param node Rückgabe: Inhalt des Blatts
+ */
+void DBBLinkIndex::fixCursorLeaf(Node &node) {
+  if (cursorBlockNo != noLink) {
+    fixNode(cursorBlockNo, LOCK_SHARED, node);
+    if (node.isLeaf()) {
+      cursorBlockNo = moveRight(cursorBlockNo, cursorNextKey, LOCK_SHARED, node);
+      return;
+    }
+    LOG4CXX_DEBUG(logger, "cursor node " + TO_STR(cursorBlockNo) + " is no leaf anymore");
+    unfixNode();
+  }
+  cursorBlockNo = descend(cursorNextKey, 0, LOCK_SHARED, node, NULL);
+}
+
+/**
+ * Schließt den Cursor
+ */
+void DBBLinkIndex::closeCursor() {
+  cursorOpen = false;
+  cursorKey.clear();
+  cursorNextKey.clear();
+  cursorBlockNo = noLink;
+}
+
+/**
+ * Öffnet einen Cursor über alle Schlüssel, beginnend im linken Blatt
+ */
+bool DBBLinkIndex::openOrderedCursor() {
+  LOG4CXX_INFO(logger, "openOrderedCursor()");
+  closeCursor();
+  cursorOpen = true;
+  return true;
+}
+
+/**
+ * Liefert den nächsten Schlüssel mit allen TIDs.
+ *
+ * Wie in nextBatch() ist zwischen zwei Aufrufen kein Blatt fixiert; gemerkt wird
+ * der erste noch nicht gelieferte Eintrag. Bei Indexen mit Duplikaten gehören
+ * alle Einträge mit gleichem Schlüssel ohne angehängte TID zusammen.
+ *
+ * @param key Rückgabe: normalisierter Schlüssel (ohne abschließendes Nullbyte)
+ * @param tids Rückgabe: TIDs des Schlüssels, nach TID sortiert
+ * @return false, falls keine Schlüssel mehr vorhanden sind
+ */
+bool DBBLinkIndex::nextOrdered(std::string &key, DBTIDBatch &tids) {
+  LOG4CXX_INFO(logger, "nextOrdered()");
+
+  checkBacbStackInvariant();
+
+  tids.clear();
+  if (!cursorOpen)
+    return false;
+
+  Node node;
+  fixCursorLeaf(node);
+
+  std::string search;
+  bool found = false;
+  bool done = false;
+  while (!done) {
+    uint pos = node.lowerBound(cursorNextKey);
+    while (!done && pos < node.entries.size()) {
+      const NodeEntry &entry = node.entries[pos];
+      std::string entrySearch = unique ? entry.key : entry.key.substr(0, entry.key.size() - 2 * sizeof(uint));
+      if (!found) {
+        search = entrySearch;
+        found = true;
+      }
+      if (entrySearch != search) {
+        cursorNextKey = entry.key;
+        done = true;
+      } else {
+        tids.push_back(entry.value);
+        ++pos;
+      }
+    }
+
+    if (!done) {
+      if (!node.hasHighKey) {
+        // letztes Blatt gelesen
+        cursorOpen = false;
+        done = true;
+      } else {
+        cursorNextKey = node.highKey;
+        BlockNo right = node.rightLink;
+        unfixNode();
+        cursorBlockNo = right;
+        fixNode(cursorBlockNo, LOCK_SHARED, node);
+      }
+    }
+  }
+  unfixNode();
+
+  checkBacbStackInvariant();
+
+  if (found && DBAttrType::getKeySize4Type(attrType) == 0)
+    search.erase(search.size() - 1);
+  key = search;
+  LOG4CXX_DEBUG(logger, "tids: " + TO_STR(tids.size()));
+  return found;
+}
+
+/**
+ * Steigt von der Wurzel zum Knoten der angegebenen Ebene ab, in dessen Bereich key liegt.
+ *
+ * Es ist immer nur ein Knoten fixiert: der Vater wird freigegeben, bevor das Kind fixiert
+ * wird. Wurde das Kind inzwischen geteilt, wird über die rechten Verweise weitergegangen.
+ * Der Zielknoten bleibt im Modus mode fixiert (oberstes Element von bacbStack).
+ *
+ * @param key Schlüssel
+ * @param level Ebene des Zielknotens (0: Blatt)
+ * @param mode Sperrmodus für den Zielknoten, alle anderen Knoten werden nur gelesen
+ * @param node Rückgabe: Inhalt des Zielknotens
+ * @param path Rückgabe (falls nicht NULL): die besuchten Väter, um später Trenner einzufügen
+ * @return Blocknummer des Zielknotens
+ */
+BlockNo DBBLinkIndex::descend(const std::string &key, uint level, DBBCBLockMode mode, Node &node, stack<BlockNo> *path) {
+  LOG4CXX_INFO(logger, "descend()");
+  LOG4CXX_DEBUG(logger, "level: " + TO_STR(level));
+
+  BlockNo blockNo = rootBlockNo;
+  fixNode(blockNo, LOCK_SHARED, node);
+  if (node.level == level && mode != LOCK_SHARED) {
+    // die Wurzel ist selbst der Zielknoten
+    unfixNode();
+    fixNode(blockNo, mode, node);
+    if (node.level != level) {
+      // die Wurzel wurde inzwischen geteilt
+      unfixNode();
+      return descend(key, level, mode, node, path);
+    }
+  }
+  if (node.level < level) {
+    unfixNode();
+    throw DBIndexException("invalid tree level");
+  }
+
+  while (node.level > level) {
+    if (node.beyond(key)) {
+      BlockNo right = node.rightLink;
+      unfixNode();
+      blockNo = right;
+      fixNode(blockNo, LOCK_SHARED, node);
+    } else {
+      if (path != NULL)
+        path->push(blockNo);
+      BlockNo child = node.child(key);
+      DBBCBLockMode m = (node.level == level + 1) ? mode : LOCK_SHARED;
+      unfixNode();
+      blockNo = child;
+      fixNode(blockNo, m, node);
+    }
+  }
+  return moveRight(blockNo, key, mode, node);
+}
+
+/**
+ * Geht vom fixierten Knoten so lange nach rechts, bis key nicht mehr jenseits des High-Keys liegt
+ * @return Blocknummer des dann fixierten Knotens
+ */
+BlockNo DBBLinkIndex::moveRight(BlockNo blockNo, const std::string &key, DBBCBLockMode mode, Node &node) {
+  while (node.beyond(key)) {
+    LOG4CXX_DEBUG(logger, "move right from " + TO_STR(blockNo) + " to " + TO_STR(node.rightLink));
+    BlockNo right = node.rightLink;
+    unfixNode();
+    blockNo = right;
+    fixNode(blockNo, mode, node);
+  }
+  return blockNo;
+}
+
+/**
+ * Fügt einen Eintrag in den Knoten der angegebenen Ebene ein.
+ *
+ * Läuft der Knoten über, wird er geteilt: die obere Hälfte kommt in einen neuen Knoten,
+ * der über den rechten Verweis sofort erreichbar ist. Erst danach wird der Knoten
+ * freigegeben und der Trenner (rekursiv) in den Vater eingefügt.
+ *
+ * @param key Schlüssel des Eintrags
+ * @param value TID bzw. Kindknoten
+ * @param level Ebene
+ * @param path Väter aus dem Abstieg, der oberste ist der Vater dieser Ebene
+ */
+void DBBLinkIndex::insertEntry(const std::string &key, const TID &value, uint level, stack<BlockNo> &path) {
+  LOG4CXX_INFO(logger, "insertEntry()");
+  LOG4CXX_DEBUG(logger, "level: " + TO_STR(level));
+
+  Node node;
+  BlockNo blockNo = rootBlockNo;
+  bool found = false;
+  if (!path.empty()) {
+    blockNo = path.top();
+    path.pop();
+    fixNode(blockNo, LOCK_EXCLUSIVE, node);
+    if (node.level != level) {
+      // die Wurzel wurde inzwischen geteilt, der Weg ist veraltet
+      unfixNode();
+    } else {
+      blockNo = moveRight(blockNo, key, LOCK_EXCLUSIVE, node);
+      found = true;
+    }
+  }
+  if (found == false) {
+    while (!path.empty())
+      path.pop();
+    blockNo = descend(key, level, LOCK_EXCLUSIVE, node, &path);
+  }
+
+  uint pos = node.lowerBound(key);
+  if (pos < node.entries.size() && node.entries[pos].key == key) {
+    unfixNode();
+    if (isUnique())
+      throw DBIndexUniqueKeyException("Attr already in index");
+    throw DBIndexUniqueKeyException("Attr, tidToInsert already in index");
+  }
+  node.entries.insert(node.entries.begin() + pos, NodeEntry(key, value));
+
+  if (node.encodedSize() <= file.getBlockSize()) {
+    node.write(bacbStack.top().getDataPtr());
+    bacbStack.top().setModified();
+    unfixNode();
+    return;
+  }
+
+  if (blockNo == rootBlockNo) {
+    splitRoot(node);
+    return;
+  }
+
+  LOG4CXX_DEBUG(logger, "split node " + TO_STR(blockNo));
+  Node right;
+  std::string separator = split(node, right);
+
+  bacbStack.push(bufMgr.fixNewBlock(file));
+  BlockNo rightBlockNo = bacbStack.top().getBlockNo();
+  right.rightLink = node.rightLink;
+  right.hasHighKey = node.hasHighKey;
+  right.highKey = node.highKey;
+  right.write(bacbStack.top().getDataPtr());
+  bacbStack.top().setModified();
+  bufMgr.unfixBlock(bacbStack.top());
+  bacbStack.pop();
+
+  node.rightLink = rightBlockNo;
+  node.hasHighKey = true;
+  node.highKey = separator;
+  node.write(bacbStack.top().getDataPtr());
+  bacbStack.top().setModified();
+  unfixNode();
+
+  TID child;
+  child.page = rightBlockNo;
+  child.slot = 0;
+  insertEntry(separator, child, level + 1, path);
+}
+
+/**
+ * Teilt die Einträge eines übervollen Knotens nach Bytes auf
+ * @param node behält die untere Hälfte
+ * @param right Rückgabe: obere Hälfte (Ebene wird übernommen)
+ * @return Trenner: kleinster Schlüssel der oberen Hälfte
+ */
+std::string DBBLinkIndex::split(Node &node, Node &right) {
+  LOG4CXX_INFO(logger, "split()");
+  size_t total = 0;
+  for (uint i = 0; i < node.entries.size(); ++i)
+    total += node.entries[i].key.size() + sizeof(TID);
+
+  size_t half = 0;
+  uint leftCnt = 0;
+  while (leftCnt + 1 < node.entries.size() && half < total / 2) {
+    half += node.entries[leftCnt].key.size() + sizeof(TID);
+    ++leftCnt;
+  }
+
+  right.level = node.level;
+  right.entries.assign(node.entries.begin() + leftCnt, node.entries.end());
+  node.entries.erase(node.entries.begin() + leftCnt, node.entries.end());
+  LOG4CXX_DEBUG(logger, "leftcnt: " + TO_STR(node.entries.size()));
+  LOG4CXX_DEBUG(logger, "rightcnt: " + TO_STR(right.entries.size()));
+  return right.entries.front().key;
+}
+
+/**
+ * Teilt die (exklusiv fixierte) Wurzel: ihr Inhalt wird auf zwei neue Knoten verteilt,
+ * die Wurzel bleibt in Block 0 und zeigt eine Ebene höher auf beide.
+ * @param root übervoller Inhalt der Wurzel
+ */
+void DBBLinkIndex::splitRoot(Node &root) {
+  LOG4CXX_INFO(logger, "splitRoot()");
+  Node left = root;
+  Node right;
+  std::string separator = split(left, right);
+
+  bacbStack.push(bufMgr.fixNewBlock(file));
+  BlockNo leftBlockNo = bacbStack.top().getBlockNo();
+  bacbStack.push(bufMgr.fixNewBlock(file));
+  BlockNo rightBlockNo = bacbStack.top().getBlockNo();
+
+  right.rightLink = noLink;
+  right.hasHighKey = false;
+  right.write(bacbStack.top().getDataPtr());
+  bacbStack.top().setModified();
+  unfixNode();
+
+  left.rightLink = rightBlockNo;
+  left.hasHighKey = true;
+  left.highKey = separator;
+  left.write(bacbStack.top().getDataPtr());
+  bacbStack.top().setModified();
+  unfixNode();
+
+  TID child;
+  child.slot = 0;
+  root.level = root.level + 1;
+  root.rightLink = noLink;
+  root.hasHighKey = false;
+  root.entries.clear();
+  child.page = leftBlockNo;
+  root.entries.push_back(NodeEntry("", child));
+  child.page = rightBlockNo;
+  root.entries.push_back(NodeEntry(separator, child));
+  root.write(bacbStack.top().getDataPtr());
+  bacbStack.top().setModified();
+  unfixNode();
+}
+
+/**
+ * Fixiert einen Knoten, legt ihn auf den Stack und liest seinen Inhalt
+ */
+DBBACB &DBBLinkIndex::fixNode(BlockNo blockNo, DBBCBLockMode mode, Node &node) {
+  bacbStack.push(bufMgr.fixBlock(file, blockNo, mode));
+  node.read(bacbStack.top().getDataPtr());
+  return bacbStack.top();
+}
+
+/**
+ * Gibt den obersten Knoten des Stacks frei
+ */
+void DBBLinkIndex::unfixNode() {
+  bufMgr.unfixBlock(bacbStack.top());
+  bacbStack.pop();
+}
+
+/**
+ * Position des ersten Eintrags mit Schlüssel >= key
+ */
+uint DBBLinkIndex::Node::lowerBound(const std::string &key) const {
+  uint left = 0;
+  uint right = entries.size();
+  while (left < right) {
+    uint mid = left + (right - left) / 2;
+    if (entries[mid].key < key)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return left;
+}
+
+/**
+ * Kindknoten des letzten Eintrags mit Schlüssel <= key
+ */
+BlockNo DBBLinkIndex::Node::child(const std::string &key) const {
+  uint pos = lowerBound(key);
+  if (pos == entries.size() || entries[pos].key != key) {
+    if (pos > 0)
+      --pos;
+  }
+  return entries[pos].value.page;
+}
+
+size_t DBBLinkIndex::Node::encodedSize() const {
+  size_t prefix = 0;
+  if (!entries.empty()) {
+    const std::string &first = entries.front().key;
+    const std::string &last = entries.back().key;
+    while (prefix < first.size() && prefix < last.size() && first[prefix] == last[prefix])
+      ++prefix;
+  }
+  size_t size = sizeof(nodePageLayout) + (hasHighKey ? highKey.size() : 0) + 1 + prefix;
+  for (uint i = 0; i < entries.size(); ++i)
+    size += 1 + entries[i].key.size() - prefix + sizeof(TID);
+  return size;
+}
+
+void DBBLinkIndex::Node::write(char *ptr) const {
+  nodePageLayout *page = (nodePageLayout *) ptr;
+  page->countEntries = entries.size();
+  page->level = level;
+  page->rightLink = rightLink;
+  page->highKeyLen = hasHighKey ? highKey.size() : noHighKey;
+  ptr += sizeof(nodePageLayout);
+  if (hasHighKey) {
+    memcpy(ptr, highKey.data(), highKey.size());
+    ptr += highKey.size();
+  }
+
+  // gemeinsamer Präfix aller Schlüssel des Knotens
+  size_t prefix = 0;
+  if (!entries.empty()) {
+    const std::string &first = entries.front().key;
+    const std::string &last = entries.back().key;
+    while (prefix < first.size() && prefix < last.size() && first[prefix] == last[prefix])
+      ++prefix;
+  }
+  *ptr++ = (char) prefix;
+  if (prefix > 0) {
+    memcpy(ptr, entries.front().key.data(), prefix);
+    ptr += prefix;
+  }
+
+  for (uint i = 0; i < entries.size(); ++i) {
+    size_t suffix = entries[i].key.size() - prefix;
+    *ptr++ = (char) suffix;
+    memcpy(ptr, entries[i].key.data() + prefix, suffix);
+    ptr += suffix;
+    memcpy(ptr, &entries[i].value, sizeof(TID));
+    ptr += sizeof(TID);
+  }
+}
+
+void DBBLinkIndex::Node::read(const char *ptr) {
+  const nodePageLayout *page = (const nodePageLayout *) ptr;
+  uint cnt = page->countEntries;
+  level = page->level;
+  rightLink = page->rightLink;
+  hasHighKey = page->highKeyLen != noHighKey;
+  ptr += sizeof(nodePageLayout);
+  if (hasHighKey) {
+    highKey.assign(ptr, page->highKeyLen);
+    ptr += page->highKeyLen;
+  } else {
+    highKey.clear();
+  }
+
+  size_t prefix = (unsigned char) *ptr++;
+  std::string prefixKey(ptr, prefix);
+  ptr += prefix;
+
+  entries.clear();
+  entries.reserve(cnt);
+  for (uint i = 0; i < cnt; ++i) {
+    size_t suffix = (unsigned char) *ptr++;
+    std::string key(prefixKey);
+    key.append(ptr, suffix);
+    ptr += suffix;
+    TID value;
+    ptr = value.read(ptr);
+    entries.push_back(NodeEntry(key, value));
+  }
+}
+
+/**
+ * Fügt createDBBLinkIndex zur globalen factory method-map hinzu
+ */
+int DBBLinkIndex::registerClass() {
+  setClassForName("DBBLinkIndex", createDBBLinkIndex);
+  return 0;
+}
+
+/**
+ * Wird aufgerufen von HubDB::Types::getClassForName von DBTypes, um DBIndex zu erstellen
+ * @param DBBufferMgr *: Buffermanager
+ * @param DBFile *: Dateiobjekt
+ * @param attrType: Attributtp
+ * @param ModeType: READ, WRITE
+ * @param bool: unique Indexattribut
+ */
+extern "C" void *createDBBLinkIndex(int nArgs, va_list ap) {
+  if (nArgs != 5) {
+    throw DBException("Invalid number of arguments");
+  }
+  DBBufferMgr *bufMgr = va_arg(ap, DBBufferMgr *);
+  DBFile *file = va_arg(ap, DBFile *);
+  enum AttrTypeEnum attrType = (enum AttrTypeEnum) va_arg(ap, int);
+  ModType m = (ModType) va_arg(ap, int);
+  bool unique = (bool) va_arg(ap, int);
+  return new DBBLinkIndex(*bufMgr, *file, attrType, m, unique);
+}
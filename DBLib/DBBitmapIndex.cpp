@@ -0,0 +1,617 @@
+#include <hubDB/DBBitmapIndex.h>
+#include <hubDB/DBFileBlock.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Index;
+using namespace HubDB::Exception;
+
+LoggerPtr DBBitmapIndex::logger(Logger::getLogger("HubDB.Index.DBBitmapIndex"));
+
+// registerClass()-Methode am Ende dieser Datei: macht die Klasse der Factory bekannt
+int rBitmapIdx = DBBitmapIndex::registerClass();
+
+// Block 0 ist immer die erste Verzeichnisseite, Datenseiten haben daher nie die Nummer 0
+const BlockNo DBBitmapIndex::rootBlockNo(0);
+
+extern "C" void *createDBBitmapIndex(int nArgs, va_list ap);
+
+/**
+ * Ausgabe des Indexes zum Debuggen
+ */
+string DBBitmapIndex::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBBitmapIndex]" << endl;
+  ss << DBIndex::toString(linePrefix + "\t") << endl;
+  ss << linePrefix << "dirEntriesPerPage: " << dirEntriesPerPage() << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+/**
+ * Konstruktor
+ * @param bufferMgr Referenz auf Buffermanager
+ * @param file Referenz auf Dateiobjekt
+ * @param attrType Typ des Indexattributs
+ * @param mode Accesstyp: READ, WRITE - siehe DBTypes.h
+ * @param unique ist Attribute unique
+ */
+DBBitmapIndex::DBBitmapIndex(DBBufferMgr &bufferMgr, DBFile &file,
+                             enum AttrTypeEnum attrType, ModType mode, bool unique) :
+        DBIndex(bufferMgr, file, attrType, mode, unique) {
+  if (logger != NULL) {
+    LOG4CXX_INFO(logger, "DBBitmapIndex()");
+  }
+  assert(dirEntriesPerPage() >= 1);
+
+  if (bufMgr.getBlockCount(file) == 0) {
+    initializeIndex();
+  }
+
+  bacbStack.push(bufMgr.fixBlock(file, rootBlockNo, mode == READ ? LOCK_SHARED : LOCK_INTWRITE));
+
+  if (logger != NULL) {
+    LOG4CXX_DEBUG(logger, "this:\n" + toString("\t"));
+  }
+}
+
+/**
+ * Destruktor
+ */
+DBBitmapIndex::~DBBitmapIndex() {
+  LOG4CXX_INFO(logger, "~DBBitmapIndex()");
+  unfixBACBs(false);
+}
+
+/**
+ * Freigeben aller vom Index fixierten Blöcke im BufferManager
+ * @param setDirty
+ */
+void DBBitmapIndex::unfixBACBs(bool setDirty) {
+  LOG4CXX_INFO(logger, "unfixBACBs()");
+  while (!bacbStack.empty()) {
+    try {
+      if (bacbStack.top().getModified() && setDirty) {
+        bacbStack.top().setDirty();
+      }
+      bufMgr.unfixBlock(bacbStack.top());
+    } catch (DBException e) {
+    }
+    bacbStack.pop();
+  }
+}
+
+/**
+ * Anzahl der Schlüssel pro Verzeichnisseite
+ */
+uint DBBitmapIndex::dirEntriesPerPage() const {
+  return (file.getBlockSize() - sizeof(dirPageLayout)) / dirEntrySize();
+}
+
+/**
+ * Platz für Container auf einer Datenseite
+ */
+size_t DBBitmapIndex::dataCapacity() const {
+  return file.getBlockSize() - sizeof(dataPageLayout);
+}
+
+/**
+ * Erstellt Indexdatei mit leerem Verzeichnis.
+ */
+void DBBitmapIndex::initializeIndex() {
+  LOG4CXX_INFO(logger, "initializeIndex()");
+  if (bufMgr.getBlockCount(file) != 0) {
+    throw DBIndexException("can not initialize existing table");
+  }
+
+  DBBACB rootBlock = bufMgr.fixNewBlock(file);
+  memset(rootBlock.getDataPtr(), 0, file.getBlockSize());
+  rootBlock.setModified();
+  bufMgr.unfixBlock(rootBlock);
+}
+
+/**
+ * Sucht alle TIDs zu einem Schlüssel
+ * @param val  zu suchender Schluesselwert
+ * @param tids Rückgabe, nach Seiten sortiert
+ */
+void DBBitmapIndex::find(const DBAttrType &val, DBListTID &tids) {
+  LOG4CXX_INFO(logger, "find()");
+  tids.clear();
+  DBTIDBitmap bitmap;
+  findBitmap(val, bitmap);
+  bitmap.toList(tids);
+}
+
+/**
+ * Lädt die Bitmap eines Schlüssels aus seiner Kette von Datenseiten
+ * @param val  zu suchender Schluesselwert
+ * @param tids Rückgabe
+ * @return immer true, da der Index Bitmaps liefern kann
+ */
+bool DBBitmapIndex::findBitmap(const DBAttrType &val, DBTIDBitmap &tids) {
+  LOG4CXX_INFO(logger, "findBitmap()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+
+  checkBacbStackInvariant();
+  tids.clear();
+  // längere Werte als der Schlüssel können nicht gespeichert sein
+  if (val.type() == VCHAR && ((const DBVCharType &) val).getVal().size() > attrTypeSize)
+    return true;
+
+  vector<char> key(attrTypeSize);
+  val.write(&key[0]);
+
+  BlockNo dirBlockNo, first, last;
+  uint pos;
+  if (findDirEntry(&key[0], dirBlockNo, pos, first, last)) {
+    BlockNo b = first;
+    while (b != rootBlockNo) {
+      DBBACB block = fixNonRootBlock(b, LOCK_SHARED);
+      vector<DBTIDContainer> containers;
+      readContainers(block.getDataPtr(), containers);
+      for (uint i = 0; i < containers.size(); ++i) {
+        tids.addContainer(containers[i]);
+      }
+      b = ((const dataPageLayout *) block.getDataPtr())->nextBlock;
+      unfixNonRootBlock(block);
+    }
+  }
+
+  checkBacbStackInvariant();
+  LOG4CXX_DEBUG(logger, "tids:\n" + tids.toString("\t"));
+  return true;
+}
+
+/**
+ * Fügt eine TID unter dem Schlüssel ein.
+ *
+ * Es wird nur die Datenseite geändert, welche den Container der Tabellenseite
+ * enthält. Wird sie zu voll, wird sie geteilt und die neue Seite in die Kette gehängt.
+ *
+ * @param val Schlüsselwert
+ * @param tid
+ */
+void DBBitmapIndex::insert(const DBAttrType &val, const TID &tid) {
+  LOG4CXX_INFO(logger, "insert()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+  LOG4CXX_DEBUG(logger, "tid: " + tid.toString());
+
+  checkBacbStackInvariant();
+
+  // Den Root-Block exclusive locken
+  if (bacbStack.top().getLockMode() != LOCK_EXCLUSIVE) {
+    bufMgr.upgradeToExclusive(bacbStack.top());
+  }
+
+  vector<char> key(attrTypeSize);
+  val.write(&key[0]);
+
+  BlockNo dirBlockNo, first, last;
+  uint pos;
+  if (!findDirEntry(&key[0], dirBlockNo, pos, first, last)) {
+    createDirEntry(&key[0], dirBlockNo, pos, first);
+    last = first;
+  } else if (unique && hasTIDs(first)) {
+    throw DBIndexUniqueKeyException("Attr already in index");
+  }
+
+  BlockNo target = findDataPage(first, last, tid.page);
+  LOG4CXX_DEBUG(logger, "target: " + TO_STR(target));
+
+  DBBACB block = fixNonRootBlock(target, LOCK_EXCLUSIVE);
+  vector<DBTIDContainer> containers;
+  readContainers(block.getDataPtr(), containers);
+
+  uint i = 0;
+  while (i < containers.size() && containers[i].getPage() < tid.page) {
+    ++i;
+  }
+  if (i == containers.size() || containers[i].getPage() != tid.page) {
+    containers.insert(containers.begin() + i, DBTIDContainer(tid.page));
+  }
+  if (!containers[i].add(tid.slot)) {
+    unfixNonRootBlock(block);
+    throw DBIndexUniqueKeyException("Attr, tidToInsert already in index");
+  }
+
+  block.setModified();
+  bool lastChanged = false;
+  bool split = encodedSize(containers, 0, containers.size()) > dataCapacity();
+  if (!split) {
+    writeContainers(block.getDataPtr(), containers, 0, containers.size());
+  } else {
+    // so teilen, dass beide Hälften etwa gleich viele Bytes belegen
+    size_t total = encodedSize(containers, 0, containers.size());
+    uint mid = 1;
+    size_t leftSize = containers[0].encodedSize();
+    while (mid + 1 < containers.size() && leftSize + containers[mid].encodedSize() <= total / 2) {
+      leftSize += containers[mid].encodedSize();
+      ++mid;
+    }
+    if (leftSize > dataCapacity() || total - leftSize > dataCapacity()) {
+      unfixNonRootBlock(block);
+      throw DBIndexException("container too large");
+    }
+
+    BlockNo newBlockNo = newDataPage();
+    DBBACB newBlock = fixNonRootBlock(newBlockNo, LOCK_EXCLUSIVE);
+    dataPageLayout *oldPage = (dataPageLayout *) block.getDataPtr();
+    dataPageLayout *newPage = (dataPageLayout *) newBlock.getDataPtr();
+    newPage->nextBlock = oldPage->nextBlock;
+    oldPage->nextBlock = newBlockNo;
+    writeContainers(newBlock.getDataPtr(), containers, mid, containers.size());
+    writeContainers(block.getDataPtr(), containers, 0, mid);
+    newBlock.setModified();
+    unfixNonRootBlock(newBlock);
+
+    if (target == last) {
+      last = newBlockNo;
+      lastChanged = true;
+    }
+  }
+  unfixNonRootBlock(block);
+
+  if (lastChanged) {
+    setLastBlock(dirBlockNo, pos, last);
+  }
+
+  checkBacbStackInvariant();
+}
+
+/**
+ * Entfernt die übergebenen TIDs unter dem Schlüssel
+ *
+ * @param val Der zu löschende Wert
+ * @param tids Die Tupel Ids
+ */
+void DBBitmapIndex::remove(const DBAttrType &val, const DBListTID &tids) {
+  LOG4CXX_INFO(logger, "remove()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+
+  checkBacbStackInvariant();
+
+  // Den Root-Block "exclusive" locken
+  if (bacbStack.top().getLockMode() != LOCK_EXCLUSIVE) {
+    bufMgr.upgradeToExclusive(bacbStack.top());
+  }
+
+  if (unique && tids.size() > 1) {
+    throw DBIndexUniqueKeyException("trying to remove multiple keys in a unique index");
+  }
+
+  vector<char> key(attrTypeSize);
+  val.write(&key[0]);
+
+  BlockNo dirBlockNo, first, last;
+  uint pos;
+  if (!findDirEntry(&key[0], dirBlockNo, pos, first, last)) {
+    throw DBIndexException("key not found (valToRemove:\n" + val.toString("\t") + ")");
+  }
+
+  // TIDs nach Tabellenseite gruppieren
+  map<BlockNo, vector<uint> > toRemove;
+  for (DBListTID::const_iterator i = tids.begin(); i != tids.end(); ++i) {
+    toRemove[i->page].push_back(i->slot);
+  }
+
+  BlockNo b = first;
+  while (!toRemove.empty() && b != rootBlockNo) {
+    DBBACB block = fixNonRootBlock(b, LOCK_EXCLUSIVE);
+    vector<DBTIDContainer> containers;
+    readContainers(block.getDataPtr(), containers);
+
+    bool modified = false;
+    uint i = 0;
+    while (i < containers.size()) {
+      map<BlockNo, vector<uint> >::iterator r = toRemove.find(containers[i].getPage());
+      if (r != toRemove.end()) {
+        for (uint s = 0; s < r->second.size(); ++s) {
+          if (containers[i].remove(r->second[s]))
+            modified = true;
+        }
+        toRemove.erase(r);
+      }
+      if (containers[i].cardinality() == 0) {
+        containers.erase(containers.begin() + i);
+      } else {
+        ++i;
+      }
+    }
+
+    if (modified) {
+      block.setModified();
+      writeContainers(block.getDataPtr(), containers, 0, containers.size());
+    }
+    b = ((const dataPageLayout *) block.getDataPtr())->nextBlock;
+    unfixNonRootBlock(block);
+  }
+
+  checkBacbStackInvariant();
+
+  if (!toRemove.empty()) {
+    throw DBIndexException("could not remove all tidsToRemove");
+  }
+}
+
+/**
+ * Öffnet den Cursor. Die Bitmap des Schlüssels wird einmal geladen und
+ * anschließend in Seitenreihenfolge ausgegeben.
+ */
+void DBBitmapIndex::openCursor(const DBAttrType &val) {
+  LOG4CXX_INFO(logger, "openCursor()");
+  closeCursor();
+  findBitmap(val, cursorBitmap);
+}
+
+bool DBBitmapIndex::nextBatch(DBTIDBatch &tids, uint maxTids) {
+  LOG4CXX_INFO(logger, "nextBatch()");
+  return cursorBitmap.nextBatch(cursorPos, tids, maxTids);
+}
+
+void DBBitmapIndex::closeCursor() {
+  cursorBitmap.clear();
+  cursorPos = DBTIDBitmap::Position();
+}
+
+uint DBBitmapIndex::count(const DBAttrType &val) {
+  LOG4CXX_INFO(logger, "count()");
+  DBTIDBitmap tids;
+  findBitmap(val, tids);
+  return tids.cardinality();
+}
+
+/**
+ * Sucht den Schlüssel im Verzeichnis. Die Schlüssel werden byteweise verglichen.
+ * @param key Schlüssel im Format von DBAttrType::write()
+ * @param dirBlockNo Rückgabe: Verzeichnisseite
+ * @param pos Rückgabe: Position auf der Verzeichnisseite
+ * @param first Rückgabe: erste Datenseite
+ * @param last Rückgabe: letzte Datenseite
+ * @return true, falls der Schlüssel gefunden wurde
+ */
+bool DBBitmapIndex::findDirEntry(const char *key, BlockNo &dirBlockNo, uint &pos, BlockNo &first, BlockNo &last) {
+  LOG4CXX_INFO(logger, "findDirEntry()");
+  bool found = false;
+  dirBlockNo = rootBlockNo;
+  do {
+    DBBACB block = fixNonRootBlock(dirBlockNo, LOCK_SHARED);
+    const char *ptr = block.getDataPtr();
+    const dirPageLayout *dir = (const dirPageLayout *) ptr;
+    ptr += sizeof(dirPageLayout);
+    pos = 0;
+    while (!found && pos < dir->keyCnt) {
+      if (memcmp(ptr, key, attrTypeSize) == 0) {
+        memcpy(&first, ptr + attrTypeSize, sizeof(BlockNo));
+        memcpy(&last, ptr + attrTypeSize + sizeof(BlockNo), sizeof(BlockNo));
+        found = true;
+      } else {
+        ptr += dirEntrySize();
+        ++pos;
+      }
+    }
+    BlockNo next = dir->nextDirBlock;
+    unfixNonRootBlock(block);
+    if (!found) {
+      dirBlockNo = next;
+    }
+  } while (!found && dirBlockNo != rootBlockNo);
+  LOG4CXX_DEBUG(logger, "found: " + TO_STR(found));
+  return found;
+}
+
+/**
+ * Legt einen neuen Schlüssel mit einer leeren Datenseite am Ende des Verzeichnisses an.
+ */
+void DBBitmapIndex::createDirEntry(const char *key, BlockNo &dirBlockNo, uint &pos, BlockNo &first) {
+  LOG4CXX_INFO(logger, "createDirEntry()");
+
+  // letzte Verzeichnisseite suchen
+  dirBlockNo = rootBlockNo;
+  BlockNo next = ((const dirPageLayout *) bacbStack.top().getDataPtr())->nextDirBlock;
+  while (next != rootBlockNo) {
+    dirBlockNo = next;
+    DBBACB block = fixNonRootBlock(dirBlockNo, LOCK_SHARED);
+    next = ((const dirPageLayout *) block.getDataPtr())->nextDirBlock;
+    unfixNonRootBlock(block);
+  }
+
+  first = newDataPage();
+
+  bool full;
+  {
+    DBBACB block = fixNonRootBlock(dirBlockNo, LOCK_EXCLUSIVE);
+    dirPageLayout *dir = (dirPageLayout *) block.getDataPtr();
+    full = (dir->keyCnt == dirEntriesPerPage());
+    if (full) {
+      // Verzeichnisseite ist voll: neue Verzeichnisseite anhängen
+      DBBACB newBlock = bufMgr.fixNewBlock(file);
+      memset(newBlock.getDataPtr(), 0, file.getBlockSize());
+      newBlock.setModified();
+      dir->nextDirBlock = newBlock.getBlockNo();
+      block.setModified();
+      dirBlockNo = newBlock.getBlockNo();
+      bufMgr.unfixBlock(newBlock);
+    }
+    unfixNonRootBlock(block);
+  }
+
+  DBBACB block = fixNonRootBlock(dirBlockNo, LOCK_EXCLUSIVE);
+  dirPageLayout *dir = (dirPageLayout *) block.getDataPtr();
+  pos = dir->keyCnt;
+  char *ptr = block.getDataPtr() + sizeof(dirPageLayout) + pos * dirEntrySize();
+  memcpy(ptr, key, attrTypeSize);
+  memcpy(ptr + attrTypeSize, &first, sizeof(BlockNo));
+  memcpy(ptr + attrTypeSize + sizeof(BlockNo), &first, sizeof(BlockNo));
+  ++dir->keyCnt;
+  block.setModified();
+  unfixNonRootBlock(block);
+}
+
+/**
+ * Setzt die letzte Datenseite eines Schlüssels
+ */
+void DBBitmapIndex::setLastBlock(BlockNo dirBlockNo, uint pos, BlockNo last) {
+  DBBACB block = fixNonRootBlock(dirBlockNo, LOCK_EXCLUSIVE);
+  char *ptr = block.getDataPtr() + sizeof(dirPageLayout) + pos * dirEntrySize();
+  memcpy(ptr + attrTypeSize + sizeof(BlockNo), &last, sizeof(BlockNo));
+  block.setModified();
+  unfixNonRootBlock(block);
+}
+
+/**
+ * Sucht die Datenseite, auf der der Container der Tabellenseite page liegt
+ * bzw. eingefügt werden muss.
+ * Da Tupel meist am Ende der Tabelle eingefügt werden, wird zuerst die letzte
+ * Datenseite geprüft.
+ */
+BlockNo DBBitmapIndex::findDataPage(BlockNo first, BlockNo last, BlockNo page) {
+  LOG4CXX_INFO(logger, "findDataPage()");
+  BlockNo firstPage;
+  {
+    DBBACB block = fixNonRootBlock(last, LOCK_SHARED);
+    const dataPageLayout *data = (const dataPageLayout *) block.getDataPtr();
+    bool append = false;
+    if (data->containerCnt > 0) {
+      memcpy(&firstPage, block.getDataPtr() + sizeof(dataPageLayout), sizeof(BlockNo));
+      append = (firstPage <= page);
+    }
+    unfixNonRootBlock(block);
+    if (append) {
+      return last;
+    }
+  }
+
+  BlockNo target = first;
+  BlockNo b = first;
+  bool done = false;
+  while (!done && b != rootBlockNo) {
+    DBBACB block = fixNonRootBlock(b, LOCK_SHARED);
+    const dataPageLayout *data = (const dataPageLayout *) block.getDataPtr();
+    if (data->containerCnt > 0) {
+      memcpy(&firstPage, block.getDataPtr() + sizeof(dataPageLayout), sizeof(BlockNo));
+      if (firstPage <= page) {
+        target = b;
+      } else {
+        done = true;
+      }
+    }
+    BlockNo next = data->nextBlock;
+    unfixNonRootBlock(block);
+    b = next;
+  }
+  return target;
+}
+
+/**
+ * Prüft, ob unter einem Schlüssel noch TIDs gespeichert sind
+ */
+bool DBBitmapIndex::hasTIDs(BlockNo first) {
+  bool found = false;
+  BlockNo b = first;
+  while (!found && b != rootBlockNo) {
+    DBBACB block = fixNonRootBlock(b, LOCK_SHARED);
+    const dataPageLayout *data = (const dataPageLayout *) block.getDataPtr();
+    found = data->containerCnt > 0;
+    b = data->nextBlock;
+    unfixNonRootBlock(block);
+  }
+  return found;
+}
+
+void DBBitmapIndex::readContainers(const char *ptr, vector<DBTIDContainer> &containers) {
+  const dataPageLayout *data = (const dataPageLayout *) ptr;
+  containers.resize(data->containerCnt);
+  ptr += sizeof(dataPageLayout);
+  for (uint i = 0; i < containers.size(); ++i) {
+    ptr = containers[i].read(ptr);
+  }
+}
+
+void DBBitmapIndex::writeContainers(char *ptr, const vector<DBTIDContainer> &containers, uint from, uint to) {
+  dataPageLayout *data = (dataPageLayout *) ptr;
+  data->containerCnt = to - from;
+  char *start = ptr + sizeof(dataPageLayout);
+  ptr = start;
+  for (uint i = from; i < to; ++i) {
+    ptr = containers[i].write(ptr);
+  }
+  data->usedBytes = ptr - start;
+}
+
+size_t DBBitmapIndex::encodedSize(const vector<DBTIDContainer> &containers, uint from, uint to) {
+  size_t size = 0;
+  for (uint i = from; i < to; ++i) {
+    size += containers[i].encodedSize();
+  }
+  return size;
+}
+
+/**
+ * Hängt eine leere Datenseite an die Datei an
+ */
+BlockNo DBBitmapIndex::newDataPage() {
+  DBBACB block = bufMgr.fixNewBlock(file);
+  memset(block.getDataPtr(), 0, file.getBlockSize());
+  ((dataPageLayout *) block.getDataPtr())->nextBlock = rootBlockNo;
+  block.setModified();
+  BlockNo blockNo = block.getBlockNo();
+  bufMgr.unfixBlock(block);
+  return blockNo;
+}
+
+/**
+ * Prüft, dass am Anfang/Ende der Operation genau eine Seite für den Root-Block fixiert ist
+ */
+void DBBitmapIndex::checkBacbStackInvariant() {
+  if (bacbStack.size() != 1) {
+    throw DBIndexException("BACB Stack is invalid");
+  }
+}
+
+/**
+ * Gibt den Block frei und entfernt ihn vom Stack
+ */
+void DBBitmapIndex::unfixNonRootBlock(const DBBACB &dbbacb) {
+  if (dbbacb.getBlockNo() != rootBlockNo) {
+    bufMgr.unfixBlock(bacbStack.top());
+    bacbStack.pop();
+  }
+}
+
+/**
+ * Lädt den Block und speichert in auf dem Stack
+ */
+DBBACB &DBBitmapIndex::fixNonRootBlock(const BlockNo &blockNo, const DBBCBLockMode &mode) {
+  if (blockNo != rootBlockNo) {
+    bacbStack.push(bufMgr.fixBlock(file, blockNo, mode));
+  }
+  return bacbStack.top();
+}
+
+/**
+ * Fügt createDBBitmapIndex zur globalen factory method-map hinzu
+ */
+int DBBitmapIndex::registerClass() {
+  setClassForName("DBBitmapIndex", createDBBitmapIndex);
+  return 0;
+}
+
+/**
+ * Wird aufgerufen von HubDB::Types::getClassForName von DBTypes, um DBIndex zu erstellen
+ * @param DBBufferMgr *: Buffermanager
+ * @param DBFile *: Dateiobjekt
+ * @param attrType: Attributtp
+ * @param ModeType: READ, WRITE
+ * @param bool: unique Indexattribut
+ */
+extern "C" void *createDBBitmapIndex(int nArgs, va_list ap) {
+  if (nArgs != 5) {
+    throw DBException("Invalid number of arguments");
+  }
+  DBBufferMgr *bufMgr = va_arg(ap, DBBufferMgr *);
+  DBFile *file = va_arg(ap, DBFile *);
+  enum AttrTypeEnum attrType = (enum AttrTypeEnum) va_arg(ap, int);
+  ModType m = (ModType) va_arg(ap, int);
+  bool unique = (bool) va_arg(ap, int);
+  return new DBBitmapIndex(*bufMgr, *file, attrType, m, unique);
+}
@@ -10,7 +10,8 @@ LoggerPtr DBBufferMgr::logger(Logger::getLogger("HubDB.Buffer.DBBufferMgr"));
 DBBufferMgr::DBBufferMgr(bool threading, int blocks) :
         DBManager(threading),
         fileMgr(threading),
-        maxBlockCnt(blocks) {
+        maxBlockCnt(blocks),
+        fixCnt(0) {
   if (logger != NULL) LOG4CXX_INFO(logger, "DBBufferMgr()");
   if (doThreading()) {
     int err = 0;
@@ -164,6 +165,7 @@ DBBACB DBBufferMgr::fixBlock(DBFile &file, BlockNo blockNo, DBBCBLockMode mode)
     while ((bcb = fixBlock(file, blockNo, mode, true)) == NULL) {
       waitForLock();
     }
+    ++fixCnt;
   } catch (DBException e) {
     unlock();
     throw e;
@@ -189,9 +191,10 @@ DBBACB DBBufferMgr::fixNewBlock(DBFile &file) {
     while ((bcb = fixBlock(file, b, LOCK_EXCLUSIVE, false)) == NULL) {
       waitForLock();
     }
+    ++fixCnt;
 
     // initialize memory with 0
-    memset(bcb->getDataPtr(), 0, DBFileBlock::getBlockSize());
+    memset(bcb->getDataPtr(), 0, file.getBlockSize());
   } catch (DBException e) {
     unlock();
     throw e;
@@ -216,9 +219,10 @@ DBBACB DBBufferMgr::fixEmptyBlock(DBFile &file, BlockNo blockNo) {
     while ((bcb = fixBlock(file, blockNo, LOCK_EXCLUSIVE, false)) == NULL) {
       waitForLock();
     }
+    ++fixCnt;
 
     // initialize memory with 0
-    memset(bcb->getDataPtr(), 0, DBFileBlock::getBlockSize());
+    memset(bcb->getDataPtr(), 0, file.getBlockSize());
   } catch (DBException e) {
     unlock();
     throw e;
@@ -0,0 +1,174 @@
+#include <hubDB/DBBulkLoad.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Table;
+using namespace HubDB::Index;
+using namespace HubDB::Exception;
+
+LoggerPtr DBBulkLoad::logger(Logger::getLogger("HubDB.Query.DBBulkLoad"));
+
+DBBulkLoad::DBBulkLoad(DBSysCatMgr &sysCatMgr, const string &dbName, const string &relName) :
+        table(sysCatMgr.openTable(dbName, relName, WRITE)),
+        rel(table->getRelDef()),
+        entryCnt(0),
+        cnt(0),
+        finished(false) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBBulkLoad()");
+  try {
+    for (uint i = 0; i < rel.attrCnt(); ++i) {
+      DBAttrDef attr = rel.attrDef(i);
+      if (attr.isIndexed() == true) {
+        QualifiedName qname;
+        strcpy(qname.relationName, rel.relationName().c_str());
+        strcpy(qname.attributeName, attr.attrName().c_str());
+        indexes.push_back(sysCatMgr.openIndex(dbName, qname, WRITE));
+        attrPos.push_back(i);
+      }
+    }
+  } catch (DBException e) {
+    for (uint i = 0; i < indexes.size(); ++i)
+      delete indexes[i];
+    delete table;
+    throw e;
+  }
+  entries.resize(indexes.size());
+  pending.resize(indexes.size());
+  flushed.assign(indexes.size(), 0);
+  flushing = indexes.size();
+}
+
+DBBulkLoad::~DBBulkLoad() {
+  LOG4CXX_INFO(logger, "~DBBulkLoad()");
+  if (finished == false) {
+    try {
+      finish();
+    } catch (DBException e) {
+      LOG4CXX_ERROR(logger, e.what());
+    }
+  }
+  for (uint i = 0; i < entries.size(); ++i) {
+    for (uint e = 0; e < entries[i].size(); ++e)
+      delete entries[i][e].val;
+  }
+  for (uint i = 0; i < indexes.size(); ++i)
+    delete indexes[i];
+  delete table;
+}
+
+string DBBulkLoad::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBBulkLoad]" << endl;
+  ss << linePrefix << "indexes: " << indexes.size() << endl;
+  ss << linePrefix << "entryCnt: " << entryCnt << endl;
+  ss << linePrefix << "cnt: " << cnt << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+void DBBulkLoad::append(DBTuple &tuple) {
+  LOG4CXX_INFO(logger, "append()");
+  if (finished == true)
+    throw DBException("append after finish");
+
+  assertUnique(tuple);
+  table->append(tuple);
+  ++cnt;
+  for (uint i = 0; i < indexes.size(); ++i) {
+    indexEntry e;
+    e.val = DBAttrType::clone(tuple.getAttrVal(attrPos[i]));
+    e.tid = tuple.getTID();
+    entries[i].push_back(e);
+    if (indexes[i]->isUnique() == true)
+      pending[i].insert(e.val->normalizedKey());
+  }
+  entryCnt += indexes.size();
+  if (entryCnt >= STD_BULK_INDEX_ENTRIES)
+    flushIndexes();
+}
+
+void DBBulkLoad::finish() {
+  LOG4CXX_INFO(logger, "finish()");
+  finished = true;
+  table->endAppend();
+  flushIndexes();
+}
+
+void DBBulkLoad::rollback(const DBListTuple &tuples, uint first) {
+  LOG4CXX_INFO(logger, "rollback()");
+  LOG4CXX_DEBUG(logger, "cnt: " + TO_STR(cnt) + " first: " + TO_STR(first));
+  // the collected entries are deleted by the destructor without being inserted
+  if (finished == false) {
+    finished = true;
+    table->endAppend();
+  }
+  DBListTID tids;
+  uint n = first;
+  for (DBListTuple::const_iterator t = tuples.begin(); t != tuples.end() && n < cnt; ++t, ++n) {
+    for (uint i = 0; i < indexes.size(); ++i) {
+      DBListTID l(1, t->getTID());
+      if (n < flushed[i]) {
+        indexes[i]->remove(t->getAttrVal(attrPos[i]), l);
+      } else if (i == flushing) {
+        // the failed flush may have inserted part of the entries
+        DBListTID found;
+        indexes[i]->find(t->getAttrVal(attrPos[i]), found);
+        if (find(found.begin(), found.end(), t->getTID()) != found.end())
+          indexes[i]->remove(t->getAttrVal(attrPos[i]), l);
+      }
+    }
+    tids.push_back(t->getTID());
+  }
+  if (tids.empty() == false)
+    table->remove(tids);
+  cnt = min(cnt, first);
+}
+
+uint DBBulkLoad::getUnindexedCnt() const {
+  uint cnt = 0;
+  for (uint i = 0; i < flushed.size(); ++i)
+    cnt = max(cnt, this->cnt - flushed[i]);
+  return cnt;
+}
+
+void DBBulkLoad::assertUnique(const DBTuple &tuple) {
+  for (uint i = 0; i < indexes.size(); ++i) {
+    if (indexes[i]->isUnique() == false)
+      continue;
+    const DBAttrType &val = tuple.getAttrVal(attrPos[i]);
+    DBListTID tids;
+    if (pending[i].count(val.normalizedKey()) > 0)
+      throw DBIndexUniqueKeyException("Attr already in index");
+    indexes[i]->find(val, tids);
+    if (tids.empty() == false)
+      throw DBIndexUniqueKeyException("Attr already in index");
+  }
+}
+
+/**
+ * Inserts the collected entries of each index in key order, entries with
+ * equal keys stay in TID order
+ */
+void DBBulkLoad::flushIndexes() {
+  LOG4CXX_INFO(logger, "flushIndexes()");
+  LOG4CXX_DEBUG(logger, "entryCnt: " + TO_STR(entryCnt));
+  for (uint i = 0; i < indexes.size(); ++i) {
+    vector<indexEntry> &l = entries[i];
+    stable_sort(l.begin(), l.end(), [](const indexEntry &a, const indexEntry &b) { return *a.val < *b.val; });
+    vector<const DBAttrType *> vals(l.size());
+    vector<TID> tids(l.size());
+    for (uint e = 0; e < l.size(); ++e) {
+      vals[e] = l[e].val;
+      tids[e] = l[e].tid;
+    }
+    flushing = i;
+    indexes[i]->insertSorted(vals, tids);
+    flushed[i] = cnt;
+    for (uint e = 0; e < l.size(); ++e)
+      delete l[e].val;
+    l.clear();
+    pending[i].clear();
+  }
+  flushing = indexes.size();
+  entryCnt = 0;
+}
@@ -0,0 +1,167 @@
+#include <hubDB/DBExternalSort.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Table;
+using namespace HubDB::Exception;
+
+LoggerPtr DBExternalSort::logger(Logger::getLogger("HubDB.Query.DBExternalSort"));
+
+DBExternalSort::DBExternalSort(DBSysCatMgr &sysCatMgr,
+                               const string &dbName,
+                               const DBRelDef &rel,
+                               uint attrPos,
+                               uint maxTuples,
+                               bool desc) :
+        sysCatMgr(sysCatMgr),
+        dbName(dbName),
+        rel(rel),
+        attrPos(attrPos),
+        maxTuples(maxTuples > 0 ? maxTuples : 1),
+        desc(desc),
+        sorted(false) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBExternalSort()");
+}
+
+DBExternalSort::~DBExternalSort() {
+  LOG4CXX_INFO(logger, "~DBExternalSort()");
+  for (uint i = 0; i < runs.size(); ++i)
+    delete runs[i];
+}
+
+string DBExternalSort::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBExternalSort]" << endl;
+  ss << linePrefix << "attrPos: " << attrPos << endl;
+  ss << linePrefix << "maxTuples: " << maxTuples << endl;
+  ss << linePrefix << "desc: " << desc << endl;
+  ss << linePrefix << "runs: " << runs.size() << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+bool DBExternalSort::less(const DBTuple &a, const DBTuple &b) const {
+  if (desc == true)
+    return a.getAttrVal(attrPos) > b.getAttrVal(attrPos);
+  return a.getAttrVal(attrPos) < b.getAttrVal(attrPos);
+}
+
+void DBExternalSort::add(const DBTuple &tuple) {
+  if (sorted == true)
+    throw DBException("add after sort");
+  memTuples.push_back(tuple);
+  if (memTuples.size() >= maxTuples)
+    spillRun(memTuples);
+}
+
+void DBExternalSort::add(DBListTuple &tuples) {
+  LOG4CXX_INFO(logger, "add()");
+  if (sorted == true)
+    throw DBException("add after sort");
+  memTuples.splice(memTuples.end(), tuples);
+  while (memTuples.size() >= maxTuples) {
+    DBListTuple run;
+    DBListTuple::iterator end = memTuples.begin();
+    advance(end, maxTuples);
+    run.splice(run.end(), memTuples, memTuples.begin(), end);
+    spillRun(run);
+  }
+}
+
+/**
+ * Sortiert die Tupel im Speicher und schreibt sie als neuen Lauf
+ */
+void DBExternalSort::spillRun(DBListTuple &tuples) {
+  LOG4CXX_INFO(logger, "spillRun()");
+  LOG4CXX_DEBUG(logger, "tuples: " + TO_STR((uint) tuples.size()));
+  tuples.sort([this](const DBTuple &a, const DBTuple &b) { return less(a, b); });
+  DBTempFile *run = sysCatMgr.createTempFile(dbName, rel);
+  runs.push_back(run);
+  DBListTuple::const_iterator i = tuples.begin();
+  while (i != tuples.end()) {
+    run->append(*i);
+    ++i;
+  }
+  run->rewind();
+  tuples.clear();
+}
+
+void DBExternalSort::sort() {
+  LOG4CXX_INFO(logger, "sort()");
+  if (sorted == true)
+    return;
+  if (runs.empty() == true) {
+    memTuples.sort([this](const DBTuple &a, const DBTuple &b) { return less(a, b); });
+  } else {
+    if (memTuples.empty() == false)
+      spillRun(memTuples);
+    // weitere Durchgänge, bis höchstens STD_SORT_FANIN Läufe übrig sind
+    while (runs.size() > STD_SORT_FANIN) {
+      vector<DBTempFile *> in(runs.begin(), runs.begin() + STD_SORT_FANIN);
+      runs.erase(runs.begin(), runs.begin() + STD_SORT_FANIN);
+      DBTempFile *out = NULL;
+      try {
+        out = sysCatMgr.createTempFile(dbName, rel);
+        mergeRuns(in, *out);
+      } catch (DBException e) {
+        for (uint i = 0; i < in.size(); ++i)
+          delete in[i];
+        if (out != NULL)
+          delete out;
+        throw e;
+      }
+      for (uint i = 0; i < in.size(); ++i)
+        delete in[i];
+      runs.push_back(out);
+    }
+    runBuf.resize(runs.size());
+  }
+  LOG4CXX_DEBUG(logger, "runs: " + TO_STR((uint) runs.size()));
+  sorted = true;
+}
+
+void DBExternalSort::mergeRuns(vector<DBTempFile *> &in, DBTempFile &out) {
+  LOG4CXX_INFO(logger, "mergeRuns()");
+  vector<DBListTuple> buf(in.size());
+  int i;
+  while ((i = minRun(in, buf)) >= 0) {
+    out.append(buf[i].front());
+    buf[i].pop_front();
+  }
+  out.rewind();
+}
+
+/**
+ * Bestimmt den Lauf mit dem kleinsten nächsten Tupel, leere Puffer werden nachgelesen
+ * @return Index des Laufs, -1 falls alle Läufe gelesen sind
+ */
+int DBExternalSort::minRun(vector<DBTempFile *> &in, vector<DBListTuple> &buf) {
+  int min = -1;
+  for (uint i = 0; i < in.size(); ++i) {
+    if (buf[i].empty() == true)
+      in[i]->read(STD_TID_BATCH, buf[i]);
+    if (buf[i].empty() == false && (min < 0 || less(buf[i].front(), buf[min].front())))
+      min = i;
+  }
+  return min;
+}
+
+uint DBExternalSort::read(uint numOfTuples, DBListTuple &tupleList) {
+  LOG4CXX_INFO(logger, "read()");
+  if (sorted == false)
+    throw DBException("read before sort");
+  uint cnt = 0;
+  if (runs.empty() == true) {
+    while (cnt < numOfTuples && memTuples.empty() == false) {
+      tupleList.splice(tupleList.end(), memTuples, memTuples.begin());
+      ++cnt;
+    }
+  } else {
+    int i;
+    while (cnt < numOfTuples && (i = minRun(runs, runBuf)) >= 0) {
+      tupleList.splice(tupleList.end(), runBuf[i], runBuf[i].begin());
+      ++cnt;
+    }
+  }
+  return cnt;
+}
@@ -12,17 +12,20 @@ using namespace HubDB::Exception;
 LoggerPtr DBFile::logger(Logger::getLogger("HubDB.File.DBFile"));
 
 DBFile::DBFile() :
-        fileNum(-1) {
+        fileNum(-1),
+        blockSize(STD_BLOCKSIZE) {
   if (logger != NULL) LOG4CXX_INFO(logger, "DBFile()");
 }
 
-DBFile::DBFile(const string &fileName) :
+DBFile::DBFile(const string &fileName, uint blockSize) :
         fileName(fileName),
         fileNum(-1),
-        blockCnt(0) {
+        blockCnt(0),
+        blockSize(blockSize) {
   if (logger != NULL) {
     LOG4CXX_INFO(logger, "DBFile()");
     LOG4CXX_DEBUG(logger, "fileName: " + fileName);
+    LOG4CXX_DEBUG(logger, "blockSize: " + TO_STR(blockSize));
   }
   fileNum = open(fileName.c_str(), FILE_OPEN_FLAGS);
   if (fileNum < 0) {
@@ -36,7 +39,7 @@ DBFile::DBFile(const string &fileName) :
   }
   if (logger != NULL) LOG4CXX_DEBUG(logger, "lseek()=" + TO_STR(l));
 
-  blockCnt = l / DBFileBlock::getBlockSize();
+  blockCnt = l / blockSize;
 
   if (logger != NULL) {
     LOG4CXX_DEBUG(logger, "this:\n" + toString("\t"));
@@ -97,6 +100,7 @@ string DBFile::toString(string linePrefix) const {
   ss << linePrefix << "fileName: " << fileName << endl;
   ss << linePrefix << "fileNum: " << fileNum << endl;
   ss << linePrefix << "blockCnt: " << blockCnt << endl;
+  ss << linePrefix << "blockSize: " << blockSize << endl;
   ss << linePrefix << "--------" << endl;
   return ss.str();
 }
@@ -105,13 +109,20 @@ void DBFile::setBlockCnt(uint cnt) {
   LOG4CXX_INFO(logger, "setBlockCnt()");
   LOG4CXX_DEBUG(logger, "cnt:" + TO_STR(cnt));
   LOG4CXX_DEBUG(logger, "this:\n" + toString());
-  if (ftruncate(fileNum, cnt * DBFileBlock::getBlockSize()) != 0) {
+  if (ftruncate(fileNum, cnt * blockSize) != 0) {
     LOG4CXX_ERROR(logger, strerror(errno));
     throw DBFileException(errno);
   }
   blockCnt = cnt;
 }
 
+void DBFile::prefetch(BlockNo blockNo) const {
+#ifdef POSIX_FADV_WILLNEED
+  // only a hint, the block is read by readFileBlock() anyway
+  posix_fadvise(fileNum, (off_t) blockNo * blockSize, blockSize, POSIX_FADV_WILLNEED);
+#endif
+}
+
 DBFileException::DBFileException(const int num)
         : DBSystemException(num) {
 }
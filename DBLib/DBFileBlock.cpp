@@ -11,11 +11,11 @@ using namespace HubDB::File;
 using namespace HubDB::Exception;
 
 LoggerPtr DBFileBlock::logger(Logger::getLogger("HubDB.File.DBFileBlock"));
-const uint DBFileBlock::blockSize(STD_BLOCKSIZE);
 
 DBFileBlock::DBFileBlock(DBFile &file, BlockNo blockNum) :
         file(file),
-        blockNum(blockNum) {
+        blockNum(blockNum),
+        data(file.getBlockSize()) {
   if (logger != NULL) {
     LOG4CXX_INFO(logger, "DBFileBlock()");
     LOG4CXX_DEBUG(logger, "file:\n" + file.toString("\t"));
@@ -38,7 +38,7 @@ void DBFileBlock::readFileBlock() {
     throw DBFileException(errno);
   }
   LOG4CXX_DEBUG(logger, "read(num: " + TO_STR(num) + " ,pos: " + TO_STR(l) + ")");
-  if ((l = read(num, data, getBlockSize())) != getBlockSize()) {
+  if ((l = read(num, getDataPtr(), getBlockSize())) != getBlockSize()) {
     LOG4CXX_DEBUG(logger, "read : " + TO_STR(l) + ")");
     LOG4CXX_ERROR(logger, strerror(errno));
     throw DBFileException(errno);
@@ -56,7 +56,7 @@ void DBFileBlock::writeFileBlock() {
     throw DBFileException(errno);
   }
   LOG4CXX_DEBUG(logger, "write(num: " + TO_STR(num) + " ,pos: " + TO_STR(l) + ")");
-  if (getBlockSize() != write(num, data, getBlockSize())) {
+  if (getBlockSize() != write(num, getDataPtr(), getBlockSize())) {
     LOG4CXX_ERROR(logger, strerror(errno));
     throw DBFileException(errno);
   }
@@ -66,7 +66,7 @@ string DBFileBlock::toString(string linePrefix) const {
   stringstream ss;
   ss << linePrefix << "[DBFileBlock]" << endl;
   ss << linePrefix << "blockNum: " << blockNum << endl;
-  ss << linePrefix << "data: " << TO_STR(data) << endl;
+  ss << linePrefix << "data: " << TO_STR(getDataPtr()) << endl;
   ss << linePrefix << "file: " << endl;
   ss << file.toString(linePrefix + "\t");
   ss << linePrefix << "-------------" << endl;
@@ -72,21 +72,24 @@ void DBFileMgr::dropFile(const string &fileName) {
   unlock();
 }
 
-DBFile &DBFileMgr::openFile(const string &fileName) {
+DBFile &DBFileMgr::openFile(const string &fileName, uint blockSize) {
   LOG4CXX_INFO(logger, "openFile()");
   LOG4CXX_DEBUG(logger, "fileName:" + fileName);
+  LOG4CXX_DEBUG(logger, "blockSize:" + TO_STR(blockSize));
   LOG4CXX_DEBUG(logger, "this:\n" + toString("\t"));
   lock();
   list<DBFile *>::iterator i = find(fileName);
-  if (i == fileList.end()) {
-    try {
-      DBFile *file = new DBFile(fileName);
+  try {
+    if (i == fileList.end()) {
+      DBFile *file = new DBFile(fileName, blockSize);
       fileList.push_back(file);
       i = find(fileName);
-    } catch (DBException e) {
-      unlock();
-      throw e;
+    } else if ((*i)->getBlockSize() != blockSize) {
+      throw DBFileMgrException("file is open with another block size");
     }
+  } catch (DBException e) {
+    unlock();
+    throw e;
   }
   DBFile &rc = **i;
   LOG4CXX_DEBUG(logger, "rc:\n" + rc.toString());
@@ -126,6 +129,7 @@ void DBFileMgr::readFileBlock(DBFileBlock &block) {
   lock();
   try {
     block.readFileBlock();
+    ++readCnt;
   } catch (DBException e) {
     unlock();
     throw e;
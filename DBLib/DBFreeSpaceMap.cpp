@@ -0,0 +1,116 @@
+#include <hubDB/DBFreeSpaceMap.h>
+#include <hubDB/DBFileBlock.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Table;
+using namespace HubDB::Exception;
+
+LoggerPtr DBFreeSpaceMap::logger(Logger::getLogger("HubDB.Table.DBFreeSpaceMap"));
+
+const BlockNo DBFreeSpaceMap::summaryBlockNo(0);
+
+DBFreeSpaceMap::DBFreeSpaceMap(DBBufferMgr &bufMgr, DBFile &file) :
+        bufMgr(bufMgr),
+        file(file) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBFreeSpaceMap()");
+}
+
+string DBFreeSpaceMap::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBFreeSpaceMap]" << endl;
+  ss << linePrefix << "pagesPerBlock: " << pagesPerBlock() << endl;
+  ss << linePrefix << "blocks: " << bufMgr.getBlockCount(file) << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+uint DBFreeSpaceMap::pagesPerBlock() const {
+  return file.getBlockSize() / sizeof(uint) * 32;
+}
+
+/**
+ * Fixiert den Block, fehlende Blöcke werden mit Nullen angelegt
+ */
+DBBACB DBFreeSpaceMap::fixBlock(BlockNo blockNo, DBBCBLockMode mode) {
+  LOG4CXX_INFO(logger, "fixBlock()");
+  LOG4CXX_DEBUG(logger, "blockNo: " + TO_STR(blockNo));
+  while (bufMgr.getBlockCount(file) <= blockNo) {
+    DBBACB bacb = bufMgr.fixNewBlock(file);
+    memset(bacb.getDataPtr(), 0, file.getBlockSize());
+    bacb.setModified();
+    bufMgr.unfixBlock(bacb);
+  }
+  return bufMgr.fixBlock(file, blockNo, mode);
+}
+
+bool DBFreeSpaceMap::findFree(BlockNo &page) {
+  LOG4CXX_INFO(logger, "findFree()");
+  if (isBuilt() == false)
+    return false;
+
+  uint words = file.getBlockSize() / sizeof(uint);
+  DBBACB summary = bufMgr.fixBlock(file, summaryBlockNo, LOCK_SHARED);
+  uint leaf;
+  bool found = findBit((const uint *) summary.getDataPtr(), words, leaf);
+  bufMgr.unfixBlock(summary);
+  if (found == false || leaf + 1 >= bufMgr.getBlockCount(file))
+    return false;
+
+  DBBACB bacb = bufMgr.fixBlock(file, leaf + 1, LOCK_SHARED);
+  uint pos;
+  found = findBit((const uint *) bacb.getDataPtr(), words, pos);
+  bufMgr.unfixBlock(bacb);
+  if (found == true)
+    page = leaf * pagesPerBlock() + pos;
+  LOG4CXX_DEBUG(logger, "found: " + TO_STR(found));
+  return found;
+}
+
+void DBFreeSpaceMap::setFree(BlockNo page, bool free) {
+  LOG4CXX_INFO(logger, "setFree()");
+  LOG4CXX_DEBUG(logger, "page: " + TO_STR(page));
+  LOG4CXX_DEBUG(logger, "free: " + TO_STR(free));
+  uint leaf = page / pagesPerBlock();
+  uint pos = page % pagesPerBlock();
+  if (free == false && leaf + 1 >= bufMgr.getBlockCount(file) && isBuilt() == true)
+    return;
+
+  DBBACB summary = fixBlock(summaryBlockNo, LOCK_EXCLUSIVE);
+  DBBACB bacb = fixBlock(leaf + 1, LOCK_EXCLUSIVE);
+  uint *bits = (uint *) bacb.getDataPtr();
+  if (getBit(bits, pos) != free) {
+    setBit(bits, pos, free);
+    bacb.setModified();
+    uint *leafBits = (uint *) summary.getDataPtr();
+    uint first;
+    bool any = free == true || findBit(bits, file.getBlockSize() / sizeof(uint), first) == true;
+    if (getBit(leafBits, leaf) != any) {
+      setBit(leafBits, leaf, any);
+      summary.setModified();
+    }
+  }
+  bufMgr.unfixBlock(bacb);
+  bufMgr.unfixBlock(summary);
+}
+
+bool DBFreeSpaceMap::findBit(const uint *bits, uint cnt, uint &pos) {
+  for (uint c = 0; c < cnt; ++c) {
+    if (bits[c] != 0) {
+      pos = c * 32 + __builtin_ctz(bits[c]);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DBFreeSpaceMap::getBit(const uint *bits, uint pos) {
+  return (bits[pos / 32] & (1u << (pos % 32))) != 0;
+}
+
+void DBFreeSpaceMap::setBit(uint *bits, uint pos, bool val) {
+  if (val == true)
+    bits[pos / 32] |= 1u << (pos % 32);
+  else
+    bits[pos / 32] &= ~(1u << (pos % 32));
+}
@@ -0,0 +1,291 @@
+#include <hubDB/DBImportParser.h>
+#include <hubDB/DBException.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Exception;
+
+LoggerPtr DBImportParser::logger(Logger::getLogger("HubDB.Query.DBImportParser"));
+
+// powers of ten that are exact as double
+static const double exactPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static bool parseInt(const char *p, const char *e, int &val) {
+  bool neg = false;
+  if (p < e && (*p == '-' || *p == '+'))
+    neg = *p++ == '-';
+  if (p == e || e - p > 10)
+    return false;
+  int64_t v = 0;
+  for (; p < e; ++p) {
+    if (*p < '0' || *p > '9')
+      return false;
+    v = v * 10 + (*p - '0');
+  }
+  if (neg == true)
+    v = -v;
+  if (v < INT32_MIN || v > INT32_MAX)
+    return false;
+  val = (int) v;
+  return true;
+}
+
+/**
+ * Decimal numbers with at most 15 significant digits and a small exponent are
+ * exact as mantissa and power of ten, one division or multiplication rounds
+ * correctly. Everything else is left to strtod().
+ */
+static bool parseDouble(const char *p, const char *e, double &val) {
+  const char *s = p;
+  bool neg = false;
+  if (p < e && (*p == '-' || *p == '+'))
+    neg = *p++ == '-';
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exp = 0;
+  bool any = false;
+  for (; p < e && *p >= '0' && *p <= '9'; ++p, any = true) {
+    if (digits > 0 || *p != '0')
+      ++digits;
+    mantissa = mantissa * 10 + (*p - '0');
+  }
+  if (p < e && *p == '.') {
+    for (++p; p < e && *p >= '0' && *p <= '9'; ++p, any = true) {
+      if (digits > 0 || *p != '0')
+        ++digits;
+      mantissa = mantissa * 10 + (*p - '0');
+      --exp;
+    }
+  }
+  if (p == e && any == true && digits <= 15 && exp >= -22) {
+    val = (double) mantissa / exactPow10[-exp];
+    if (neg == true)
+      val = -val;
+    return true;
+  }
+
+  char buf[64];
+  if (e - s >= (ptrdiff_t) sizeof(buf))
+    return false;
+  memcpy(buf, s, e - s);
+  buf[e - s] = '\0';
+  char *end;
+  val = strtod(buf, &end);
+  return end == buf + (e - s) && end != buf;
+}
+
+DBImportParser::DBImportParser(const string &fileName, const DBRelDef &rel) :
+        rel(rel),
+        fd(-1),
+        data(NULL),
+        size(0),
+        pos(0),
+        round(STD_IMPORT_THREADS),
+        running(false),
+        finished(false) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBImportParser()");
+  for (uint i = 0; i < rel.attrCnt(); ++i) {
+    AttrTypeEnum t = rel.attrDef(i).attrType();
+    if (t != INT && t != DOUBLE && t != VCHAR)
+      throw DBException("unknow attribute type " + TO_STR(t));
+  }
+  fd = open(fileName.c_str(), O_RDONLY);
+  if (fd == -1)
+    throw DBSystemException(errno);
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    int err = errno;
+    close(fd);
+    throw DBSystemException(err);
+  }
+  size = st.st_size;
+  if (size > 0) {
+    void *ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      int err = errno;
+      close(fd);
+      throw DBSystemException(err);
+    }
+    madvise(ptr, size, MADV_SEQUENTIAL);
+    data = (const char *) ptr;
+  }
+  for (uint i = 0; i < round.size(); ++i)
+    round[i].rel = &this->rel;
+}
+
+DBImportParser::~DBImportParser() {
+  LOG4CXX_INFO(logger, "~DBImportParser()");
+  if (running == true)
+    joinRound();
+  if (data != NULL)
+    munmap((void *) data, size);
+  if (fd != -1)
+    close(fd);
+}
+
+string DBImportParser::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBImportParser]" << endl;
+  ss << linePrefix << "size: " << size << endl;
+  ss << linePrefix << "pos: " << pos << endl;
+  ss << linePrefix << "finished: " << finished << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+bool DBImportParser::next(DBListTuple &tuples) {
+  LOG4CXX_INFO(logger, "next()");
+  tuples.clear();
+  if (error.empty() == false) {
+    string msg = error;
+    error.clear();
+    throw DBException(msg);
+  }
+  if (running == false && finished == false)
+    startRound();
+  if (running == false)
+    return false;
+  joinRound();
+
+  for (uint i = 0; i < round.size(); ++i) {
+    tuples.splice(tuples.end(), round[i].tuples);
+    if (round[i].stop == true) {
+      // the exception is thrown after the tuples in front of it were written
+      error = round[i].error;
+      finished = true;
+      break;
+    }
+  }
+  for (uint i = 0; i < round.size(); ++i)
+    round[i].tuples.clear();
+  // the next round is parsed while the caller writes these tuples
+  if (finished == false)
+    startRound();
+  if (tuples.empty() == true)
+    return next(tuples);
+  return true;
+}
+
+/**
+ * Splits the next STD_IMPORT_THREADS * STD_IMPORT_CHUNK bytes at line ends
+ * and starts one thread per chunk
+ */
+void DBImportParser::startRound() {
+  LOG4CXX_INFO(logger, "startRound()");
+  if (pos >= size) {
+    finished = true;
+    return;
+  }
+  for (uint i = 0; i < round.size(); ++i) {
+    chunk &c = round[i];
+    c.begin = data + pos;
+    size_t len = min((size_t) STD_IMPORT_CHUNK, size - pos);
+    if (pos + len < size) {
+      const char *nl = (const char *) memchr(data + pos + len, '\n', size - pos - len);
+      len = (nl == NULL) ? size - pos : nl + 1 - c.begin;
+    }
+    pos += len;
+    c.end = c.begin + len;
+    c.stop = false;
+    c.error.clear();
+    int err = pthread_create(&c.thread, NULL, parseChunk, &c);
+    if (err != 0) {
+      // the chunk is parsed by the calling thread
+      parseChunk(&c);
+      c.thread = pthread_self();
+    }
+  }
+  running = true;
+}
+
+void DBImportParser::joinRound() {
+  LOG4CXX_INFO(logger, "joinRound()");
+  for (uint i = 0; i < round.size(); ++i) {
+    if (pthread_equal(round[i].thread, pthread_self()) == 0)
+      pthread_join(round[i].thread, NULL);
+  }
+  running = false;
+}
+
+void *DBImportParser::parseChunk(void *arg) {
+  chunk &c = *(chunk *) arg;
+  const char *p = c.begin;
+  try {
+    while (p < c.end) {
+      // memchr compares many bytes per instruction
+      const char *eol = (const char *) memchr(p, '\n', c.end - p);
+      if (eol == NULL)
+        eol = c.end;
+      c.tuples.push_back(DBTuple());
+      if (parseLine(*c.rel, p, eol, c.tuples.back()) == false) {
+        c.tuples.pop_back();
+        const char *s = p;
+        while (s < eol && isSpace(*s) == true)
+          ++s;
+        if (s < eol) {
+          c.stop = true;
+          break;
+        }
+      }
+      p = eol + 1;
+    }
+  } catch (DBException &e) {
+    c.tuples.pop_back();
+    c.stop = true;
+    c.error = e.what();
+  }
+  return NULL;
+}
+
+/**
+ * @return false if the line does not hold exactly one tuple
+ */
+bool DBImportParser::parseLine(const DBRelDef &rel, const char *p, const char *eol, DBTuple &tuple) {
+  for (uint i = 0; i < rel.attrCnt(); ++i) {
+    while (p < eol && isSpace(*p) == true)
+      ++p;
+    const char *s = p;
+    while (p < eol && isSpace(*p) == false)
+      ++p;
+    if (s == p)
+      return false;
+    switch (rel.attrDef(i).attrType()) {
+      case INT: {
+        int v;
+        if (parseInt(s, p, v) == false)
+          return false;
+        DBIntType val(v);
+        tuple.appendAttrVal(&val);
+        break;
+      }
+      case DOUBLE: {
+        double v;
+        if (parseDouble(s, p, v) == false)
+          return false;
+        DBDoubleType val(v);
+        tuple.appendAttrVal(&val);
+        break;
+      }
+      default: {
+        // like %32s for VARCHAR longer values are cut off
+        size_t l = min((size_t) (p - s), (size_t) rel.attrDef(i).attrLen() + 2);
+        if (l == 0 || s[0] != '\'' || s[l - 1] != '\'')
+          throw DBException("invalid import string: " + string(s, l) + " " + TO_STR(l));
+        DBVCharType val(string(s + 1, l > 1 ? l - 2 : 0));
+        tuple.appendAttrVal(&val);
+        break;
+      }
+    }
+  }
+  while (p < eol && isSpace(*p) == true)
+    ++p;
+  return p == eol;
+}
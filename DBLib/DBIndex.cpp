@@ -22,6 +22,52 @@ ss << bufMgr.toString(linePrefix+"\t") << endl;
   return ss.str();
 }
 
+void DBIndex::insertSorted(const vector<const DBAttrType *> &vals, const vector<TID> &tids) {
+  LOG4CXX_INFO(logger, "insertSorted()");
+  uint i = 0;
+  try {
+    for (; i < vals.size(); ++i)
+      insert(*vals[i], tids[i]);
+  } catch (DBException e) {
+    for (uint u = 0; u < i; ++u)
+      remove(*vals[u], DBListTID(1, tids[u]));
+    throw e;
+  }
+}
+
+void DBIndex::openCursor(const DBAttrType &val) {
+  LOG4CXX_INFO(logger, "openCursor()");
+  closeCursor();
+  find(val, cursorTids);
+  cursorTids.sort();
+}
+
+bool DBIndex::nextBatch(DBTIDBatch &tids, uint maxTids) {
+  LOG4CXX_INFO(logger, "nextBatch()");
+  tids.clear();
+  while (!cursorTids.empty() && tids.size() < maxTids) {
+    tids.push_back(cursorTids.front());
+    cursorTids.pop_front();
+  }
+  return !tids.empty();
+}
+
+void DBIndex::closeCursor() {
+  cursorTids.clear();
+}
+
+uint DBIndex::count(const DBAttrType &val) {
+  LOG4CXX_INFO(logger, "count()");
+  uint cnt = 0;
+  DBTIDBatch tids;
+  tids.reserve(STD_TID_BATCH);
+  openCursor(val);
+  while (nextBatch(tids))
+    cnt += tids.size();
+  closeCursor();
+  return cnt;
+}
+
 DBIndexException::DBIndexException(const std::string &msg1)
         : DBRuntimeException(msg1) {
 }
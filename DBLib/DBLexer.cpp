@@ -1399,9 +1399,22 @@ static const flex_int16_t yy_chk[3599] =
 #include <hubDB/DBParserDefs.h>
 #include <hubDB/DBParser.h>
 
-#line 1402 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
+// Schlüsselwörter, die nur als Name erkannt und hier nachgeschlagen werden
+static int keywordToken(const char * text){
+    static const struct { const char * word; int token; } keywords[] = {
+        {"count",COUNTT},{"sum",SUMT},{"min",MINT},{"max",MAXT},{"avg",AVGT},
+        {"group",GROUP},{"by",BY},{"order",ORDER},{"asc",ASC},{"desc",DESC},{"limit",LIMIT},{"analyze",ANALYZE},{"explain",EXPLAIN},{"slotted",SLOTTED},{"pagesize",PAGESIZE}
+    };
+    for(unsigned int i=0;i<sizeof(keywords)/sizeof(keywords[0]);++i){
+        if(strcasecmp(text,keywords[i].word)==0)
+            return keywords[i].token;
+    }
+    return 0;
+}
+
+#line 1415 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
 
-#line 1404 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
+#line 1417 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
 
 #define INITIAL 0
 #define STATE_COMMENT 1
@@ -1663,10 +1676,10 @@ YY_DECL
 		}
 
 	{
-#line 73 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 86 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 
 
-#line 1669 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
+#line 1682 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -1725,308 +1738,308 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 75 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 88 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {BEGIN 0; return APOSTROPHE;}
 	YY_BREAK
 case 2:
 /* rule 2 can match eol */
 YY_RULE_SETUP
-#line 76 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 89 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {myyylval->str=strdup(yytext); return STR_VALUE;}
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 77 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 90 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {}
 	YY_BREAK
 case 4:
 /* rule 4 can match eol */
 YY_RULE_SETUP
-#line 78 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 91 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {BEGIN 0;}
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 79 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 92 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return LIST;}
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 80 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 93 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return ON;}
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 81 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 94 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return JOIN;}
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 82 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 95 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return INDEX;}
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 83 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 96 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return GET;}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 84 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 97 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return AND;}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 85 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 98 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return SCHEMA;}
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 86 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 99 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return UNIQUE;}
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 87 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 100 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return FOR;}
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 88 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 101 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return TYPE;}
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 89 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 102 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return CREATE;}
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 90 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 103 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DROP;}
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 91 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 104 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DATABASE;}
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 92 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 105 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DATABASE;}
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 93 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 106 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return STATISTICS;}
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 94 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 107 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return STATISTICS;}
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 95 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 108 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return CLASSES;}
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 96 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 109 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return PRINT;}
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 97 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 110 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return HELP;}
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 98 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 111 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return TABLES;}
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 99 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 112 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return TABLE;}
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 100 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 113 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return INSERT;}
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 101 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 114 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return INTO;}
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 102 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 115 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return VALUES;}
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 103 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 116 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return SELECT;}
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 104 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 117 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DELETE;}
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 105 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 118 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return FROM;}
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 106 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 119 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return WHERE;}
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 107 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 120 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return TO;}
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 108 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 121 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return IMPORT;}
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 109 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 122 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return EXPORT;}
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 110 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 123 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return QUIT;}
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 111 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 124 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return CONNECT;}
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 112 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 125 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DISCONNECT;}
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 113 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 126 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return AS;}
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 114 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 127 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return INTT;}
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 115 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 128 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DOUBLET;}
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 116 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 129 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return VARCHAR;}
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 117 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 130 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return IN;}
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 118 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 131 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {BEGIN STATE_VALUE; return APOSTROPHE;}
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 119 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 132 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {myyylval->realnum=atof(yytext);return REALNUM;}
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 120 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 133 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {myyylval->num=atoi(yytext);return NUM;}
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 121 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
-{myyylval->str=strdup(yytext);return DBNAME;}
+#line 134 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+{int t=keywordToken(yytext); if(t!=0) return t; myyylval->str=strdup(yytext);return DBNAME;}
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 122 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 135 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return EQUALS;}
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 123 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 136 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return STAR;}
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 124 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 137 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return PARA_OPEN;}
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
-#line 125 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 138 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return PARA_CLOSE;}
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
-#line 126 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 139 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return COMMATA;}
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
-#line 127 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 140 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return SEMICOLON;}
 	YY_BREAK
 case 54:
 YY_RULE_SETUP
-#line 128 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 141 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {return DOT;}
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 129 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 142 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {BEGIN STATE_COMMENT;}
 	YY_BREAK
 case 56:
 /* rule 56 can match eol */
 YY_RULE_SETUP
-#line 130 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 143 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {BEGIN 0;}
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
-#line 131 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 144 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {}
 	YY_BREAK
 case 58:
 YY_RULE_SETUP
-#line 132 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 145 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {}
 	YY_BREAK
 case 59:
 YY_RULE_SETUP
-#line 133 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 146 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 {extyyerror(yytext,*yyget_extra(yyscanner));}
 	YY_BREAK
 case 60:
 YY_RULE_SETUP
-#line 134 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 147 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 ECHO;
 	YY_BREAK
-#line 2029 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
+#line 2042 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.cpp"
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(STATE_COMMENT):
 case YY_STATE_EOF(STATE_VALUE):
@@ -3197,6 +3210,6 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 134 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
+#line 147 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBLexer.lex"
 
 
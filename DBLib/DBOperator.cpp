@@ -0,0 +1,1698 @@
+#include <hubDB/DBOperator.h>
+#include <hubDB/DBException.h>
+#include <climits>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Exception;
+
+LoggerPtr DBScanOp::logger(Logger::getLogger("HubDB.Query.DBScanOp"));
+LoggerPtr DBIndexScanOp::logger(Logger::getLogger("HubDB.Query.DBIndexScanOp"));
+LoggerPtr DBBitmapScanOp::logger(Logger::getLogger("HubDB.Query.DBBitmapScanOp"));
+LoggerPtr DBFilterOp::logger(Logger::getLogger("HubDB.Query.DBFilterOp"));
+LoggerPtr DBHashJoinOp::logger(Logger::getLogger("HubDB.Query.DBHashJoinOp"));
+LoggerPtr DBIndexJoinOp::logger(Logger::getLogger("HubDB.Query.DBIndexJoinOp"));
+LoggerPtr DBPartitionedHashJoinOp::logger(Logger::getLogger("HubDB.Query.DBPartitionedHashJoinOp"));
+LoggerPtr DBMergeJoinOp::logger(Logger::getLogger("HubDB.Query.DBMergeJoinOp"));
+LoggerPtr DBHashAggregateOp::logger(Logger::getLogger("HubDB.Query.DBHashAggregateOp"));
+LoggerPtr DBOrderedIndexScanOp::logger(Logger::getLogger("HubDB.Query.DBOrderedIndexScanOp"));
+LoggerPtr DBSortOp::logger(Logger::getLogger("HubDB.Query.DBSortOp"));
+LoggerPtr DBTopNOp::logger(Logger::getLogger("HubDB.Query.DBTopNOp"));
+
+// partitioning stages, afterwards the groups are aggregated in memory regardless of the budget
+static const uint maxAggLevel = 3;
+
+void DBOperator::fetchAll(DBListJoinTuple &rows) {
+  DBListJoinTuple batch;
+  open();
+  while (next(batch) == true)
+    rows.splice(rows.end(), batch);
+  close();
+}
+
+/**
+ * Moves the tuples into the first tuple of new rows, the list is empty afterwards
+ */
+void DBOperator::toRows(DBListTuple &tuples, DBListJoinTuple &rows) {
+  DBListTuple::iterator i = tuples.begin();
+  while (i != tuples.end()) {
+    rows.push_back(pair<DBTuple, DBTuple>());
+    rows.back().first.swap(*i);
+    ++i;
+  }
+  tuples.clear();
+}
+
+/**
+ * Moves the first tuples of the rows into the list, the rows are empty afterwards
+ */
+void DBOperator::fromRows(DBListJoinTuple &rows, DBListTuple &tuples) {
+  DBListJoinTuple::iterator i = rows.begin();
+  while (i != rows.end()) {
+    tuples.push_back(DBTuple());
+    tuples.back().swap((*i).first);
+    ++i;
+  }
+  rows.clear();
+}
+
+/**
+ * Lists the predicates joined by AND
+ */
+static string predicateList(const DBListPredicate &where) {
+  string s;
+  DBListPredicate::const_iterator u = where.begin();
+  while (u != where.end()) {
+    if (s.empty() == false)
+      s += " AND ";
+    s += (*u).toString();
+    ++u;
+  }
+  return s;
+}
+
+string DBOperator::describe() const {
+  stringstream ss;
+  ss << explain();
+  if (estRows >= 0)
+    ss << "  (est. rows: " << (uint) (estRows + 0.5) << ")";
+  return ss.str();
+}
+
+void DBOperator::explainTree(ostream &s, string linePrefix) {
+  s << linePrefix << describe() << endl;
+  vector<DBOperator **> inputs;
+  getInputs(inputs);
+  for (uint i = 0; i < inputs.size(); ++i)
+    (*inputs[i])->explainTree(s, linePrefix + "  ");
+}
+
+void DBOperator::tupleDef(const vector<AttrTypeEnum> &types, RelDefStruct &def) {
+  if (types.size() > MAX_ATTR_PER_REL)
+    throw DBException("too many attributes for an intermediate tuple");
+  memset(&def, 0, sizeof(def));
+  strcpy(def.relationName, "TEMP");
+  def.attrCnt = types.size();
+  for (uint c = 0; c < types.size(); ++c) {
+    AttrDefStruct &attr = def.attrList[c];
+    sprintf(attr.attrName, "C%u", c);
+    attr.attrPos = c;
+    attr.attrType = types[c];
+    attr.attrLen = DBAttrType::getSize4Type(types[c]);
+    def.tupleSize += attr.attrLen;
+  }
+}
+
+DBListOp::DBListOp(DBListJoinTuple &rows, const string &source) :
+        cnt(rows.size()),
+        source(source),
+        computed(true) {
+  data.swap(rows);
+}
+
+DBListOp::DBListOp(DBListTuple &tuples, const string &source) :
+        cnt(tuples.size()),
+        source(source),
+        computed(true) {
+  toRows(tuples, data);
+}
+
+DBListOp::DBListOp(const string &source) :
+        cnt(0),
+        source(source),
+        computed(false) {
+}
+
+string DBListOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBListOp]" << endl;
+  ss << linePrefix << "rows: " << data.size() << endl;
+  return ss.str();
+}
+
+string DBListOp::explain() const {
+  if (computed == false)
+    return "Materialize " + source;
+  stringstream ss;
+  ss << "Materialized " << cnt << " row(s)";
+  if (source.empty() == false)
+    ss << " of " << source;
+  return ss.str();
+}
+
+bool DBListOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  DBListJoinTuple::iterator end = data.begin();
+  for (uint n = 0; n < STD_TID_BATCH && end != data.end(); ++n)
+    ++end;
+  rows.splice(rows.end(), data, data.begin(), end);
+  return rows.empty() == false;
+}
+
+DBDeferredOp::DBDeferredOp(const std::function<void(DBListJoinTuple &)> &compute, const string &source) :
+        DBListOp(source),
+        compute(compute) {
+}
+
+void DBDeferredOp::open() {
+  data.clear();
+  compute(data);
+  cnt = data.size();
+  computed = true;
+}
+
+DBScanOp::DBScanOp(DBTable &table, const DBListPredicate &where, uint attrMask) :
+        table(table),
+        where(where),
+        attrMask(attrMask),
+        eof(false) {
+  pos.page = 0;
+  pos.slot = 0;
+}
+
+string DBScanOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBScanOp]" << endl;
+  ss << linePrefix << "relation: " << table.getRelDef().relationName() << endl;
+  ss << linePrefix << "pos: " << pos.toString() << endl;
+  return ss.str();
+}
+
+string DBScanOp::explain() const {
+  string s = "Scan " + table.getRelDef().relationName();
+  if (where.empty() == false)
+    s += " where " + predicateList(where);
+  return s;
+}
+
+void DBScanOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  pos.page = 0;
+  pos.slot = 0;
+  eof = false;
+}
+
+bool DBScanOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  if (eof == true)
+    return false;
+  DBListTuple l;
+  pos = table.readSeqFromTID(pos, STD_SCAN_BATCH, l, &where, attrMask);
+  LOG4CXX_DEBUG(logger, "read " + TO_STR(l.size()) + " tuples");
+  eof = l.size() < STD_SCAN_BATCH;
+  toRows(l, rows);
+  return rows.empty() == false;
+}
+
+DBIndexScanOp::DBIndexScanOp(DBTable &table, DBIndex *index, const DBAttrType &val, uint attrMask) :
+        table(table),
+        index(index),
+        val(DBAttrType::clone(val)),
+        attrMask(attrMask) {
+  tids.reserve(STD_TID_BATCH);
+}
+
+DBIndexScanOp::~DBIndexScanOp() {
+  delete index;
+  delete val;
+}
+
+string DBIndexScanOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBIndexScanOp]" << endl;
+  ss << linePrefix << "relation: " << table.getRelDef().relationName() << endl;
+  ss << linePrefix << "val: " << val->toString() << endl;
+  return ss.str();
+}
+
+string DBIndexScanOp::explain() const {
+  stringstream ss;
+  ss << "Index scan " << table.getRelDef().relationName() << " key ";
+  val->print(ss, false);
+  return ss.str();
+}
+
+void DBIndexScanOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  index->openCursor(*val);
+}
+
+bool DBIndexScanOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  if (index->nextBatch(tids) == false)
+    return false;
+  LOG4CXX_DEBUG(logger, "fetch " + TO_STR(tids.size()) + " tids");
+  DBListTuple l;
+  table.readTIDs(tids, l, attrMask, false);
+  toRows(l, rows);
+  return rows.empty() == false;
+}
+
+void DBIndexScanOp::close() {
+  index->closeCursor();
+}
+
+DBBitmapScanOp::DBBitmapScanOp(DBTable &table, DBTIDBitmap &bitmap, uint attrMask) :
+        table(table),
+        attrMask(attrMask) {
+  this->bitmap.swap(bitmap);
+  tids.reserve(STD_TID_BATCH);
+}
+
+string DBBitmapScanOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBBitmapScanOp]" << endl;
+  ss << linePrefix << "relation: " << table.getRelDef().relationName() << endl;
+  ss << linePrefix << "bitmap:\n" << bitmap.toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBBitmapScanOp::explain() const {
+  stringstream ss;
+  ss << "Bitmap scan " << table.getRelDef().relationName() << " (" << bitmap.cardinality() << " TIDs)";
+  return ss.str();
+}
+
+void DBBitmapScanOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  pos = DBTIDBitmap::Position();
+}
+
+bool DBBitmapScanOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  if (bitmap.nextBatch(pos, tids) == false)
+    return false;
+  LOG4CXX_DEBUG(logger, "fetch " + TO_STR(tids.size()) + " tids");
+  DBListTuple l;
+  table.readTIDs(tids, l, attrMask);
+  toRows(l, rows);
+  return rows.empty() == false;
+}
+
+DBOrderedIndexScanOp::DBOrderedIndexScanOp(DBTable &table, DBIndex *index, uint attrMask) :
+        table(table),
+        index(index),
+        attrMask(attrMask) {
+  tids.reserve(STD_TID_BATCH);
+}
+
+DBOrderedIndexScanOp::~DBOrderedIndexScanOp() {
+  delete index;
+}
+
+string DBOrderedIndexScanOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBOrderedIndexScanOp]" << endl;
+  ss << linePrefix << "relation: " << table.getRelDef().relationName() << endl;
+  return ss.str();
+}
+
+string DBOrderedIndexScanOp::explain() const {
+  return "Ordered index scan " + table.getRelDef().relationName();
+}
+
+void DBOrderedIndexScanOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  if (index->openOrderedCursor() == false)
+    throw DBException("index is not ordered");
+}
+
+bool DBOrderedIndexScanOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  string key;
+  // one key per batch, its tids are sorted by page
+  while (rows.empty() == true && index->nextOrdered(key, tids) == true) {
+    DBListTuple l;
+    table.readTIDs(tids, l, attrMask);
+    toRows(l, rows);
+  }
+  return rows.empty() == false;
+}
+
+void DBOrderedIndexScanOp::close() {
+  index->closeCursor();
+}
+
+DBTempScanOp::DBTempScanOp(vector<DBTempFile *> &files, const string &source) :
+        source(source),
+        filePos(0) {
+  this->files.swap(files);
+}
+
+DBTempScanOp::~DBTempScanOp() {
+  for (uint p = 0; p < files.size(); ++p)
+    delete files[p];
+}
+
+string DBTempScanOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBTempScanOp]" << endl;
+  ss << linePrefix << "files: " << files.size() << endl;
+  return ss.str();
+}
+
+string DBTempScanOp::explain() const {
+  uint cnt = 0;
+  for (uint p = 0; p < files.size(); ++p)
+    cnt += files[p]->getTupleCnt();
+  stringstream ss;
+  ss << "Temp scan of " << cnt << " row(s) in " << files.size() << " file(s)";
+  if (source.empty() == false)
+    ss << " of " << source;
+  return ss.str();
+}
+
+void DBTempScanOp::open() {
+  filePos = 0;
+  for (uint p = 0; p < files.size(); ++p)
+    files[p]->rewind();
+}
+
+bool DBTempScanOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  DBListTuple l;
+  while (filePos < files.size() && files[filePos]->read(STD_TID_BATCH, l) == 0)
+    ++filePos;
+  toRows(l, rows);
+  return rows.empty() == false;
+}
+
+DBFilterOp::DBFilterOp(DBOperator *child, const DBRelDef &def, const DBListPredicate &where, const list<bool> &checkList) :
+        child(child),
+        where(where),
+        checkList(checkList) {
+  DBListPredicate::iterator u = this->where.begin();
+  while (u != this->where.end()) {
+    posList.push_back(def.attrDef((*u).name().attributeName).attrPos());
+    ++u;
+  }
+}
+
+DBFilterOp::~DBFilterOp() {
+  delete child;
+}
+
+string DBFilterOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBFilterOp]" << endl;
+  ss << linePrefix << "predicates: " << where.size() << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBFilterOp::explain() const {
+  // predicates that are not checked are answered by the index below
+  DBListPredicate checked, indexed;
+  list<bool>::const_iterator c = checkList.begin();
+  for (DBListPredicate::const_iterator u = where.begin(); u != where.end(); ++u, ++c)
+    ((*c == true) ? checked : indexed).push_back(*u);
+  string s = "Filter";
+  if (checked.empty() == false)
+    s += " " + predicateList(checked);
+  if (indexed.empty() == false)
+    s += " (by index: " + predicateList(indexed) + ")";
+  return s;
+}
+
+void DBFilterOp::open() {
+  child->open();
+}
+
+bool DBFilterOp::next(DBListJoinTuple &rows) {
+  // a batch may be filtered out completely, so read on until a row matches
+  while (child->next(rows) == true) {
+    DBListJoinTuple::iterator i = rows.begin();
+    while (i != rows.end()) {
+      if (match((*i).first, where, posList, checkList) == true) {
+        LOG4CXX_DEBUG(logger, "tuple: " + (*i).first.toString("\t"));
+        ++i;
+      } else {
+        i = rows.erase(i);
+      }
+    }
+    if (rows.empty() == false)
+      return true;
+  }
+  return false;
+}
+
+void DBFilterOp::close() {
+  child->close();
+}
+
+bool DBFilterOp::match(const DBTuple &tuple,
+                       DBListPredicate &where,
+                       const list<uint> &posList,
+                       const list<bool> &checkList) {
+  DBListPredicate::iterator u = where.begin();
+  list<uint>::const_iterator ii = posList.begin();
+  list<bool>::const_iterator ic = checkList.begin();
+  while (u != where.end()) {
+    if (*ic == true && !((*u).val() == tuple.getAttrVal(*ii)))
+      return false;
+    ++ii;
+    ++ic;
+    ++u;
+  }
+  return true;
+}
+
+DBHashJoinOp::DBHashJoinOp(DBOperator *build, DBOperator *probe, uint buildSide, uint attrJoinPos[2]) :
+        build(build),
+        probe(probe),
+        buildSide(buildSide) {
+  this->attrJoinPos[0] = attrJoinPos[0];
+  this->attrJoinPos[1] = attrJoinPos[1];
+}
+
+DBHashJoinOp::~DBHashJoinOp() {
+  delete build;
+  delete probe;
+}
+
+string DBHashJoinOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBHashJoinOp]" << endl;
+  ss << linePrefix << "buildSide: " << buildSide << endl;
+  ss << linePrefix << "build:\n" << build->toString(linePrefix + "\t");
+  ss << linePrefix << "probe:\n" << probe->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBHashJoinOp::explain() const {
+  return (string) "Hash join, build side " + ((buildSide == 0) ? "left" : "right");
+}
+
+void DBHashJoinOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  DBListJoinTuple rows;
+  build->fetchAll(rows);
+  fromRows(rows, buildTuples);
+  buildHashTable(buildTuples, attrJoinPos[buildSide], hashTable);
+  probe->open();
+}
+
+bool DBHashJoinOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  DBListJoinTuple batch;
+  while (rows.empty() == true && probe->next(batch) == true) {
+    DBListTuple l;
+    fromRows(batch, l);
+    probeHashTable(hashTable, buildSide, l, attrJoinPos[1 - buildSide], rows);
+  }
+  return rows.empty() == false;
+}
+
+void DBHashJoinOp::close() {
+  probe->close();
+  hashTable.clear();
+  buildTuples.clear();
+}
+
+void DBHashJoinOp::buildHashTable(const DBListTuple &build, uint attrPos, DBJoinHashTable &hashTable) {
+  LOG4CXX_INFO(logger, "buildHashTable()");
+  hashTable.reserve(build.size());
+  DBListTuple::const_iterator i = build.begin();
+  while (i != build.end()) {
+    hashTable.insert(make_pair(&(*i).getAttrVal(attrPos), &(*i)));
+    ++i;
+  }
+}
+
+void DBHashJoinOp::probeHashTable(DBJoinHashTable &hashTable,
+                                  uint buildSide,
+                                  const DBListTuple &probe,
+                                  uint attrPos,
+                                  DBListJoinTuple &tuples) {
+  LOG4CXX_INFO(logger, "probeHashTable()");
+  DBListTuple::const_iterator i = probe.begin();
+  while (i != probe.end()) {
+    pair<DBJoinHashTable::const_iterator, DBJoinHashTable::const_iterator> range =
+            hashTable.equal_range(&(*i).getAttrVal(attrPos));
+    DBJoinHashTable::const_iterator u = range.first;
+    while (u != range.second) {
+      pair<DBTuple, DBTuple> p;
+      if (buildSide == 0) {
+        p.first = *u->second;
+        p.second = *i;
+      } else {
+        p.first = *i;
+        p.second = *u->second;
+      }
+      LOG4CXX_DEBUG(logger, "left:\n" + p.first.toString("\t"));
+      LOG4CXX_DEBUG(logger, "right:\n" + p.second.toString("\t"));
+      tuples.push_back(p);
+      ++u;
+    }
+    ++i;
+  }
+}
+
+DBIndexJoinOp::DBIndexJoinOp(DBOperator *outer,
+                             uint inner,
+                             DBTable &table,
+                             DBIndex *index,
+                             uint attrJoinPos[2],
+                             const DBListPredicate &innerWhere,
+                             uint attrMask) :
+        outer(outer),
+        inner(inner),
+        table(table),
+        index(index),
+        innerWhere(innerWhere),
+        attrMask(attrMask) {
+  this->attrJoinPos[0] = attrJoinPos[0];
+  this->attrJoinPos[1] = attrJoinPos[1];
+  // predicates on the inner table are checked on the fetched tuples
+  const DBRelDef &def = table.getRelDef();
+  DBListPredicate::iterator u = this->innerWhere.begin();
+  while (u != this->innerWhere.end()) {
+    posList.push_back(def.attrDef((*u).name().attributeName).attrPos());
+    checkList.push_back(true);
+    ++u;
+  }
+}
+
+DBIndexJoinOp::~DBIndexJoinOp() {
+  delete outer;
+  delete index;
+}
+
+string DBIndexJoinOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBIndexJoinOp]" << endl;
+  ss << linePrefix << "inner: " << table.getRelDef().relationName() << endl;
+  ss << linePrefix << "outer:\n" << outer->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBIndexJoinOp::explain() const {
+  const DBRelDef &def = table.getRelDef();
+  string s = "Index nested-loop join, inner " + def.relationName() + "." + def.attrDef(attrJoinPos[inner]).attrName();
+  if (innerWhere.empty() == false)
+    s += " where " + predicateList(innerWhere);
+  return s;
+}
+
+void DBIndexJoinOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  outer->open();
+}
+
+bool DBIndexJoinOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  uint outerPos = attrJoinPos[1 - inner];
+  DBListJoinTuple outerRows;
+  DBTIDBatch tids, found;
+  while (rows.empty() == true && outer->next(outerRows) == true) {
+    DBListTuple batch;
+    fromRows(outerRows, batch);
+    batch.sort([outerPos](const DBTuple &a, const DBTuple &b) {
+      return a.getAttrVal(outerPos) < b.getAttrVal(outerPos);
+    });
+
+    tids.clear();
+    const DBAttrType *prev = NULL;
+    DBListTuple::const_iterator i = batch.begin();
+    while (i != batch.end()) {
+      const DBAttrType &val = (*i).getAttrVal(outerPos);
+      if (prev == NULL || !(*prev == val)) {
+        index->openCursor(val);
+        while (index->nextBatch(found))
+          tids.insert(tids.end(), found.begin(), found.end());
+        prev = &val;
+      }
+      ++i;
+    }
+    index->closeCursor();
+    LOG4CXX_DEBUG(logger, "probe " + TO_STR((uint) batch.size()) + " tuples, fetch " + TO_STR((uint) tids.size()) + " tids");
+
+    // the matches go into a hash table, page order is enough
+    DBListTuple l, matches;
+    table.readTIDs(tids, l, attrMask, false);
+    DBListTuple::iterator u = l.begin();
+    while (u != l.end()) {
+      if (DBFilterOp::match(*u, innerWhere, posList, checkList) == true)
+        matches.push_back(*u);
+      ++u;
+    }
+    DBJoinHashTable hashTable;
+    DBHashJoinOp::buildHashTable(matches, attrJoinPos[inner], hashTable);
+    DBHashJoinOp::probeHashTable(hashTable, inner, batch, outerPos, rows);
+  }
+  return rows.empty() == false;
+}
+
+void DBIndexJoinOp::close() {
+  outer->close();
+}
+
+DBPartitionedHashJoinOp::DBPartitionedHashJoinOp(DBOperator *left,
+                                                 DBOperator *right,
+                                                 uint first,
+                                                 DBSysCatMgr &sysCatMgr,
+                                                 const string &dbName,
+                                                 const DBRelDef &leftRel,
+                                                 const DBRelDef &rightRel,
+                                                 uint attrJoinPos[2]) :
+        first(first),
+        sysCatMgr(sysCatMgr),
+        dbName(dbName),
+        indexTable(NULL),
+        index(NULL),
+        indexMask(ALL_ATTRS),
+        maxOuter(0),
+        buildSide(first),
+        streamed(false),
+        perPartition(false),
+        partPos(0),
+        sub(NULL) {
+  input[0] = left;
+  input[1] = right;
+  rel.push_back(leftRel);
+  rel.push_back(rightRel);
+  for (uint i = 0; i < 2; ++i) {
+    this->attrJoinPos[i] = attrJoinPos[i];
+    maxTuples[i] = memTuples(rel[i]);
+    opened[i] = false;
+    cnt[i] = 0;
+  }
+}
+
+DBPartitionedHashJoinOp::~DBPartitionedHashJoinOp() {
+  clear();
+  if (index != NULL)
+    delete index;
+  delete input[0];
+  delete input[1];
+}
+
+string DBPartitionedHashJoinOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBPartitionedHashJoinOp]" << endl;
+  ss << linePrefix << "first: " << first << endl;
+  ss << linePrefix << "maxTuples: " << maxTuples[0] << "/" << maxTuples[1] << endl;
+  ss << linePrefix << "partitions: " << part[0].size() << "/" << part[1].size() << endl;
+  ss << linePrefix << "left:\n" << input[0]->toString(linePrefix + "\t");
+  ss << linePrefix << "right:\n" << input[1]->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBPartitionedHashJoinOp::explain() const {
+  string s = (string) "Hash join, " + ((first == 0) ? "left" : "right") + " input first";
+  if (indexTable != NULL) {
+    const DBRelDef &def = indexTable->getRelDef();
+    s += ", index " + def.relationName() + "." + def.attrDef(attrJoinPos[1 - first]).attrName() +
+         " if below " + TO_STR(maxOuter) + " row(s)";
+  }
+  if (strategy.empty() == false)
+    s += " (" + strategy + ")";
+  return s;
+}
+
+void DBPartitionedHashJoinOp::setIndexJoin(DBTable &table, DBIndex *index, const DBListPredicate &where, uint attrMask, uint maxOuter) {
+  if (this->index != NULL)
+    delete this->index;
+  indexTable = &table;
+  this->index = index;
+  indexWhere = where;
+  indexMask = attrMask;
+  this->maxOuter = maxOuter;
+}
+
+uint DBPartitionedHashJoinOp::memTuples(const DBRelDef &rel) {
+  return STD_JOIN_MEM_BLOCKS * STD_BLOCKSIZE / max(1u, rel.tupleSize());
+}
+
+void DBPartitionedHashJoinOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  clear();
+  uint second = 1 - first;
+  opened[first] = true;
+  input[first]->open();
+  if (readInput(first) == true) {
+    if (index != NULL && mem[first].size() < maxOuter) {
+      strategy = "index nested-loop join";
+      DBIndex *probe = index;
+      index = NULL;
+      sub = new DBIndexJoinOp(new DBListOp(mem[first]), second, *indexTable, probe, attrJoinPos, indexWhere, indexMask);
+      sub->open();
+      return;
+    }
+    strategy = "in memory";
+    buildHashTable(first);
+    streamed = true;
+    opened[second] = true;
+    input[second]->open();
+    return;
+  }
+
+  opened[second] = true;
+  input[second]->open();
+  if (readInput(second) == true) {
+    // only the first input is partitioned, its partitions are probed in any order
+    strategy = TO_STR(MAX_JOIN_PARTITIONS) + " partitions of the " + ((first == 0) ? "left" : "right") + " input";
+    buildHashTable(second);
+    return;
+  }
+
+  if (cnt[0] > MAX_JOIN_PARTITIONS * maxTuples[0] && cnt[1] > MAX_JOIN_PARTITIONS * maxTuples[1]) {
+    strategy = "sort-merge join";
+    DBOperator *sorted[2] = {NULL, NULL};
+    for (uint i = 0; i < 2; ++i)
+      sorted[i] = new DBSortOp(new DBTempScanOp(part[i]), sysCatMgr, dbName, rel[i], attrJoinPos[i], false);
+    sub = new DBMergeJoinOp(sorted[0], sorted[1], attrJoinPos);
+    sub->open();
+    return;
+  }
+
+  strategy = TO_STR(MAX_JOIN_PARTITIONS) + " partitions of both inputs";
+  perPartition = true;
+  partPos = 0;
+  if (nextPartition() == false)
+    partPos = MAX_JOIN_PARTITIONS;
+}
+
+bool DBPartitionedHashJoinOp::next(DBListJoinTuple &rows) {
+  if (sub != NULL)
+    return sub->next(rows);
+  rows.clear();
+  DBListJoinTuple batch;
+  DBListTuple l;
+  while (rows.empty() == true) {
+    uint probeSide = 1 - buildSide;
+    if (streamed == true) {
+      if (input[probeSide]->next(batch) == false)
+        return false;
+      fromRows(batch, l);
+    } else {
+      while (partPos < part[probeSide].size() && part[probeSide][partPos]->read(STD_TID_BATCH, l) == 0) {
+        ++partPos;
+        if (perPartition == true && nextPartition() == false)
+          return false;
+        probeSide = 1 - buildSide;
+      }
+      if (l.empty() == true)
+        return false;
+    }
+    DBHashJoinOp::probeHashTable(hashTable, buildSide, l, attrJoinPos[probeSide], rows);
+    l.clear();
+  }
+  return true;
+}
+
+void DBPartitionedHashJoinOp::close() {
+  for (uint i = 0; i < 2; ++i) {
+    if (opened[i] == true)
+      input[i]->close();
+    opened[i] = false;
+  }
+  if (sub != NULL)
+    sub->close();
+  clear();
+}
+
+/**
+ * Reads the input into memory; if it exceeds the budget, all of its tuples are
+ * distributed to the partitions instead
+ * @return true if the input fits into memory
+ */
+bool DBPartitionedHashJoinOp::readInput(uint side) {
+  DBListJoinTuple rows;
+  DBListTuple l;
+  while (input[side]->next(rows) == true) {
+    cnt[side] += rows.size();
+    fromRows(rows, (part[side].empty() == true) ? mem[side] : l);
+    if (part[side].empty() == true && mem[side].size() > maxTuples[side]) {
+      LOG4CXX_DEBUG(logger, "partition input " + TO_STR(side));
+      for (uint p = 0; p < MAX_JOIN_PARTITIONS; ++p)
+        part[side].push_back(sysCatMgr.createTempFile(dbName, rel[side]));
+      l.swap(mem[side]);
+    }
+    DBListTuple::const_iterator i = l.begin();
+    while (i != l.end()) {
+      part[side][partitionOf((*i).getAttrVal(attrJoinPos[side]))]->append(*i);
+      ++i;
+    }
+    l.clear();
+  }
+  // finish writing so that no partition keeps a page fixed
+  for (uint p = 0; p < part[side].size(); ++p)
+    part[side][p]->rewind();
+  LOG4CXX_DEBUG(logger, "input " + TO_STR(side) + ": " + TO_STR(cnt[side]) + " tuples");
+  return part[side].empty() == true;
+}
+
+void DBPartitionedHashJoinOp::buildHashTable(uint side) {
+  buildSide = side;
+  hashTable.clear();
+  DBHashJoinOp::buildHashTable(mem[side], attrJoinPos[side], hashTable);
+}
+
+/**
+ * Loads the build side of the next partition (starting at partPos) that has
+ * tuples on both sides; a skewed partition may exceed the budget, it is joined
+ * in memory anyway
+ * @return false if there are no partitions left
+ */
+bool DBPartitionedHashJoinOp::nextPartition() {
+  mem[0].clear();
+  mem[1].clear();
+  hashTable.clear();
+  while (partPos < MAX_JOIN_PARTITIONS &&
+         (part[0][partPos]->getTupleCnt() == 0 || part[1][partPos]->getTupleCnt() == 0))
+    ++partPos;
+  if (partPos >= MAX_JOIN_PARTITIONS)
+    return false;
+  uint side = (part[1][partPos]->getTupleCnt() < part[0][partPos]->getTupleCnt()) ? 1 : 0;
+  LOG4CXX_DEBUG(logger, "partition " + TO_STR(partPos) + ": " + TO_STR(part[0][partPos]->getTupleCnt()) + "/" +
+                        TO_STR(part[1][partPos]->getTupleCnt()));
+  part[side][partPos]->rewind();
+  while (part[side][partPos]->read(STD_TID_BATCH, mem[side]) > 0);
+  part[1 - side][partPos]->rewind();
+  buildHashTable(side);
+  return true;
+}
+
+void DBPartitionedHashJoinOp::clear() {
+  if (sub != NULL)
+    delete sub;
+  sub = NULL;
+  hashTable.clear();
+  for (uint i = 0; i < 2; ++i) {
+    mem[i].clear();
+    for (uint p = 0; p < part[i].size(); ++p)
+      delete part[i][p];
+    part[i].clear();
+    cnt[i] = 0;
+  }
+  buildSide = first;
+  streamed = false;
+  perPartition = false;
+  partPos = 0;
+}
+
+uint DBPartitionedHashJoinOp::partitionOf(const DBAttrType &val) {
+  // the upper bits of a multiplicative hash, std::hash<int> is the identity
+  uint64_t h = (uint64_t) val.hashValue() * 0x9E3779B97F4A7C15ull;
+  return (uint) ((h >> 32) % MAX_JOIN_PARTITIONS);
+}
+
+DBMergeJoinOp::DBMergeJoinOp(DBOperator *left, DBOperator *right, uint attrJoinPos[2]) :
+        pending(false),
+        done(false) {
+  input[0] = left;
+  input[1] = right;
+  for (uint i = 0; i < 2; ++i) {
+    this->attrJoinPos[i] = attrJoinPos[i];
+    eof[i] = false;
+  }
+}
+
+DBMergeJoinOp::~DBMergeJoinOp() {
+  delete input[0];
+  delete input[1];
+}
+
+string DBMergeJoinOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBMergeJoinOp]" << endl;
+  ss << linePrefix << "group: " << group[0].size() << "/" << group[1].size() << endl;
+  ss << linePrefix << "left:\n" << input[0]->toString(linePrefix + "\t");
+  ss << linePrefix << "right:\n" << input[1]->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBMergeJoinOp::explain() const {
+  return "Merge join, left column " + TO_STR(attrJoinPos[0]) + " = right column " + TO_STR(attrJoinPos[1]);
+}
+
+void DBMergeJoinOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  for (uint i = 0; i < 2; ++i) {
+    buf[i].clear();
+    group[i].clear();
+    eof[i] = false;
+  }
+  pending = false;
+  done = false;
+  input[0]->open();
+  input[1]->open();
+}
+
+bool DBMergeJoinOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  while (rows.size() < STD_TID_BATCH) {
+    if (pending == false) {
+      if (done == true || matchGroups() == false) {
+        done = true;
+        break;
+      }
+      pos[0] = group[0].begin();
+      pos[1] = group[1].begin();
+      pending = true;
+    }
+    // a large group is continued with the next batch
+    while (pending == true && rows.size() < STD_TID_BATCH) {
+      rows.push_back(make_pair(*pos[0], *pos[1]));
+      if (++pos[1] == group[1].end()) {
+        pos[1] = group[1].begin();
+        pending = ++pos[0] != group[0].end();
+      }
+    }
+  }
+  return rows.empty() == false;
+}
+
+void DBMergeJoinOp::close() {
+  input[0]->close();
+  input[1]->close();
+  for (uint i = 0; i < 2; ++i) {
+    buf[i].clear();
+    group[i].clear();
+  }
+  pending = false;
+}
+
+/**
+ * Moves all tuples with the next join value of the input into its group
+ * @return false at the end of the input
+ */
+bool DBMergeJoinOp::readGroup(uint side) {
+  group[side].clear();
+  DBListJoinTuple rows;
+  while (buf[side].empty() == true && eof[side] == false) {
+    if (input[side]->next(rows) == true)
+      fromRows(rows, buf[side]);
+    else
+      eof[side] = true;
+  }
+  if (buf[side].empty() == true)
+    return false;
+  group[side].splice(group[side].end(), buf[side], buf[side].begin());
+  const DBAttrType &val = group[side].front().getAttrVal(attrJoinPos[side]);
+  while (true) {
+    if (buf[side].empty() == true) {
+      if (eof[side] == true || input[side]->next(rows) == false) {
+        eof[side] = true;
+        break;
+      }
+      fromRows(rows, buf[side]);
+    }
+    if (!(buf[side].front().getAttrVal(attrJoinPos[side]) == val))
+      break;
+    group[side].splice(group[side].end(), buf[side], buf[side].begin());
+  }
+  return true;
+}
+
+/**
+ * Reads the groups of both inputs until their join values are equal
+ * @return false if one of the inputs is exhausted
+ */
+bool DBMergeJoinOp::matchGroups() {
+  bool more[2];
+  for (uint i = 0; i < 2; ++i)
+    more[i] = readGroup(i);
+  while (more[0] == true && more[1] == true) {
+    const DBAttrType &left = group[0].front().getAttrVal(attrJoinPos[0]);
+    const DBAttrType &right = group[1].front().getAttrVal(attrJoinPos[1]);
+    if (left < right)
+      more[0] = readGroup(0);
+    else if (right < left)
+      more[1] = readGroup(1);
+    else
+      return true;
+  }
+  return false;
+}
+
+DBHashAggregateOp::DBHashAggregateOp(DBOperator *child,
+                                     DBSysCatMgr &sysCatMgr,
+                                     const string &dbName,
+                                     DBRelDef *def[2],
+                                     const list<pair<uint, uint> > &groupList,
+                                     const vector<DBAggregate> &aggList) :
+        child(child),
+        sysCatMgr(sysCatMgr),
+        dbName(dbName),
+        colList(groupList.begin(), groupList.end()),
+        groupCnt(groupList.size()),
+        aggList(aggList),
+        level(0) {
+  // every attribute is read once, even if several functions aggregate it
+  for (uint a = 0; a < aggList.size(); ++a) {
+    uint c = 0;
+    if (aggList[a].type != NONE) {
+      pair<uint, uint> p(aggList[a].side, aggList[a].pos);
+      c = find(colList.begin(), colList.end(), p) - colList.begin();
+      if (c == colList.size())
+        colList.push_back(p);
+    }
+    argCol.push_back(c);
+  }
+  vector<AttrTypeEnum> types;
+  for (uint c = 0; c < colList.size(); ++c)
+    types.push_back(def[colList[c].first]->attrTypeDef(colList[c].second));
+  tupleDef(types, colDef);
+  maxGroups = STD_AGG_MEM_BLOCKS * STD_BLOCKSIZE / max(1u, colDef.tupleSize);
+  emitPos = groups.end();
+}
+
+DBHashAggregateOp::~DBHashAggregateOp() {
+  clearGroups();
+  dropPartitions(spilled);
+  while (pending.empty() == false) {
+    delete pending.front().file;
+    pending.pop_front();
+  }
+  delete child;
+}
+
+string DBHashAggregateOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBHashAggregateOp]" << endl;
+  ss << linePrefix << "groupCnt: " << groupCnt << endl;
+  ss << linePrefix << "aggregates: " << aggList.size() << endl;
+  ss << linePrefix << "maxGroups: " << maxGroups << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBHashAggregateOp::explain() const {
+  stringstream ss;
+  ss << "Hash aggregate, " << groupCnt << " grouping attribute(s), " << aggList.size() << " aggregate(s)";
+  return ss.str();
+}
+
+void DBHashAggregateOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  child->open();
+  level = 0;
+  DBListJoinTuple rows;
+  vector<const DBAttrType *> cols(colList.size());
+  while (child->next(rows) == true) {
+    DBListJoinTuple::const_iterator i = rows.begin();
+    while (i != rows.end()) {
+      for (uint c = 0; c < colList.size(); ++c) {
+        const DBTuple &t = (colList[c].first == 0) ? (*i).first : (*i).second;
+        cols[c] = &t.getAttrVal(colList[c].second);
+      }
+      aggregate(cols);
+      ++i;
+    }
+  }
+  // without grouping attributes there is a result row even for an empty input
+  if (groupCnt == 0 && groups.empty() == true)
+    addGroup(cols, "");
+  finishInput();
+}
+
+bool DBHashAggregateOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  while (emitPos == groups.end()) {
+    if (nextPartition() == false)
+      return false;
+  }
+  for (uint n = 0; n < STD_TID_BATCH && emitPos != groups.end(); ++n, ++emitPos) {
+    rows.push_back(pair<DBTuple, DBTuple>());
+    DBTuple &t = rows.back().first;
+    t = (*emitPos).key;
+    for (uint a = 0; a < aggList.size(); ++a) {
+      const aggState &st = (*emitPos).states[a];
+      DBAttrType *val = NULL;
+      if (aggList[a].func == AGG_COUNT) {
+        val = new DBIntType(st.cnt);
+      } else if (st.cnt == 0) {
+        val = NULL;
+      } else if (aggList[a].func == AGG_AVG) {
+        val = new DBDoubleType(st.sum / st.cnt);
+      } else if (aggList[a].func == AGG_SUM && aggList[a].type == INT) {
+        if (st.intSum > INT_MAX || st.intSum < INT_MIN)
+          throw DBRuntimeException("SUM over INT out of range");
+        val = new DBIntType((int) st.intSum);
+      } else if (aggList[a].func == AGG_SUM) {
+        val = new DBDoubleType(st.sum);
+      } else {
+        val = DBAttrType::clone(*st.ext);
+      }
+      t.appendAttrVal(val);
+      if (val != NULL)
+        delete val;
+    }
+  }
+  return true;
+}
+
+void DBHashAggregateOp::close() {
+  child->close();
+  clearGroups();
+  dropPartitions(spilled);
+  while (pending.empty() == false) {
+    delete pending.front().file;
+    pending.pop_front();
+  }
+}
+
+void DBHashAggregateOp::aggregate(const vector<const DBAttrType *> &cols) {
+  string key = groupKey(cols);
+  aggGroup *g = NULL;
+  unordered_map<string, aggGroup *>::iterator u = groupIndex.find(key);
+  if (u != groupIndex.end()) {
+    g = u->second;
+  } else if (groups.size() >= maxGroups && level < maxAggLevel) {
+    spill(cols, key);
+    return;
+  } else {
+    g = addGroup(cols, key);
+  }
+
+  for (uint a = 0; a < aggList.size(); ++a) {
+    aggState &st = g->states[a];
+    const DBAttrType *val = (aggList[a].type != NONE) ? cols[argCol[a]] : NULL;
+    ++st.cnt;
+    switch (aggList[a].func) {
+      case AGG_SUM:
+      case AGG_AVG:
+        if (aggList[a].type == INT) {
+          int i = ((const DBIntType *) val)->getVal();
+          st.intSum += i;
+          st.sum += i;
+        } else {
+          st.sum += ((const DBDoubleType *) val)->getVal();
+        }
+        break;
+      case AGG_MIN:
+      case AGG_MAX:
+        if (st.ext == NULL || (aggList[a].func == AGG_MIN ? *val < *st.ext : *val > *st.ext)) {
+          if (st.ext != NULL)
+            delete st.ext;
+          st.ext = DBAttrType::clone(*val);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+DBHashAggregateOp::aggGroup *DBHashAggregateOp::addGroup(const vector<const DBAttrType *> &cols, const string &key) {
+  aggState init = {0, 0.0, 0, NULL};
+  groups.push_back(aggGroup());
+  aggGroup &g = groups.back();
+  for (uint c = 0; c < groupCnt; ++c)
+    g.key.appendAttrVal(cols[c]);
+  g.states.assign(aggList.size(), init);
+  groupIndex[key] = &g;
+  return &g;
+}
+
+/**
+ * Queues the partitions written while aggregating the current input
+ */
+void DBHashAggregateOp::finishInput() {
+  LOG4CXX_DEBUG(logger, "level " + TO_STR(level) + ": " + TO_STR((uint) groups.size()) + " groups");
+  for (uint p = 0; p < spilled.size(); ++p) {
+    spilled[p]->rewind();
+    aggPartition part = {spilled[p], level + 1};
+    pending.push_back(part);
+  }
+  spilled.clear();
+  emitPos = groups.begin();
+}
+
+/**
+ * Writes the attributes of a row of a group that does not fit into memory to its partition
+ */
+void DBHashAggregateOp::spill(const vector<const DBAttrType *> &cols, const string &key) {
+  if (spilled.empty() == true) {
+    LOG4CXX_DEBUG(logger, "spill level " + TO_STR(level));
+    for (uint p = 0; p < MAX_AGG_PARTITIONS; ++p)
+      spilled.push_back(sysCatMgr.createTempFile(dbName, DBRelDef(&colDef)));
+  }
+  DBTuple t;
+  for (uint c = 0; c < cols.size(); ++c)
+    t.appendAttrVal(cols[c]);
+  // each level uses other bits of the hash, so a partition is split up again
+  uint64_t h = (uint64_t) std::hash<string>()(key) * 0x9E3779B97F4A7C15ull;
+  spilled[(uint) ((h >> (32 + 8 * level)) % MAX_AGG_PARTITIONS)]->append(t);
+}
+
+/**
+ * Aggregates the next pending partition
+ * @return false if there are no partitions left
+ */
+bool DBHashAggregateOp::nextPartition() {
+  clearGroups();
+  if (pending.empty() == true)
+    return false;
+  aggPartition part = pending.front();
+  pending.pop_front();
+  level = part.level;
+  LOG4CXX_DEBUG(logger, "aggregate partition of " + TO_STR(part.file->getTupleCnt()) + " tuples");
+  try {
+    DBListTuple l;
+    vector<const DBAttrType *> cols(colList.size());
+    while (part.file->read(STD_TID_BATCH, l) > 0) {
+      DBListTuple::const_iterator i = l.begin();
+      while (i != l.end()) {
+        for (uint c = 0; c < colList.size(); ++c)
+          cols[c] = &(*i).getAttrVal(c);
+        aggregate(cols);
+        ++i;
+      }
+      l.clear();
+    }
+  } catch (DBException e) {
+    delete part.file;
+    throw e;
+  }
+  delete part.file;
+  finishInput();
+  return true;
+}
+
+string DBHashAggregateOp::groupKey(const vector<const DBAttrType *> &cols) const {
+  string key;
+  for (uint c = 0; c < groupCnt; ++c) {
+    key += cols[c]->normalizedKey();
+    // the key of a string has a variable length
+    if (cols[c]->type() == VCHAR)
+      key += '\0';
+  }
+  return key;
+}
+
+void DBHashAggregateOp::clearGroups() {
+  list<aggGroup>::iterator g = groups.begin();
+  while (g != groups.end()) {
+    for (uint a = 0; a < (*g).states.size(); ++a) {
+      if ((*g).states[a].ext != NULL)
+        delete (*g).states[a].ext;
+    }
+    ++g;
+  }
+  groups.clear();
+  groupIndex.clear();
+  emitPos = groups.end();
+}
+
+void DBHashAggregateOp::dropPartitions(vector<DBTempFile *> &part) {
+  for (uint p = 0; p < part.size(); ++p)
+    delete part[p];
+  part.clear();
+}
+
+DBProjectOp::DBProjectOp(DBOperator *child, const list<pair<uint, uint> > &proList) :
+        child(child),
+        proList(proList) {
+}
+
+DBProjectOp::~DBProjectOp() {
+  delete child;
+}
+
+string DBProjectOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBProjectOp]" << endl;
+  ss << linePrefix << "attributes: " << proList.size() << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBProjectOp::explain() const {
+  return "Project " + TO_STR(proList.size()) + " column(s)";
+}
+
+void DBProjectOp::open() {
+  child->open();
+}
+
+bool DBProjectOp::next(DBListJoinTuple &rows) {
+  if (child->next(rows) == false)
+    return false;
+  DBListJoinTuple::iterator i = rows.begin();
+  while (i != rows.end()) {
+    DBTuple t;
+    list<pair<uint, uint> >::const_iterator pI = proList.begin();
+    while (pI != proList.end()) {
+      const DBTuple &src = ((*pI).first == 0) ? (*i).first : (*i).second;
+      t.appendAttrVal(src.hasAttrVal((*pI).second) ? &src.getAttrVal((*pI).second) : NULL);
+      ++pI;
+    }
+    (*i).first.swap(t);
+    (*i).second = DBTuple();
+    ++i;
+  }
+  return true;
+}
+
+void DBProjectOp::close() {
+  child->close();
+}
+
+DBSortOp::DBSortOp(DBOperator *child,
+                   DBSysCatMgr &sysCatMgr,
+                   const string &dbName,
+                   const DBRelDef &rel,
+                   uint attrPos,
+                   bool desc) :
+        child(child),
+        sysCatMgr(sysCatMgr),
+        dbName(dbName),
+        rel(rel),
+        attrPos(attrPos),
+        desc(desc),
+        sorter(NULL) {
+}
+
+DBSortOp::~DBSortOp() {
+  if (sorter != NULL)
+    delete sorter;
+  delete child;
+}
+
+string DBSortOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBSortOp]" << endl;
+  ss << linePrefix << "attrPos: " << attrPos << endl;
+  ss << linePrefix << "desc: " << desc << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBSortOp::explain() const {
+  return "External sort by column " + TO_STR(attrPos) + (desc ? " DESC" : " ASC");
+}
+
+uint DBSortOp::memTuples(const DBRelDef &rel) {
+  return STD_SORT_MEM_BLOCKS * STD_BLOCKSIZE / max(1u, rel.tupleSize());
+}
+
+void DBSortOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  child->open();
+  if (sorter != NULL)
+    delete sorter;
+  sorter = new DBExternalSort(sysCatMgr, dbName, rel, attrPos, memTuples(rel), desc);
+  DBListJoinTuple rows;
+  DBListTuple l;
+  while (child->next(rows) == true) {
+    fromRows(rows, l);
+    sorter->add(l);
+  }
+  sorter->sort();
+  LOG4CXX_DEBUG(logger, "runs: " + TO_STR(sorter->getRunCnt()));
+}
+
+bool DBSortOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  DBListTuple l;
+  if (sorter->read(STD_TID_BATCH, l) == 0)
+    return false;
+  toRows(l, rows);
+  return true;
+}
+
+void DBSortOp::close() {
+  child->close();
+  if (sorter != NULL)
+    delete sorter;
+  sorter = NULL;
+}
+
+DBTopNOp::DBTopNOp(DBOperator *child, uint attrPos, bool desc, uint limit) :
+        child(child),
+        attrPos(attrPos),
+        desc(desc),
+        limit(limit),
+        emitPos(0) {
+}
+
+DBTopNOp::~DBTopNOp() {
+  delete child;
+}
+
+string DBTopNOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBTopNOp]" << endl;
+  ss << linePrefix << "attrPos: " << attrPos << endl;
+  ss << linePrefix << "desc: " << desc << endl;
+  ss << linePrefix << "limit: " << limit << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBTopNOp::explain() const {
+  return "Top-N heap of " + TO_STR(limit) + " row(s) by column " + TO_STR(attrPos) + (desc ? " DESC" : " ASC");
+}
+
+/**
+ * Whether a is returned before b
+ */
+bool DBTopNOp::before(const DBTuple &a, const DBTuple &b) const {
+  if (desc == true)
+    return a.getAttrVal(attrPos) > b.getAttrVal(attrPos);
+  return a.getAttrVal(attrPos) < b.getAttrVal(attrPos);
+}
+
+void DBTopNOp::open() {
+  LOG4CXX_INFO(logger, "open()");
+  child->open();
+  heap.clear();
+  heap.reserve(limit);
+  emitPos = 0;
+  auto cmp = [this](const DBTuple &a, const DBTuple &b) { return before(a, b); };
+  DBListJoinTuple rows;
+  while (child->next(rows) == true) {
+    DBListJoinTuple::iterator i = rows.begin();
+    while (i != rows.end()) {
+      if (heap.size() < limit) {
+        heap.push_back(DBTuple());
+        heap.back().swap((*i).first);
+        push_heap(heap.begin(), heap.end(), cmp);
+      } else if (limit > 0 && before((*i).first, heap.front()) == true) {
+        pop_heap(heap.begin(), heap.end(), cmp);
+        heap.back().swap((*i).first);
+        push_heap(heap.begin(), heap.end(), cmp);
+      }
+      ++i;
+    }
+  }
+  sort_heap(heap.begin(), heap.end(), cmp);
+}
+
+bool DBTopNOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  for (uint n = 0; n < STD_TID_BATCH && emitPos < heap.size(); ++n, ++emitPos) {
+    rows.push_back(pair<DBTuple, DBTuple>());
+    rows.back().first.swap(heap[emitPos]);
+  }
+  return rows.empty() == false;
+}
+
+void DBTopNOp::close() {
+  child->close();
+  heap.clear();
+}
+
+DBLimitOp::DBLimitOp(DBOperator *child, uint limit) :
+        child(child),
+        limit(limit),
+        cnt(0) {
+}
+
+DBLimitOp::~DBLimitOp() {
+  delete child;
+}
+
+string DBLimitOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBLimitOp]" << endl;
+  ss << linePrefix << "limit: " << limit << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBLimitOp::explain() const {
+  return "Limit " + TO_STR(limit);
+}
+
+void DBLimitOp::open() {
+  cnt = 0;
+  child->open();
+}
+
+bool DBLimitOp::next(DBListJoinTuple &rows) {
+  rows.clear();
+  if (cnt >= limit || child->next(rows) == false)
+    return false;
+  if (rows.size() > limit - cnt)
+    rows.resize(limit - cnt);
+  cnt += rows.size();
+  return true;
+}
+
+void DBLimitOp::close() {
+  child->close();
+}
+
+DBOutputOp::DBOutputOp(DBOperator *child, DBSocket &socket) :
+        child(child),
+        socket(socket),
+        cnt(0) {
+}
+
+DBOutputOp::~DBOutputOp() {
+  delete child;
+}
+
+string DBOutputOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBOutputOp]" << endl;
+  ss << linePrefix << "cnt: " << cnt << endl;
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBOutputOp::explain() const {
+  return "Output";
+}
+
+void DBOutputOp::open() {
+  cnt = 0;
+  child->open();
+}
+
+bool DBOutputOp::next(DBListJoinTuple &rows) {
+  if (child->next(rows) == false)
+    return false;
+  stringstream &out = socket.getWriteStream();
+  DBListJoinTuple::const_iterator i = rows.begin();
+  while (i != rows.end()) {
+    for (uint a = 0; a < (*i).first.getAttrCnt(); ++a) {
+      if ((*i).first.hasAttrVal(a) == true)
+        (*i).first.getAttrVal(a).print(out);
+      else
+        out << setw(MAX_STR_LEN) << "NULL";
+      out << "\t";
+    }
+    out << endl;
+    ++cnt;
+    ++i;
+  }
+  if (out.tellp() > (streamoff) STD_SEND_SIZE)
+    socket.writeToSocket();
+  return true;
+}
+
+void DBOutputOp::close() {
+  child->close();
+}
+
+DBProfile::DBProfile(DBSysCatMgr &sysCatMgr) :
+        sysCatMgr(sysCatMgr),
+        fixCnt(0),
+        readCnt(0),
+        msec(0),
+        startFix(0),
+        startRead(0) {
+}
+
+string DBProfile::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBProfile]" << endl;
+  ss << linePrefix << "fixCnt: " << fixCnt << endl;
+  ss << linePrefix << "readCnt: " << readCnt << endl;
+  ss << linePrefix << "msec: " << msec << endl;
+  return ss.str();
+}
+
+void DBProfile::start() {
+  startFix = sysCatMgr.getFixCnt();
+  startRead = sysCatMgr.getReadCnt();
+  startTime = std::chrono::steady_clock::now();
+}
+
+void DBProfile::stop() {
+  msec += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  fixCnt += sysCatMgr.getFixCnt() - startFix;
+  readCnt += sysCatMgr.getReadCnt() - startRead;
+}
+
+string DBProfile::describe() const {
+  stringstream ss;
+  ss << "fixes: " << fixCnt << ", misses: " << readCnt << ", time: " << fixed << setprecision(3) << msec << " ms";
+  return ss.str();
+}
+
+DBProfileOp::DBProfileOp(DBOperator *child, DBSysCatMgr &sysCatMgr) :
+        child(child),
+        profile(sysCatMgr),
+        rows(0),
+        opened(false) {
+}
+
+DBProfileOp::~DBProfileOp() {
+  delete child;
+}
+
+string DBProfileOp::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBProfileOp]" << endl;
+  ss << linePrefix << "rows: " << rows << endl;
+  ss << profile.toString(linePrefix + "\t");
+  ss << linePrefix << "child:\n" << child->toString(linePrefix + "\t");
+  return ss.str();
+}
+
+string DBProfileOp::explain() const {
+  if (opened == false)
+    return child->describe() + "  (never executed)";
+  return child->describe() + "  (rows: " + TO_STR(rows) + ", " + profile.describe() + ")";
+}
+
+void DBProfileOp::open() {
+  opened = true;
+  profile.start();
+  try {
+    child->open();
+  } catch (DBException e) {
+    profile.stop();
+    throw e;
+  }
+  profile.stop();
+}
+
+bool DBProfileOp::next(DBListJoinTuple &rows) {
+  profile.start();
+  bool more;
+  try {
+    more = child->next(rows);
+  } catch (DBException e) {
+    profile.stop();
+    throw e;
+  }
+  profile.stop();
+  if (more == true)
+    this->rows += rows.size();
+  return more;
+}
+
+void DBProfileOp::close() {
+  profile.start();
+  try {
+    child->close();
+  } catch (DBException e) {
+    profile.stop();
+    throw e;
+  }
+  profile.stop();
+}
+
+void DBProfileOp::instrument(DBOperator *&op, DBSysCatMgr &sysCatMgr) {
+  vector<DBOperator **> inputs;
+  op->getInputs(inputs);
+  for (uint i = 0; i < inputs.size(); ++i)
+    instrument(*inputs[i], sysCatMgr);
+  op = new DBProfileOp(op, sysCatMgr);
+}
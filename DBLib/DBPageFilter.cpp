@@ -0,0 +1,91 @@
+#include <hubDB/DBPageFilter.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Table;
+using namespace HubDB::Exception;
+
+LoggerPtr DBPageFilter::logger(Logger::getLogger("HubDB.Table.DBPageFilter"));
+
+/**
+ * Compares the value at ptr of up to 32 slots without branches
+ */
+template<typename T>
+static uint matchWord(const char *ptr, size_t stride, uint n, T val) {
+  uint bits = 0;
+  for (uint b = 0; b < n; ++b) {
+    T v;
+    memcpy(&v, ptr + b * stride, sizeof(T));
+    bits |= (uint) (v == val) << b;
+  }
+  return bits;
+}
+
+static uint matchWordVChar(const char *ptr, size_t stride, uint n, const char *val) {
+  uint bits = 0;
+  for (uint b = 0; b < n; ++b)
+    bits |= (uint) (memcmp(ptr + b * stride, val, MAX_STR_LEN) == 0) << b;
+  return bits;
+}
+
+DBPageFilter::DBPageFilter(const DBRelDef &rel, DBListPredicate &where) :
+        tupleSize(rel.tupleSize()),
+        never(false) {
+  DBListPredicate::iterator i = where.begin();
+  while (i != where.end()) {
+    uint pos = rel.attrDef((*i).name().attributeName).attrPos();
+    predicateLayout p;
+    memset(&p, 0, sizeof(p));
+    p.type = rel.attrTypeDef(pos);
+    for (uint a = 0; a < pos; ++a)
+      p.offset += DBAttrType::getSize4Type(rel.attrTypeDef(a));
+    if ((*i).val().type() != p.type) {
+      never = true;
+    } else if (p.type == VCHAR && ((const DBVCharType &) (*i).val()).getVal().size() > MAX_STR_LEN) {
+      // longer values are never stored in the fixed format
+      never = true;
+    } else if (p.type == INT) {
+      p.intVal = ((const DBIntType &) (*i).val()).getVal();
+    } else if (p.type == DOUBLE) {
+      p.doubleVal = ((const DBDoubleType &) (*i).val()).getVal();
+    } else {
+      strncpy(p.vcharVal, ((const DBVCharType &) (*i).val()).getVal().c_str(), MAX_STR_LEN);
+    }
+    preds.push_back(p);
+    ++i;
+  }
+}
+
+string DBPageFilter::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBPageFilter]" << endl;
+  ss << linePrefix << "tupleSize: " << tupleSize << endl;
+  ss << linePrefix << "predicates: " << preds.size() << endl;
+  ss << linePrefix << "never: " << never << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+void DBPageFilter::filter(const char *slots, uint slotCnt, uint *mask) const {
+  for (uint w = 0; w * 32 < slotCnt; ++w) {
+    uint n = min(32u, slotCnt - w * 32);
+    const char *word = slots + w * 32 * tupleSize;
+    vector<predicateLayout>::const_iterator p = preds.begin();
+    if (never == true)
+      mask[w] = 0;
+    while (mask[w] != 0 && p != preds.end()) {
+      const char *ptr = word + p->offset;
+      switch (p->type) {
+        case INT:
+          mask[w] &= matchWord(ptr, tupleSize, n, p->intVal);
+          break;
+        case DOUBLE:
+          mask[w] &= matchWord(ptr, tupleSize, n, p->doubleVal);
+          break;
+        default:
+          mask[w] &= matchWordVChar(ptr, tupleSize, n, p->vcharVal);
+          break;
+      }
+      ++p;
+    }
+  }
+}
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.4.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2019 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.4.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,7 +67,7 @@
 
 
 /* First part of user prologue.  */
-#line 6 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+#line 7 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
 
 #include <hubDB/DBParserDefs.h>
 #include <hubDB/DBParser.h>
@@ -85,8 +86,17 @@ static LoggerPtr loggerParser(Logger::getLogger("HubDB.Parser"));
 YY_DECL ;
 
 
-#line 89 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 90 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
 #  if defined __cplusplus
 #   if 201103L <= __cplusplus
@@ -99,144 +109,220 @@ YY_DECL ;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_USERS_BZCSCHAE_WORKSPACE_DBS2_HUBDB_INCLUDE_HUBDB_DBPARSER_H_INCLUDED
-# define YY_YY_USERS_BZCSCHAE_WORKSPACE_DBS2_HUBDB_INCLUDE_HUBDB_DBPARSER_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    CREATE = 258,
-    DROP = 259,
-    TABLE = 260,
-    INSERT = 261,
-    INTO = 262,
-    VALUES = 263,
-    SELECT = 264,
-    DELETE = 265,
-    FROM = 266,
-    WHERE = 267,
-    CONNECT = 268,
-    DISCONNECT = 269,
-    EQUALS = 270,
-    STAR = 271,
-    PARA_OPEN = 272,
-    PARA_CLOSE = 273,
-    COMMATA = 274,
-    SEMICOLON = 275,
-    TO = 276,
-    LIST = 277,
-    TABLES = 278,
-    IMPORT = 279,
-    EXPORT = 280,
-    QUIT = 281,
-    APOSTROPHE = 282,
-    INDEX = 283,
-    TYPE = 284,
-    GET = 285,
-    SCHEMA = 286,
-    FOR = 287,
-    DATABASE = 288,
-    INTT = 289,
-    DOUBLET = 290,
-    VARCHAR = 291,
-    AS = 292,
-    IN = 293,
-    DOT = 294,
-    UNIQUE = 295,
-    ON = 296,
-    AND = 297,
-    JOIN = 298,
-    PRINT = 299,
-    STATISTICS = 300,
-    CLASSES = 301,
-    HELP = 302,
-    NUM = 303,
-    REALNUM = 304,
-    DBNAME = 305,
-    STR_VALUE = 306
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-union YYSTYPE
+#include <hubDB/DBParser.h>
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 25 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-
-  char * str;
-  QualifiedName qName;
-  int num;
-  double realnum;
-  bool flag;
-  AttrDefStruct attrDef;
-  RelDefStruct relDef;
-  DBAttrType * valT;
-  DBTuple * tupleT;
-  DBListQualifiedName * listString;
-  DBListPredicate * listPredicate;
-  DBJoin * join;
-
-#line 199 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
-
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_CREATE = 3,                     /* CREATE  */
+  YYSYMBOL_DROP = 4,                       /* DROP  */
+  YYSYMBOL_TABLE = 5,                      /* TABLE  */
+  YYSYMBOL_INSERT = 6,                     /* INSERT  */
+  YYSYMBOL_INTO = 7,                       /* INTO  */
+  YYSYMBOL_VALUES = 8,                     /* VALUES  */
+  YYSYMBOL_SELECT = 9,                     /* SELECT  */
+  YYSYMBOL_DELETE = 10,                    /* DELETE  */
+  YYSYMBOL_FROM = 11,                      /* FROM  */
+  YYSYMBOL_WHERE = 12,                     /* WHERE  */
+  YYSYMBOL_CONNECT = 13,                   /* CONNECT  */
+  YYSYMBOL_DISCONNECT = 14,                /* DISCONNECT  */
+  YYSYMBOL_EQUALS = 15,                    /* EQUALS  */
+  YYSYMBOL_STAR = 16,                      /* STAR  */
+  YYSYMBOL_PARA_OPEN = 17,                 /* PARA_OPEN  */
+  YYSYMBOL_PARA_CLOSE = 18,                /* PARA_CLOSE  */
+  YYSYMBOL_COMMATA = 19,                   /* COMMATA  */
+  YYSYMBOL_SEMICOLON = 20,                 /* SEMICOLON  */
+  YYSYMBOL_TO = 21,                        /* TO  */
+  YYSYMBOL_LIST = 22,                      /* LIST  */
+  YYSYMBOL_TABLES = 23,                    /* TABLES  */
+  YYSYMBOL_IMPORT = 24,                    /* IMPORT  */
+  YYSYMBOL_EXPORT = 25,                    /* EXPORT  */
+  YYSYMBOL_QUIT = 26,                      /* QUIT  */
+  YYSYMBOL_APOSTROPHE = 27,                /* APOSTROPHE  */
+  YYSYMBOL_INDEX = 28,                     /* INDEX  */
+  YYSYMBOL_TYPE = 29,                      /* TYPE  */
+  YYSYMBOL_GET = 30,                       /* GET  */
+  YYSYMBOL_SCHEMA = 31,                    /* SCHEMA  */
+  YYSYMBOL_FOR = 32,                       /* FOR  */
+  YYSYMBOL_DATABASE = 33,                  /* DATABASE  */
+  YYSYMBOL_INTT = 34,                      /* INTT  */
+  YYSYMBOL_DOUBLET = 35,                   /* DOUBLET  */
+  YYSYMBOL_VARCHAR = 36,                   /* VARCHAR  */
+  YYSYMBOL_AS = 37,                        /* AS  */
+  YYSYMBOL_IN = 38,                        /* IN  */
+  YYSYMBOL_DOT = 39,                       /* DOT  */
+  YYSYMBOL_UNIQUE = 40,                    /* UNIQUE  */
+  YYSYMBOL_ON = 41,                        /* ON  */
+  YYSYMBOL_AND = 42,                       /* AND  */
+  YYSYMBOL_JOIN = 43,                      /* JOIN  */
+  YYSYMBOL_PRINT = 44,                     /* PRINT  */
+  YYSYMBOL_STATISTICS = 45,                /* STATISTICS  */
+  YYSYMBOL_CLASSES = 46,                   /* CLASSES  */
+  YYSYMBOL_HELP = 47,                      /* HELP  */
+  YYSYMBOL_COUNTT = 48,                    /* COUNTT  */
+  YYSYMBOL_SUMT = 49,                      /* SUMT  */
+  YYSYMBOL_MINT = 50,                      /* MINT  */
+  YYSYMBOL_MAXT = 51,                      /* MAXT  */
+  YYSYMBOL_AVGT = 52,                      /* AVGT  */
+  YYSYMBOL_GROUP = 53,                     /* GROUP  */
+  YYSYMBOL_BY = 54,                        /* BY  */
+  YYSYMBOL_ORDER = 55,                     /* ORDER  */
+  YYSYMBOL_ASC = 56,                       /* ASC  */
+  YYSYMBOL_DESC = 57,                      /* DESC  */
+  YYSYMBOL_LIMIT = 58,                     /* LIMIT  */
+  YYSYMBOL_ANALYZE = 59,                   /* ANALYZE  */
+  YYSYMBOL_EXPLAIN = 60,                   /* EXPLAIN  */
+  YYSYMBOL_SLOTTED = 61,                   /* SLOTTED  */
+  YYSYMBOL_PAGESIZE = 62,                  /* PAGESIZE  */
+  YYSYMBOL_NUM = 63,                       /* NUM  */
+  YYSYMBOL_REALNUM = 64,                   /* REALNUM  */
+  YYSYMBOL_DBNAME = 65,                    /* DBNAME  */
+  YYSYMBOL_STR_VALUE = 66,                 /* STR_VALUE  */
+  YYSYMBOL_YYACCEPT = 67,                  /* $accept  */
+  YYSYMBOL_start = 68,                     /* start  */
+  YYSYMBOL_commands = 69,                  /* commands  */
+  YYSYMBOL_full_command = 70,              /* full_command  */
+  YYSYMBOL_command = 71,                   /* command  */
+  YYSYMBOL_dbName = 72,                    /* dbName  */
+  YYSYMBOL_qName = 73,                     /* qName  */
+  YYSYMBOL_strValue = 74,                  /* strValue  */
+  YYSYMBOL_create_db = 75,                 /* create_db  */
+  YYSYMBOL_pagesize = 76,                  /* pagesize  */
+  YYSYMBOL_drop_db = 77,                   /* drop_db  */
+  YYSYMBOL_connect = 78,                   /* connect  */
+  YYSYMBOL_disconnect = 79,                /* disconnect  */
+  YYSYMBOL_list_tables = 80,               /* list_tables  */
+  YYSYMBOL_get_schema = 81,                /* get_schema  */
+  YYSYMBOL_create_table = 82,              /* create_table  */
+  YYSYMBOL_attrDefs = 83,                  /* attrDefs  */
+  YYSYMBOL_unique = 84,                    /* unique  */
+  YYSYMBOL_format = 85,                    /* format  */
+  YYSYMBOL_type = 86,                      /* type  */
+  YYSYMBOL_drop_table = 87,                /* drop_table  */
+  YYSYMBOL_create_index = 88,              /* create_index  */
+  YYSYMBOL_itype = 89,                     /* itype  */
+  YYSYMBOL_drop_index = 90,                /* drop_index  */
+  YYSYMBOL_insert = 91,                    /* insert  */
+  YYSYMBOL_rows = 92,                      /* rows  */
+  YYSYMBOL_value = 93,                     /* value  */
+  YYSYMBOL_vtype = 94,                     /* vtype  */
+  YYSYMBOL_delete = 95,                    /* delete  */
+  YYSYMBOL_where_clause = 96,              /* where_clause  */
+  YYSYMBOL_predicates = 97,                /* predicates  */
+  YYSYMBOL_select = 98,                    /* select  */
+  YYSYMBOL_projection = 99,                /* projection  */
+  YYSYMBOL_selectList = 100,               /* selectList  */
+  YYSYMBOL_selectItem = 101,               /* selectItem  */
+  YYSYMBOL_aggFunc = 102,                  /* aggFunc  */
+  YYSYMBOL_group_by = 103,                 /* group_by  */
+  YYSYMBOL_order_by = 104,                 /* order_by  */
+  YYSYMBOL_direction = 105,                /* direction  */
+  YYSYMBOL_limit = 106,                    /* limit  */
+  YYSYMBOL_attrList = 107,                 /* attrList  */
+  YYSYMBOL_join = 108,                     /* join  */
+  YYSYMBOL_import = 109,                   /* import  */
+  YYSYMBOL_export = 110,                   /* export  */
+  YYSYMBOL_analyze = 111,                  /* analyze  */
+  YYSYMBOL_explain = 112,                  /* explain  */
+  YYSYMBOL_explain_mode = 113,             /* explain_mode  */
+  YYSYMBOL_explainable = 114,              /* explainable  */
+  YYSYMBOL_statistics = 115,               /* statistics  */
+  YYSYMBOL_classes = 116,                  /* classes  */
+  YYSYMBOL_help = 117                      /* help  */
 };
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-int yyparse (yyscan_t scanner, DBQueryMgr& queryMgr);
-
-#endif /* !YY_YY_USERS_BZCSCHAE_WORKSPACE_DBS2_HUBDB_INCLUDE_HUBDB_DBPARSER_H_INCLUDED  */
-
 
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short yytype_uint16;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short yytype_int16;
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -244,7 +330,7 @@ typedef short yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
@@ -252,7 +338,20 @@ typedef short yytype_int16;
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -266,38 +365,43 @@ typedef short yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -310,10 +414,22 @@ typedef short yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -378,8 +494,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -388,17 +503,17 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -411,11 +526,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -427,12 +542,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -442,30 +557,33 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  62
+#define YYFINAL  76
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   137
+#define YYLAST   209
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  52
+#define YYNTOKENS  67
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  37
+#define YYNNTS  51
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  70
+#define YYNRULES  104
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  153
+#define YYNSTATES  206
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   321
 
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   306
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
-static const yytype_uint8 yytranslate[] =
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -497,229 +615,278 @@ static const yytype_uint8 yytranslate[] =
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    48,    49,    50,    51
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,    61,    61,    62,    65,    66,    67,    70,    78,    79,
-      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
-      90,    91,    92,    93,    94,    95,    98,   114,   123,   133,
-     141,   149,   157,   164,   171,   179,   188,   204,   218,   219,
-     222,   223,   224,   227,   235,   243,   244,   247,   254,   263,
-     268,   275,   279,   283,   290,   301,   305,   313,   321,   331,
-     345,   349,   355,   360,   368,   371,   381,   390,   399,   410,
-     423
+       0,    74,    74,    75,    78,    79,    80,    83,    91,    92,
+      93,    94,    95,    96,    97,    98,    99,   100,   101,   102,
+     103,   104,   105,   106,   107,   108,   109,   110,   113,   129,
+     138,   148,   157,   160,   166,   174,   182,   189,   196,   204,
+     214,   230,   244,   245,   248,   249,   252,   253,   254,   255,
+     265,   273,   281,   282,   285,   292,   304,   310,   318,   323,
+     330,   334,   338,   345,   356,   360,   368,   376,   386,   404,
+     408,   414,   419,   426,   432,   438,   450,   451,   452,   453,
+     454,   458,   461,   468,   471,   480,   483,   487,   494,   497,
+     503,   508,   516,   519,   529,   538,   547,   555,   559,   563,
+     570,   571,   574,   585,   598
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "CREATE", "DROP", "TABLE", "INSERT",
-  "INTO", "VALUES", "SELECT", "DELETE", "FROM", "WHERE", "CONNECT",
-  "DISCONNECT", "EQUALS", "STAR", "PARA_OPEN", "PARA_CLOSE", "COMMATA",
-  "SEMICOLON", "TO", "LIST", "TABLES", "IMPORT", "EXPORT", "QUIT",
-  "APOSTROPHE", "INDEX", "TYPE", "GET", "SCHEMA", "FOR", "DATABASE",
-  "INTT", "DOUBLET", "VARCHAR", "AS", "IN", "DOT", "UNIQUE", "ON", "AND",
-  "JOIN", "PRINT", "STATISTICS", "CLASSES", "HELP", "NUM", "REALNUM",
+  "\"end of file\"", "error", "\"invalid token\"", "CREATE", "DROP",
+  "TABLE", "INSERT", "INTO", "VALUES", "SELECT", "DELETE", "FROM", "WHERE",
+  "CONNECT", "DISCONNECT", "EQUALS", "STAR", "PARA_OPEN", "PARA_CLOSE",
+  "COMMATA", "SEMICOLON", "TO", "LIST", "TABLES", "IMPORT", "EXPORT",
+  "QUIT", "APOSTROPHE", "INDEX", "TYPE", "GET", "SCHEMA", "FOR",
+  "DATABASE", "INTT", "DOUBLET", "VARCHAR", "AS", "IN", "DOT", "UNIQUE",
+  "ON", "AND", "JOIN", "PRINT", "STATISTICS", "CLASSES", "HELP", "COUNTT",
+  "SUMT", "MINT", "MAXT", "AVGT", "GROUP", "BY", "ORDER", "ASC", "DESC",
+  "LIMIT", "ANALYZE", "EXPLAIN", "SLOTTED", "PAGESIZE", "NUM", "REALNUM",
   "DBNAME", "STR_VALUE", "$accept", "start", "commands", "full_command",
-  "command", "dbName", "qName", "strValue", "create_db", "drop_db",
-  "connect", "disconnect", "list_tables", "get_schema", "create_table",
-  "attrDefs", "unique", "type", "drop_table", "create_index", "itype",
-  "drop_index", "insert", "value", "vtype", "delete", "where_clause",
-  "predicates", "select", "projection", "attrList", "join", "import",
-  "export", "statistics", "classes", "help", YY_NULLPTR
+  "command", "dbName", "qName", "strValue", "create_db", "pagesize",
+  "drop_db", "connect", "disconnect", "list_tables", "get_schema",
+  "create_table", "attrDefs", "unique", "format", "type", "drop_table",
+  "create_index", "itype", "drop_index", "insert", "rows", "value",
+  "vtype", "delete", "where_clause", "predicates", "select", "projection",
+  "selectList", "selectItem", "aggFunc", "group_by", "order_by",
+  "direction", "limit", "attrList", "join", "import", "export", "analyze",
+  "explain", "explain_mode", "explainable", "statistics", "classes",
+  "help", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -119
+#define YYPACT_NINF (-142)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-119)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
-static const yytype_int8 yypact[] =
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-      45,   -15,    10,    11,     7,   -14,     9,     1,     3,    -2,
-      13,   -25,  -119,    -5,   -35,    17,    40,    90,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,  -119,   -25,
-     -25,   -25,   -25,   -25,   -25,   -25,  -119,  -119,     6,  -119,
-      36,    31,   -25,   -25,  -119,    33,    30,    39,    32,    43,
-      46,  -119,  -119,  -119,  -119,    28,    47,    48,    52,    57,
-      58,    71,   -25,   -25,   -25,    68,    61,  -119,    34,    75,
-      30,    78,  -119,  -119,    67,    30,    81,  -119,  -119,  -119,
-    -119,    70,  -119,    55,  -119,   -25,    82,  -119,    79,   -25,
-      85,   -25,   -25,  -119,  -119,    25,   -25,    68,    92,    66,
-    -119,  -119,    89,  -119,    91,   -27,    -6,  -119,  -119,  -119,
-       0,  -119,    72,    97,    25,   -25,  -119,  -119,  -119,  -119,
-    -119,    83,    98,   -25,    99,    25,   -25,  -119,  -119,   106,
-    -119,  -119,  -119,   -27,  -119,  -119,   109,    25,    83,   -25,
-    -119,  -119,  -119
+       4,    -9,    16,    51,     9,    39,    11,     6,    17,    27,
+      46,    -4,  -142,    52,   -26,    65,    -4,    42,   102,    56,
+    -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,
+    -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,
+    -142,  -142,  -142,    -4,    -4,    -4,    -4,    -4,    -4,    -4,
+    -142,  -142,  -142,  -142,  -142,  -142,  -142,    67,  -142,    96,
+      89,  -142,    95,    -4,    -4,  -142,    97,    91,    98,    88,
+     103,   104,  -142,   105,  -142,    15,  -142,  -142,  -142,    90,
+      99,    64,   109,   110,   111,   124,    -4,    -4,    44,    -7,
+     121,   114,  -142,    69,   130,    91,   133,  -142,  -142,  -142,
+    -142,  -142,  -142,   122,    91,   120,    78,   123,  -142,  -142,
+    -142,   125,  -142,   106,  -142,   127,   128,    -4,   131,  -142,
+     126,    -4,   135,    -4,    -4,  -142,  -142,  -142,  -142,   -23,
+      12,    -4,   121,  -142,  -142,   132,   108,  -142,  -142,   136,
+    -142,   137,    63,    28,  -142,  -142,  -142,    49,  -142,   141,
+    -142,   107,   112,   -23,    -4,  -142,  -142,  -142,  -142,   142,
+     129,   100,    -4,  -142,   -23,   -23,    -4,   113,   115,  -142,
+     145,   101,  -142,  -142,  -142,   143,    63,  -142,    53,   147,
+      -4,   117,   116,   -23,   148,  -142,   129,  -142,    -4,  -142,
+     149,    44,   118,   152,  -142,  -142,  -142,  -142,    -4,    18,
+    -142,  -142,  -142,  -142,  -142,  -142
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     3,     0,     0,     0,     0,     0,     5,     7,
-      10,    11,     8,     9,    12,    13,    14,    15,    16,    17,
-      18,    19,    20,    21,    22,    23,    24,    25,     6,     0,
-       0,     0,     0,     0,     0,     0,    60,    26,     0,    63,
-       0,    61,     0,     0,    32,     0,     0,     0,     0,     0,
-       0,    70,     1,     2,     4,     0,    45,     0,     0,     0,
-       0,     0,     0,     0,     0,    55,     0,    33,     0,     0,
-       0,     0,    68,    69,     0,     0,     0,    29,    43,    47,
-      30,     0,    27,    64,    62,     0,     0,    31,     0,     0,
-       0,     0,     0,    46,    44,     0,     0,    55,     0,    56,
-      54,    28,     0,    67,     0,     0,     0,    51,    52,    53,
-       0,    50,     0,     0,     0,     0,    66,    34,    40,    41,
-      42,    38,     0,     0,     0,     0,     0,    59,    58,     0,
-      39,    37,    35,     0,    48,    49,     0,     0,    38,     0,
-      57,    36,    65
+       0,     0,     3,     0,     0,     0,     0,    98,     0,     0,
+       5,     7,    10,    11,     8,     9,    12,    13,    14,    15,
+      16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
+      26,    27,     6,     0,     0,     0,     0,     0,     0,     0,
+      69,    76,    77,    78,    79,    80,    28,     0,    73,     0,
+      70,    72,     0,     0,     0,    36,     0,     0,     0,     0,
+       0,     0,   104,     0,    99,     0,     1,     2,     4,     0,
+      52,    32,     0,     0,     0,     0,     0,     0,     0,     0,
+      64,     0,    37,     0,     0,     0,     0,   102,   103,    96,
+     101,   100,    97,     0,     0,     0,     0,     0,    50,    54,
+      34,     0,    29,    92,    71,     0,     0,     0,     0,    35,
+       0,     0,     0,     0,     0,    53,    51,    33,    31,     0,
+       0,     0,    64,    75,    74,     0,    65,    63,    30,     0,
+      95,     0,     0,     0,    60,    61,    62,     0,    59,     0,
+      55,     0,    81,     0,     0,    94,    38,    46,    47,    48,
+      42,    44,     0,    57,     0,     0,     0,     0,    83,    67,
+       0,     0,    43,    41,    45,     0,     0,    58,     0,     0,
+       0,     0,    88,     0,     0,    39,    42,    56,     0,    91,
+      82,     0,     0,     0,    66,    49,    40,    93,     0,    85,
+      89,    68,    90,    86,    87,    84
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
 {
-    -119,  -119,  -119,   108,  -119,   -11,   -39,   -53,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,  -119,   -22,   -16,  -119,  -119,
-    -119,  -119,  -119,  -119,  -118,  -119,    21,  -119,  -119,  -119,
-    -119,  -119,  -119,  -119,  -119,  -119,  -119
+    -142,  -142,  -142,   154,  -142,   -10,   -44,   -52,  -142,  -142,
+    -142,  -142,  -142,  -142,  -142,  -142,  -142,   -11,  -142,     0,
+    -142,  -142,  -142,  -142,  -142,  -142,    13,  -141,   119,    45,
+    -142,   134,  -142,  -142,   -86,  -142,  -142,  -142,  -142,  -142,
+    -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,  -142,
+    -142
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    16,    17,    18,    19,    48,    49,   119,    20,    21,
-      22,    23,    24,    25,    26,   116,   141,   131,    27,    28,
-      86,    29,    30,   120,   121,    31,    96,   109,    32,    50,
-      51,   107,    33,    34,    35,    36,    37
+       0,    18,    19,    20,    21,    57,    58,   146,    22,   107,
+      23,    24,    25,    26,    27,    28,   143,   173,   175,   160,
+      29,    30,   105,    31,    32,   130,   147,   148,    33,   118,
+     136,    34,    59,    60,    61,    62,   168,   182,   205,   193,
+     190,   132,    35,    36,    37,    38,    75,   102,    39,    40,
+      41
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      57,    66,    46,    79,    69,    38,   138,   128,   129,   130,
-      59,    60,   132,   133,    45,    39,    42,   145,   134,   135,
-      52,    55,    53,    54,    56,    47,    58,   100,    65,   150,
-      67,    68,   103,    70,    71,    94,    47,    61,    40,    43,
-      62,    75,    76,    41,    44,    72,     1,    73,     2,     3,
-      74,     4,    78,    77,     5,     6,   108,    78,     7,     8,
-      80,    92,    93,    82,    81,    84,    83,     9,    87,    10,
-      11,    12,    88,   117,   118,    13,    85,    89,    90,    91,
-      95,    97,    99,   101,   102,    98,   139,   105,   112,    14,
-     114,   115,    15,     2,     3,   122,     4,   146,   106,     5,
-       6,   104,   110,     7,     8,   113,   111,   124,   125,   126,
-     152,   127,     9,   136,    10,    11,    63,   137,   142,   144,
-      13,   147,   143,   140,   149,    64,   151,   148,   123,     0,
-       0,     0,     0,     0,    14,     0,     0,    15
+      80,    68,   114,    83,    93,     1,    73,     2,     3,   115,
+       4,    42,   169,     5,     6,    94,    49,     7,     8,    70,
+      71,    43,    63,   177,     5,     6,     9,    64,    10,    11,
+      12,   149,   150,    79,    13,    81,    82,    65,    84,    85,
+     144,   145,   194,   122,    44,   116,   161,   162,    14,    45,
+      66,    15,   125,    90,    91,    50,    46,    67,    56,     2,
+       3,    56,     4,    16,    17,     5,     6,   163,   164,     7,
+       8,   187,   164,   135,   203,   204,   112,   113,     9,    47,
+      10,    11,    77,    69,    48,    72,    13,    51,    52,    53,
+      54,    55,    51,    52,    53,    54,    55,   157,   158,   159,
+      14,    74,    76,    15,    56,   199,    86,    87,    88,    56,
+     170,   139,    89,   141,   142,    16,    17,    92,    93,    95,
+      96,   151,   179,    97,    98,    99,   106,   103,   104,   108,
+     109,   110,   111,   117,   119,   120,   189,   121,   123,   124,
+     126,   127,   129,   128,   197,   133,   134,   153,   166,   131,
+     154,   137,   176,   138,   202,   140,   155,   156,   165,   171,
+     183,   174,   188,   185,   184,   167,   195,   180,   198,   172,
+     181,   191,   201,    78,   192,   196,   186,   152,   178,     0,
+       0,   200,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,   100,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   101
 };
 
 static const yytype_int16 yycheck[] =
 {
-      11,    40,    16,    56,    43,    20,   124,    34,    35,    36,
-      45,    46,    18,    19,     7,     5,     5,   135,    18,    19,
-      11,    23,    21,    20,    11,    50,    31,    80,    39,   147,
-      41,    42,    85,    44,    45,    74,    50,    20,    28,    28,
-       0,    52,    53,    33,    33,    39,     1,    11,     3,     4,
-      19,     6,    27,    20,     9,    10,    95,    27,    13,    14,
-      21,    72,    73,    20,    32,    37,    20,    22,    20,    24,
-      25,    26,    20,    48,    49,    30,    29,    20,    20,     8,
-      12,    20,     7,     5,    17,    51,   125,    17,    99,    44,
-     101,   102,    47,     3,     4,   106,     6,   136,    43,     9,
-      10,    20,    20,    13,    14,    20,    27,    15,    42,    20,
-     149,    20,    22,    41,    24,    25,    26,    20,    20,    20,
-      30,    15,   133,    40,    15,    17,   148,   143,   107,    -1,
-      -1,    -1,    -1,    -1,    44,    -1,    -1,    47
+      44,    11,    88,    47,    27,     1,    16,     3,     4,    16,
+       6,    20,   153,     9,    10,    67,     7,    13,    14,    45,
+      46,     5,    11,   164,     9,    10,    22,    21,    24,    25,
+      26,    19,    20,    43,    30,    45,    46,    20,    48,    49,
+      63,    64,   183,    95,    28,    89,    18,    19,    44,    33,
+      23,    47,   104,    63,    64,    16,     5,    11,    65,     3,
+       4,    65,     6,    59,    60,     9,    10,    18,    19,    13,
+      14,    18,    19,   117,    56,    57,    86,    87,    22,    28,
+      24,    25,    26,    31,    33,    20,    30,    48,    49,    50,
+      51,    52,    48,    49,    50,    51,    52,    34,    35,    36,
+      44,    59,     0,    47,    65,   191,    39,    11,    19,    65,
+     154,   121,    17,   123,   124,    59,    60,    20,    27,    21,
+      32,   131,   166,    20,    20,    20,    62,    37,    29,    20,
+      20,    20,     8,    12,    20,    66,   180,     7,     5,    17,
+      20,    63,    17,    20,   188,    18,    18,    15,    41,    43,
+      42,    20,   162,    27,   198,    20,    20,    20,    17,    17,
+      15,    61,    15,    20,    63,    53,    18,    54,    19,    40,
+      55,    54,    20,    19,    58,   186,   176,   132,   165,    -1,
+      -1,    63,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    75,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    75
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     1,     3,     4,     6,     9,    10,    13,    14,    22,
-      24,    25,    26,    30,    44,    47,    53,    54,    55,    56,
-      60,    61,    62,    63,    64,    65,    66,    70,    71,    73,
-      74,    77,    80,    84,    85,    86,    87,    88,    20,     5,
-      28,    33,     5,    28,    33,     7,    16,    50,    57,    58,
-      81,    82,    11,    21,    20,    23,    11,    57,    31,    45,
-      46,    20,     0,    26,    55,    57,    58,    57,    57,    58,
-      57,    57,    39,    11,    19,    57,    57,    20,    27,    59,
-      21,    32,    20,    20,    37,    29,    72,    20,    20,    20,
-      20,     8,    57,    57,    58,    12,    78,    20,    51,     7,
-      59,     5,    17,    59,    20,    17,    43,    83,    58,    79,
-      20,    27,    57,    20,    57,    57,    67,    48,    49,    59,
-      75,    76,    57,    78,    15,    42,    20,    20,    34,    35,
-      36,    69,    18,    19,    18,    19,    41,    20,    76,    58,
-      40,    68,    20,    57,    20,    76,    58,    15,    69,    15,
-      76,    68,    58
+      24,    25,    26,    30,    44,    47,    59,    60,    68,    69,
+      70,    71,    75,    77,    78,    79,    80,    81,    82,    87,
+      88,    90,    91,    95,    98,   109,   110,   111,   112,   115,
+     116,   117,    20,     5,    28,    33,     5,    28,    33,     7,
+      16,    48,    49,    50,    51,    52,    65,    72,    73,    99,
+     100,   101,   102,    11,    21,    20,    23,    11,    72,    31,
+      45,    46,    20,    72,    59,   113,     0,    26,    70,    72,
+      73,    72,    72,    73,    72,    72,    39,    11,    19,    17,
+      72,    72,    20,    27,    74,    21,    32,    20,    20,    20,
+      95,    98,   114,    37,    29,    89,    62,    76,    20,    20,
+      20,     8,    72,    72,   101,    16,    73,    12,    96,    20,
+      66,     7,    74,     5,    17,    74,    20,    63,    20,    17,
+      92,    43,   108,    18,    18,    73,    97,    20,    27,    72,
+      20,    72,    72,    83,    63,    64,    74,    93,    94,    19,
+      20,    72,    96,    15,    42,    20,    20,    34,    35,    36,
+      86,    18,    19,    18,    19,    17,    41,    53,   103,    94,
+      73,    17,    40,    84,    61,    85,    72,    94,    93,    73,
+      54,    55,   104,    15,    63,    20,    86,    18,    15,    73,
+     107,    54,    58,   106,    94,    18,    84,    73,    19,   101,
+      63,    20,    73,    56,    57,   105
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,    52,    53,    53,    54,    54,    54,    55,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    57,    58,    59,    60,
-      61,    62,    63,    64,    65,    66,    67,    67,    68,    68,
-      69,    69,    69,    70,    71,    72,    72,    73,    74,    75,
-      75,    76,    76,    76,    77,    78,    78,    79,    79,    80,
-      81,    81,    82,    82,    83,    83,    84,    85,    86,    87,
-      88
+       0,    67,    68,    68,    69,    69,    69,    70,    71,    71,
+      71,    71,    71,    71,    71,    71,    71,    71,    71,    71,
+      71,    71,    71,    71,    71,    71,    71,    71,    72,    73,
+      74,    75,    76,    76,    77,    78,    79,    80,    81,    82,
+      83,    83,    84,    84,    85,    85,    86,    86,    86,    86,
+      87,    88,    89,    89,    90,    91,    92,    92,    93,    93,
+      94,    94,    94,    95,    96,    96,    97,    97,    98,    99,
+      99,   100,   100,   101,   101,   101,   102,   102,   102,   102,
+     102,   103,   103,   104,   104,   105,   105,   105,   106,   106,
+     107,   107,   108,   108,   109,   110,   111,   112,   113,   113,
+     114,   114,   115,   116,   117
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     2,     1,     2,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     3,     3,     4,
-       4,     4,     2,     3,     6,     8,     5,     3,     0,     1,
-       1,     1,     1,     4,     5,     0,     2,     4,     8,     3,
-       1,     1,     1,     1,     5,     0,     2,     5,     3,     7,
-       1,     1,     3,     1,     0,     6,     6,     5,     3,     3,
-       2
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
+       3,     5,     0,     2,     4,     4,     2,     3,     6,     9,
+       5,     3,     0,     1,     0,     1,     1,     1,     1,     4,
+       4,     5,     0,     2,     4,     6,     5,     3,     3,     1,
+       1,     1,     1,     5,     0,     2,     5,     3,    10,     1,
+       1,     3,     1,     1,     4,     4,     1,     1,     1,     1,
+       1,     0,     3,     0,     4,     0,     1,     1,     0,     2,
+       3,     1,     0,     6,     6,     5,     3,     3,     0,     1,
+       1,     1,     3,     3,     2
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -741,10 +908,9 @@ static const yytype_uint8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -761,19 +927,16 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, scanner, queryMgr); \
+                  Kind, Value, scanner, queryMgr); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -784,20 +947,17 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, yyscan_t scanner, DBQueryMgr& queryMgr)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, DBQueryMgr& queryMgr)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (scanner);
-  YYUSE (queryMgr);
+  YY_USE (yyoutput);
+  YY_USE (scanner);
+  YY_USE (queryMgr);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -807,12 +967,13 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, yy
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, yyscan_t scanner, DBQueryMgr& queryMgr)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, yyscan_t scanner, DBQueryMgr& queryMgr)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yytype, yyvaluep, scanner, queryMgr);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner, queryMgr);
   YYFPRINTF (yyo, ")");
 }
 
@@ -822,7 +983,7 @@ yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, yyscan_t
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -845,21 +1006,21 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, int yyrule, yyscan_t scanner, DBQueryMgr& queryMgr)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, yyscan_t scanner, DBQueryMgr& queryMgr)
 {
-  unsigned long yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                                              , scanner, queryMgr);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner, queryMgr);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -874,8 +1035,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -898,255 +1059,35 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
 
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            else
-              goto append;
-
-          append:
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return (YYSIZE_T) (yystpcpy (yyres, yystr) - yyres);
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
-    }
-
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-    default: /* Avoid compiler warnings. */
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
-
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
-  }
-
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, yyscan_t scanner, DBQueryMgr& queryMgr)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, yyscan_t scanner, DBQueryMgr& queryMgr)
 {
-  YYUSE (yyvaluep);
-  YYUSE (scanner);
-  YYUSE (queryMgr);
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
+  YY_USE (queryMgr);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1154,7 +1095,7 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, yyscan_t scanner,
 int
 yyparse (yyscan_t scanner, DBQueryMgr& queryMgr)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1165,45 +1106,38 @@ YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
 YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    YYSIZE_T yystacksize;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1211,16 +1145,10 @@ YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
 
@@ -1234,36 +1162,39 @@ yynewstate:
 
 
 /*--------------------------------------------------------------------.
-| yynewstate -- set current state (the top of the stack) to yystate.  |
+| yysetstate -- set current state (the top of the stack) to yystate.  |
 `--------------------------------------------------------------------*/
 yysetstate:
   YYDPRINTF ((stderr, "Entering state %d\n", yystate));
   YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
-  *yyssp = (yytype_int16) yystate;
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = (YYSIZE_T) (yyssp - yyss + 1);
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
 # if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
 
         /* Each stack pointer address is followed by the size of the
            data in use in that stack, in bytes.  This used to be a
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
                     &yystacksize);
         yyss = yyss1;
         yyvs = yyvs1;
@@ -1271,20 +1202,21 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1293,14 +1225,17 @@ yysetstate:
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1321,18 +1256,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1360,14 +1306,13 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1402,37 +1347,37 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 61 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { YYACCEPT; }
-#line 1409 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 2: /* start: commands QUIT  */
+#line 74 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                     { YYACCEPT; }
+#line 1354 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 3:
-#line 62 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { YYACCEPT; }
-#line 1415 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 3: /* start: QUIT  */
+#line 75 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+            { YYACCEPT; }
+#line 1360 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 6:
-#line 67 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {yyerrok; queryMgr.getSocket()->getWriteStream()<<endl; queryMgr.getSocket()->writeToSocket();}
-#line 1421 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 6: /* commands: error SEMICOLON  */
+#line 80 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                          {yyerrok; queryMgr.setExplainMode(DBQueryMgr::EXPLAIN_NONE); queryMgr.getSocket()->getWriteStream()<<endl; queryMgr.getSocket()->writeToSocket();}
+#line 1366 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 7:
-#line 71 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
+  case 7: /* full_command: command  */
+#line 84 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        {
 		queryMgr.getSocket()->getWriteStream()<<endl;
 		queryMgr.getSocket()->writeToSocket();
 		HubDB::Server::DBServer::checkAbortStatus();
 	}
-#line 1431 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1376 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 26:
-#line 99 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
+  case 28: /* dbName: DBNAME  */
+#line 114 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                {
 			if(strlen((yyvsp[0].str))>MAX_STR_LEN){
 				queryMgr.getSocket()->getWriteStream() << "string is too large" <<endl;
 				YYERROR;
@@ -1445,103 +1390,120 @@ yyreduce:
                 ++i;
             }
 		}
-#line 1449 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1394 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 27:
-#line 115 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
+  case 29: /* qName: dbName DOT dbName  */
+#line 130 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                {
 			strcpy((yyval.qName).relationName,(yyvsp[-2].str));
 			free((yyvsp[-2].str));
 			strcpy((yyval.qName).attributeName,(yyvsp[0].str));
 			free((yyvsp[0].str));
 		}
-#line 1460 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1405 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 28:
-#line 124 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
+  case 30: /* strValue: APOSTROPHE STR_VALUE APOSTROPHE  */
+#line 139 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                {
 			(yyval.str)=(yyvsp[-1].str);
-			if(strlen((yyval.str))>MAX_STR_LEN){
+			if(strlen((yyval.str))>MAX_VCHAR_LEN){
 				queryMgr.getSocket()->getWriteStream() << "string is too large" <<endl;
 				YYERROR;
 			}
 		}
-#line 1472 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1417 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 29:
-#line 134 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
-		LOG4CXX_DEBUG(loggerParser,(string)"create database " + (yyvsp[-1].str) );
-		queryMgr.createDB((yyvsp[-1].str));
-        free((yyvsp[-1].str));
+  case 31: /* create_db: CREATE DATABASE dbName pagesize SEMICOLON  */
+#line 149 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        {
+		LOG4CXX_DEBUG(loggerParser,(string)"create database " + (yyvsp[-2].str) );
+		queryMgr.createDB((yyvsp[-2].str),(yyvsp[-1].num));
+        free((yyvsp[-2].str));
 	}
-#line 1482 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1427 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 32: /* pagesize: %empty  */
+#line 157 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.num) = STD_BLOCKSIZE;
+    }
+#line 1435 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 30:
-#line 142 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 33: /* pagesize: PAGESIZE NUM  */
+#line 161 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
+        (yyval.num) = (yyvsp[0].num);
+    }
+#line 1443 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 34: /* drop_db: DROP DATABASE dbName SEMICOLON  */
+#line 167 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        {
 		LOG4CXX_DEBUG(loggerParser,(string)"drop database " + (yyvsp[-1].str) );
 		queryMgr.dropDB((yyvsp[-1].str));
         free((yyvsp[-1].str));
 	}
-#line 1492 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1453 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 31:
-#line 150 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
+  case 35: /* connect: CONNECT TO dbName SEMICOLON  */
+#line 175 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        {
 		LOG4CXX_DEBUG(loggerParser,(string)"connect to " + (yyvsp[-1].str) );
 		queryMgr.connectTo((yyvsp[-1].str));
         free((yyvsp[-1].str));
 	}
-#line 1502 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1463 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 32:
-#line 158 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {
+  case 36: /* disconnect: DISCONNECT SEMICOLON  */
+#line 183 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        {
 		LOG4CXX_DEBUG(loggerParser,"disconnect");
 		queryMgr.disconnect();
 	}
-#line 1511 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1472 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 33:
-#line 165 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 37: /* list_tables: LIST TABLES SEMICOLON  */
+#line 190 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,"list tables " );
         queryMgr.listTables();
     }
-#line 1520 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1481 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 34:
-#line 172 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 38: /* get_schema: GET SCHEMA FOR TABLE dbName SEMICOLON  */
+#line 197 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"get schema for tables " + (yyvsp[-1].str) );
         queryMgr.getSchemaForTable((yyvsp[-1].str));
         free((yyvsp[-1].str));
     }
-#line 1530 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1491 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 35:
-#line 180 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 39: /* create_table: CREATE TABLE dbName AS PARA_OPEN attrDefs PARA_CLOSE format SEMICOLON  */
+#line 205 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
-	    strcpy((yyvsp[-2].relDef).relationName,(yyvsp[-5].str));
-        LOG4CXX_DEBUG(loggerParser,(string)"create table\n"+TO_STR(&(yyvsp[-2].relDef))); 
-        queryMgr.createTable((yyvsp[-2].relDef));
-        free((yyvsp[-5].str));
+	    strcpy((yyvsp[-3].relDef).relationName,(yyvsp[-6].str));
+	    (yyvsp[-3].relDef).isSlotted = (yyvsp[-1].flag);
+        LOG4CXX_DEBUG(loggerParser,(string)"create table\n"+TO_STR(&(yyvsp[-3].relDef))); 
+        queryMgr.createTable((yyvsp[-3].relDef));
+        free((yyvsp[-6].str));
     }
-#line 1541 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1503 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 36:
-#line 189 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 40: /* attrDefs: attrDefs COMMATA dbName type unique  */
+#line 215 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.relDef) = (yyvsp[-4].relDef);
     	if((yyval.relDef).attrCnt == MAX_ATTR_PER_REL){
@@ -1557,11 +1519,11 @@ yyreduce:
         (yyval.relDef).attrList[(yyval.relDef).attrCnt++] = (yyvsp[-1].attrDef);
         (yyval.relDef).tupleSize += (yyvsp[-1].attrDef).attrLen;
     }
-#line 1561 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1523 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 37:
-#line 205 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 41: /* attrDefs: dbName type unique  */
+#line 231 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.relDef).attrCnt = 0;
         (yyval.relDef).tupleSize = (yyvsp[-1].attrDef).attrLen;
@@ -1573,136 +1535,183 @@ yyreduce:
         free((yyvsp[-2].str));
         (yyval.relDef).attrList[(yyval.relDef).attrCnt++] = (yyvsp[-1].attrDef);
     }
-#line 1577 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1539 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 38:
-#line 218 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { (yyval.flag)=false; }
-#line 1583 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 42: /* unique: %empty  */
+#line 244 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        { (yyval.flag)=false; }
+#line 1545 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 39:
-#line 219 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { (yyval.flag)=true;}
-#line 1589 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 43: /* unique: UNIQUE  */
+#line 245 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                   { (yyval.flag)=true;}
+#line 1551 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 40:
-#line 222 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { (yyval.attrDef).attrType = INT; (yyval.attrDef).attrLen = DBIntType::getSize(); }
-#line 1595 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 44: /* format: %empty  */
+#line 248 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        { (yyval.flag)=false; }
+#line 1557 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 41:
-#line 223 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { (yyval.attrDef).attrType = DOUBLE; (yyval.attrDef).attrLen = DBDoubleType::getSize();}
-#line 1601 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 45: /* format: SLOTTED  */
+#line 249 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                    { (yyval.flag)=true;}
+#line 1563 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 42:
-#line 224 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {  (yyval.attrDef).attrType = VCHAR; (yyval.attrDef).attrLen = DBVCharType::getSize(); }
-#line 1607 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 46: /* type: INTT  */
+#line 252 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+           { (yyval.attrDef).attrType = INT; (yyval.attrDef).attrLen = DBIntType::getSize(); }
+#line 1569 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 43:
-#line 228 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 47: /* type: DOUBLET  */
+#line 253 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                  { (yyval.attrDef).attrType = DOUBLE; (yyval.attrDef).attrLen = DBDoubleType::getSize();}
+#line 1575 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 48: /* type: VARCHAR  */
+#line 254 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                  {  (yyval.attrDef).attrType = VCHAR; (yyval.attrDef).attrLen = DBVCharType::getSize(); }
+#line 1581 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 49: /* type: VARCHAR PARA_OPEN NUM PARA_CLOSE  */
+#line 256 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                {
+			if((yyvsp[-1].num)<1 || (uint)(yyvsp[-1].num)>MAX_VCHAR_LEN){
+				queryMgr.getSocket()->getWriteStream() << "invalid VARCHAR length" <<endl;
+				YYERROR;
+			}
+			(yyval.attrDef).attrType = VCHAR; (yyval.attrDef).attrLen = (yyvsp[-1].num);
+		}
+#line 1593 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 50: /* drop_table: DROP TABLE dbName SEMICOLON  */
+#line 266 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"drop table " + (yyvsp[-1].str));
         queryMgr.dropTable((yyvsp[-1].str));
         free((yyvsp[-1].str));
     }
-#line 1617 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1603 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 44:
-#line 236 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 51: /* create_index: CREATE INDEX qName itype SEMICOLON  */
+#line 274 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"create index " + (yyvsp[-2].qName).toString() + " TYPE " + (yyvsp[-1].str) );
         queryMgr.createIndex((yyvsp[-2].qName),(yyvsp[-1].str));
         free((yyvsp[-1].str));
     }
-#line 1627 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1613 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 45:
-#line 243 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    { (yyval.str)=strdup(DEFAULT_IDXTYPE.c_str());}
-#line 1633 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 52: /* itype: %empty  */
+#line 281 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+       { (yyval.str)=strdup(DEFAULT_IDXTYPE.c_str());}
+#line 1619 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 46:
-#line 244 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
-    {(yyval.str)=(yyvsp[0].str);}
-#line 1639 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+  case 53: /* itype: TYPE strValue  */
+#line 282 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                     {(yyval.str)=(yyvsp[0].str);}
+#line 1625 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 47:
-#line 248 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 54: /* drop_index: DROP INDEX qName SEMICOLON  */
+#line 286 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"drop index " + (yyvsp[-1].qName).toString());
         queryMgr.dropIndex((yyvsp[-1].qName));
     }
+#line 1634 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 55: /* insert: INSERT INTO dbName VALUES rows SEMICOLON  */
+#line 293 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+       LOG4CXX_DEBUG(loggerParser,(string)"insert into " + (yyvsp[-3].str) + " " + TO_STR((yyvsp[-1].listTuple)->size()) + " row(s)");
+       if((yyvsp[-1].listTuple)->size() == 1)
+           queryMgr.insertInto((yyvsp[-3].str),&(yyvsp[-1].listTuple)->front());
+       else
+           queryMgr.insertInto((yyvsp[-3].str),(yyvsp[-1].listTuple));
+       free((yyvsp[-3].str));
+       delete (yyvsp[-1].listTuple);
+    }
 #line 1648 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 48:
-#line 255 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 56: /* rows: rows COMMATA PARA_OPEN value PARA_CLOSE  */
+#line 305 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
-       LOG4CXX_DEBUG(loggerParser,(string)"insert into " + (yyvsp[-5].str) + " value(" + (yyvsp[-2].tupleT)->toString() + ")");
-       queryMgr.insertInto((yyvsp[-5].str),(yyvsp[-2].tupleT));
-       free((yyvsp[-5].str));
-       delete (yyvsp[-2].tupleT);
+        (yyval.listTuple) = (yyvsp[-4].listTuple);
+        (yyval.listTuple)->push_back(*(yyvsp[-1].tupleT));
+        delete (yyvsp[-1].tupleT);
     }
-#line 1659 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1658 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 49:
-#line 264 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 57: /* rows: PARA_OPEN value PARA_CLOSE  */
+#line 311 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.listTuple) = new DBListTuple();
+        (yyval.listTuple)->push_back(*(yyvsp[-1].tupleT));
+        delete (yyvsp[-1].tupleT);
+    }
+#line 1668 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 58: /* value: value COMMATA vtype  */
+#line 319 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.tupleT) = (yyvsp[-2].tupleT);
         (yyval.tupleT)->appendAttrVal((yyvsp[0].valT));
     }
-#line 1668 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1677 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 50:
-#line 269 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 59: /* value: vtype  */
+#line 324 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.tupleT) = new DBTuple();
         (yyval.tupleT)->appendAttrVal((yyvsp[0].valT));
     }
-#line 1677 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1686 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 51:
-#line 276 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 60: /* vtype: NUM  */
+#line 331 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.valT) = new DBIntType((yyvsp[0].num));
     }
-#line 1685 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1694 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 52:
-#line 280 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 61: /* vtype: REALNUM  */
+#line 335 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.valT) = new DBDoubleType((yyvsp[0].realnum));
     }
-#line 1693 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1702 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 53:
-#line 284 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 62: /* vtype: strValue  */
+#line 339 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.valT) = new DBVCharType((yyvsp[0].str));
         free((yyvsp[0].str));
     }
-#line 1702 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1711 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 54:
-#line 291 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 63: /* delete: DELETE FROM dbName where_clause SEMICOLON  */
+#line 346 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"delete from " + (yyvsp[-2].str) + ((yyvsp[-1].listPredicate)!=NULL ? " where " + TO_STR(*(yyvsp[-1].listPredicate)) : ""));
         queryMgr.deleteFromTable((yyvsp[-2].str),(yyvsp[-1].listPredicate));
@@ -1710,29 +1719,29 @@ yyreduce:
         if((yyvsp[-1].listPredicate)!=NULL)
             delete (yyvsp[-1].listPredicate);
     }
-#line 1714 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1723 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 55:
-#line 301 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 64: /* where_clause: %empty  */
+#line 356 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
     	LOG4CXX_DEBUG(loggerParser,"where is null");
         (yyval.listPredicate) = NULL;
     }
-#line 1723 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1732 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 56:
-#line 306 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 65: /* where_clause: WHERE predicates  */
+#line 361 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
     	LOG4CXX_DEBUG(loggerParser,"where: " + TO_STR((yyvsp[0].listPredicate)));    
     	(yyval.listPredicate) = (yyvsp[0].listPredicate);
     }
-#line 1732 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1741 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 57:
-#line 314 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 66: /* predicates: predicates AND qName EQUALS vtype  */
+#line 369 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.listPredicate) = (yyvsp[-4].listPredicate);
         DBPredicate p((yyvsp[0].valT),(yyvsp[-2].qName));
@@ -1740,11 +1749,11 @@ yyreduce:
         (yyval.listPredicate)->push_back(p);
         LOG4CXX_DEBUG(loggerParser,"PredicateList is"+ TO_STR(*(yyval.listPredicate)))
     }
-#line 1744 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1753 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 58:
-#line 322 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 67: /* predicates: qName EQUALS vtype  */
+#line 377 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.listPredicate) = new DBListPredicate();
         DBPredicate p((yyvsp[0].valT),(yyvsp[-2].qName));
@@ -1752,69 +1761,229 @@ yyreduce:
         (yyval.listPredicate)->push_back(p);
         LOG4CXX_DEBUG(loggerParser,"PredicateList is "+ TO_STR((yyval.listPredicate))+ " "+ TO_STR(*(yyval.listPredicate)))
     }
-#line 1756 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1765 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 59:
-#line 332 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 68: /* select: SELECT projection FROM dbName join where_clause group_by order_by limit SEMICOLON  */
+#line 387 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
-        LOG4CXX_DEBUG(loggerParser,"select " + ((yyvsp[-5].listString)!=NULL ? TO_STR((yyvsp[-5].listString)) : "*") + " from " + (yyvsp[-3].str) + " " + ((yyvsp[-2].join)!=NULL ? (yyvsp[-2].join)->toString() : "") + " " + ((yyvsp[-1].listPredicate)!=NULL ? "where " + TO_STR(*(yyvsp[-1].listPredicate)) : ""));
-        queryMgr.select((yyvsp[-5].listString),(yyvsp[-3].str),(yyvsp[-2].join),(yyvsp[-1].listPredicate));
-        free((yyvsp[-3].str));
-        if((yyvsp[-5].listString)!=NULL)
-            delete (yyvsp[-5].listString);
-        if((yyvsp[-2].join)!=NULL)
-            delete (yyvsp[-2].join);
-        if((yyvsp[-1].listPredicate)!=NULL)
-            delete (yyvsp[-1].listPredicate); 
+        LOG4CXX_DEBUG(loggerParser,"select " + ((yyvsp[-8].listSelect)!=NULL ? TO_STR((yyvsp[-8].listSelect)) : "*") + " from " + (yyvsp[-6].str) + " " + ((yyvsp[-5].join)!=NULL ? (yyvsp[-5].join)->toString() : "") + " " + ((yyvsp[-4].listPredicate)!=NULL ? "where " + TO_STR(*(yyvsp[-4].listPredicate)) : "") + ((yyvsp[-3].listString)!=NULL ? " group by " + TO_STR((yyvsp[-3].listString)) : "") + ((yyvsp[-2].orderBy)!=NULL ? " order by " + (yyvsp[-2].orderBy)->item.toString() : "") + ((yyvsp[-1].num)>=0 ? " limit " + TO_STR((yyvsp[-1].num)) : ""));
+        queryMgr.select((yyvsp[-8].listSelect),(yyvsp[-6].str),(yyvsp[-5].join),(yyvsp[-4].listPredicate),(yyvsp[-3].listString),(yyvsp[-2].orderBy),(yyvsp[-1].num));
+        free((yyvsp[-6].str));
+        if((yyvsp[-8].listSelect)!=NULL)
+            delete (yyvsp[-8].listSelect);
+        if((yyvsp[-5].join)!=NULL)
+            delete (yyvsp[-5].join);
+        if((yyvsp[-4].listPredicate)!=NULL)
+            delete (yyvsp[-4].listPredicate); 
+        if((yyvsp[-3].listString)!=NULL)
+            delete (yyvsp[-3].listString);
+        if((yyvsp[-2].orderBy)!=NULL)
+            delete (yyvsp[-2].orderBy);
     }
-#line 1772 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1785 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 60:
-#line 346 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 69: /* projection: STAR  */
+#line 405 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.listSelect) = NULL;
+    }
+#line 1793 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 70: /* projection: selectList  */
+#line 409 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.listSelect) = (yyvsp[0].listSelect);
+    }
+#line 1801 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 71: /* selectList: selectList COMMATA selectItem  */
+#line 415 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.listSelect) = (yyvsp[-2].listSelect);
+        (yyval.listSelect)->push_back((yyvsp[0].selectItem));
+    }
+#line 1810 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 72: /* selectList: selectItem  */
+#line 420 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.listSelect) = new DBListSelectItem;
+        (yyval.listSelect)->push_back((yyvsp[0].selectItem));
+    }
+#line 1819 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 73: /* selectItem: qName  */
+#line 427 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.selectItem).func = AGG_NONE;
+        (yyval.selectItem).star = false;
+        (yyval.selectItem).name = (yyvsp[0].qName);
+    }
+#line 1829 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 74: /* selectItem: aggFunc PARA_OPEN qName PARA_CLOSE  */
+#line 433 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.selectItem).func = (yyvsp[-3].aggFunc);
+        (yyval.selectItem).star = false;
+        (yyval.selectItem).name = (yyvsp[-1].qName);
+    }
+#line 1839 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 75: /* selectItem: aggFunc PARA_OPEN STAR PARA_CLOSE  */
+#line 439 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        if((yyvsp[-3].aggFunc)!=AGG_COUNT){
+            queryMgr.getSocket()->getWriteStream() << "* is only allowed in COUNT(*)" <<endl;
+            YYERROR;
+        }
+        (yyval.selectItem).func = (yyvsp[-3].aggFunc);
+        (yyval.selectItem).star = true;
+        memset(&(yyval.selectItem).name,0,sizeof((yyval.selectItem).name));
+    }
+#line 1853 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 76: /* aggFunc: COUNTT  */
+#line 450 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                { (yyval.aggFunc) = AGG_COUNT; }
+#line 1859 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 77: /* aggFunc: SUMT  */
+#line 451 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                  { (yyval.aggFunc) = AGG_SUM; }
+#line 1865 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 78: /* aggFunc: MINT  */
+#line 452 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                  { (yyval.aggFunc) = AGG_MIN; }
+#line 1871 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 79: /* aggFunc: MAXT  */
+#line 453 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                  { (yyval.aggFunc) = AGG_MAX; }
+#line 1877 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 80: /* aggFunc: AVGT  */
+#line 454 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+                  { (yyval.aggFunc) = AGG_AVG; }
+#line 1883 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 81: /* group_by: %empty  */
+#line 458 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.listString) = NULL;
     }
-#line 1780 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1891 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 61:
-#line 350 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 82: /* group_by: GROUP BY attrList  */
+#line 462 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.listString) = (yyvsp[0].listString);
     }
-#line 1788 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1899 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 62:
-#line 356 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 83: /* order_by: %empty  */
+#line 468 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.orderBy) = NULL;
+    }
+#line 1907 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 84: /* order_by: ORDER BY selectItem direction  */
+#line 472 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.orderBy) = new DBOrderBy;
+        (yyval.orderBy)->item = (yyvsp[-1].selectItem);
+        (yyval.orderBy)->desc = (yyvsp[0].flag);
+    }
+#line 1917 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 85: /* direction: %empty  */
+#line 480 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.flag) = false;
+    }
+#line 1925 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 86: /* direction: ASC  */
+#line 484 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.flag) = false;
+    }
+#line 1933 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 87: /* direction: DESC  */
+#line 488 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.flag) = true;
+    }
+#line 1941 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 88: /* limit: %empty  */
+#line 494 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.num) = -1;
+    }
+#line 1949 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 89: /* limit: LIMIT NUM  */
+#line 498 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        (yyval.num) = (yyvsp[0].num);
+    }
+#line 1957 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 90: /* attrList: attrList COMMATA qName  */
+#line 504 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.listString) = (yyvsp[-2].listString);
         (yyval.listString)->push_back((yyvsp[0].qName));
     }
-#line 1797 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1966 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 63:
-#line 361 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 91: /* attrList: qName  */
+#line 509 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.listString) = new DBListQualifiedName;
         (yyval.listString)->push_back((yyvsp[0].qName));
     }
-#line 1806 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1975 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 64:
-#line 368 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 92: /* join: %empty  */
+#line 516 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.join) = NULL;
     }
-#line 1814 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1983 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 65:
-#line 372 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 93: /* join: JOIN dbName ON qName EQUALS qName  */
+#line 520 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         (yyval.join) = new DBJoin;
 		strcpy((yyval.join)->relationName,(yyvsp[-4].str));
@@ -1822,34 +1991,62 @@ yyreduce:
         (yyval.join)->attrNames[0] = (yyvsp[-2].qName);
         (yyval.join)->attrNames[1] = (yyvsp[0].qName);        
     }
-#line 1826 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 1995 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 66:
-#line 382 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 94: /* import: IMPORT FROM strValue INTO dbName SEMICOLON  */
+#line 530 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"import from " + (yyvsp[-3].str) + " into " + (yyvsp[-1].str));
         queryMgr.importTab((yyvsp[-3].str),(yyvsp[-1].str));
         free((yyvsp[-3].str));
         free((yyvsp[-1].str));
     }
-#line 1837 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 2006 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 67:
-#line 391 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 95: /* export: EXPORT dbName TO strValue SEMICOLON  */
+#line 539 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"export " + (yyvsp[-3].str) + " to " + (yyvsp[-1].str));
         queryMgr.exportTab((yyvsp[-3].str),(yyvsp[-1].str));
         free((yyvsp[-3].str));
         free((yyvsp[-1].str));
     }
-#line 1848 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 2017 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 68:
-#line 400 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 96: /* analyze: ANALYZE dbName SEMICOLON  */
+#line 548 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
+        LOG4CXX_DEBUG(loggerParser,(string)"analyze " + (yyvsp[-1].str));
+        queryMgr.analyzeTable((yyvsp[-1].str));
+        free((yyvsp[-1].str));
+    }
+#line 2027 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 98: /* explain_mode: %empty  */
+#line 559 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        LOG4CXX_DEBUG(loggerParser,(string)"explain");
+        queryMgr.setExplainMode(DBQueryMgr::EXPLAIN_PLAN);
+    }
+#line 2036 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 99: /* explain_mode: ANALYZE  */
+#line 564 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+    {
+        LOG4CXX_DEBUG(loggerParser,(string)"explain analyze");
+        queryMgr.setExplainMode(DBQueryMgr::EXPLAIN_ANALYZE);
+    }
+#line 2045 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+    break;
+
+  case 102: /* statistics: PRINT STATISTICS SEMICOLON  */
+#line 575 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+        {
 		LOG4CXX_DEBUG(loggerParser,(string)"print statistics");
 		if(DBMonitorMgr::getMonitorPtr() != NULL){
 			DBMonitorMgr::getMonitorPtr()->printStatistic(queryMgr.getSocket()->getWriteStream());
@@ -1857,11 +2054,11 @@ yyreduce:
 			queryMgr.getSocket()->getWriteStream() << "Monitoring is not enabled"<<endl;
 		}
 	}
-#line 1861 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 2058 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 69:
-#line 411 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 103: /* classes: PRINT CLASSES SEMICOLON  */
+#line 586 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"print classes");
         queryMgr.getSocket()->getWriteStream() << "----------KnownClasses----------" <<endl;
@@ -1873,38 +2070,43 @@ yyreduce:
         }
         queryMgr.getSocket()->getWriteStream() << "   " << cnt << " row(s) selected."<<endl;
     }
-#line 1877 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 2074 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
-  case 70:
-#line 424 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+  case 104: /* help: HELP SEMICOLON  */
+#line 599 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
     {
         LOG4CXX_DEBUG(loggerParser,(string)"help");
         queryMgr.getSocket()->getWriteStream() << "HELP:" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tCREATE DATABASE <dbname>" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tCREATE DATABASE <dbname> [PAGESIZE <bytes>]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\t\t<bytes>: power of two from " << STD_BLOCKSIZE << " to " << MAX_BLOCKSIZE << ", default " << STD_BLOCKSIZE <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDROP DATABASE <dbname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tCONNECT TO <dbname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDISCONNECT" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tLIST TABLES" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tGET SCHEMA FOR TABLE <tabname>" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tCREATE TABLE <tabname> AS ( <attrname> {INTEGER|DOUBLE|VARCHAR} [UNIQUE] {,<attrname> {INTEGER|DOUBLE|VARCHAR} [UNIQUE]}*)" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tCREATE TABLE <tabname> AS ( <attrname> <type> [UNIQUE] {,<attrname> <type> [UNIQUE]}*) [SLOTTED]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\t\t<type>: INTEGER | DOUBLE | VARCHAR | VARCHAR(n), n > " << MAX_STR_LEN << " only SLOTTED" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDROP TABLE <tabname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tCREATE INDEX <tabname>.<attrname> [TYPE '<idxclassname>']" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDROP INDEX <tabname>.<attrname>" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tINSERT INTO <tabname> VALUES (x,y,z,..)" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tINSERT INTO <tabname> VALUES (x,y,z,..) {,(x,y,z,..)}*" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDELETE FROM <tabname> [WHERE <tabname>.<attrname> = value {AND <tabname>.<attrname> = value}*]" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tSELECT {*|<tabname>.<attrname>{,<tabname>.<attrname>}*} FROM <tabname> [JOIN <tabname> ON <tabname>.<attrname> = <tabname>.<attrname>] [WHERE <tabname>.<attrname> = value {AND <tabname>.<attrname> = value}*]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tSELECT {*|<item>{,<item>}*} FROM <tabname> [JOIN <tabname> ON <tabname>.<attrname> = <tabname>.<attrname>] [WHERE <tabname>.<attrname> = value {AND <tabname>.<attrname> = value}*] [GROUP BY <tabname>.<attrname>{,<tabname>.<attrname>}*] [ORDER BY <item> [ASC|DESC]] [LIMIT n]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\t\t<item>: <tabname>.<attrname> | {COUNT|SUM|MIN|MAX|AVG}(<tabname>.<attrname>) | COUNT(*)" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tIMPORT FROM '<filename>' INTO <tabname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tEXPORT <tabname> TO '<filename>'" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tANALYZE <tabname>" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tEXPLAIN [ANALYZE] {SELECT ...|DELETE ...}" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tPRINT STATISTICS" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tPRINT CLASSES" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tHELP" <<endl;
     }
-#line 1904 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 2106 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
     break;
 
 
-#line 1908 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
+#line 2110 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.cpp"
 
       default: break;
     }
@@ -1919,11 +2121,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
@@ -1947,50 +2148,14 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (scanner, queryMgr, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (scanner, queryMgr, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2023,6 +2188,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2039,13 +2205,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2059,7 +2226,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, scanner, queryMgr);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner, queryMgr);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2071,7 +2238,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2082,7 +2249,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2090,24 +2257,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (scanner, queryMgr, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2123,20 +2288,18 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, scanner, queryMgr);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner, queryMgr);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 449 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+
+#line 629 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
 
 
 void extyyerror(const char *str,DBQueryMgr & queryMgr)
@@ -1,5 +1,6 @@
 
 %define api.pure full
+%define api.header.include {<hubDB/DBParser.h>}
 %parse-param {yyscan_t scanner} {DBQueryMgr& queryMgr}
 %lex-param {yyscan_t scanner}
 
@@ -32,7 +33,12 @@ YY_DECL ;
   RelDefStruct relDef;
   DBAttrType * valT;
   DBTuple * tupleT;
+  DBListTuple * listTuple;
   DBListQualifiedName * listString;
+  DBSelectItem selectItem;
+  DBListSelectItem * listSelect;
+  AggFuncEnum aggFunc;
+  DBOrderBy * orderBy;
   DBListPredicate * listPredicate;
   DBJoin * join;
 };
@@ -41,19 +47,26 @@ YY_DECL ;
 %token DISCONNECT EQUALS STAR PARA_OPEN PARA_CLOSE COMMATA SEMICOLON TO LIST
 %token TABLES IMPORT EXPORT QUIT APOSTROPHE INDEX TYPE GET SCHEMA FOR DATABASE
 %token INTT DOUBLET VARCHAR AS IN DOT UNIQUE ON AND JOIN PRINT STATISTICS CLASSES
-%token HELP
+%token HELP COUNTT SUMT MINT MAXT AVGT GROUP BY ORDER ASC DESC LIMIT ANALYZE
+%token EXPLAIN SLOTTED PAGESIZE
 %token <num>  NUM
 %token <realnum> REALNUM
 %token <str> DBNAME STR_VALUE
 
 %type <str> strValue itype dbName
 %type <qName> qName
-%type <flag> unique
+%type <flag> unique direction format
 %type <attrDef> type
 %type <relDef> attrDefs
 %type <valT> vtype
 %type <tupleT> value
-%type <listString> attrList projection
+%type <listTuple> rows
+%type <listString> attrList group_by
+%type <listSelect> projection selectList
+%type <selectItem> selectItem
+%type <aggFunc> aggFunc
+%type <orderBy> order_by
+%type <num> limit pagesize
 %type <listPredicate> predicates where_clause
 %type <join> join
 %%
@@ -64,7 +77,7 @@ start: commands QUIT { YYACCEPT; }
 
 commands: commands full_command
         | full_command
-        | error SEMICOLON {yyerrok; queryMgr.getSocket()->getWriteStream()<<endl; queryMgr.getSocket()->writeToSocket();}
+        | error SEMICOLON {yyerrok; queryMgr.setExplainMode(DBQueryMgr::EXPLAIN_NONE); queryMgr.getSocket()->getWriteStream()<<endl; queryMgr.getSocket()->writeToSocket();}
 ;
 
 full_command: command
@@ -90,6 +103,8 @@ command: connect
      | select
      | import
      | export
+     | analyze
+     | explain
      | statistics
      | classes
      | help
@@ -123,21 +138,31 @@ qName: dbName DOT dbName
 strValue: APOSTROPHE STR_VALUE APOSTROPHE
 		{
 			$$=$2;
-			if(strlen($$)>MAX_STR_LEN){
+			if(strlen($$)>MAX_VCHAR_LEN){
 				queryMgr.getSocket()->getWriteStream() << "string is too large" <<endl;
 				YYERROR;
 			}
 		}
 ;
 
-create_db: CREATE DATABASE dbName SEMICOLON
+create_db: CREATE DATABASE dbName pagesize SEMICOLON
 	{
 		LOG4CXX_DEBUG(loggerParser,(string)"create database " + $3 );
-		queryMgr.createDB($3);
+		queryMgr.createDB($3,$4);
         free($3);
 	}
 ;
 
+pagesize:
+    {
+        $$ = STD_BLOCKSIZE;
+    }
+		| PAGESIZE NUM
+    {
+        $$ = $2;
+    }
+;
+
 drop_db: DROP DATABASE dbName SEMICOLON
 	{
 		LOG4CXX_DEBUG(loggerParser,(string)"drop database " + $3 );
@@ -176,9 +201,10 @@ get_schema: GET SCHEMA FOR TABLE dbName SEMICOLON
     }
 ;
 
-create_table: CREATE TABLE dbName AS PARA_OPEN attrDefs PARA_CLOSE SEMICOLON
+create_table: CREATE TABLE dbName AS PARA_OPEN attrDefs PARA_CLOSE format SEMICOLON
     {
 	    strcpy($6.relationName,$3);
+	    $6.isSlotted = $8;
         LOG4CXX_DEBUG(loggerParser,(string)"create table\n"+TO_STR(&$6)); 
         queryMgr.createTable($6);
         free($3);
@@ -219,9 +245,21 @@ unique: { $$=false; }
 	  | UNIQUE { $$=true;}
 ;
 
+format: { $$=false; }
+	  | SLOTTED { $$=true;}
+;
+
 type: INTT { $$.attrType = INT; $$.attrLen = DBIntType::getSize(); }
 	| DOUBLET { $$.attrType = DOUBLE; $$.attrLen = DBDoubleType::getSize();}
 	| VARCHAR {  $$.attrType = VCHAR; $$.attrLen = DBVCharType::getSize(); }
+	| VARCHAR PARA_OPEN NUM PARA_CLOSE
+		{
+			if($3<1 || (uint)$3>MAX_VCHAR_LEN){
+				queryMgr.getSocket()->getWriteStream() << "invalid VARCHAR length" <<endl;
+				YYERROR;
+			}
+			$$.attrType = VCHAR; $$.attrLen = $3;
+		}
 ;
 
 drop_table: DROP TABLE dbName SEMICOLON
@@ -251,12 +289,29 @@ drop_index: DROP INDEX qName SEMICOLON
     }
 ;
 
-insert: INSERT INTO dbName VALUES PARA_OPEN value PARA_CLOSE SEMICOLON
+insert: INSERT INTO dbName VALUES rows SEMICOLON
     {
-       LOG4CXX_DEBUG(loggerParser,(string)"insert into " + $3 + " value(" + $6->toString() + ")");
-       queryMgr.insertInto($3,$6);
+       LOG4CXX_DEBUG(loggerParser,(string)"insert into " + $3 + " " + TO_STR($5->size()) + " row(s)");
+       if($5->size() == 1)
+           queryMgr.insertInto($3,&$5->front());
+       else
+           queryMgr.insertInto($3,$5);
        free($3);
-       delete $6;
+       delete $5;
+    }
+;
+
+rows: rows COMMATA PARA_OPEN value PARA_CLOSE
+    {
+        $$ = $1;
+        $$->push_back(*$4);
+        delete $4;
+    }
+     | PARA_OPEN value PARA_CLOSE
+    {
+        $$ = new DBListTuple();
+        $$->push_back(*$2);
+        delete $2;
     }
 ;
 
@@ -328,10 +383,10 @@ predicates: predicates AND qName EQUALS vtype
     }
 ;
 
-select: SELECT projection FROM dbName join where_clause SEMICOLON
+select: SELECT projection FROM dbName join where_clause group_by order_by limit SEMICOLON
     {
-        LOG4CXX_DEBUG(loggerParser,"select " + ($2!=NULL ? TO_STR($2) : "*") + " from " + $4 + " " + ($5!=NULL ? $5->toString() : "") + " " + ($6!=NULL ? "where " + TO_STR(*$6) : ""));
-        queryMgr.select($2,$4,$5,$6);
+        LOG4CXX_DEBUG(loggerParser,"select " + ($2!=NULL ? TO_STR($2) : "*") + " from " + $4 + " " + ($5!=NULL ? $5->toString() : "") + " " + ($6!=NULL ? "where " + TO_STR(*$6) : "") + ($7!=NULL ? " group by " + TO_STR($7) : "") + ($8!=NULL ? " order by " + $8->item.toString() : "") + ($9>=0 ? " limit " + TO_STR($9) : ""));
+        queryMgr.select($2,$4,$5,$6,$7,$8,$9);
         free($4);
         if($2!=NULL)
             delete $2;
@@ -339,6 +394,10 @@ select: SELECT projection FROM dbName join where_clause SEMICOLON
             delete $5;
         if($6!=NULL)
             delete $6; 
+        if($7!=NULL)
+            delete $7;
+        if($8!=NULL)
+            delete $8;
     }
 ;
 
@@ -346,12 +405,101 @@ projection: STAR
     {
         $$ = NULL;
     }
-		  | attrList
+		  | selectList
     {
         $$ = $1;
     }
 ;
 
+selectList: selectList COMMATA selectItem
+    {
+        $$ = $1;
+        $$->push_back($3);
+    }
+		  | selectItem
+    {
+        $$ = new DBListSelectItem;
+        $$->push_back($1);
+    }
+;
+
+selectItem: qName
+    {
+        $$.func = AGG_NONE;
+        $$.star = false;
+        $$.name = $1;
+    }
+		  | aggFunc PARA_OPEN qName PARA_CLOSE
+    {
+        $$.func = $1;
+        $$.star = false;
+        $$.name = $3;
+    }
+		  | aggFunc PARA_OPEN STAR PARA_CLOSE
+    {
+        if($1!=AGG_COUNT){
+            queryMgr.getSocket()->getWriteStream() << "* is only allowed in COUNT(*)" <<endl;
+            YYERROR;
+        }
+        $$.func = $1;
+        $$.star = true;
+        memset(&$$.name,0,sizeof($$.name));
+    }
+;
+
+aggFunc: COUNTT { $$ = AGG_COUNT; }
+	   | SUMT { $$ = AGG_SUM; }
+	   | MINT { $$ = AGG_MIN; }
+	   | MAXT { $$ = AGG_MAX; }
+	   | AVGT { $$ = AGG_AVG; }
+;
+
+group_by:
+    {
+        $$ = NULL;
+    }
+		| GROUP BY attrList
+    {
+        $$ = $3;
+    }
+;
+
+order_by:
+    {
+        $$ = NULL;
+    }
+		| ORDER BY selectItem direction
+    {
+        $$ = new DBOrderBy;
+        $$->item = $3;
+        $$->desc = $4;
+    }
+;
+
+direction:
+    {
+        $$ = false;
+    }
+		| ASC
+    {
+        $$ = false;
+    }
+		| DESC
+    {
+        $$ = true;
+    }
+;
+
+limit:
+    {
+        $$ = -1;
+    }
+		| LIMIT NUM
+    {
+        $$ = $2;
+    }
+;
+
 attrList: attrList COMMATA qName
     {
         $$ = $1;
@@ -396,6 +544,33 @@ export: EXPORT dbName TO strValue SEMICOLON
     }
 ;
 
+analyze: ANALYZE dbName SEMICOLON
+    {
+        LOG4CXX_DEBUG(loggerParser,(string)"analyze " + $2);
+        queryMgr.analyzeTable($2);
+        free($2);
+    }
+;
+
+explain: EXPLAIN explain_mode explainable
+;
+
+explain_mode: /* empty */
+    {
+        LOG4CXX_DEBUG(loggerParser,(string)"explain");
+        queryMgr.setExplainMode(DBQueryMgr::EXPLAIN_PLAN);
+    }
+    | ANALYZE
+    {
+        LOG4CXX_DEBUG(loggerParser,(string)"explain analyze");
+        queryMgr.setExplainMode(DBQueryMgr::EXPLAIN_ANALYZE);
+    }
+;
+
+explainable: select
+    | delete
+;
+
 statistics:	PRINT STATISTICS SEMICOLON
 	{
 		LOG4CXX_DEBUG(loggerParser,(string)"print statistics");
@@ -424,21 +599,26 @@ help: HELP SEMICOLON
     {
         LOG4CXX_DEBUG(loggerParser,(string)"help");
         queryMgr.getSocket()->getWriteStream() << "HELP:" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tCREATE DATABASE <dbname>" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tCREATE DATABASE <dbname> [PAGESIZE <bytes>]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\t\t<bytes>: power of two from " << STD_BLOCKSIZE << " to " << MAX_BLOCKSIZE << ", default " << STD_BLOCKSIZE <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDROP DATABASE <dbname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tCONNECT TO <dbname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDISCONNECT" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tLIST TABLES" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tGET SCHEMA FOR TABLE <tabname>" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tCREATE TABLE <tabname> AS ( <attrname> {INTEGER|DOUBLE|VARCHAR} [UNIQUE] {,<attrname> {INTEGER|DOUBLE|VARCHAR} [UNIQUE]}*)" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tCREATE TABLE <tabname> AS ( <attrname> <type> [UNIQUE] {,<attrname> <type> [UNIQUE]}*) [SLOTTED]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\t\t<type>: INTEGER | DOUBLE | VARCHAR | VARCHAR(n), n > " << MAX_STR_LEN << " only SLOTTED" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDROP TABLE <tabname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tCREATE INDEX <tabname>.<attrname> [TYPE '<idxclassname>']" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDROP INDEX <tabname>.<attrname>" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tINSERT INTO <tabname> VALUES (x,y,z,..)" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tINSERT INTO <tabname> VALUES (x,y,z,..) {,(x,y,z,..)}*" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tDELETE FROM <tabname> [WHERE <tabname>.<attrname> = value {AND <tabname>.<attrname> = value}*]" <<endl;
-        queryMgr.getSocket()->getWriteStream() << "\tSELECT {*|<tabname>.<attrname>{,<tabname>.<attrname>}*} FROM <tabname> [JOIN <tabname> ON <tabname>.<attrname> = <tabname>.<attrname>] [WHERE <tabname>.<attrname> = value {AND <tabname>.<attrname> = value}*]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tSELECT {*|<item>{,<item>}*} FROM <tabname> [JOIN <tabname> ON <tabname>.<attrname> = <tabname>.<attrname>] [WHERE <tabname>.<attrname> = value {AND <tabname>.<attrname> = value}*] [GROUP BY <tabname>.<attrname>{,<tabname>.<attrname>}*] [ORDER BY <item> [ASC|DESC]] [LIMIT n]" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\t\t<item>: <tabname>.<attrname> | {COUNT|SUM|MIN|MAX|AVG}(<tabname>.<attrname>) | COUNT(*)" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tIMPORT FROM '<filename>' INTO <tabname>" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tEXPORT <tabname> TO '<filename>'" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tANALYZE <tabname>" <<endl;
+        queryMgr.getSocket()->getWriteStream() << "\tEXPLAIN [ANALYZE] {SELECT ...|DELETE ...}" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tPRINT STATISTICS" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tPRINT CLASSES" <<endl;
         queryMgr.getSocket()->getWriteStream() << "\tHELP" <<endl;
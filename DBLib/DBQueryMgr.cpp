@@ -1,6 +1,8 @@
 #include <hubDB/DBQueryMgr.h>
 #include <hubDB/DBTable.h>
 #include <hubDB/DBIndex.h>
+#include <hubDB/DBBulkLoad.h>
+#include <hubDB/DBImportParser.h>
 #include <hubDB/DBException.h>
 
 using namespace HubDB::Exception;
@@ -17,7 +19,8 @@ DBQueryMgr::DBQueryMgr(DBServerSocket &socket, DBSysCatMgr &sysCatMgr) :
         sysCatMgr(sysCatMgr),
         connectDB(""),
         isConnected(false),
-        sysCatHdl(NULL) {
+        sysCatHdl(NULL),
+        explainMode(EXPLAIN_NONE) {
   if (logger != NULL) LOG4CXX_INFO(logger, "DBQueryMgr()");
 }
 
@@ -52,11 +55,12 @@ void DBQueryMgr::process() {
   }
 }
 
-void DBQueryMgr::createDB(char *dbName) {
+void DBQueryMgr::createDB(char *dbName, uint blockSize) {
   LOG4CXX_INFO(logger, "createDB()");
   LOG4CXX_DEBUG(logger, (string) "dbName: " + dbName);
+  LOG4CXX_DEBUG(logger, "blockSize: " + TO_STR(blockSize));
   try {
-    sysCatMgr.createDB(dbName);
+    sysCatMgr.createDB(dbName, blockSize);
     socket.getWriteStream() << "DB created" << endl;
   } catch (DBException e) {
     LOG4CXX_ERROR(logger, e.what());
@@ -150,7 +154,7 @@ void DBQueryMgr::getSchemaForTable(char *table) {
       DBAttrDef adef = def.attrDef(i);
       socket.getWriteStream() << adef.attrName() << "\t";
       socket.getWriteStream() << adef.attrPos() << "\t";
-      socket.getWriteStream() << DBAttrType::getName4Type(adef.attrType()) << "\t";
+      socket.getWriteStream() << DBAttrType::getName4Type(adef.attrType(), adef.attrLen()) << "\t";
       socket.getWriteStream() << adef.attrLen() << "\t";
       socket.getWriteStream() << boolalpha << adef.isUnique() << "\t";
       socket.getWriteStream() << boolalpha << adef.isIndexed() << "\t";
@@ -197,15 +201,52 @@ void DBQueryMgr::createIndex(const QualifiedName &qname, char *type) {
   LOG4CXX_DEBUG(logger, (string) "qname: " + qname.toString());
   LOG4CXX_DEBUG(logger, (string) "type: " + type);
 
-  DBTable *table = NULL;
-  DBIndex *index = NULL;
-
+  string oldType;
+  bool dropped = false;
+  bool created = false;
   try {
     LOG4CXX_DEBUG(logger, "create index");
     if (!isConnected)
       throw DBQueryMgrNoConnectionException();
+    // unique attributes always have an index, CREATE INDEX only chooses its type
+    const DBRelDef &def = sysCatMgr.getSchemaForTable(connectDB, qname.relationName);
+    for (uint i = 0; i < def.attrCnt(); ++i) {
+      DBAttrDef attr = def.attrDef(i);
+      if (attr.attrName().compare(qname.attributeName) == 0 && attr.isUnique() == true && attr.isIndexed() == true) {
+        oldType = attr.indexType();
+        sysCatMgr.dropIndex(connectDB, qname);
+        dropped = true;
+      }
+    }
     sysCatMgr.createIndex(connectDB, qname, type);
+    created = true;
+    fillIndex(qname);
+    socket.getWriteStream() << "Index created" << endl;
+  } catch (DBException e) {
+    LOG4CXX_ERROR(logger, e.what());
+    socket.getWriteStream() << e.what() << endl;
+    // the index file has a fixed name, so the old index of a unique attribute is rebuilt
+    if (dropped == true) {
+      try {
+        if (created == true)
+          sysCatMgr.dropIndex(connectDB, qname);
+        sysCatMgr.createIndex(connectDB, qname, oldType);
+        fillIndex(qname);
+      } catch (DBException e) {
+        LOG4CXX_ERROR(logger, e.what());
+      }
+    }
+  }
+}
 
+void DBQueryMgr::fillIndex(const QualifiedName &qname) {
+  LOG4CXX_INFO(logger, "fillIndex()");
+  LOG4CXX_DEBUG(logger, (string) "qname: " + qname.toString());
+
+  DBTable *table = NULL;
+  DBIndex *index = NULL;
+
+  try {
     LOG4CXX_DEBUG(logger, "open table");
     table = sysCatMgr.openTable(connectDB, qname.relationName, READ);
 
@@ -241,15 +282,15 @@ void DBQueryMgr::createIndex(const QualifiedName &qname, char *type) {
         ++i;
       }
     } while (l.size() == 100);
-    socket.getWriteStream() << "Index created" << endl;
   } catch (DBException e) {
-    LOG4CXX_ERROR(logger, e.what());
-    socket.getWriteStream() << e.what() << endl;
+    if (index != NULL)
+      delete index;
+    if (table != NULL)
+      delete table;
+    throw e;
   }
-  if (index != NULL)
-    delete index;
-  if (table != NULL)
-    delete table;
+  delete index;
+  delete table;
 }
 
 void DBQueryMgr::dropIndex(const QualifiedName &qname) {
@@ -259,6 +300,12 @@ void DBQueryMgr::dropIndex(const QualifiedName &qname) {
   try {
     if (!isConnected)
       throw DBQueryMgrNoConnectionException();
+    const DBRelDef &def = sysCatMgr.getSchemaForTable(connectDB, qname.relationName);
+    for (uint i = 0; i < def.attrCnt(); ++i) {
+      DBAttrDef attr = def.attrDef(i);
+      if (attr.attrName().compare(qname.attributeName) == 0 && attr.isUnique() == true)
+        throw DBQueryMgrException("index of unique attribute can not be dropped");
+    }
     sysCatMgr.dropIndex(connectDB, qname);
     socket.getWriteStream() << "Index dropped" << endl;
   } catch (DBException &e) {
@@ -276,6 +323,7 @@ bool DBQueryMgr::insertInto(char *tableName, DBTuple *value, bool print) {
   DBIndex *index = NULL;
   bool undo = false;
   bool rc = true;
+  list<uint> indexed;
   try {
     if (!isConnected)
       throw DBQueryMgrNoConnectionException();
@@ -284,11 +332,7 @@ bool DBQueryMgr::insertInto(char *tableName, DBTuple *value, bool print) {
     table = sysCatMgr.openTable(connectDB, tableName, WRITE);
 
     const DBRelDef &relDef = table->getRelDef();
-    for (uint i = 0; i < relDef.attrCnt(); ++i) {
-      DBAttrDef attr = relDef.attrDef(i);
-      if (value->getAttrVal(i).type() != attr.attrType())
-        throw DBQueryMgrException("Type missmatch");
-    }
+    checkValues(relDef, *value);
     LOG4CXX_DEBUG(logger, "insert val in table values:\n" + value->toString("\t"));
     table->insert(*value);
     LOG4CXX_DEBUG(logger, "values:\n" + value->toString("\t"));
@@ -305,6 +349,7 @@ bool DBQueryMgr::insertInto(char *tableName, DBTuple *value, bool print) {
         LOG4CXX_DEBUG(logger, "tid: " + value->getTID().toString());
 
         index->insert(value->getAttrVal(i), value->getTID());
+        indexed.push_back(i);
         LOG4CXX_DEBUG(logger, "delete index");
         delete index;
         index = NULL;
@@ -317,6 +362,20 @@ bool DBQueryMgr::insertInto(char *tableName, DBTuple *value, bool print) {
     if (undo == true) {
       DBListTID l;
       l.push_back(value->getTID());
+      // a later unique index may have failed, the earlier ones already hold the TID
+      if (index != NULL) {
+        delete index;
+        index = NULL;
+      }
+      for (list<uint>::iterator i = indexed.begin(); i != indexed.end(); ++i) {
+        QualifiedName qname;
+        strcpy(qname.relationName, tableName);
+        strcpy(qname.attributeName, table->getRelDef().attrDef(*i).attrName().c_str());
+        index = sysCatMgr.openIndex(connectDB, qname, WRITE);
+        index->remove(value->getAttrVal(*i), l);
+        delete index;
+        index = NULL;
+      }
       table->remove(l);
     }
     LOG4CXX_ERROR(logger, e.what());
@@ -332,12 +391,63 @@ bool DBQueryMgr::insertInto(char *tableName, DBTuple *value, bool print) {
   return rc;
 }
 
+bool DBQueryMgr::insertInto(char *tableName, DBListTuple *values, bool print) {
+  LOG4CXX_INFO(logger, "insertInto()");
+  LOG4CXX_DEBUG(logger, (string) "tableName: " + tableName);
+  LOG4CXX_DEBUG(logger, "values: " + TO_STR(values->size()));
+
+  DBBulkLoad *load = NULL;
+  bool rc = true;
+  try {
+    if (!isConnected)
+      throw DBQueryMgrNoConnectionException();
+
+    LOG4CXX_DEBUG(logger, "open table");
+    load = new DBBulkLoad(sysCatMgr, connectDB, tableName);
+    for (DBListTuple::iterator t = values->begin(); t != values->end(); ++t)
+      checkValues(load->getRelDef(), *t);
+    try {
+      for (DBListTuple::iterator t = values->begin(); t != values->end(); ++t)
+        load->append(*t);
+      load->finish();
+    } catch (DBException &e) {
+      load->rollback(*values);
+      throw e;
+    }
+    if (print == true)
+      socket.getWriteStream() << "   " << load->getCnt() << " row(s) inserted." << endl;
+  } catch (DBException &e) {
+    LOG4CXX_ERROR(logger, e.what());
+    socket.getWriteStream() << e.what() << endl;
+    rc = false;
+  }
+  if (load != NULL)
+    delete load;
+  return rc;
+}
+
+void DBQueryMgr::checkValues(const DBRelDef &relDef, const DBTuple &value) {
+  for (uint i = 0; i < relDef.attrCnt(); ++i) {
+    DBAttrDef attr = relDef.attrDef(i);
+    if (value.getAttrVal(i).type() != attr.attrType())
+      throw DBQueryMgrException("Type missmatch");
+    if (attr.attrType() == VCHAR && ((const DBVCharType &) value.getAttrVal(i)).getVal().size() > attr.attrLen())
+      throw DBQueryMgrException("value too long for " + attr.attrName());
+  }
+}
+
 void DBQueryMgr::deleteFromTable(char *tableName, DBListPredicate *where) {
   LOG4CXX_INFO(logger, "deleteFromTable()");
   LOG4CXX_DEBUG(logger, (string) "tableName: " + tableName);
 
+  ExplainModeEnum explain = explainMode;
+  explainMode = EXPLAIN_NONE;
+  DBProfile planning(sysCatMgr);
+  DBProfile execution(sysCatMgr);
+  planning.start();
+
   DBTable *table = NULL;
-  DBIndex *index = NULL;
+  DBOperator *op = NULL;
   try {
     if (!isConnected)
       throw DBQueryMgrNoConnectionException();
@@ -345,7 +455,6 @@ void DBQueryMgr::deleteFromTable(char *tableName, DBListPredicate *where) {
     LOG4CXX_DEBUG(logger, "open table");
     table = sysCatMgr.openTable(connectDB, tableName, WRITE);
 
-    const DBRelDef &relDef = table->getRelDef();
     DBListTuple tupleList;
 
     LOG4CXX_DEBUG(logger, "select tuples");
@@ -353,9 +462,52 @@ void DBQueryMgr::deleteFromTable(char *tableName, DBListPredicate *where) {
 
     if (where == NULL)
       where = &tmp;
-    selectTuple(table, *where, tupleList);
+    op = scanOperator(table, *where);
+    if (explain == EXPLAIN_ANALYZE)
+      DBProfileOp::instrument(op, sysCatMgr);
+    planning.stop();
+
+    uint cnt = 0;
+    stringstream plan;
+    if (explain != EXPLAIN_PLAN) {
+      execution.start();
+      DBListJoinTuple rows;
+      op->fetchAll(rows);
+      DBOperator::fromRows(rows, tupleList);
+    }
+    // the scan releases its indexes before they are opened for writing
+    if (explain != EXPLAIN_NONE)
+      op->explainTree(plan, "  ");
+    delete op;
+    op = NULL;
+    if (explain != EXPLAIN_PLAN) {
+      cnt = removeTuples(table, tableName, where, tupleList);
+      execution.stop();
+    }
+    if (explain == EXPLAIN_NONE) {
+      socket.getWriteStream() << "   " << cnt << " row(s) deleted." << endl;
+    } else {
+      string root = (string) "Delete from " + tableName;
+      if (explain == EXPLAIN_ANALYZE)
+        root += "  (rows: " + TO_STR(cnt) + ", " + execution.describe() + ")";
+      printPlan(explain, root + "\n" + plan.str(), planning, execution);
+    }
+  } catch (DBException &e) {
+    LOG4CXX_ERROR(logger, e.what());
+    socket.getWriteStream() << e.what() << endl;
+  }
+  if (op != NULL)
+    delete op;
+  if (table != NULL)
+    delete table;
+}
 
-    DBListTID l;
+uint DBQueryMgr::removeTuples(DBTable *table, char *tableName, DBListPredicate *where, DBListTuple &tupleList) {
+  LOG4CXX_INFO(logger, "removeTuples()");
+  const DBRelDef &relDef = table->getRelDef();
+  DBIndex *index = NULL;
+  DBListTID l;
+  try {
     DBListTuple::iterator i = tupleList.begin();
     while (i != tupleList.end()) {
       l.push_back(i->getTID());
@@ -391,7 +543,7 @@ void DBQueryMgr::deleteFromTable(char *tableName, DBListPredicate *where) {
           } else {
             if (where == NULL) {
               string type = attr.indexType();
-              dropIndex(qname);
+              sysCatMgr.dropIndex(connectDB, qname);
               LOG4CXX_DEBUG(logger, "create index");
               sysCatMgr.createIndex(connectDB, qname, type);
             } else {
@@ -411,88 +563,76 @@ void DBQueryMgr::deleteFromTable(char *tableName, DBListPredicate *where) {
         }
       }
     }
-    uint cnt = l.size();
     table->remove(l);
-    socket.getWriteStream() << "   " << cnt << " row(s) deleted." << endl;
-  } catch (DBException &e) {
-    LOG4CXX_ERROR(logger, e.what());
-    socket.getWriteStream() << e.what() << endl;
+  } catch (DBException e) {
+    if (index != NULL)
+      delete index;
+    throw e;
   }
-  if (index != NULL)
-    delete index;
-  if (table != NULL)
-    delete table;
+  return l.size();
 }
 
 void DBQueryMgr::importTab(char *fileName, char *table) {
   LOG4CXX_INFO(logger, "importTab()");
   LOG4CXX_DEBUG(logger, (string) "fileName: " + fileName);
   LOG4CXX_DEBUG(logger, (string) "table: " + table);
-  FILE *file = NULL;
+  DBImportParser *parser = NULL;
+  DBBulkLoad *load = NULL;
   try {
     if (!isConnected)
       throw DBQueryMgrNoConnectionException();
     const DBRelDef &def = sysCatMgr.getSchemaForTable(connectDB, table);
-    file = fopen(fileName, "r");
-    if (file == NULL)
-      throw DBSystemException(errno);
+    parser = new DBImportParser(fileName, def);
+    load = new DBBulkLoad(sysCatMgr, connectDB, table);
 
     LOG4CXX_DEBUG(logger, (string) "file is open");
-    DataImport data[MAX_ATTR_PER_REL];
-    void *ptr[MAX_ATTR_PER_REL];
-    uint cnt = def.attrCnt();
-
-    char iline[100];
-    iline[0] = '\0';
-
-    for (uint i = 0; i < cnt; ++i) {
-      if (i > 0)
-        strcat(iline, "\t");
-      switch (def.attrDef(i).attrType()) {
-        case INT:
-          strcat(iline, "%d");
-          ptr[i] = &data[i].i;
-          break;
-        case DOUBLE:
-          strcat(iline, "%lg");
-          ptr[i] = &data[i].d;
-          break;
-        case VCHAR:
-          strcat(iline, "%32s");
-          ptr[i] = &data[i].c[0];
-          break;
-        default:
-          throw DBException("unknow attribute type " + def.attrDef(i).attrType());
-      }
-    }
-    LOG4CXX_DEBUG(logger, iline);
-
-    errno = 0;
-    int rc = 0;
     uint rcnt = 0, gcnt = 0;
-
-    while (cnt ==
-           (rc = fscanf(file, iline, ptr[0], ptr[1], ptr[2], ptr[3], ptr[4], ptr[5], ptr[6], ptr[7], ptr[8], ptr[9]))) {
-      DBTuple *t = new DBTuple();
-      for (uint i = 0; i < cnt; ++i) {
-        DBAttrType *attr = DBAttrType::import(data[i], def.attrDef(i).attrType());
-        t->appendAttrVal(attr);
-        delete attr;
+    DBListTuple tuples;
+    DBListTuple unindexed;  // appended rows whose index entries are not all inserted yet
+
+    try {
+      while (parser->next(tuples) == true) {
+        for (DBListTuple::iterator t = tuples.begin(); t != tuples.end(); ++t) {
+          uint appended = load->getCnt();
+          try {
+            load->append(*t);
+          } catch (DBIndexUniqueKeyException &e) {
+            // a duplicate is rejected before it is appended, the import goes on
+            if (load->getCnt() != appended)
+              throw;
+            LOG4CXX_ERROR(logger, e.what());
+            socket.getWriteStream() << e.what() << endl;
+            ++gcnt;
+            continue;
+          } catch (DBException &e) {
+            // the row may be appended before the index entries failed
+            if (load->getCnt() != appended)
+              unindexed.push_back(*t);
+            throw;
+          }
+          unindexed.push_back(*t);
+          while (unindexed.size() > load->getUnindexedCnt())
+            unindexed.pop_front();
+          ++rcnt;
+          ++gcnt;
+        }
       }
-      if (insertInto(table, t, false) == true)
-        ++rcnt;
-      delete t;
-      ++gcnt;
+      load->finish();
+    } catch (DBException &e) {
+      // the rows up to the last complete index flush stay imported
+      LOG4CXX_DEBUG(logger, "roll back " + TO_STR(unindexed.size()) + " row(s)");
+      load->rollback(unindexed, load->getCnt() - min(load->getCnt(), (uint) unindexed.size()));
+      throw;
     }
-    if (errno != 0) // for scanf
-      throw DBSystemException(errno);
     socket.getWriteStream() << "   " << rcnt << " from " << gcnt << " row(s) imported." << endl;
   } catch (DBException &e) {
     LOG4CXX_ERROR(logger, e.what());
     socket.getWriteStream() << e.what() << endl;
   }
-  if (file != NULL)
-    fclose(file);
+  if (load != NULL)
+    delete load;
+  if (parser != NULL)
+    delete parser;
 }
 
 void DBQueryMgr::exportTab(char *relName, char *fileName) {
@@ -541,7 +681,83 @@ void DBQueryMgr::exportTab(char *relName, char *fileName) {
     delete table;
 }
 
-void DBQueryMgr::select(DBListQualifiedName *projection, char *relName, DBJoin *join, DBListPredicate *where) {
+void DBQueryMgr::analyzeTable(char *relName) {
+  LOG4CXX_INFO(logger, "analyzeTable()");
+  LOG4CXX_DEBUG(logger, (string) "relName: " + relName);
+
+  DBTable *table = NULL;
+  DBOperator *op = NULL;
+  try {
+    if (!isConnected)
+      throw DBQueryMgrNoConnectionException();
+    table = sysCatMgr.openTable(connectDB, relName, READ);
+    const DBRelDef &def = table->getRelDef();
+
+    // one pass over the table
+    DBStatsCollector collector(def);
+    DBListPredicate where;
+    op = new DBScanOp(*table, where);
+    DBListJoinTuple rows;
+    op->open();
+    while (op->next(rows) == true) {
+      for (DBListJoinTuple::iterator i = rows.begin(); i != rows.end(); ++i)
+        collector.add((*i).first);
+    }
+    op->close();
+
+    DBTableStats stats;
+    collector.finish(table->getPageCnt(), stats);
+    sysCatMgr.writeStatistics(connectDB, relName, stats);
+
+    socket.getWriteStream() << "Table analyzed: " << stats.rowCnt << " row(s), " << stats.pageCnt << " page(s)" << endl;
+    for (uint i = 0; i < def.attrCnt(); ++i)
+      socket.getWriteStream() << "\t" << def.attrDef(i).attrName() << ": " << stats.attrs[i].distinct << " distinct" << endl;
+  } catch (DBException e) {
+    LOG4CXX_ERROR(logger, e.what());
+    socket.getWriteStream() << e.what() << endl;
+  }
+  if (op != NULL)
+    delete op;
+  if (table != NULL)
+    delete table;
+}
+
+/**
+ * Resolves a qualified attribute name to the input side and its position
+ * @return false if it belongs to neither table
+ */
+static bool resolveAttr(DBRelDef *def[2], const QualifiedName &name, pair<uint, uint> &p) {
+  for (uint i = 0; i < 2 && def[i] != NULL; ++i) {
+    if (def[i]->relationName().compare(name.relationName) == 0) {
+      p.first = i;
+      p.second = def[i]->attrDef(name.attributeName).attrPos();
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Builds the aggregate of a select item resolved to side and position p
+ */
+static DBAggregate makeAggregate(DBRelDef *def[2], const DBSelectItem &item, const pair<uint, uint> &p) {
+  DBAggregate a;
+  a.func = item.func;
+  a.side = p.first;
+  a.pos = p.second;
+  a.type = (item.star == true) ? NONE : def[p.first]->attrDef(p.second).attrType();
+  if ((a.func == AGG_SUM || a.func == AGG_AVG) && a.type == VCHAR)
+    throw DBQueryMgrException((string) "numeric attribute required: " + item.toString());
+  return a;
+}
+
+void DBQueryMgr::select(DBListSelectItem *projection,
+                        char *relName,
+                        DBJoin *join,
+                        DBListPredicate *where,
+                        DBListQualifiedName *groupBy,
+                        DBOrderBy *orderBy,
+                        int limit) {
   LOG4CXX_INFO(logger, "select()");
 
   DBTable *table[2] = {NULL, NULL};
@@ -550,9 +766,24 @@ void DBQueryMgr::select(DBListQualifiedName *projection, char *relName, DBJoin *
   list<pair<uint, uint> > proList;
   const uint left = 0;
   const uint right = 1;
+  const uint aggSide = 2; // proList entry refers to aggList
   DBListPredicate whereJoin[2];
   list<string> proStr;
-  DBListJoinTuple l;
+  list<pair<uint, uint> > groupList;
+  vector<DBAggregate> aggList;
+  bool aggregate = (groupBy != NULL);
+  DBOperator *op = NULL;
+  const DBAttrType *indexVal = NULL;
+  uint indexCnt = 0;
+  bool indexCount = false;
+  uint sortPos = 0;
+  bool sortExtra = false;
+  bool sorted = false;
+  ExplainModeEnum explain = explainMode;
+  explainMode = EXPLAIN_NONE;
+  DBProfile planning(sysCatMgr);
+  DBProfile execution(sysCatMgr);
+  planning.start();
 
   try {
     if (!isConnected)
@@ -589,36 +820,88 @@ void DBQueryMgr::select(DBListQualifiedName *projection, char *relName, DBJoin *
 
     LOG4CXX_DEBUG(logger, "check projection");
     if (projection != NULL) {
-      DBListQualifiedName::iterator i = projection->begin();
+      DBListSelectItem::iterator i = projection->begin();
       while (i != projection->end()) {
-        pair<uint, uint> p;
-        if (def[left]->relationName().compare((*i).relationName) == 0) {
-          p.first = left;
-          p.second = def[left]->attrDef((*i).attributeName).attrPos();
-        } else if (join != NULL && def[right]->relationName().compare((*i).relationName) == 0) {
-          p.first = right;
-          p.second = def[right]->attrDef((*i).attributeName).attrPos();
-        } else {
+        pair<uint, uint> p(left, 0);
+        if ((*i).star == false && resolveAttr(def, (*i).name, p) == false)
           throw DBException((string) "invalid projection " + (*i).toString());
+        if ((*i).func == AGG_NONE) {
+          proList.push_back(p);
+          proStr.push_back(def[p.first]->relationName() + "." + def[p.first]->attrDef(p.second).attrName());
+        } else {
+          proList.push_back(pair<uint, uint>(aggSide, aggList.size()));
+          proStr.push_back((*i).toString());
+          aggList.push_back(makeAggregate(def, *i, p));
+          aggregate = true;
         }
-        proList.push_back(p);
         ++i;
       }
     } else {
       pair<uint, uint> p;
-      p.first = left;
-      for (uint i = 0; i < def[left]->attrCnt(); ++i) {
-        p.second = i;
-        proList.push_back(p);
-      }
-      if (join != NULL) {
-        p.first = right;
-        for (uint i = 0; i < def[right]->attrCnt(); ++i) {
-          p.second = i;
+      for (p.first = left; p.first <= right && def[p.first] != NULL; ++p.first) {
+        for (p.second = 0; p.second < def[p.first]->attrCnt(); ++p.second) {
           proList.push_back(p);
+          proStr.push_back(def[p.first]->relationName() + "." + def[p.first]->attrDef(p.second).attrName());
         }
       }
+    }
 
+    if (orderBy != NULL) {
+      LOG4CXX_DEBUG(logger, "check order by");
+      // the rows are sorted after the projection; a sort key that is not
+      // projected is appended and removed again after sorting
+      const DBSelectItem &item = orderBy->item;
+      pair<uint, uint> p(left, 0);
+      if (item.star == false && resolveAttr(def, item.name, p) == false)
+        throw DBException((string) "invalid order by " + item.toString());
+      if (item.func != AGG_NONE) {
+        DBAggregate a = makeAggregate(def, item, p);
+        uint n = 0;
+        while (n < aggList.size() &&
+               !(aggList[n].func == a.func && aggList[n].type == a.type &&
+                 (a.type == NONE || (aggList[n].side == a.side && aggList[n].pos == a.pos))))
+          ++n;
+        if (n == aggList.size())
+          aggList.push_back(a);
+        p = pair<uint, uint>(aggSide, n);
+        aggregate = true;
+      }
+      sortPos = distance(proList.begin(), find(proList.begin(), proList.end(), p));
+      if (sortPos == proList.size()) {
+        proList.push_back(p);
+        proStr.push_back(item.toString());
+        sortExtra = true;
+      }
+    }
+
+    if (aggregate == true) {
+      LOG4CXX_DEBUG(logger, "check group by");
+      if (groupBy != NULL) {
+        DBListQualifiedName::iterator i = groupBy->begin();
+        while (i != groupBy->end()) {
+          pair<uint, uint> p;
+          if (resolveAttr(def, *i, p) == false)
+            throw DBException((string) "invalid group by " + (*i).toString());
+          groupList.push_back(p);
+          ++i;
+        }
+      }
+      // the aggregation yields the grouping attributes followed by the aggregates
+      list<pair<uint, uint> >::iterator pI = proList.begin();
+      list<string>::iterator sI = proStr.begin();
+      while (pI != proList.end()) {
+        if ((*pI).first == aggSide) {
+          (*pI).second += groupList.size();
+        } else {
+          list<pair<uint, uint> >::iterator g = find(groupList.begin(), groupList.end(), *pI);
+          if (g == groupList.end())
+            throw DBQueryMgrException(*sI + " is neither grouped nor aggregated");
+          (*pI).second = distance(groupList.begin(), g);
+        }
+        (*pI).first = left;
+        ++pI;
+        ++sI;
+      }
     }
 
     LOG4CXX_DEBUG(logger, "check where " + TO_STR(where));
@@ -652,64 +935,189 @@ void DBQueryMgr::select(DBListQualifiedName *projection, char *relName, DBJoin *
 
     LOG4CXX_DEBUG(logger, "select");
 
-    if (join != NULL) {
-      selectJoinTuple(table, joinAttrs, whereJoin, l);
-      LOG4CXX_DEBUG(logger, "l.size(): " + TO_STR(l.size()));
-    } else {
-      DBTuple empty;
-      DBListTuple lsmall;
-      selectTuple(table[left], whereJoin[left], lsmall);
-
-      LOG4CXX_DEBUG(logger, "lsmall.size(): " + TO_STR(lsmall.size()));
-      DBListTuple::iterator iS = lsmall.begin();
-
-      while (lsmall.end() != iS) {
+    if (aggregate == true && join == NULL && groupList.empty() == true) {
+      // COUNT alone is answered from an index if it covers all predicates
+      vector<DBAggregate>::iterator a = aggList.begin();
+      while (a != aggList.end() && (*a).func == AGG_COUNT)
+        ++a;
+      if (a == aggList.end()) {
+        if (whereJoin[left].empty() == true) {
+          indexCount = countIndexOnly(table[left], indexCnt);
+        } else {
+          uint pos = def[left]->attrDef(whereJoin[left].front().name().attributeName).attrPos();
+          indexCount = selectIndexOnly(table[left], pos, whereJoin[left], indexCnt);
+        }
+        LOG4CXX_DEBUG(logger, "index count: " + TO_STR(indexCount) + " " + TO_STR(indexCnt));
+      }
+    } else if (aggregate == false && join == NULL && projection != NULL) {
+      // a projection on the indexed attribute only can be answered from the index
+      list<pair<uint, uint> >::iterator pI = proList.begin();
+      while (pI != proList.end() && (*pI).second == proList.front().second)
+        ++pI;
+      if (pI == proList.end() &&
+          selectIndexOnly(table[left], proList.front().second, whereJoin[left], indexCnt) == true) {
+        LOG4CXX_DEBUG(logger, "index only: " + TO_STR(indexCnt));
+        indexVal = &whereJoin[left].front().val();
+      }
+    }
 
-        pair<DBTuple, DBTuple> p;
-        p.first = DBTuple(*iS);
-        LOG4CXX_DEBUG(logger, "iS: \n" + (*iS).toString("\t"));
-        p.second = DBTuple();
-        l.push_back(p);
-        ++iS;
+    // only attributes that are projected, aggregated, compared or joined on are decoded
+    uint attrMask[2] = {0, 0};
+    if (aggregate == true) {
+      for (list<pair<uint, uint> >::iterator g = groupList.begin(); g != groupList.end(); ++g)
+        attrMask[(*g).first] |= 1u << (*g).second;
+      for (vector<DBAggregate>::iterator a = aggList.begin(); a != aggList.end(); ++a) {
+        if ((*a).type != NONE)
+          attrMask[(*a).side] |= 1u << (*a).pos;
       }
-      LOG4CXX_DEBUG(logger, "done copy");
+    } else {
+      for (list<pair<uint, uint> >::iterator pI = proList.begin(); pI != proList.end(); ++pI)
+        attrMask[(*pI).first] |= 1u << (*pI).second;
+    }
+    for (uint i = 0; i < 2 && def[i] != NULL; ++i) {
+      for (DBListPredicate::iterator u = whereJoin[i].begin(); u != whereJoin[i].end(); ++u)
+        attrMask[i] |= 1u << def[i]->attrDef((*u).name().attributeName).attrPos();
+      if (join != NULL)
+        attrMask[i] |= 1u << joinAttrs[i];
     }
 
-    list<pair<uint, uint> >::iterator pI = proList.begin();
-    while (pI != proList.end()) {
-      pair<uint, uint> p = (*pI);
-      LOG4CXX_DEBUG(logger, "p.first " + TO_STR(p.first));
-      LOG4CXX_DEBUG(logger, "p.second " + TO_STR(p.second));
-      socket.getWriteStream() << setw(MAX_STR_LEN) << "-" << def[p.first]->relationName() << "."
-                              << def[p.first]->attrDef(p.second).attrName() << "-" << "\t";
-      ++pI;
+    // the rows are pulled through the operator tree and printed batch by batch
+    if (join != NULL) {
+      op = joinOperator(table, joinAttrs, whereJoin, attrMask);
+    } else if (indexVal == NULL && indexCount == false) {
+      // an ascending sort on an indexed attribute may follow the index
+      if (orderBy != NULL && orderBy->desc == false && aggregate == false) {
+        list<pair<uint, uint> >::iterator pI = proList.begin();
+        advance(pI, sortPos);
+        op = orderedScanOperator(table[left], whereJoin[left], (*pI).second, attrMask[left]);
+        sorted = (op != NULL);
+      }
+      if (op == NULL)
+        op = scanOperator(table[left], whereJoin[left], attrMask[left]);
     }
-    socket.getWriteStream() << endl;
+    if (op != NULL && aggregate == true)
+      op = new DBHashAggregateOp(op, sysCatMgr, connectDB, def, groupList, aggList);
 
-    uint cnt = l.size();
-    while (l.empty() == false) {
-      pI = proList.begin();
-      while (pI != proList.end()) {
-        pair<uint, uint> p = (*pI);
-        LOG4CXX_DEBUG(logger, "p.first " + TO_STR(p.first));
-        LOG4CXX_DEBUG(logger, "p.second " + TO_STR(p.second));
+    if (explain == EXPLAIN_NONE) {
+      list<string>::iterator sI = proStr.begin();
+      for (uint c = 0; c < proStr.size() - (sortExtra ? 1 : 0); ++c, ++sI)
+        socket.getWriteStream() << setw(MAX_STR_LEN) << "-" << *sI << "-" << "\t";
+      socket.getWriteStream() << endl;
+    }
 
-        if (p.first == left) {
-          l.front().first.getAttrVal(p.second).print(socket.getWriteStream());
+    uint cnt = 0;
+    stringstream plan;
+    // the answers from an index are estimated like the operators (see DBOperator::describe())
+    double estRows = -1;
+    DBTableStats stats;
+    if ((indexCount == true || indexVal != NULL) &&
+        sysCatMgr.readStatistics(connectDB, def[left]->relationName(), stats) == true) {
+      if (indexCount == true)
+        estRows = (limit != 0) ? 1 : 0;
+      else
+        estRows = stats.rows(table[left]->getPageCnt()) * stats.selectivity(*def[left], whereJoin[left]);
+      if (limit >= 0)
+        estRows = min(estRows, (double) limit);
+    }
+    if (indexCount == true) {
+      cnt = (limit != 0) ? 1 : 0;
+      planning.stop();
+      plan << "Count from index of " << def[left]->relationName();
+      if (estRows >= 0)
+        plan << "  (est. rows: " << (uint) (estRows + 0.5) << ")";
+      DBIntType val(indexCnt);
+      for (uint r = 0; explain == EXPLAIN_NONE && r < cnt; ++r) {
+        for (uint c = 0; c < proList.size() - (sortExtra ? 1 : 0); ++c) {
+          val.print(socket.getWriteStream());
+          socket.getWriteStream() << "\t";
+        }
+        socket.getWriteStream() << endl;
+      }
+      if (explain == EXPLAIN_ANALYZE)
+        plan << "  (rows: " << cnt << ")";
+      plan << endl;
+    } else if (indexVal != NULL) {
+      cnt = (limit >= 0) ? min(indexCnt, (uint) limit) : indexCnt;
+      planning.stop();
+      plan << "Values from index of " << def[left]->relationName() << " where " << whereJoin[left].front().toString();
+      if (estRows >= 0)
+        plan << "  (est. rows: " << (uint) (estRows + 0.5) << ")";
+      for (uint r = 0; explain == EXPLAIN_NONE && r < cnt; ++r) {
+        for (list<pair<uint, uint> >::iterator pI = proList.begin(); pI != proList.end(); ++pI) {
+          indexVal->print(socket.getWriteStream());
+          socket.getWriteStream() << "\t";
+        }
+        socket.getWriteStream() << endl;
+      }
+      if (explain == EXPLAIN_ANALYZE)
+        plan << "  (rows: " << cnt << ")";
+      plan << endl;
+    } else {
+      op = new DBProjectOp(op, proList);
+      if (orderBy != NULL && sorted == false) {
+        // types of the projected columns
+        vector<AttrTypeEnum> types;
+        for (list<pair<uint, uint> >::iterator pI = proList.begin(); pI != proList.end(); ++pI) {
+          if (aggregate == false) {
+            types.push_back(def[(*pI).first]->attrDef((*pI).second).attrType());
+          } else if ((*pI).second < groupList.size()) {
+            list<pair<uint, uint> >::iterator g = groupList.begin();
+            advance(g, (*pI).second);
+            types.push_back(def[(*g).first]->attrDef((*g).second).attrType());
+          } else {
+            const DBAggregate &a = aggList[(*pI).second - groupList.size()];
+            types.push_back(a.func == AGG_COUNT ? INT : (a.func == AGG_AVG ? DOUBLE : a.type));
+          }
+        }
+        RelDefStruct rel;
+        DBOperator::tupleDef(types, rel);
+        if (limit >= 0 && (uint) limit <= DBSortOp::memTuples(DBRelDef(&rel))) {
+          // only the best limit rows are kept
+          op = new DBTopNOp(op, sortPos, orderBy->desc, limit);
+          limit = -1;
         } else {
-          l.front().second.getAttrVal(p.second).print(socket.getWriteStream());
+          op = new DBSortOp(op, sysCatMgr, connectDB, DBRelDef(&rel), sortPos, orderBy->desc);
         }
-        socket.getWriteStream() << "\t";
-        ++pI;
       }
-      l.pop_front();
-      socket.getWriteStream() << endl;
+      // the limit stops pulling rows from the scan as soon as it is reached
+      if (limit >= 0)
+        op = new DBLimitOp(op, limit);
+      if (sortExtra == true) {
+        list<pair<uint, uint> > trim;
+        for (uint c = 0; c + 1 < proList.size(); ++c)
+          trim.push_back(pair<uint, uint>(left, c));
+        op = new DBProjectOp(op, trim);
+      }
+      if (explain == EXPLAIN_NONE)
+        op = new DBOutputOp(op, socket);
+      else if (explain == EXPLAIN_ANALYZE)
+        DBProfileOp::instrument(op, sysCatMgr);
+      planning.stop();
+      if (explain != EXPLAIN_PLAN) {
+        execution.start();
+        DBListJoinTuple rows;
+        op->open();
+        while (op->next(rows) == true)
+          cnt += rows.size();
+        op->close();
+        execution.stop();
+      }
+      if (explain == EXPLAIN_NONE)
+        cnt = ((DBOutputOp *) op)->getCnt();
+      else
+        op->explainTree(plan);
+    }
+    if (explain == EXPLAIN_NONE) {
+      socket.getWriteStream() << "   " << cnt << " row(s) selected." << endl;
+    } else {
+      printPlan(explain, plan.str(), planning, execution);
     }
-    socket.getWriteStream() << "   " << cnt << " row(s) selected." << endl;
   } catch (DBException e) {
     LOG4CXX_ERROR(logger, e.what());
     socket.getWriteStream() << e.what() << endl;
   }
+  if (op != NULL)
+    delete op;
   for (uint i = 0; i < 2; ++i) {
     LOG4CXX_DEBUG(logger, "free table[" + TO_STR(i) + "]:" + TO_STR(table[i]));
     if (table[i] != NULL)
@@ -720,6 +1128,143 @@ void DBQueryMgr::select(DBListQualifiedName *projection, char *relName, DBJoin *
   }
 }
 
+void DBQueryMgr::printPlan(ExplainModeEnum explain, const string &plan, const DBProfile &planning, const DBProfile &execution) {
+  LOG4CXX_INFO(logger, "printPlan()");
+  socket.getWriteStream() << plan;
+  if (explain == EXPLAIN_ANALYZE) {
+    socket.getWriteStream() << "Planning: " << planning.describe() << endl;
+    socket.getWriteStream() << "Execution: " << execution.describe() << endl;
+  }
+}
+
+DBOperator *DBQueryMgr::scanOperator(DBTable *table, DBListPredicate &where, uint /*attrMask*/) {
+  LOG4CXX_INFO(logger, "scanOperator()");
+  return new DBDeferredOp([this, table, &where](DBListJoinTuple &rows) {
+    DBListTuple l;
+    selectTuple(table, where, l);
+    DBOperator::toRows(l, rows);
+  }, "selection of " + table->getRelDef().relationName());
+}
+
+DBOperator *DBQueryMgr::joinOperator(DBTable *table[2], uint attrJoinPos[2], DBListPredicate where[2], uint /*attrMask*/[2]) {
+  LOG4CXX_INFO(logger, "joinOperator()");
+  return new DBDeferredOp([this, table, attrJoinPos, where](DBListJoinTuple &rows) {
+    selectJoinTuple(table, attrJoinPos, where, rows);
+  }, "join of " + table[0]->getRelDef().relationName() + " and " + table[1]->getRelDef().relationName());
+}
+
+DBOperator *DBQueryMgr::orderedScanOperator(DBTable *table, DBListPredicate &where, uint attrPos, uint attrMask) {
+  LOG4CXX_INFO(logger, "orderedScanOperator()");
+  const DBRelDef &def = table->getRelDef();
+  DBAttrDef adef = def.attrDef(attrPos);
+  if (adef.isIndexed() == false)
+    return NULL;
+
+  // an indexed predicate is cheaper to answer by index lookup and sorting
+  list<bool> checkList;
+  DBListPredicate::iterator u = where.begin();
+  while (u != where.end()) {
+    DBAttrDef pdef = def.attrDef((*u).name().attributeName);
+    if (pdef.isIndexed() == true)
+      return NULL;
+    attrMask |= 1u << pdef.attrPos();
+    checkList.push_back(true);
+    ++u;
+  }
+
+  QualifiedName qname;
+  strcpy(qname.relationName, def.relationName().c_str());
+  strcpy(qname.attributeName, adef.attrName().c_str());
+  DBIndex *index = sysCatMgr.openIndex(connectDB, qname, READ);
+  bool ordered = false;
+  try {
+    ordered = index->openOrderedCursor();
+    if (ordered == true)
+      index->closeCursor();
+  } catch (DBException e) {
+    delete index;
+    throw e;
+  }
+  if (ordered == false) {
+    delete index;
+    return NULL;
+  }
+  DBOperator *op = new DBOrderedIndexScanOp(*table, index, attrMask);
+  if (where.empty() == true)
+    return op;
+  return new DBFilterOp(op, def, where, checkList);
+}
+
+bool DBQueryMgr::countIndexOnly(DBTable *table, uint &cnt) {
+  LOG4CXX_INFO(logger, "countIndexOnly()");
+  const DBRelDef &def = table->getRelDef();
+  QualifiedName qname;
+  strcpy(qname.relationName, def.relationName().c_str());
+  for (uint i = 0; i < def.attrCnt(); ++i) {
+    DBAttrDef adef = def.attrDef(i);
+    if (adef.isIndexed() == false)
+      continue;
+    strcpy(qname.attributeName, adef.attrName().c_str());
+    DBIndex *index = sysCatMgr.openIndex(connectDB, qname, READ);
+    bool ordered = false;
+    try {
+      ordered = index->openOrderedCursor();
+      if (ordered == true) {
+        // every tuple is indexed exactly once, the keys need not be compared
+        string key;
+        DBTIDBatch tids;
+        cnt = 0;
+        while (index->nextOrdered(key, tids) == true)
+          cnt += tids.size();
+        index->closeCursor();
+      }
+    } catch (DBException e) {
+      delete index;
+      throw e;
+    }
+    delete index;
+    if (ordered == true)
+      return true;
+  }
+  return false;
+}
+
+bool DBQueryMgr::selectIndexOnly(DBTable *table, uint attrPos, DBListPredicate &where, uint &cnt) {
+  LOG4CXX_INFO(logger, "selectIndexOnly()");
+  LOG4CXX_DEBUG(logger, "attrPos: " + TO_STR(attrPos));
+  const DBRelDef &def = table->getRelDef();
+  DBAttrDef adef = def.attrDef(attrPos);
+  if (adef.isIndexed() == false || where.empty() == true)
+    return false;
+
+  DBListPredicate::iterator i = where.begin();
+  while (i != where.end()) {
+    if (def.attrDef((*i).name().attributeName).attrPos() != attrPos)
+      return false;
+    ++i;
+  }
+
+  cnt = 0;
+  // predicates with different keys on the same attribute never match together
+  for (i = ++where.begin(); i != where.end(); ++i) {
+    if (!((*i).val() == where.front().val()))
+      return true;
+  }
+
+  QualifiedName qname;
+  strcpy(qname.relationName, def.relationName().c_str());
+  strcpy(qname.attributeName, adef.attrName().c_str());
+  DBIndex *index = sysCatMgr.openIndex(connectDB, qname, READ);
+  try {
+    cnt = index->count(where.front().val());
+  } catch (DBException e) {
+    delete index;
+    throw e;
+  }
+  delete index;
+  return true;
+}
+
 DBQueryMgrException::DBQueryMgrException(const std::string &msg1)
         : DBRuntimeException(msg1) {
 }
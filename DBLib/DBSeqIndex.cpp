@@ -26,7 +26,8 @@ string DBSeqIndex::toString(string linePrefix) const {
   ss << linePrefix << "[DBSeqIndex]" << endl;
   ss << DBIndex::toString(linePrefix + "\t") << endl;
   ss << linePrefix << "tidsPerEntry: " << tidsPerEntry << endl;
-  ss << linePrefix << "entriesPerPage: " << entriesPerPage() << endl;
+  ss << linePrefix << "keyLen: " << keyLen << endl;
+  ss << linePrefix << "maxEntrySize: " << maxEntrySize() << endl;
   ss << linePrefix << "-----------" << endl;
   return ss.str();
 }
@@ -45,13 +46,19 @@ DBSeqIndex::DBSeqIndex(DBBufferMgr &bufferMgr, DBFile &file,
         DBIndex(bufferMgr, file, attrType, mode, unique),
 
         // falls unqiue, dann nur ein Tupel pro value, ansonsten den Wert vom oben gesetzen MAX_TID_PER_ENTRY
-        tidsPerEntry(unique ? 1 : MAX_TID_PER_ENTRY)
+        tidsPerEntry(unique ? 1 : MAX_TID_PER_ENTRY),
+        keyLen(DBAttrType::getKeySize4Type(attrType)),
+        cursorOpen(false),
+        cursorBlockNo(rootBlockNo),
+        cursorEntry(0),
+        cursorTidPos(0)
 {
 
   if (logger != NULL) {
     LOG4CXX_INFO(logger, "DBSeqIndex()");
   }
-  assert(entriesPerPage() > 1);
+  // nach dem Teilen einer übervollen Seite müssen beide Hälften passen
+  assert(3 * maxEntrySize() <= file.getBlockSize());
 
   // if this function is called for the first time -> index file has 0 blocks
   // -> call initializeIndex to create file
@@ -101,23 +108,20 @@ void DBSeqIndex::unfixBACBs(bool setDirty) {
 }
 
 /**
-  * Gibt die Anzahl der Einträge pro Seite zurueck
-  *
-  * Gesamtblockgroesse: DBFileBlock::getBlockSize()
-  * Platz zum Speichern der Position des ersten freien Blocks: sizeof(uint)
-  * Laenge des Schluesselattributs: DBAttrType::getSize4Type(attrType)
-  * Grösse der TID (siehe DBTypes.h): sizeof(TID)
-  *
-  * Einträge (TIDs) pro Schlüsseleintrag (maximal MAX_TID_PER_ENTRY or 1 when unique): tidsPerEntry
-  *
-  * Bsp.: VARCHAR: entriesPerPage() = (1024-4) / (30+8*20) = 5, Rest 70
-  * Bsp.: INTEGER UNIQUE: entriesPerPage() = (1024-4) / (4+8*1) = 85, Rest 0
-  *
-  * @return
-  */
-uint DBSeqIndex::entriesPerPage() const {
-  return (DBFileBlock::getBlockSize() - sizeof(uint)) /
-         (DBAttrType::getSize4Type(attrType) + sizeof(TID) * tidsPerEntry);
+ * Gibt die maximale Größe eines Eintrags auf einer Seite zurück
+ *
+ * Die Schlüssel werden normalisiert (siehe DBAttrType::normalizedKey()) und ohne den
+ * gemeinsamen Präfix der Seite gespeichert, TID-Listen nur so lang wie benötigt.
+ * Die Anzahl der Einträge pro Seite hängt daher von den Schlüsseln ab.
+ *
+ * Bsp.: VARCHAR: maxEntrySize() = 1+30 + 1+8*20 = 192
+ * Bsp.: INTEGER UNIQUE: maxEntrySize() = 4 + 8 = 12, bei 2 Byte Präfix 10 (ca. 100 statt 85 pro Seite)
+ *
+ * @return
+ */
+size_t DBSeqIndex::maxEntrySize() const {
+  return (keyLen == 0 ? 1 + MAX_STR_LEN : keyLen)
+         + (tidsPerEntry == 1 ? 0 : 1) + sizeof(TID) * tidsPerEntry;
 }
 
 /**
@@ -163,10 +167,11 @@ void DBSeqIndex::find(const DBAttrType &val, DBListTID &tids) {
   tids.clear();
 
   // die erste Seite suchen auf der ein Tupel mit einem bestimmten Wert vorkommen könnte
+  std::string key = val.normalizedKey();
   BlockNo page;
-  if (findFirstPage(val, page)) {
+  if (findFirstPage(key, page)) {
     // wenn Page gefunden, dann auf dieser Page weitersuchen und TID List fuellen
-    findFromPage(val, page, tids);
+    findFromPage(key, page, tids);
   }
 
   // ist genau eine Seite fixiert?
@@ -194,11 +199,12 @@ void DBSeqIndex::insert(const DBAttrType &val, const TID &tid) {
   }
 
   // Suchen auf welcher Seite die Tupel mit Wert val im Index liegen könnten
+  std::string key = val.normalizedKey();
   BlockNo page;
-  findFirstPage(val, page);
+  findFirstPage(key, page);
 
   // nun Einfügen in diese Seite
-  insertInPage(val, tid, page);
+  insertInPage(key, tid, page);
 
   // ist genau eine Seite fixiert?
   checkBacbStackInvariant();
@@ -231,10 +237,11 @@ void DBSeqIndex::remove(const DBAttrType &valToRemove, const list<TID> &tidsToRe
   }
 
   // Suchen auf welcher Seite Tupel mit valToRemove im Index liegen
+  std::string key = valToRemove.normalizedKey();
   BlockNo page;
-  if (findFirstPage(valToRemove, page)) {
+  if (findFirstPage(key, page)) {
     // sobald Seite gefunden: löschen der TIDs
-    removeFromPage(valToRemove, tidsToRemove, page);
+    removeFromPage(key, tidsToRemove, page);
   } else {
     // ansonsten Fehler werfen
     throw DBIndexException("key not found (valToRemove:\n" + valToRemove.toString("\t") + ")");
@@ -244,6 +251,178 @@ void DBSeqIndex::remove(const DBAttrType &valToRemove, const list<TID> &tidsToRe
   checkBacbStackInvariant();
 }
 
+/**
+ * Öffnet einen Cursor auf alle TIDs zum Schlüssel val.
+ *
+ * Es wird nur die erste Seite gesucht, auf der val vorkommen könnte. Die Seiten werden
+ * erst beim Abholen der Stapel in nextBatch() gelesen.
+ *
+ * @param val Schlüsselwert
+ */
+void DBSeqIndex::openCursor(const DBAttrType &val) {
+  LOG4CXX_INFO(logger, "openCursor()");
+  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
+
+  closeCursor();
+
+  std::string key = val.normalizedKey();
+  BlockNo page;
+  if (findFirstPage(key, page)) {
+    cursorOpen = true;
+    cursorKey = key;
+    cursorBlockNo = page;
+  }
+}
+
+/**
+ * Liefert die nächsten (höchstens maxTids) TIDs des Cursors.
+ *
+ * Es ist immer nur eine Seite des Index zusätzlich zum Root-Block fixiert. Die Position
+ * innerhalb der Seite wird gemerkt, so dass der nächste Aufruf dort weiterliest.
+ * Die TIDs eines Stapels werden nach Seite sortiert, damit die Tabelle sie in
+ * Seitenreihenfolge lesen kann.
+ *
+ * @param tids Puffer, wird geleert und gefüllt
+ * @param maxTids maximale Anzahl TIDs pro Stapel
+ * @return false, falls keine TIDs mehr vorhanden sind
+ */
+bool DBSeqIndex::nextBatch(DBTIDBatch &tids, uint maxTids) {
+  LOG4CXX_INFO(logger, "nextBatch()");
+
+  // ist genau eine Seite fixiert?
+  checkBacbStackInvariant();
+
+  tids.clear();
+  while (cursorOpen && tids.size() < maxTids) {
+    if (cursorBlockNo >= bufMgr.getBlockCount(file)) {
+      cursorOpen = false;
+      break;
+    }
+
+    DBBACB block = fixNonRootBlock(cursorBlockNo, LOCK_SHARED);
+    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(block.getDataPtr(), keyLen, tidsPerEntry);
+
+    bool done = false;
+    while (!done && cursorEntry < index->countEntries && tids.size() < maxTids) {
+      const IndexEntries &entry = index->entries[cursorEntry];
+      if (entry.key == cursorKey) {
+        // TIDs übernehmen bis der Puffer voll ist
+        while (cursorTidPos < entry.tidList.size() && tids.size() < maxTids) {
+          tids.push_back(entry.tidList[cursorTidPos++]);
+        }
+        if (cursorTidPos == entry.tidList.size()) {
+          ++cursorEntry;
+          cursorTidPos = 0;
+        }
+      }
+        // bereits am gesuchten Wert vorbei
+      else if (entry.key > cursorKey) {
+        done = true;
+      } else {
+        ++cursorEntry;
+      }
+    }
+
+    bool pageDone = (cursorEntry == index->countEntries);
+    unfixNonRootBlock(block);
+
+    if (done) {
+      cursorOpen = false;
+    } else if (pageDone) {
+      ++cursorBlockNo;
+      cursorEntry = 0;
+      cursorTidPos = 0;
+    }
+  }
+
+  std::sort(tids.begin(), tids.end());
+
+  // ist genau eine Seite fixiert?
+  checkBacbStackInvariant();
+
+  LOG4CXX_DEBUG(logger, "tids: " + TO_STR(tids.size()));
+  return !tids.empty();
+}
+
+/**
+ * Schließt den Cursor
+ */
+void DBSeqIndex::closeCursor() {
+  cursorOpen = false;
+  cursorKey.clear();
+  cursorBlockNo = rootBlockNo;
+  cursorEntry = 0;
+  cursorTidPos = 0;
+}
+
+/**
+ * Öffnet einen Cursor über alle Schlüssel, beginnend auf der ersten Seite
+ */
+bool DBSeqIndex::openOrderedCursor() {
+  LOG4CXX_INFO(logger, "openOrderedCursor()");
+  closeCursor();
+  cursorOpen = true;
+  return true;
+}
+
+/**
+ * Liefert den nächsten Schlüssel mit allen TIDs. Die Einträge eines Schlüssels
+ * können sich über mehrere Seiten erstrecken, es ist aber immer nur eine Seite
+ * zusätzlich zum Root-Block fixiert.
+ * @param key Rückgabe: Schlüssel
+ * @param tids Rückgabe: TIDs des Schlüssels
+ * @return false, falls keine Schlüssel mehr vorhanden sind
+ */
+bool DBSeqIndex::nextOrdered(std::string &key, DBTIDBatch &tids) {
+  LOG4CXX_INFO(logger, "nextOrdered()");
+
+  // ist genau eine Seite fixiert?
+  checkBacbStackInvariant();
+
+  tids.clear();
+  bool found = false;
+  bool done = false;
+  while (cursorOpen && !done) {
+    if (cursorBlockNo >= bufMgr.getBlockCount(file)) {
+      cursorOpen = false;
+      break;
+    }
+
+    DBBACB block = fixNonRootBlock(cursorBlockNo, LOCK_SHARED);
+    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(block.getDataPtr(), keyLen, tidsPerEntry);
+
+    while (!done && cursorEntry < index->countEntries) {
+      const IndexEntries &entry = index->entries[cursorEntry];
+      if (!found) {
+        key = entry.key;
+        found = true;
+      }
+      if (entry.key != key) {
+        done = true;
+      } else {
+        tids.insert(tids.end(), entry.tidList.begin(), entry.tidList.end());
+        ++cursorEntry;
+      }
+    }
+
+    bool pageDone = (cursorEntry == index->countEntries);
+    unfixNonRootBlock(block);
+
+    if (!done && pageDone) {
+      ++cursorBlockNo;
+      cursorEntry = 0;
+    }
+  }
+
+  std::sort(tids.begin(), tids.end());
+
+  // ist genau eine Seite fixiert?
+  checkBacbStackInvariant();
+
+  LOG4CXX_DEBUG(logger, "tids: " + TO_STR(tids.size()));
+  return found;
+}
+
 /**
  * Prüft, dass am Anfang/Ende der Operation genau eine Seite für den Root-Block fixiert ist
  */
@@ -262,9 +441,8 @@ void DBSeqIndex::checkBacbStackInvariant() {
  * auf einer vorherigen Seite liegen. Daher muss dann die vorherige Seite noch untersucht werden.
  *
  */
-bool DBSeqIndex::findFirstPage(const DBAttrType &val, BlockNo &blockNo) {
+bool DBSeqIndex::findFirstPage(const std::string &key, BlockNo &blockNo) {
   LOG4CXX_INFO(logger, "findFirstPage()");
-  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
 
   // ist genau eine Seite fixiert?
   checkBacbStackInvariant();
@@ -299,21 +477,18 @@ bool DBSeqIndex::findFirstPage(const DBAttrType &val, BlockNo &blockNo) {
 
       // Setze firstVal und lastVal Attribute dieses Objektes
       // (Wert des ersten / letzten Value des Blocks)
-      std::shared_ptr<SequentialIndex> index = SequentialIndex::read(current.getDataPtr(), attrType, tidsPerEntry);
+      std::shared_ptr<SequentialIndex> index = SequentialIndex::read(current.getDataPtr(), keyLen, tidsPerEntry);
 
       // Erstes und letztes Element eines Blocks
-      std::shared_ptr<DBAttrType> firstVal = index->entries[0].attr;
-      std::shared_ptr<DBAttrType> lastVal = index->entries[index->countEntries-1].attr;
-
-      LOG4CXX_DEBUG(logger, "first:" + firstVal->toString());
-      LOG4CXX_DEBUG(logger, "last:" + lastVal->toString());
+      const std::string &firstKey = index->entries[0].key;
+      const std::string &lastKey = index->entries[index->countEntries-1].key;
 
       // Wert befindet sich auf einem vorherigen Block
-      if (val < *firstVal) {
+      if (key < firstKey) {
         right = blockNo;
       }
         // Wert befindet sich auf einem nachfolgenden Block
-      else if (val > *lastVal) {
+      else if (key > lastKey) {
         left = blockNo + 1;
       }
         // wenn nicht vor dem aktuellen und nicht danach dann KANN
@@ -323,13 +498,13 @@ bool DBSeqIndex::findFirstPage(const DBAttrType &val, BlockNo &blockNo) {
       }
         // wenn erster Wert gleich dem gesuchten Wert ist, dann könnte ein
         // Duplikat auf dem vorherigen Block liegen
-      else if (val == *firstVal) {
+      else if (key == firstKey) {
         // wenn auf der ersten Seite, dann dann gibt es keinen vorherigen Block
         if (blockNo == rootBlockNo) {
           found = true;
         }
           // wenn nicht, dann könnte im vorherigen Block auch der gesuchte Wert stehen
-          // Problematisch: Wenn sich der Wert über drei oder noch mehr Blöcke verteilt (entriesPerPage: 85)
+          // Problematisch: Wenn sich der Wert über drei oder noch mehr Blöcke verteilt (ca. 100 Einträge pro Seite)
         else {
           left = blockNo - 1;
           right = blockNo;
@@ -376,9 +551,8 @@ bool DBSeqIndex::findFirstPage(const DBAttrType &val, BlockNo &blockNo) {
  * @param blockNo
  * @param tidsFound Rückgabewert
  */
-void DBSeqIndex::findFromPage(const DBAttrType &val, BlockNo blockNo, list<TID> &tidsFound) {
+void DBSeqIndex::findFromPage(const std::string &key, BlockNo blockNo, list<TID> &tidsFound) {
   LOG4CXX_INFO(logger, "findFromPage()");
-  LOG4CXX_DEBUG(logger, "val:\n" + val.toString("\t"));
 
   // ist genau eine Seite fixiert?
   checkBacbStackInvariant();
@@ -394,7 +568,7 @@ void DBSeqIndex::findFromPage(const DBAttrType &val, BlockNo blockNo, list<TID>
 
     // Pointer zum Anfang der Seite
     const char *ptr = block.getDataPtr();
-    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(ptr, attrType, tidsPerEntry);
+    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(ptr, keyLen, tidsPerEntry);
 
     // Mindestens ein Eintrag muss vorhanden sein
     if (index->countEntries == 0) {
@@ -404,12 +578,11 @@ void DBSeqIndex::findFromPage(const DBAttrType &val, BlockNo blockNo, list<TID>
     // iteriere über alle gefüllten Tupelfelder der Seite
     // (countEntries ist die Stelle des ersten freien Tupels)
     for (uint i = 0; !done && i < index->countEntries; ++i) {
-      // Lese Attributwert an derzeitigen Stelle der Seite
-      // setzt Pointer weiter
-      std::shared_ptr<DBAttrType> attr = index->entries[i].attr;
+      // Schlüssel an der derzeitigen Stelle der Seite
+      const std::string &entryKey = index->entries[i].key;
 
       // falls der Wert gefunden wurde
-      if (*attr == val) {
+      if (entryKey == key) {
         std::vector<TID> tidList = index->entries[i].tidList;
 
         // dann iteriere über alle TIDs und füge sie in die tidsFound-Liste ein
@@ -419,7 +592,7 @@ void DBSeqIndex::findFromPage(const DBAttrType &val, BlockNo blockNo, list<TID>
         }
       }
         // wenn bereits an gesuchtem Wert vorbei - while-Schleife beenden
-      else if (*attr > val) {
+      else if (entryKey > key) {
         done = true;
       }
     }
@@ -467,9 +640,8 @@ DBBACB& DBSeqIndex::fixNonRootBlock(const BlockNo & blockNo, const DBBCBLockMode
  * @param tidsToRemove Die zu entfernenden TIDs
  * @param startBlockNo Der erste Block (es kann sein, dass im darauffolgenden Block gelöscht werden muss)
  */
-void DBSeqIndex::removeFromPage(const DBAttrType &valToRemove, list<TID> tidsToRemove, BlockNo startBlockNo) {
+void DBSeqIndex::removeFromPage(const std::string &keyToRemove, list<TID> tidsToRemove, BlockNo startBlockNo) {
   LOG4CXX_INFO(logger, "removeFromPage()");
-  LOG4CXX_DEBUG(logger, "valToRemove:\n" + valToRemove.toString("\t"));
   LOG4CXX_DEBUG(logger, "blockNo: " + TO_STR(startBlockNo));
 
   // ist genau eine Seite fixiert?
@@ -497,7 +669,7 @@ void DBSeqIndex::removeFromPage(const DBAttrType &valToRemove, list<TID> tidsToR
     // wenn der aktuelle Block nicht dem ersten entspricht, dann "exclusive" sperren
     DBBACB startBlock = fixNonRootBlock(startBlockNo, LOCK_EXCLUSIVE);
 
-    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(startBlock.getDataPtr(), attrType, tidsPerEntry);
+    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(startBlock.getDataPtr(), keyLen, tidsPerEntry);
 
     // Kein Eintrag vorhanden
     if (index->countEntries == 0) {
@@ -509,14 +681,11 @@ void DBSeqIndex::removeFromPage(const DBAttrType &valToRemove, list<TID> tidsToR
     uint i = 0;
     while (i < index->countEntries && !done && cntTIDs != 0) {
 
-      // Eintrag lesen
-      std::shared_ptr<DBAttrType> attr = index->entries[i].attr;
-
-      // ptrNext zeigt nun auf die TID-Liste
-      // std::vector<TID>& tidList = index->entries[i].tidList;
+      // Schlüssel des Eintrags
+      const std::string &entryKey = index->entries[i].key;
 
-      // wenn TID mit valToRemove gefunden
-      if (*attr == valToRemove) {
+      // wenn TID mit keyToRemove gefunden
+      if (entryKey == keyToRemove) {
 
         // dann gehe für alle tidsToRemove alle Tids durch
         uint c = 0;
@@ -550,7 +719,7 @@ void DBSeqIndex::removeFromPage(const DBAttrType &valToRemove, list<TID> tidsToR
         }
       }
         // Falls value bereits zu hoch ist, abbrechen
-      else if (*attr > valToRemove) {
+      else if (entryKey > keyToRemove) {
         done = true;
       }
         // ansonsten nächstes Feld anschauen (*attr < valToRemove)
@@ -562,7 +731,7 @@ void DBSeqIndex::removeFromPage(const DBAttrType &valToRemove, list<TID> tidsToR
 
     if (startBlock.getModified()) {
       // Rohdaten in Block schreibe
-      index->write(startBlock.getDataPtr(), attrType, tidsPerEntry);
+      index->write(startBlock.getDataPtr(), keyLen, tidsPerEntry);
     }
 
     // falls keine verbliebenen Tids vorhanden sind, kann die ganze Seite geloescht werden
@@ -591,18 +760,18 @@ void DBSeqIndex::removeFromPage(const DBAttrType &valToRemove, list<TID> tidsToR
 }
 
 /**
- * Einfügen eines neuen (möglicherweise bereits vorhandenen) Werts und
+ * Einfügen eines neuen (möglicherweise bereits vorhandenen) Schlüssels und
  * der dazugehörige TID in eine Seite.
  *
- * Start bei Seite mit blockNo
+ * Start bei Seite mit blockNo. Passt die geänderte Seite nicht mehr in einen Block,
+ * wird sie geteilt.
  *
- * @param valToInsert Der einzufügende Wert
+ * @param keyToInsert Der einzufügende (normalisierte) Schlüssel
  * @param tidToInsert Die einzugügende TID
  * @param blockNo Der Block, in den eingefügt werden soll
  */
-void DBSeqIndex::insertInPage(const DBAttrType &valToInsert, const TID &tidToInsert, BlockNo blockNo) {
+void DBSeqIndex::insertInPage(const std::string &keyToInsert, const TID &tidToInsert, BlockNo blockNo) {
   LOG4CXX_INFO(logger, "insertInPage()");
-  LOG4CXX_DEBUG(logger, "valToInsert:\n" + valToInsert.toString("\t"));
   LOG4CXX_DEBUG(logger, "tidToInsert: " + tidToInsert.toString());
   LOG4CXX_DEBUG(logger, "blockNo: " + TO_STR(blockNo));
 
@@ -616,8 +785,7 @@ void DBSeqIndex::insertInPage(const DBAttrType &valToInsert, const TID &tidToIns
 
   bool done = false;
 
-  // bool zum Speichern ob überhaupt Platz für den Wert vorhanden ist
-  // -> möglicherweite muss eine neue Seite eingefügt werden
+  // bool zum Speichern ob der Schlüssel bereits eingefügt wurde
   bool inserted = false;
 
   // Schleife von blockNummer (der Block wo wir anfangen mit Einfügen)
@@ -629,138 +797,76 @@ void DBSeqIndex::insertInPage(const DBAttrType &valToInsert, const TID &tidToIns
     LOG4CXX_DEBUG(logger, "blockNo: " + TO_STR(blockNo));
     DBBACB block = fixNonRootBlock(blockNo, LOCK_EXCLUSIVE);
 
-    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(block.getDataPtr(), attrType, tidsPerEntry);
+    std::shared_ptr<SequentialIndex> index = SequentialIndex::read(block.getDataPtr(), keyLen, tidsPerEntry);
 
-    // da der erste Wert die Position der ersten freie Stelle speichert,
-    // die Stelle in posToInsert merken
+    // ohne passenden Eintrag wird am Ende der Seite eingefügt
     uint posToInsert = index->countEntries;
+    bool modified = false;
 
     LOG4CXX_DEBUG(logger, "countEntries: " + TO_STR(posToInsert));
 
-    // nun vom Anfang bis zur ersten freien Stelle, alle Felder mit TID Objekten durchlaufen
-    for (uint i = 0; i < posToInsert && !done; ++i) {
-      // Eintrag lesen
-      std::shared_ptr<DBAttrType> attr = index->entries[i].attr;
+    for (uint i = 0; i < index->countEntries && !done; ++i) {
+      IndexEntries &entry = index->entries[i];
 
-      LOG4CXX_DEBUG(logger, "attr:\n" + attr->toString("\t"));
-
-      // wenn value gefunden: in TID Liste einfügen
-      if (valToInsert == *attr) {
+      // wenn Schlüssel gefunden: in TID Liste einfügen
+      if (keyToInsert == entry.key) {
         // bereits den Key gefunden der jetzt eingefügt werden soll UND Unique führt zu einer Exception
         if (isUnique()) {
           throw DBIndexUniqueKeyException("Attr already in index");
         }
 
-        // Iteriere tidsPerEntry
-        for (uint c = 0; c < tidsPerEntry; ++c) {
-          // Exception, falls der Wert schon vorhanden ist
-          if (index->entries[i].tidList[c] == tidToInsert) {
+        // Exception, falls die TID schon vorhanden ist
+        for (uint c = 0; c < entry.tidList.size(); ++c) {
+          if (entry.tidList[c] == tidToInsert) {
             throw DBIndexUniqueKeyException("Attr, tidToInsert already in index");
           }
         }
 
-        // gehe bis an das Ende der TID Liste
-        if (index->entries[i].tidList.size() < entriesPerPage()
+        // noch Platz in der TID Liste
+        if (entry.tidList.size() < tidsPerEntry
             && !inserted) {
-          // wenn noch nichts eingefügt wurde dann genau hier die neue TID einfuegen
-          block.setModified();
-          index->entries[i].tidList.push_back(tidToInsert);
-
-          // Es wurde in die Liste eingefügt
+          entry.tidList.push_back(tidToInsert);
           inserted = true;
+          modified = true;
         }
       }
-        // falls einzufügender Wert kleiner als der aktuelle Wert,
-        // posToInsert auf die Stelle setzen, wo value später eingefügt werden soll
-      else if (valToInsert < *attr) {
+        // falls einzufügender Schlüssel kleiner als der aktuelle ist,
+        // posToInsert auf die Stelle setzen, wo er eingefügt werden soll
+      else if (keyToInsert < entry.key) {
         posToInsert = i;
         done = true;
       }
     } // for
 
-    if (block.getModified()) {
-      // Rohdaten in Block schreibe
-      index->write(block.getDataPtr(), attrType, tidsPerEntry);
-    }
-
     LOG4CXX_DEBUG(logger, "posToInsert: " + TO_STR(posToInsert));
     LOG4CXX_DEBUG(logger, "inserted: " + TO_STR(inserted));
     LOG4CXX_DEBUG(logger, "done: " + TO_STR(done));
 
-    // TID/Value muss neu eingefügt werden
+    // Schlüssel/TID muss als neuer Eintrag eingefügt werden
     if (!inserted) {
-      bool unfix = false;
-
-      // Es konnte nicht eingefügt werden, da keine freie Stelle auf der Seite frei ist
-      if (index->countEntries == entriesPerPage()) {
-        LOG4CXX_DEBUG(logger, "split page countEntries: " + TO_STR(index->countEntries));
-
-        // split the page as it is full
-        splitPage(blockNo, posToInsert, unfix);
-      }
-
-      // nun ist platz vorhanden, insert kein Problem mehr
+      index->entries.insert(index->entries.begin() + posToInsert, IndexEntries(keyToInsert, tidToInsert));
+      ++index->countEntries;
       inserted = true;
-
-      DBBACB blockToInsert = bacbStack.top();
-
-      // TODO nicht so schön, immernoch low-level
-
-      // Stelle bestimmen wo Einfügen möglich ist
-      uint *numberOfElements = (uint *) blockToInsert.getDataPtr();
-      //std::shared_ptr<SequentialIndex> indexNew = SequentialIndex::read(blockToInsert.getDataPtr(), attrType, tidsPerEntry);
-
-      LOG4CXX_DEBUG(logger, "posToInsert: " + TO_STR(posToInsert));
-      LOG4CXX_DEBUG(logger, "numberOfElements: " + TO_STR(numberOfElements) + " " + TO_STR(*numberOfElements));
-
-      // Byte-Stelle erhalten wo ich gerne einfügen möchte
-      char *from = blockToInsert.getDataPtr() // Position des Blocks
-                   + sizeof(uint) // Position der ersten freien Stelle
-                   + getEntrySize() * posToInsert; // Anzahl Einträge
-
-      LOG4CXX_DEBUG(logger, "from: " + TO_STR(from));
-
-      // falls ich nicht am Ende einfügen möchte, müssen die Einträge verschoben werden
-      if (*numberOfElements != posToInsert) {
-        // um eine Position verschieben
-        char *to = from + getEntrySize();
-        memmove(to, from, getEntrySize() * (*numberOfElements - posToInsert));
-      }
-
-      LOG4CXX_DEBUG(logger, "valToInsert: " + valToInsert.toString("\t"));
-
-      // Nun den neuen Wert einfügen
-      from = valToInsert.write(from);
-
-      // und die zu speichernde TID
-      TID *tidList = (TID *) from;
-      tidList[0] = tidToInsert;
-
-      // invalidTID häengen
-      if (!isUnique()) {
-        tidList[1] = invalidTID;
-      }
-
-      // Anzahl Element um 1 erhähen
-      ++*numberOfElements;
-      LOG4CXX_DEBUG(logger, "numberOfElements: " + TO_STR(*numberOfElements));
-
-      // neues modified date
-      blockToInsert.setModified();
-
-      // im Buffer unfixen!
-      if (unfix) {
-        bufMgr.unfixBlock(blockToInsert);
-        bacbStack.pop();
-      }
+      modified = true;
 
       if (isUnique()) {
         done = true;
       }
-    } // if inserted
+    }
+
+    if (modified) {
+      block.setModified();
+      if (index->encodedSize(keyLen, tidsPerEntry) > file.getBlockSize()) {
+        LOG4CXX_DEBUG(logger, "split page countEntries: " + TO_STR(index->countEntries));
+        splitPage(blockNo, *index);
+      } else {
+        // Rohdaten in Block schreiben
+        index->write(block.getDataPtr(), keyLen, tidsPerEntry);
+      }
+    }
 
     // wieder nur die erste Seite gelockt am Ende der ganzen Methode
-    unfixNonRootBlock(bacbStack.top());
+    unfixNonRootBlock(block);
 
     // und ein Block weiter schauen
     ++blockNo;
@@ -772,83 +878,53 @@ void DBSeqIndex::insertInPage(const DBAttrType &valToInsert, const TID &tidToIns
 }
 
 /**
- * Liefert die Größe eines Eintrags mit Attribut-Value und TID-Listen
- * @return
+ * Teilt eine übervolle Seite (oberste Seite des Stacks) auf zwei Seiten auf.
+ * Geteilt wird nach Bytes, nicht nach Anzahl der Einträge, da diese unterschiedlich groß sind.
+ * Die rechte Hälfte wird in eine neue, direkt folgende Seite geschrieben.
+ * @param blockNo wird auf die neue Seite gesetzt
+ * @param index Inhalt der übervollen Seite
  */
-size_t DBSeqIndex::getEntrySize() const {
-  return (sizeof(TID) * tidsPerEntry + attrTypeSize);
-}
-
-
-/**
- * Teilt eine Seite auf zwei Seiten auf
- * @param countEntries
- * @param blockNo
- * @param posToInsert
- * @param unfix
- */
-void DBSeqIndex::splitPage(BlockNo &blockNo,
-                           uint &posToInsert,
-                           bool &unfix) {
+void DBSeqIndex::splitPage(BlockNo &blockNo, SequentialIndex &index) {
+  LOG4CXX_INFO(logger, "splitPage()");
   DBBACB blockToSplit = bacbStack.top();
 
-  // Setze prtOld auf eine Stelle nach der Hälfte der Seite
-  std::shared_ptr<SequentialIndex> index = SequentialIndex::read(blockToSplit.getDataPtr(), attrType, tidsPerEntry);
+  // Hälfte bestimmen
+  size_t total = index.encodedSize(keyLen, tidsPerEntry);
+  size_t half = 0;
+  uint leftCnt = 0;
+  while (leftCnt + 1 < index.countEntries && half < total / 2) {
+    half += index.entries[leftCnt].key.size() + sizeof(TID) * index.entries[leftCnt].tidList.size();
+    ++leftCnt;
+  }
 
-  // Häfte bestimmen
-  index->countEntries = (entriesPerPage() - entriesPerPage() / 2);
+  SequentialIndex indexNew;
+  indexNew.entries.assign(index.entries.begin() + leftCnt, index.entries.end());
+  indexNew.countEntries = indexNew.entries.size();
+  index.entries.erase(index.entries.begin() + leftCnt, index.entries.end());
+  index.countEntries = leftCnt;
 
-  LOG4CXX_DEBUG(logger, "leftcnt: " + TO_STR(index->countEntries));
+  LOG4CXX_DEBUG(logger, "leftcnt: " + TO_STR(index.countEntries));
+  LOG4CXX_DEBUG(logger, "rightcnt: " + TO_STR(indexNew.countEntries));
 
-  // Pointer weitersetzen um die Hälfte
+  if (index.encodedSize(keyLen, tidsPerEntry) > file.getBlockSize()
+      || indexNew.encodedSize(keyLen, tidsPerEntry) > file.getBlockSize()) {
+    throw DBIndexException("Invalid Entries size");
+  }
+
+  // Rohdaten in Block schreiben
+  index.write(blockToSplit.getDataPtr(), keyLen, tidsPerEntry);
   blockToSplit.setModified();
 
-  // neue LEERE Seite am Ende einfuegen + locken + modify date setzen
+  // neue LEERE Seite nach der geteilten Seite einfuegen + locken + modify date setzen
   insertEmptyPage(blockToSplit.getBlockNo() + 1);
 
   DBBACB newBlock = bufMgr.fixBlock(file, blockToSplit.getBlockNo() + 1, LOCK_EXCLUSIVE);
-  bacbStack.push(newBlock);
+  indexNew.write(newBlock.getDataPtr(), keyLen, tidsPerEntry);
   newBlock.setModified();
-
-  // Pointer auf Anfang des neuen Blocks
-  std::shared_ptr<SequentialIndex> indexNew = SequentialIndex::read(newBlock.getDataPtr(), attrType, tidsPerEntry);
-
-  // Zukünftigen Anzahl von Werten auf der neuen Seite ausrechnen
-  // (Gesamtanzahl minus Anzahl nach der geteilt wird auf der alten Seite)
-  indexNew->countEntries = entriesPerPage() - index->countEntries;
-
-  LOG4CXX_DEBUG(logger, "rightcnt: " + TO_STR(indexNew->countEntries));
-
-  // Die Daten von der alten Seite auf die neue Seite kopieren (also Werte und TIDs)
-  indexNew->entries.assign(index->entries.begin()+index->countEntries, index->entries.end());
-  index->entries.erase(index->entries.begin()+index->countEntries, index->entries.end());
-
-  if (indexNew->entries.size() != indexNew->countEntries
-      || index->entries.size() != index->countEntries) {
-    throw DBIndexException("Invalid Entries size");
-  }
+  bufMgr.unfixBlock(newBlock);
 
   // do not check this block a second time
   ++blockNo;
-
-  // Rohdaten in Block schreibe
-  index->write(blockToSplit.getDataPtr(), attrType, tidsPerEntry);
-  indexNew->write(newBlock.getDataPtr(), attrType, tidsPerEntry);
-
-  // wenn die Position bei der geteilt wurde, größer ist als die Position bei der ich einfügen will,
-  // dann kann der rechte lock freigegeben werden... alles weitere passiert im linken block
-  if (posToInsert <= index->countEntries) {
-    LOG4CXX_DEBUG(logger, "unfix right page");
-    bufMgr.unfixBlock(newBlock);
-    bacbStack.pop();
-  }
-    //  ansonsten liegt die Position auf der neuen Seite
-    //  (minimiert um die Anzahl der Werte die auf der alten Seiten geblieben sind )
-  else {
-    posToInsert -= index->countEntries;
-    unfix = true;
-    LOG4CXX_DEBUG(logger, "new posToInsert: " + TO_STR(posToInsert));
-  }
 }
 
 /**
@@ -887,7 +963,7 @@ void DBSeqIndex::insertEmptyPage(BlockNo pos) {
     DBBACB right = bacbStack.top();
 
     // Dann den Inhalt der Seite Left in die Seite Right kopieren
-    memcpy(right.getDataPtr(), left.getDataPtr(), DBFileBlock::getBlockSize());
+    memcpy(right.getDataPtr(), left.getDataPtr(), file.getBlockSize());
     right.setModified();
 
     // unfix und entfernen vom Stack
@@ -900,7 +976,7 @@ void DBSeqIndex::insertEmptyPage(BlockNo pos) {
   // nachdem alle Seite von pos bis zum Ende (wo jetzt die neue Seite ist) eine Position weiter
   // geschoben wurden, kann die Seite an Stelle pos mit 0en überschrieben werden
   DBBACB newPage = bacbStack.top();
-  memset(newPage.getDataPtr(), 0, DBFileBlock::getBlockSize());
+  memset(newPage.getDataPtr(), 0, file.getBlockSize());
   newPage.setModified();
 
   // wenn die pos Seite nicht die rootSeite ist, dann unlocken
@@ -941,7 +1017,7 @@ void DBSeqIndex::removeEmptyPage(BlockNo blockNoToRemove) {
       DBBACB left = bacbStack.top();
       DBBACB right = bufMgr.fixBlock(file, i, LOCK_EXCLUSIVE);
 
-      memcpy(left.getDataPtr(), right.getDataPtr(), DBFileBlock::getBlockSize());
+      memcpy(left.getDataPtr(), right.getDataPtr(), file.getBlockSize());
       left.setModified();
 
       // unfix und entfernen vom Stack
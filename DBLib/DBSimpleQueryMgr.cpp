@@ -1,8 +1,12 @@
 #include <hubDB/DBSimpleQueryMgr.h>
 #include <hubDB/DBTable.h>
 #include <hubDB/DBIndex.h>
+#include <hubDB/DBTempFile.h>
+#include <hubDB/DBFileBlock.h>
 #include <hubDB/DBException.h>
 
+#include <cmath>
+
 using namespace HubDB::Exception;
 using namespace HubDB::Manager;
 using namespace HubDB::Table;
@@ -44,124 +48,469 @@ void DBSimpleQueryMgr::selectJoinTuple(DBTable *table[2],
                                        DBListPredicate where[2],
                                        DBListJoinTuple &tuples) {
   LOG4CXX_INFO(logger, "selectJoinTuple()");
+  uint attrMask[2] = {ALL_ATTRS, ALL_ATTRS};
+  DBOperator *op = joinOperator(table, attrJoinPos, where, attrMask);
+  try {
+    op->fetchAll(tuples);
+  } catch (DBException e) {
+    delete op;
+    throw e;
+  }
+  delete op;
+}
+
+DBOperator *DBSimpleQueryMgr::joinOperator(DBTable *table[2],
+                                           uint attrJoinPos[2],
+                                           DBListPredicate where[2],
+                                           uint attrMask[2]) {
+  LOG4CXX_INFO(logger, "joinOperator()");
+  // every input needs its join attribute
+  uint mask[2];
+  for (uint i = 0; i < 2; ++i)
+    mask[i] = attrMask[i] | (1u << attrJoinPos[i]);
+
+  // with statistics of both tables the cost model chooses the algorithm,
+  // otherwise the sizes of the inputs decide
+  DBTableStats stats[2];
+  bool analyzed = true;
+  for (uint i = 0; i < 2; ++i) {
+    if (sysCatMgr.readStatistics(connectDB, table[i]->getRelDef().relationName(), stats[i]) == false)
+      analyzed = false;
+  }
+  JoinAlgoEnum algo = JOIN_HASH;
+  uint side = 0;
+  double estRows = -1;
+  if (analyzed == true)
+    algo = joinPlan(table, attrJoinPos, where, stats, side, estRows);
+  DBOperator *op = NULL;
 
-  DBListTuple l[2];
+  // two large inputs without further predicates are merged in the order of
+  // their indexes, neither table is scanned nor sorted (without statistics)
+  bool large = true;
   for (uint i = 0; i < 2; ++i) {
-    selectTuple(table[i], where[i], l[i]);
-  }
-  DBListTuple::iterator i = l[0].begin();
-  while (i != l[0].end()) {
-    DBTuple &left = (*i);
-
-    DBListTuple::iterator u = l[1].begin();
-    while (u != l[1].end()) {
-      DBTuple &right = (*u);
-
-      if (left.getAttrVal(attrJoinPos[0]) == right.getAttrVal(attrJoinPos[1])) {
-        LOG4CXX_DEBUG(logger, "left:\n" + left.toString("\t"));
-        LOG4CXX_DEBUG(logger, "right:\n" + right.toString("\t"));
-        pair<DBTuple, DBTuple> p;
-        p.first = left;
-        p.second = right;
-        tuples.push_back(p);
+    if (where[i].empty() == false ||
+        table[i]->getPageCnt() * table[i]->tuplesPerPage() <= DBPartitionedHashJoinOp::memTuples(table[i]->getRelDef()))
+      large = false;
+  }
+  // the index keys are only comparable for attributes of the same type
+  bool sameType = table[0]->getRelDef().attrDef(attrJoinPos[0]).attrType() ==
+                  table[1]->getRelDef().attrDef(attrJoinPos[1]).attrType();
+  if ((analyzed == false && large == true && sameType == true) || algo == JOIN_INDEX_MERGE)
+    op = indexMergeJoin(table, attrJoinPos, mask);
+
+  // index nested-loop join: if the join attribute of one table (the larger one
+  // if both) is indexed, the outer input probes the index and only matching
+  // pages are read. Without statistics the hash join reads the outer input
+  // first and switches to the index if it has fewer tuples than that table has pages.
+  int inner = (op == NULL && algo == JOIN_INDEX_NESTED_LOOP) ? side : -1;
+  for (uint i = 0; op == NULL && analyzed == false && sameType == true && i < 2; ++i) {
+    if (table[i]->getRelDef().attrDef(attrJoinPos[i]).isIndexed() == true &&
+        (inner < 0 || table[i]->getPageCnt() > table[inner]->getPageCnt()))
+      inner = i;
+  }
+  DBIndex *index = NULL;
+  DBOperator *input[2] = {NULL, NULL};
+  try {
+    if (op == NULL && inner >= 0) {
+      const DBRelDef &def = table[inner]->getRelDef();
+      QualifiedName qname;
+      strcpy(qname.relationName, def.relationName().c_str());
+      strcpy(qname.attributeName, def.attrDef(attrJoinPos[inner]).attrName().c_str());
+      index = sysCatMgr.openIndex(connectDB, qname, READ);
+    }
+    if (op == NULL && analyzed == true && inner >= 0) {
+      uint outer = 1 - inner;
+      input[outer] = scanOperator(table[outer], where[outer], mask[outer]);
+      op = new DBIndexJoinOp(input[outer], inner, *table[inner], index, attrJoinPos, where[inner], mask[inner]);
+      input[outer] = NULL;
+      index = NULL;
+    } else if (op == NULL) {
+      // the hash join reads the outer input of the index or the estimated build side first
+      for (uint i = 0; i < 2; ++i)
+        input[i] = scanOperator(table[i], where[i], mask[i]);
+      uint first = (inner >= 0) ? 1 - inner : side;
+      DBPartitionedHashJoinOp *join = new DBPartitionedHashJoinOp(input[0], input[1], first, sysCatMgr, connectDB,
+                                                                  table[0]->getRelDef(), table[1]->getRelDef(), attrJoinPos);
+      input[0] = input[1] = NULL;
+      if (index != NULL)
+        join->setIndexJoin(*table[inner], index, where[inner], mask[inner], table[inner]->getPageCnt());
+      index = NULL;
+      op = join;
+    }
+  } catch (DBException e) {
+    if (index != NULL)
+      delete index;
+    for (uint i = 0; i < 2; ++i) {
+      if (input[i] != NULL)
+        delete input[i];
+    }
+    throw e;
+  }
+  op->setEstimate(estRows);
+  return op;
+}
+
+/**
+ * Page reads to fetch rows tuples at random positions of a table with the given
+ * number of pages; a page holding several of them is read once (Cardenas)
+ */
+double DBSimpleQueryMgr::fetchCost(double pages, double rows) {
+  if (pages < 1 || rows <= 0)
+    return 0;
+  return COST_RANDOM_PAGE * pages * (1 - pow(1 - 1 / pages, rows));
+}
+
+/**
+ * Page reads of an index lookup returning rows TIDs from pages of blockSize bytes
+ */
+double DBSimpleQueryMgr::indexCost(double rows, uint blockSize) {
+  return COST_INDEX_PROBE + rows * sizeof(TID) / blockSize;
+}
+
+static bool lessRows(const pair<double, DBPredicate *> &a, const pair<double, DBPredicate *> &b) {
+  return a.first < b.first;
+}
+
+/**
+ * Estimates the cheapest access path from the statistics: a full scan, the
+ * most selective index or the intersection of the most selective indexes
+ * @param indexPreds returns the predicates answered by indexes, empty for a full scan
+ * @param estRows returns the estimated number of selected tuples
+ * @return estimated cost in pages
+ */
+double DBSimpleQueryMgr::accessPath(DBTable *table,
+                                    DBListPredicate &where,
+                                    const DBTableStats &stats,
+                                    vector<DBPredicate *> &indexPreds,
+                                    double &estRows) {
+  LOG4CXX_INFO(logger, "accessPath()");
+  const DBRelDef &def = table->getRelDef();
+  double pages = table->getPageCnt();
+  double rows = stats.rows(table->getPageCnt());
+  estRows = rows * stats.selectivity(def, where);
+
+  vector<pair<double, DBPredicate *> > cand;
+  DBListPredicate::iterator u = where.begin();
+  while (u != where.end()) {
+    DBAttrDef adef = def.attrDef((*u).name().attributeName);
+    if (adef.isIndexed() == true)
+      cand.push_back(make_pair(rows * stats.selectivity(adef.attrPos(), (*u).val()), &*u));
+    ++u;
+  }
+  stable_sort(cand.begin(), cand.end(), lessRows);
+
+  // a full scan reads every page once; each further index is only added to the
+  // intersection if the pages it saves outweigh reading its TIDs
+  double best = pages;
+  uint bestCnt = 0;
+  double cost = 0;
+  double sel = 1.0;
+  for (uint n = 0; n < cand.size(); ++n) {
+    cost += indexCost(cand[n].first, table->getBlockSize());
+    sel *= (rows > 0) ? cand[n].first / rows : 0;
+    if (cost + fetchCost(pages, rows * sel) < best) {
+      best = cost + fetchCost(pages, rows * sel);
+      bestCnt = n + 1;
+    }
+  }
+  indexPreds.clear();
+  for (uint n = 0; n < bestCnt; ++n)
+    indexPreds.push_back(cand[n].second);
+  LOG4CXX_DEBUG(logger, "cost: " + TO_STR(best) + " rows: " + TO_STR(estRows) + " indexes: " + TO_STR(bestCnt));
+  return best;
+}
+
+/**
+ * Reads the tuples through the indexes of the given predicates: a single index
+ * drives a cursor, several indexes are intersected as TID bitmaps.
+ * The remaining predicates are checked per tuple.
+ */
+DBOperator *DBSimpleQueryMgr::indexAccess(DBTable *table,
+                                          DBListPredicate &where,
+                                          uint attrMask,
+                                          const vector<DBPredicate *> &indexPreds) {
+  LOG4CXX_INFO(logger, "indexAccess()");
+  const DBRelDef &def = table->getRelDef();
+  list<bool> checkList;
+  DBListPredicate::iterator u = where.begin();
+  while (u != where.end()) {
+    attrMask |= 1u << def.attrDef((*u).name().attributeName).attrPos();
+    checkList.push_back(find(indexPreds.begin(), indexPreds.end(), &*u) == indexPreds.end());
+    ++u;
+  }
+
+  QualifiedName qname;
+  strcpy(qname.relationName, def.relationName().c_str());
+  DBIndex *index = NULL;
+  DBOperator *op = NULL;
+  DBTIDBitmap bitmap;
+  try {
+    for (uint n = 0; op == NULL && n < indexPreds.size(); ++n) {
+      const DBAttrType &val = indexPreds[n]->val();
+      strcpy(qname.attributeName, indexPreds[n]->name().attributeName);
+      index = sysCatMgr.openIndex(connectDB, qname, READ);
+      DBTIDBitmap tids;
+      if (index->findBitmap(val, tids) == false) {
+        if (indexPreds.size() == 1) {
+          op = new DBIndexScanOp(*table, index, val, attrMask);
+          index = NULL;
+          break;
+        }
+        // the TIDs of other indexes are collected into a bitmap to intersect them
+        DBTIDBatch batch;
+        index->openCursor(val);
+        while (index->nextBatch(batch) == true) {
+          for (uint t = 0; t < batch.size(); ++t)
+            tids.add(batch[t]);
+        }
+        index->closeCursor();
       }
-      ++u;
+      delete index;
+      index = NULL;
+      if (n == 0)
+        bitmap.swap(tids);
+      else
+        bitmap.andWith(tids);
     }
-    ++i;
+    if (op == NULL)
+      op = new DBBitmapScanOp(*table, bitmap, attrMask);
+  } catch (DBException e) {
+    if (index != NULL)
+      delete index;
+    throw e;
   }
+  return new DBFilterOp(op, def, where, checkList);
+}
+
+/**
+ * Chooses the join algorithm and the order of the inputs with the lowest
+ * estimated cost
+ * @param side returns the inner input of an index nested-loop join or the
+ * build input of a hash join
+ */
+DBSimpleQueryMgr::JoinAlgoEnum DBSimpleQueryMgr::joinPlan(DBTable *table[2],
+                                                          uint attrJoinPos[2],
+                                                          DBListPredicate where[2],
+                                                          const DBTableStats stats[2],
+                                                          uint &side,
+                                                          double &estRows) {
+  LOG4CXX_INFO(logger, "joinPlan()");
+  double pages[2], rows[2], est[2], access[2], distinct[2];
+  bool indexed[2];
+  for (uint i = 0; i < 2; ++i) {
+    vector<DBPredicate *> indexPreds;
+    DBAttrDef adef = table[i]->getRelDef().attrDef(attrJoinPos[i]);
+    pages[i] = table[i]->getPageCnt();
+    rows[i] = stats[i].rows(table[i]->getPageCnt());
+    access[i] = accessPath(table[i], where[i], stats[i], indexPreds, est[i]);
+    distinct[i] = max(1u, stats[i].attrs[attrJoinPos[i]].distinct);
+    indexed[i] = adef.isIndexed();
+  }
+  bool sameType = table[0]->getRelDef().attrDef(attrJoinPos[0]).attrType() ==
+                  table[1]->getRelDef().attrDef(attrJoinPos[1]).attrType();
+
+  // hash join: both inputs are read once, the smaller one is the build side;
+  // if it exceeds the memory budget, both inputs are written to partitions and read again
+  JoinAlgoEnum algo = JOIN_HASH;
+  side = (est[1] < est[0]) ? 1 : 0;
+  double best = access[0] + access[1];
+  if (est[side] > DBPartitionedHashJoinOp::memTuples(table[side]->getRelDef())) {
+    for (uint i = 0; i < 2; ++i)
+      best += 2 * est[i] / table[i]->tuplesPerPage();
+  }
+
+  // index nested-loop join: every outer tuple probes the index of the inner
+  // input and reads the pages of its join partners
+  for (uint i = 0; sameType == true && i < 2; ++i) {
+    double cost = access[1 - i] + est[1 - i] * (COST_INDEX_PROBE + fetchCost(pages[i], rows[i] / distinct[i]));
+    if (indexed[i] == true && cost < best) {
+      best = cost;
+      algo = JOIN_INDEX_NESTED_LOOP;
+      side = i;
+    }
+  }
+
+  // index merge join: both indexes are read in key order, the tuples of each key are fetched together
+  if (sameType == true && indexed[0] == true && indexed[1] == true &&
+      where[0].empty() == true && where[1].empty() == true) {
+    double cost = 0;
+    for (uint i = 0; i < 2; ++i)
+      cost += indexCost(rows[i], table[i]->getBlockSize()) + distinct[i] * fetchCost(pages[i], rows[i] / distinct[i]);
+    if (cost < best) {
+      best = cost;
+      algo = JOIN_INDEX_MERGE;
+    }
+  }
+  estRows = est[0] * est[1] / max(distinct[0], distinct[1]);
+  LOG4CXX_DEBUG(logger, "algo: " + TO_STR(algo) + " side: " + TO_STR(side) + " cost: " + TO_STR(best) +
+                        " rows: " + TO_STR(estRows));
+  return algo;
+}
+
+/**
+ * Merges both inputs in the order of ordered indexes on their join attributes
+ * @return NULL if one of the join attributes has no ordered index
+ */
+DBOperator *DBSimpleQueryMgr::indexMergeJoin(DBTable *table[2], uint attrJoinPos[2], uint attrMask[2]) {
+  LOG4CXX_INFO(logger, "indexMergeJoin()");
+  DBIndex *index[2] = {NULL, NULL};
+  DBOperator *scan[2] = {NULL, NULL};
+  try {
+    for (uint i = 0; i < 2; ++i) {
+      const DBRelDef &def = table[i]->getRelDef();
+      DBAttrDef adef = def.attrDef(attrJoinPos[i]);
+      if (adef.isIndexed() == false)
+        break;
+      QualifiedName qname;
+      strcpy(qname.relationName, def.relationName().c_str());
+      strcpy(qname.attributeName, adef.attrName().c_str());
+      index[i] = sysCatMgr.openIndex(connectDB, qname, READ);
+      bool ordered = index[i]->openOrderedCursor();
+      index[i]->closeCursor();
+      if (ordered == false)
+        break;
+      scan[i] = new DBOrderedIndexScanOp(*table[i], index[i], attrMask[i]);
+      index[i] = NULL;
+    }
+  } catch (DBException e) {
+    for (uint i = 0; i < 2; ++i) {
+      if (index[i] != NULL)
+        delete index[i];
+      if (scan[i] != NULL)
+        delete scan[i];
+    }
+    throw e;
+  }
+  if (scan[0] != NULL && scan[1] != NULL)
+    return new DBMergeJoinOp(scan[0], scan[1], attrJoinPos);
+  for (uint i = 0; i < 2; ++i) {
+    if (index[i] != NULL)
+      delete index[i];
+    if (scan[i] != NULL)
+      delete scan[i];
+  }
+  return NULL;
 }
 
 void DBSimpleQueryMgr::selectTuple(DBTable *table, DBListPredicate &where, DBListTuple &tuple) {
   LOG4CXX_INFO(logger, "selectTuple()");
+  fetchTuples(table, where, ALL_ATTRS, tuple);
+}
+
+/**
+ * Collects the tuples of scanOperator(), decoding only the attributes in attrMask
+ */
+void DBSimpleQueryMgr::fetchTuples(DBTable *table, DBListPredicate &where, uint attrMask, DBListTuple &tuple) {
+  LOG4CXX_INFO(logger, "fetchTuples()");
+  DBListJoinTuple rows;
+  DBOperator *op = scanOperator(table, where, attrMask);
+  try {
+    op->fetchAll(rows);
+  } catch (DBException e) {
+    delete op;
+    throw e;
+  }
+  delete op;
+  DBOperator::fromRows(rows, tuple);
+  LOG4CXX_DEBUG(logger, "return");
+}
+
+DBOperator *DBSimpleQueryMgr::scanOperator(DBTable *table, DBListPredicate &where, uint attrMask) {
+  LOG4CXX_INFO(logger, "scanOperator()");
   LOG4CXX_DEBUG(logger, "table:\n" + table->toString("\t"));
   LOG4CXX_DEBUG(logger, "where: " + TO_STR(where));
 
-  DBListTuple l;
-  TID t;
-  t.page = 0;
-  t.slot = 0;
-  list<uint> posList;
   list<bool> checkList;
-  DBListTID tidList;
   const DBRelDef &def = table->getRelDef();
   QualifiedName qname;
-  bool indexUsed = false;
+  DBIndex *cursorIndex = NULL;
+  DBPredicate *cursorPred = NULL;
+  list<bool>::iterator cursorCheck;
+  DBTIDBitmap bitmap;
+  bool bitmapUsed = false;
+  DBOperator *op = NULL;
 
   strcpy(qname.relationName, def.relationName().c_str());
 
-  DBListPredicate::iterator u = where.begin();
-  while (u != where.end()) {
-    DBPredicate &p = *u;
-    if (strcmp(def.relationName().c_str(), p.name().relationName) != 0)
-      throw DBQueryMgrException("Predicate missmatch");
-    DBAttrDef adef = def.attrDef(p.name().attributeName);
-    if (adef.isIndexed() == true) {
-      checkList.push_back(false);
-      strcpy(qname.attributeName, adef.attrName().c_str());
-      DBListTID tidListTmp;
-      DBIndex *index = NULL;
-      try {
-        index = sysCatMgr.openIndex(connectDB, qname, READ);
-        if (indexUsed == true) {
-          index->find(p.val(), tidListTmp);
-          tidListTmp.sort();
-        } else {
-          index->find(p.val(), tidList);
-          tidList.sort();
+  // with statistics the cost model chooses the access path
+  DBTableStats stats;
+  if (where.empty() == false && sysCatMgr.readStatistics(connectDB, def.relationName(), stats) == true) {
+    vector<DBPredicate *> indexPreds;
+    double estRows;
+    accessPath(table, where, stats, indexPreds, estRows);
+    if (indexPreds.empty() == true)
+      op = new DBScanOp(*table, where, attrMask);
+    else
+      op = indexAccess(table, where, attrMask, indexPreds);
+    op->setEstimate(estRows);
+    return op;
+  }
+
+  try {
+    // predicates on bitmap indexes are intersected without touching the table,
+    // otherwise the first indexed predicate drives an index cursor;
+    // all remaining predicates are checked per tuple
+    DBListPredicate::iterator u = where.begin();
+    while (u != where.end()) {
+      DBPredicate &p = *u;
+      if (strcmp(def.relationName().c_str(), p.name().relationName) != 0)
+        throw DBQueryMgrException("Predicate missmatch");
+      DBAttrDef adef = def.attrDef(p.name().attributeName);
+      attrMask |= 1u << adef.attrPos();
+      bool check = true;
+      if (adef.isIndexed() == true) {
+        strcpy(qname.attributeName, adef.attrName().c_str());
+        DBIndex *index = sysCatMgr.openIndex(connectDB, qname, READ);
+        DBTIDBitmap tids;
+        bool isBitmap;
+        try {
+          isBitmap = index->findBitmap(p.val(), tids);
+        } catch (DBException e) {
+          delete index;
+          throw e;
         }
-        delete index;
-      } catch (DBException e) {
-        if (index != NULL)
+        if (isBitmap == true) {
           delete index;
-        throw e;
-      }
-      if (indexUsed == true) {
-        DBListTID tidListNew;
-        set_intersection(tidList.begin(), tidList.end(), tidListTmp.begin(), tidListTmp.end(),
-                         std::inserter(tidListNew, tidListNew.begin()));
-        tidList = tidListNew;
-      } else {
-        indexUsed = true;
+          if (bitmapUsed == true) {
+            bitmap.andWith(tids);
+          } else {
+            bitmap.swap(tids);
+            bitmapUsed = true;
+          }
+          LOG4CXX_DEBUG(logger, "bitmap:\n" + bitmap.toString("\t"));
+          check = false;
+        } else if (cursorIndex == NULL) {
+          cursorIndex = index;
+          cursorPred = &p;
+          check = false;
+        } else {
+          delete index;
+        }
       }
-      LOG4CXX_DEBUG(logger, "tidList: " + TO_STR(tidList));
-      if (tidList.size() == 0)
-        break;
-    } else {
-      checkList.push_back(true);
+      checkList.push_back(check);
+      if (cursorPred == &p)
+        cursorCheck = --checkList.end();
+      ++u;
     }
-    posList.push_back(adef.attrPos());
-    ++u;
-  }
 
-  do {
-    l.clear();
-    if (indexUsed == true) {
-      table->readTIDs(tidList, l);
-    } else {
-      t = table->readSeqFromTID(t, 100, l);
-    }
-    LOG4CXX_DEBUG(logger, "read " + TO_STR(l.size()) + " tuples");
-    DBListTuple::iterator i = l.begin();
-    while (l.end() != i) {
-      bool match = true;
-      u = where.begin();
-      list<uint>::iterator ii = posList.begin();
-      list<bool>::iterator ic = checkList.begin();
-      while (match == true && u != where.end()) {
-        DBPredicate &p = *u;
-        if (*ic == true &&
-            !(p.val() == (*i).getAttrVal(*ii)))
-          match = false;
-        ++ii;
-        ++ic;
-        ++u;
-      }
-      if (match == true) {
-        LOG4CXX_DEBUG(logger, "tuple: " + (*i).toString("\t"));
-        tuple.push_back(*i);
+    if (bitmapUsed == true) {
+      if (cursorIndex != NULL) {
+        *cursorCheck = true;
+        delete cursorIndex;
+        cursorIndex = NULL;
       }
-      ++i;
+      op = new DBBitmapScanOp(*table, bitmap, attrMask);
+    } else if (cursorIndex != NULL) {
+      op = new DBIndexScanOp(*table, cursorIndex, cursorPred->val(), attrMask);
+      cursorIndex = NULL;
+    } else {
+      // the scan itself checks all predicates on the page bytes
+      return new DBScanOp(*table, where, attrMask);
     }
-  } while (l.size() == 100 && indexUsed == false);
-  LOG4CXX_DEBUG(logger, "return");
+  } catch (DBException e) {
+    if (cursorIndex != NULL)
+      delete cursorIndex;
+    throw e;
+  }
+  return new DBFilterOp(op, def, where, checkList);
 }
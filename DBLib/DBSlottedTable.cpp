@@ -0,0 +1,565 @@
+#include <hubDB/DBSlottedTable.h>
+#include <hubDB/DBFileBlock.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Table;
+using namespace HubDB::Exception;
+
+LoggerPtr DBSlottedTable::logger(Logger::getLogger("HubDB.Table.DBSlottedTable"));
+
+const uint16_t DBSlottedTable::OVERFLOW_LEN(0xFFFF);
+
+DBSlottedTable::DBSlottedTable(DBBufferMgr &bufMgr, DBFile &file, DBFile &fsmFile, DBFile &overflowFile,
+                               const DBRelDef &rel, ModType mode, DBFile *zoneFile) :
+        DBTable(bufMgr, file, fsmFile, rel, mode, zoneFile),
+        overflowFile(overflowFile) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBSlottedTable()");
+}
+
+void DBSlottedTable::initializeTable(DBBufferMgr &bufMgr, DBFile &file) {
+  LOG4CXX_INFO(logger, "initializeTable()");
+  if (bufMgr.getBlockCount(file) != 0)
+    throw DBTableException("can not initializie exisiting table");
+
+  DBBACB bacb = bufMgr.fixNewBlock(file);
+  initPage(bacb.getDataPtr(), file.getBlockSize());
+  bacb.setModified();
+  bufMgr.unfixBlock(bacb);
+}
+
+/**
+ * Longest record kept in a page, a page with free space holds at least one more
+ */
+size_t DBSlottedTable::maxRecordSize() {
+  return (file.getBlockSize() - sizeof(slottedPageLayout)) / 4 - sizeof(slotEntry);
+}
+
+uint DBSlottedTable::tuplesPerPage() {
+  size_t size = 1 + sizeof(slotEntry);
+  for (uint i = 0; i < rel.attrCnt(); ++i) {
+    DBAttrDef attr = rel.attrDef(i);
+    if (attr.attrType() == VCHAR)
+      size += sizeof(uint16_t) + min(attr.attrLen(), MAX_STR_LEN);
+    else
+      size += DBAttrType::getSize4Type(attr.attrType());
+  }
+  return (file.getBlockSize() - sizeof(slottedPageLayout)) / size;
+}
+
+bool DBSlottedTable::hasFreeSpace(const DBBACB &bacb) {
+  return ((const slottedPageLayout *) bacb.getDataPtr())->freeBytes >= maxRecordSize() + sizeof(slotEntry);
+}
+
+void DBSlottedTable::initPage(char *ptr, uint blockSize) {
+  memset(ptr, 0, blockSize);
+  slottedPageLayout *page = (slottedPageLayout *) ptr;
+  page->dataStart = blockSize;
+  page->freeBytes = blockSize - sizeof(slottedPageLayout);
+}
+
+/**
+ * A record of len bytes fits, a free slot is used before the directory grows
+ */
+bool DBSlottedTable::hasRoom(const char *ptr, size_t len) {
+  const slottedPageLayout *page = (const slottedPageLayout *) ptr;
+  if (page->tupleCnt == page->slotCnt)
+    len += sizeof(slotEntry);
+  return page->freeBytes >= len;
+}
+
+const char *DBSlottedTable::getRecord(const char *ptr, uint slot) {
+  const slottedPageLayout *page = (const slottedPageLayout *) ptr;
+  const slotEntry *slots = (const slotEntry *) (ptr + sizeof(slottedPageLayout));
+  if (slot >= page->slotCnt || slots[slot].offset == 0)
+    return NULL;
+  return ptr + slots[slot].offset;
+}
+
+/**
+ * Encodes the tuple into rec, the longest values are moved to the overflow
+ * file until the record fits maxRecordSize(); the size is checked before
+ * any value is written
+ */
+void DBSlottedTable::encode(const DBTuple &tuple) {
+  const size_t refSize = sizeof(uint16_t) + sizeof(overflowRef);
+  size_t size = 1 + tuple.recordSize(rel);
+  uint overflowMask = 0;
+  while (size > maxRecordSize()) {
+    uint longest = rel.attrCnt();
+    size_t len = refSize;
+    for (uint i = 0; i < rel.attrCnt(); ++i) {
+      if (rel.attrTypeDef(i) == VCHAR && (overflowMask & (1u << i)) == 0 &&
+          tuple.getAttrVal(i).recordSize() > len) {
+        longest = i;
+        len = tuple.getAttrVal(i).recordSize();
+      }
+    }
+    if (longest == rel.attrCnt())
+      throw DBTableException("tuple too large");
+    overflowMask |= 1u << longest;
+    size -= len - refSize;
+  }
+
+  rec.resize(size);
+  char *ptr = &rec[0];
+  *ptr++ = overflowMask != 0 ? 1 : 0;
+  if (overflowMask == 0) {
+    tuple.writeRecord(rel, ptr);
+    return;
+  }
+  // chains written before a failing one would otherwise be lost
+  vector<BlockNo> chains;
+  try {
+    for (uint i = 0; i < rel.attrCnt(); ++i) {
+      if ((overflowMask & (1u << i)) != 0) {
+        const string &val = ((const DBVCharType &) tuple.getAttrVal(i)).getVal();
+        overflowRef ref;
+        ref.len = val.size();
+        ref.first = writeOverflow(val);
+        chains.push_back(ref.first);
+        memcpy(ptr, &OVERFLOW_LEN, sizeof(OVERFLOW_LEN));
+        memcpy(ptr + sizeof(OVERFLOW_LEN), &ref, sizeof(ref));
+        ptr += refSize;
+      } else {
+        ptr = tuple.getAttrVal(i).writeRecord(ptr);
+      }
+    }
+  } catch (DBException e) {
+    for (uint c = 0; c < chains.size(); ++c)
+      freeChain(chains[c]);
+    throw e;
+  }
+}
+
+void DBSlottedTable::decode(const char *ptr, DBTuple &tuple, uint attrMask) {
+  if (*ptr++ == 0) {
+    tuple.readRecord(rel, ptr, attrMask);
+    return;
+  }
+  for (uint i = 0; i < rel.attrCnt(); ++i) {
+    AttrTypeEnum type = rel.attrTypeDef(i);
+    bool read = (attrMask & (1u << i)) != 0;
+    uint16_t len = 0;
+    if (type == VCHAR)
+      memcpy(&len, ptr, sizeof(len));
+    if (type == VCHAR && len == OVERFLOW_LEN) {
+      overflowRef ref;
+      memcpy(&ref, ptr + sizeof(len), sizeof(ref));
+      ptr += sizeof(len) + sizeof(ref);
+      if (read == true) {
+        DBVCharType val(readOverflow(ref));
+        tuple.appendAttrVal(&val);
+      } else {
+        tuple.appendAttrVal(NULL);
+      }
+    } else if (read == true) {
+      DBAttrType *val = DBAttrType::readRecord(ptr, type, &ptr);
+      tuple.appendAttrVal(val);
+      delete val;
+    } else {
+      tuple.appendAttrVal(NULL);
+      ptr += DBAttrType::getRecordSize(ptr, type);
+    }
+  }
+}
+
+/**
+ * Moves the records to the end of the page, so that the gaps of removed
+ * records become one free area in front of them
+ */
+void DBSlottedTable::compactPage(char *ptr) {
+  LOG4CXX_INFO(logger, "compactPage()");
+  vector<char> copy(ptr, ptr + file.getBlockSize());
+  slottedPageLayout *page = (slottedPageLayout *) ptr;
+  slotEntry *slots = (slotEntry *) (ptr + sizeof(slottedPageLayout));
+  uint end = file.getBlockSize();
+  for (uint s = 0; s < page->slotCnt; ++s) {
+    if (slots[s].offset != 0) {
+      end -= slots[s].len;
+      memcpy(ptr + end, &copy[slots[s].offset], slots[s].len);
+      slots[s].offset = end;
+    }
+  }
+  page->dataStart = end;
+}
+
+/**
+ * Writes rec into a free slot of the page on top of the stack
+ * @return the slot
+ */
+uint DBSlottedTable::placeRecord(DBTuple &tuple) {
+  char *ptr = bacbStack.top().getDataPtr();
+  slottedPageLayout *page = (slottedPageLayout *) ptr;
+  slotEntry *slots = (slotEntry *) (ptr + sizeof(slottedPageLayout));
+  assert(hasRoom(ptr, rec.size()) == true);
+
+  uint pos = 0;
+  if (page->tupleCnt < page->slotCnt) {
+    while (slots[pos].offset != 0)
+      ++pos;
+  } else {
+    pos = page->slotCnt;
+  }
+  size_t need = rec.size() + (pos == page->slotCnt ? sizeof(slotEntry) : 0);
+  size_t directory = sizeof(slottedPageLayout) + page->slotCnt * sizeof(slotEntry);
+  if (directory + need > page->dataStart)
+    compactPage(ptr);
+  if (pos == page->slotCnt)
+    ++page->slotCnt;
+  page->dataStart -= rec.size();
+  memcpy(ptr + page->dataStart, &rec[0], rec.size());
+  slots[pos].offset = page->dataStart;
+  slots[pos].len = rec.size();
+  page->freeBytes -= need;
+  ++page->tupleCnt;
+  bacbStack.top().setModified();
+
+  TID t;
+  t.page = bacbStack.top().getBlockNo();
+  t.slot = pos;
+  tuple.setTID(t);
+  for (uint u = 0; u < uniqueKeys.size(); ++u)
+    uniqueKeys[u].insert(tuple.getAttrVal(uniqueAttrs[u]).normalizedKey());
+  if (zoneMap != NULL) {
+    if (zoneMap->isValid(t.page) == true)
+      zoneMap->add(t.page, tuple);
+    else
+      summarizePage(bacbStack.top());
+  }
+  return pos;
+}
+
+void DBSlottedTable::insert(DBTuple &tuple) {
+  LOG4CXX_INFO(logger, "insert()");
+  LOG4CXX_DEBUG(logger, "tuple:\n" + tuple.toString("\t"));
+
+  if (bacbStack.size() != 1)
+    throw DBTableException("BACB Stack is invalid");
+
+  assertUnique(tuple);
+  if (fsm.isBuilt() == false)
+    buildFreeSpaceMap();
+  encode(tuple);
+
+  bool found = false;
+  BlockNo n;
+  while (found == false && fsm.findFree(n) == true) {
+    LOG4CXX_DEBUG(logger, "n: " + TO_STR(n));
+    fixPage(n);
+    found = hasRoom(bacbStack.top().getDataPtr(), rec.size());
+    if (found == false) {
+      // stale entry
+      fsm.setFree(n, false);
+      unfixPage();
+    }
+  }
+  // the bit of a page is reset below maxRecordSize(), shorter records still fit
+  bool bit = found;
+  if (found == false) {
+    fixPage(bufMgr.getBlockCount(file) - 1);
+    found = hasRoom(bacbStack.top().getDataPtr(), rec.size());
+    if (found == false)
+      unfixPage();
+  }
+  if (found == false) {
+    bacbStack.push(bufMgr.fixNewBlock(file));
+    initPage(bacbStack.top().getDataPtr(), file.getBlockSize());
+  }
+
+  placeRecord(tuple);
+  bool free = hasFreeSpace(bacbStack.top());
+  if (free != bit)
+    fsm.setFree(tuple.getTID().page, free);
+  unfixPage();
+
+  assert(bacbStack.size() == 1);
+}
+
+void DBSlottedTable::append(DBTuple &tuple) {
+  LOG4CXX_INFO(logger, "append()");
+  LOG4CXX_DEBUG(logger, "tuple:\n" + tuple.toString("\t"));
+
+  assertUnique(tuple);
+  if (bacbStack.size() == 1) {
+    if (fsm.isBuilt() == false)
+      buildFreeSpaceMap();
+    fixPage(bufMgr.getBlockCount(file) - 1);
+    appendNewPage = false;
+  }
+
+  encode(tuple);
+  if (hasRoom(bacbStack.top().getDataPtr(), rec.size()) == false) {
+    if (appendNewPage == false)
+      fsm.setFree(bacbStack.top().getBlockNo(), false);
+    unfixPage();
+    bacbStack.push(bufMgr.fixNewBlock(file));
+    initPage(bacbStack.top().getDataPtr(), file.getBlockSize());
+    appendNewPage = true;
+  }
+  placeRecord(tuple);
+}
+
+void DBSlottedTable::remove(const DBListTID &tidList) {
+  LOG4CXX_INFO(logger, "remove()");
+  if (bacbStack.size() != 1)
+    throw DBTableException("BACB Stack is invalid");
+
+  if (fsm.isBuilt() == false)
+    buildFreeSpaceMap();
+
+  uint uniqueMask = 0;
+  for (uint u = 0; u < uniqueAttrs.size(); ++u)
+    uniqueMask |= 1u << uniqueAttrs[u];
+
+  DBListTID::const_iterator i = tidList.begin();
+  while (i != tidList.end()) {
+    const TID &tid = (*i);
+    LOG4CXX_INFO(logger, "tid: " + tid.toString());
+
+    fixPage(tid.page);
+    char *ptr = bacbStack.top().getDataPtr();
+    slottedPageLayout *page = (slottedPageLayout *) ptr;
+    slotEntry *slots = (slotEntry *) (ptr + sizeof(slottedPageLayout));
+    bool free = hasFreeSpace(bacbStack.top());
+
+    const char *r = getRecord(ptr, tid.slot);
+    if (r != NULL) {
+      if (uniqueKeysLoaded == true) {
+        DBTuple t;
+        decode(r, t, uniqueMask);
+        for (uint u = 0; u < uniqueKeys.size(); ++u)
+          uniqueKeys[u].erase(t.getAttrVal(uniqueAttrs[u]).normalizedKey());
+      }
+      freeOverflow(r);
+      page->freeBytes += slots[tid.slot].len;
+      slots[tid.slot].offset = 0;
+      slots[tid.slot].len = 0;
+      --page->tupleCnt;
+      while (page->slotCnt > 0 && slots[page->slotCnt - 1].offset == 0) {
+        --page->slotCnt;
+        page->freeBytes += sizeof(slotEntry);
+      }
+      if (page->tupleCnt == 0)
+        page->dataStart = file.getBlockSize();
+    }
+    // Minimum/Maximum werden nicht verkleinert, nur leere Seiten zurückgesetzt
+    if (zoneMap != NULL && page->tupleCnt == 0)
+      zoneMap->clear(tid.page);
+    bacbStack.top().setModified();
+
+    if (free == false && hasFreeSpace(bacbStack.top()) == true)
+      fsm.setFree(tid.page, true);
+    unfixPage();
+    ++i;
+  }
+
+  assert(bacbStack.size() == 1);
+}
+
+void DBSlottedTable::readTuple(const DBBACB &bacb, const TID &tid, DBTuple &tuple, uint attrMask) {
+  const char *r = getRecord(bacb.getDataPtr(), tid.slot);
+  if (r == NULL)
+    throw DBTableException("invalid TID");
+  tuple.setTID(tid);
+  decode(r, tuple, attrMask);
+  LOG4CXX_DEBUG(logger, "tuple:\n" + tuple.toString("\t"));
+}
+
+TID DBSlottedTable::readSeqFromTID(TID tid,
+                                   uint numOfTuples,
+                                   DBListTuple &tupleList,
+                                   DBListPredicate *where,
+                                   uint attrMask) {
+  LOG4CXX_INFO(logger, "readSeqFromTID()");
+  LOG4CXX_DEBUG(logger, "tid: " + tid.toString());
+  LOG4CXX_DEBUG(logger, "numOfTuples: " + TO_STR(numOfTuples));
+  if (bacbStack.size() != 1)
+    throw DBTableException("BACB Stack is invalid");
+
+  vector<uint> predPos;
+  uint readMask = attrMask;
+  if (where != NULL) {
+    for (DBListPredicate::iterator p = where->begin(); p != where->end(); ++p) {
+      predPos.push_back(rel.attrDef((*p).name().attributeName).attrPos());
+      readMask |= 1u << predPos.back();
+    }
+  }
+
+  while (numOfTuples > 0 && tid.page < bufMgr.getBlockCount(file)) {
+    if (where != NULL && zoneMap != NULL && zoneMap->mayMatch(tid.page, *where) == false) {
+      LOG4CXX_DEBUG(logger, "skip page: " + TO_STR(tid.page));
+      ++tid.page;
+      tid.slot = 0;
+      continue;
+    }
+    if (tid.page != rootBlockNo)
+      bacbStack.push(bufMgr.fixBlock(file, tid.page, LOCK_SHARED));
+    const char *ptr = bacbStack.top().getDataPtr();
+    const slottedPageLayout *page = (const slottedPageLayout *) ptr;
+    for (; tid.slot < page->slotCnt && numOfTuples > 0; ++tid.slot) {
+      const char *r = getRecord(ptr, tid.slot);
+      if (r == NULL)
+        continue;
+      tupleList.push_back(DBTuple());
+      DBTuple &t = tupleList.back();
+      t.setTID(tid);
+      decode(r, t, readMask);
+      bool match = true;
+      if (where != NULL) {
+        DBListPredicate::iterator p = where->begin();
+        for (uint i = 0; match == true && i < predPos.size(); ++i, ++p)
+          match = t.getAttrVal(predPos[i]) == (*p).val();
+      }
+      if (match == false) {
+        tupleList.pop_back();
+        continue;
+      }
+      LOG4CXX_DEBUG(logger, "tuple:\n" + t.toString("\t"));
+      --numOfTuples;
+    }
+    unfixPage();
+    if (numOfTuples > 0) {
+      ++tid.page;
+      tid.slot = 0;
+    }
+  }
+  LOG4CXX_DEBUG(logger, "return tid:" + tid.toString());
+  assert(bacbStack.size() == 1);
+  return tid;
+}
+
+void DBSlottedTable::summarizePage(const DBBACB &bacb) {
+  LOG4CXX_INFO(logger, "summarizePage()");
+  zoneMap->clear(bacb.getBlockNo());
+  const char *ptr = bacb.getDataPtr();
+  const slottedPageLayout *page = (const slottedPageLayout *) ptr;
+  for (uint s = 0; s < page->slotCnt; ++s) {
+    const char *r = getRecord(ptr, s);
+    if (r != NULL) {
+      DBTuple t;
+      decode(r, t, ALL_ATTRS);
+      zoneMap->add(bacb.getBlockNo(), t);
+    }
+  }
+}
+
+/**
+ * Schreibt den Wert in eine Kette von Seiten der Überlaufdatei, freie Seiten
+ * werden zuerst verwendet
+ * @return erste Seite der Kette
+ */
+BlockNo DBSlottedTable::writeOverflow(const string &val) {
+  LOG4CXX_INFO(logger, "writeOverflow()");
+  LOG4CXX_DEBUG(logger, "len: " + TO_STR(val.size()));
+  if (bufMgr.getBlockCount(overflowFile) == 0) {
+    DBBACB bacb = bufMgr.fixNewBlock(overflowFile);
+    bacb.setModified();
+    bufMgr.unfixBlock(bacb);
+  }
+
+  size_t capacity = overflowFile.getBlockSize() - sizeof(overflowPageLayout);
+  DBBACB info = bufMgr.fixBlock(overflowFile, 0, LOCK_EXCLUSIVE);
+  overflowInfoPage *infoPage = (overflowInfoPage *) info.getDataPtr();
+  stack<DBBACB> chain;
+  BlockNo first = 0;
+  try {
+    for (size_t pos = 0; pos < val.size(); pos += capacity) {
+      if (infoPage->freeList != 0) {
+        chain.push(bufMgr.fixBlock(overflowFile, infoPage->freeList, LOCK_EXCLUSIVE));
+        infoPage->freeList = ((const overflowPageLayout *) chain.top().getDataPtr())->next;
+        info.setModified();
+      } else {
+        chain.push(bufMgr.fixNewBlock(overflowFile));
+      }
+      overflowPageLayout *page = (overflowPageLayout *) chain.top().getDataPtr();
+      page->next = 0;
+      page->len = min(capacity, val.size() - pos);
+      memcpy(chain.top().getDataPtr() + sizeof(overflowPageLayout), val.data() + pos, page->len);
+      chain.top().setModified();
+      if (chain.size() == 1) {
+        first = chain.top().getBlockNo();
+      } else {
+        DBBACB bacb = chain.top();
+        chain.pop();
+        ((overflowPageLayout *) chain.top().getDataPtr())->next = bacb.getBlockNo();
+        bufMgr.unfixBlock(chain.top());
+        chain.pop();
+        chain.push(bacb);
+      }
+    }
+  } catch (DBException e) {
+    while (chain.empty() == false) {
+      bufMgr.unfixBlock(chain.top());
+      chain.pop();
+    }
+    bufMgr.unfixBlock(info);
+    throw e;
+  }
+  if (chain.empty() == false)
+    bufMgr.unfixBlock(chain.top());
+  bufMgr.unfixBlock(info);
+  return first;
+}
+
+string DBSlottedTable::readOverflow(const overflowRef &ref) {
+  LOG4CXX_INFO(logger, "readOverflow()");
+  string val;
+  val.reserve(ref.len);
+  BlockNo b = ref.first;
+  while (b != 0 && val.size() < ref.len) {
+    DBBACB bacb = bufMgr.fixBlock(overflowFile, b, LOCK_SHARED);
+    const overflowPageLayout *page = (const overflowPageLayout *) bacb.getDataPtr();
+    val.append(bacb.getDataPtr() + sizeof(overflowPageLayout), page->len);
+    b = page->next;
+    bufMgr.unfixBlock(bacb);
+  }
+  if (val.size() != ref.len)
+    throw DBTableException("invalid overflow chain");
+  return val;
+}
+
+/**
+ * Hängt die Ketten der ausgelagerten Werte des Satzes an die freien Seiten
+ */
+void DBSlottedTable::freeOverflow(const char *ptr) {
+  if (*ptr++ == 0)
+    return;
+  LOG4CXX_INFO(logger, "freeOverflow()");
+  for (uint i = 0; i < rel.attrCnt(); ++i) {
+    AttrTypeEnum type = rel.attrTypeDef(i);
+    uint16_t len = 0;
+    if (type == VCHAR)
+      memcpy(&len, ptr, sizeof(len));
+    if (type != VCHAR || len != OVERFLOW_LEN) {
+      ptr += DBAttrType::getRecordSize(ptr, type);
+      continue;
+    }
+    overflowRef ref;
+    memcpy(&ref, ptr + sizeof(len), sizeof(ref));
+    ptr += sizeof(len) + sizeof(ref);
+    freeChain(ref.first);
+  }
+}
+
+/**
+ * Hängt die Kette ab der Seite first an die freien Seiten
+ */
+void DBSlottedTable::freeChain(BlockNo first) {
+  LOG4CXX_INFO(logger, "freeChain()");
+  DBBACB info = bufMgr.fixBlock(overflowFile, 0, LOCK_EXCLUSIVE);
+  BlockNo b = first;
+  while (b != 0) {
+    DBBACB bacb = bufMgr.fixBlock(overflowFile, b, LOCK_EXCLUSIVE);
+    overflowPageLayout *page = (overflowPageLayout *) bacb.getDataPtr();
+    b = page->next;
+    if (b == 0) {
+      page->next = ((const overflowInfoPage *) info.getDataPtr())->freeList;
+      bacb.setModified();
+    }
+    bufMgr.unfixBlock(bacb);
+  }
+  ((overflowInfoPage *) info.getDataPtr())->freeList = first;
+  info.setModified();
+  bufMgr.unfixBlock(info);
+}
@@ -0,0 +1,155 @@
+#include <hubDB/DBStatistics.h>
+#include <hubDB/DBException.h>
+
+#include <cmath>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Exception;
+
+/**
+ * Verteilt die Bits eines Hashwerts (std::hash<int> ist die Identität)
+ */
+static uint64_t mixHash(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+DBHyperLogLog::DBHyperLogLog() :
+        registers(1u << HLL_REGISTER_BITS, 0) {
+}
+
+void DBHyperLogLog::add(size_t hash) {
+  uint64_t h = mixHash(hash);
+  uint idx = (uint) (h >> (64 - HLL_REGISTER_BITS));
+  uint64_t rest = h << HLL_REGISTER_BITS;
+  uint8_t rank = 1;
+  while (rank <= 64 - HLL_REGISTER_BITS && (rest & 0x8000000000000000ull) == 0) {
+    rest <<= 1;
+    ++rank;
+  }
+  if (rank > registers[idx])
+    registers[idx] = rank;
+}
+
+double DBHyperLogLog::estimate() const {
+  double m = registers.size();
+  double sum = 0;
+  uint zeros = 0;
+  for (uint i = 0; i < registers.size(); ++i) {
+    sum += ldexp(1.0, -registers[i]);
+    if (registers[i] == 0)
+      ++zeros;
+  }
+  double e = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+  // few values: linear counting of the empty registers is more precise
+  if (e <= 2.5 * m && zeros > 0)
+    e = m * log(m / zeros);
+  return e;
+}
+
+string DBTableStats::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBTableStats]" << endl;
+  ss << linePrefix << "rowCnt: " << rowCnt << endl;
+  ss << linePrefix << "pageCnt: " << pageCnt << endl;
+  for (uint i = 0; i < attrs.size(); ++i)
+    ss << linePrefix << "attr " << i << ": " << attrs[i].distinct << " distinct, " << attrs[i].bounds.size() << " bounds" << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+double DBTableStats::rows(uint curPageCnt) const {
+  if (pageCnt == 0)
+    return rowCnt;
+  return (double) rowCnt * curPageCnt / pageCnt;
+}
+
+double DBTableStats::selectivity(uint attrPos, const DBAttrType &val) const {
+  if (rowCnt == 0 || attrPos >= attrs.size())
+    return 0;
+  const DBAttrStats &a = attrs[attrPos];
+  double sel = 1.0 / max(1u, a.distinct);
+  if (a.bounds.size() < 2)
+    return sel;
+  string key = val.normalizedKey();
+  if (key < a.bounds.front() || key > a.bounds.back())
+    return 0;
+  uint k = count(a.bounds.begin() + 1, a.bounds.end(), key);
+  if (k >= 2)
+    sel = max(sel, (double) (k - 1) / (a.bounds.size() - 1));
+  return sel;
+}
+
+double DBTableStats::selectivity(const DBRelDef &rel, DBListPredicate &where) const {
+  double sel = 1.0;
+  DBListPredicate::iterator i = where.begin();
+  while (i != where.end()) {
+    sel *= selectivity(rel.attrDef((*i).name().attributeName).attrPos(), (*i).val());
+    ++i;
+  }
+  return sel;
+}
+
+DBStatsCollector::DBStatsCollector(const DBRelDef &rel) :
+        attrCnt(rel.attrCnt()),
+        rowCnt(0),
+        seed(0x2545F4914F6CDD1Dull),
+        hll(rel.attrCnt()),
+        sample(rel.attrCnt()) {
+}
+
+uint64_t DBStatsCollector::nextRandom() {
+  // xorshift64, a fixed seed gives reproducible statistics
+  seed ^= seed << 13;
+  seed ^= seed >> 7;
+  seed ^= seed << 17;
+  return seed;
+}
+
+void DBStatsCollector::add(const DBTuple &tuple) {
+  uint slot = rowCnt;
+  if (rowCnt >= STAT_SAMPLE_TUPLES)
+    slot = (uint) (nextRandom() % (rowCnt + 1));
+  ++rowCnt;
+  for (uint a = 0; a < attrCnt; ++a) {
+    const DBAttrType &val = tuple.getAttrVal(a);
+    hll[a].add(val.hashValue());
+    if (slot < sample[a].size()) {
+      sample[a][slot] = val.normalizedKey();
+    } else if (slot == sample[a].size()) {
+      sample[a].push_back(val.normalizedKey());
+    }
+  }
+}
+
+void DBStatsCollector::finish(uint pageCnt, DBTableStats &stats) {
+  stats.rowCnt = rowCnt;
+  stats.pageCnt = pageCnt;
+  stats.attrs.assign(attrCnt, DBAttrStats());
+  for (uint a = 0; a < attrCnt; ++a) {
+    DBAttrStats &s = stats.attrs[a];
+    vector<string> &keys = sample[a];
+    sort(keys.begin(), keys.end());
+    if (rowCnt <= keys.size()) {
+      // the sample holds the whole table, the values are counted exactly
+      s.distinct = keys.empty() ? 0 : 1;
+      for (uint i = 1; i < keys.size(); ++i) {
+        if (keys[i] != keys[i - 1])
+          ++s.distinct;
+      }
+    } else {
+      s.distinct = (uint) min((double) rowCnt, floor(hll[a].estimate() + 0.5));
+    }
+    if (keys.empty() == true)
+      continue;
+    uint n = keys.size();
+    uint buckets = min(STAT_BUCKETS, n);
+    s.bounds.push_back(keys.front());
+    for (uint b = 1; b <= buckets; ++b)
+      s.bounds.push_back(keys[(uint64_t) b * n / buckets - 1]);
+  }
+}
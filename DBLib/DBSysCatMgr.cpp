@@ -9,15 +9,27 @@ const BlockNo DBSysCatMgr::rootBlockNo(0);
 const char SYSCAT_FILENAME[] = "syscat.db";
 const char REL_END[] = ".db";
 const char IDX_END[] = ".idx";
+const char ZM_END[] = ".zm";
+const char FSM_END[] = ".fsm";
+const char OVF_END[] = ".ovf";
+const char STAT_END[] = ".st";
+const char TMP_PREFIX[] = "tmp";
+const char TMP_END[] = ".tmp";
 const char IDX_SEP = '_';
 
 #define RELNAME(db, rel) db + FILE_SEP + rel + REL_END
 #define IDXNAME(db, rel, attr) db + FILE_SEP + rel + IDX_SEP + attr + IDX_END
+#define ZMNAME(db, rel) db + FILE_SEP + rel + ZM_END
+#define FSMNAME(db, rel) db + FILE_SEP + rel + FSM_END
+#define OVFNAME(db, rel) db + FILE_SEP + rel + OVF_END
+#define STATNAME(db, rel) db + FILE_SEP + rel + STAT_END
+#define TMPNAME(db, n) db + FILE_SEP + TMP_PREFIX + n + TMP_END
 #define SYSCATNAME(db) db + FILE_SEP + SYSCAT_FILENAME
 
 DBSysCatMgr::DBSysCatMgr(bool doMonitor, string bufferMgrName, bool doThreading) :
         DBManager(doThreading),
-        bufMgr(NULL) {
+        bufMgr(NULL),
+        tempFileCnt(0) {
   assert(sizeof(sysCatInfoPage) <= STD_BLOCKSIZE);
   assert(sizeof(RelDefStruct) <= STD_BLOCKSIZE);
   LOG4CXX_INFO(logger, "DBSysCatMgr()");
@@ -49,9 +61,10 @@ string DBSysCatMgr::toString(string linePrefix) const {
   return ss.str();
 }
 
-void DBSysCatMgr::initialize(DBFile &file) {
+void DBSysCatMgr::initialize(DBFile &file, uint blockSize) {
   LOG4CXX_INFO(logger, "initialize()");
   LOG4CXX_DEBUG(logger, "file:\n" + file.toString("\t"));
+  LOG4CXX_DEBUG(logger, "blockSize: " + TO_STR(blockSize));
   if (bufMgr->getBlockCount(file) != 0)
     throw DBSysCatMgrException("can not initializie exisiting syscat");
 
@@ -59,7 +72,7 @@ void DBSysCatMgr::initialize(DBFile &file) {
   try {
     bacbStack.push(bufMgr->fixNewBlock(file));
     sysCatInfoPage *page = (sysCatInfoPage *) bacbStack.top().getDataPtr();
-    page->blockSize = DBFileBlock::getBlockSize();
+    page->blockSize = blockSize;
     page->isValid = true;
     bacbStack.top().setModified();
   } catch (DBException e) {
@@ -71,16 +84,19 @@ void DBSysCatMgr::initialize(DBFile &file) {
   bacbStack.pop();
 }
 
-void DBSysCatMgr::createDB(string name) {
+void DBSysCatMgr::createDB(string name, uint blockSize) {
   LOG4CXX_INFO(logger, "createDB()");
   LOG4CXX_DEBUG(logger, "name: " + name);
+  LOG4CXX_DEBUG(logger, "blockSize: " + TO_STR(blockSize));
   lock();
   try {
+    if (isValidBlockSize(blockSize) == false)
+      throw DBSysCatMgrException("invalid page size " + TO_STR(blockSize));
     string sysCatFile(SYSCATNAME(name));
     bufMgr->createDirectory(name);
     bufMgr->createFile(sysCatFile);
     DBFile &file = bufMgr->openFile(sysCatFile);
-    initialize(file);
+    initialize(file, blockSize);
     bufMgr->closeFile(file);
   } catch (DBException &e) {
     unlock();
@@ -100,6 +116,7 @@ void DBSysCatMgr::dropDB(string name) {
     bacbStack.push(bufMgr->fixBlock(file, rootBlockNo, LOCK_EXCLUSIVE));
     sysCatInfoPage *page = (sysCatInfoPage *) bacbStack.top().getDataPtr();
     page->isValid = false;
+    blockSizes.erase(name);
     bacbStack.top().setModified();
     bufMgr->flushBlock(bacbStack.top());
     for (BlockNo b = 1; b < bufMgr->getBlockCount(file); ++b) {
@@ -113,6 +130,11 @@ void DBSysCatMgr::dropDB(string name) {
       }
       bufMgr->unfixBlock(bacbStack.top());
       bacbStack.pop();
+      dropZoneMap(name, def.relationName());
+      dropFreeSpaceMap(name, def.relationName());
+      if (def.isSlotted() == true)
+        dropOverflow(name, def.relationName());
+      dropStatistics(name, def.relationName());
       bufMgr->dropFile(RELNAME(name, def.relationName()));
     }
     bufMgr->unfixBlock(bacbStack.top());
@@ -152,6 +174,10 @@ DBBACB *DBSysCatMgr::connectTo(string name) {
     if (page->isValid == false) {
       throw DBSysCatMgrException("DB is invalid");
     }
+    if (isValidBlockSize(page->blockSize) == false) {
+      throw DBSysCatMgrException("DB has unsupported page size " + TO_STR(page->blockSize));
+    }
+    blockSizes[name] = page->blockSize;
   } catch (DBException e) {
     if (rc != NULL) {
       bufMgr->unfixBlock(*rc);
@@ -164,6 +190,42 @@ DBBACB *DBSysCatMgr::connectTo(string name) {
   return rc;
 }
 
+bool DBSysCatMgr::isValidBlockSize(uint blockSize) {
+  return blockSize >= STD_BLOCKSIZE && blockSize <= MAX_BLOCKSIZE && (blockSize & (blockSize - 1)) == 0;
+}
+
+uint DBSysCatMgr::getBlockSize(const string dbName) {
+  LOG4CXX_INFO(logger, "getBlockSize()");
+  LOG4CXX_DEBUG(logger, "dbName: " + dbName);
+  lock();
+  uint blockSize = 0;
+  try {
+    // the root page stays fixed while connected, it is not fixed twice by one thread
+    map<string, uint>::const_iterator i = blockSizes.find(dbName);
+    if (i != blockSizes.end()) {
+      blockSize = i->second;
+    } else {
+      string sysCatFile(SYSCATNAME(dbName));
+      DBFile &file = bufMgr->openFile(sysCatFile);
+      DBBACB bacb = bufMgr->fixBlock(file, rootBlockNo, LOCK_SHARED);
+      blockSize = ((const sysCatInfoPage *) bacb.getDataPtr())->blockSize;
+      bufMgr->unfixBlock(bacb);
+      if (isValidBlockSize(blockSize) == false)
+        throw DBSysCatMgrException("DB has unsupported page size " + TO_STR(blockSize));
+      blockSizes[dbName] = blockSize;
+    }
+  } catch (DBException e) {
+    unlock();
+    throw e;
+  }
+  unlock();
+  return blockSize;
+}
+
+DBFile &DBSysCatMgr::openDBFile(const string dbName, const string fileName) {
+  return bufMgr->openFile(fileName, getBlockSize(dbName));
+}
+
 void DBSysCatMgr::listTables(string dbName, list<string> &tableNames) {
   LOG4CXX_INFO(logger, "listTables()");
   LOG4CXX_DEBUG(logger, "dbName: " + dbName);
@@ -215,14 +277,40 @@ void DBSysCatMgr::createTable(const string dbName, const RelDefStruct &def) {
   LOG4CXX_DEBUG(logger, "dbName: " + dbName);
   lock();
   try {
+    // the fixed format always stores MAX_STR_LEN bytes per VARCHAR, so only the
+    // slotted format knows other lengths; long values are not indexed
+    for (uint i = 0; i < def.attrCnt; ++i) {
+      const AttrDefStruct &attr = def.attrList[i];
+      if (attr.attrType == VCHAR && attr.attrLen != MAX_STR_LEN && def.isSlotted == false)
+        throw DBSysCatMgrException("VARCHAR(" + TO_STR(attr.attrLen) + ") requires a SLOTTED table");
+      if (attr.attrType == VCHAR && attr.attrLen > MAX_STR_LEN && attr.isUnique == true)
+        throw DBSysCatMgrException("VARCHAR(" + TO_STR(attr.attrLen) + ") can not be UNIQUE");
+    }
     string sysCatFile(SYSCATNAME(dbName));
     string relFile(RELNAME(dbName, def.relationName));
     bufMgr->createFile(relFile);
-    DBFile &rfile = bufMgr->openFile(relFile);
-    DBTable::initializeTable(*bufMgr, rfile);
+    DBFile &rfile = openDBFile(dbName, relFile);
+    if (def.isSlotted == true) {
+      DBSlottedTable::initializeTable(*bufMgr, rfile);
+      bufMgr->createFile(OVFNAME(dbName, def.relationName));
+    } else {
+      DBTable::initializeTable(*bufMgr, rfile);
+    }
+    bufMgr->createFile(ZMNAME(dbName, def.relationName));
+    bufMgr->createFile(FSMNAME(dbName, def.relationName));
+    bufMgr->createFile(STATNAME(dbName, def.relationName));
     DBFile &file = bufMgr->openFile(sysCatFile);
     DBBACB bacb = bufMgr->fixNewBlock(file);
     memcpy(bacb.getDataPtr(), &def, sizeof(def));
+    // eindeutige Attribute erhalten einen Index, der Duplikate zurückweist
+    RelDefStruct *relDef = (RelDefStruct *) bacb.getDataPtr();
+    for (uint i = 0; i < relDef->attrCnt; ++i) {
+      if (relDef->attrList[i].isUnique == true) {
+        bufMgr->createFile(IDXNAME(dbName, def.relationName, relDef->attrList[i].attrName));
+        relDef->attrList[i].isIndexed = true;
+        strcpy(relDef->attrList[i].indexType, DEFAULT_IDXTYPE.c_str());
+      }
+    }
     bacb.setModified();
     bufMgr->flushBlock(bacb);
     bufMgr->unfixBlock(bacb);
@@ -264,13 +352,18 @@ void DBSysCatMgr::dropTable(const string dbName, const string relName) {
         bufMgr->dropFile(IDXNAME(dbName, def.relationName(), adef.attrName()));
       }
     }
+    dropZoneMap(dbName, def.relationName());
+    dropFreeSpaceMap(dbName, def.relationName());
+    if (def.isSlotted() == true)
+      dropOverflow(dbName, def.relationName());
+    dropStatistics(dbName, def.relationName());
     bufMgr->dropFile(RELNAME(dbName, def.relationName()));
     uint blockCnt = bufMgr->getBlockCount(file);
     if ((blockCnt - 1) > bacbStack.top().getBlockNo()) {
       bufMgr->upgradeToExclusive(bacbStack.top());
       char *ptr = bacbStack.top().getDataPtr();
       bacbStack.push(bufMgr->fixBlock(file, blockCnt - 1, LOCK_SHARED));
-      memcpy(ptr, bacbStack.top().getDataPtr(), DBFileBlock::getBlockSize());
+      memcpy(ptr, bacbStack.top().getDataPtr(), file.getBlockSize());
       bufMgr->unfixBlock(bacbStack.top());
       bacbStack.pop();
       bacbStack.top().setModified();
@@ -295,8 +388,13 @@ DBTable *DBSysCatMgr::openTable(const string dbName, const string relName, ModTy
   lock();
   try {
     string relFile(RELNAME(dbName, relName));
-    DBFile &file = bufMgr->openFile(relFile);
-    table = new DBTable(*bufMgr, file, getSchemaForTable(dbName, relName), mode);
+    DBFile &file = openDBFile(dbName, relFile);
+    DBFile &fsmFile = openFreeSpaceMap(dbName, relName);
+    DBRelDef def = getSchemaForTable(dbName, relName);
+    if (def.isSlotted() == true)
+      table = new DBSlottedTable(*bufMgr, file, fsmFile, openOverflow(dbName, relName), def, mode, &openZoneMap(dbName, relName));
+    else
+      table = new DBTable(*bufMgr, file, fsmFile, def, mode, &openZoneMap(dbName, relName));
   } catch (DBException e) {
     unlock();
     throw e;
@@ -305,6 +403,190 @@ DBTable *DBSysCatMgr::openTable(const string dbName, const string relName, ModTy
   return table;
 }
 
+DBFile &DBSysCatMgr::openZoneMap(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "openZoneMap()");
+  string zmFile(ZMNAME(dbName, relName));
+  try {
+    return openDBFile(dbName, zmFile);
+  } catch (DBException e) {
+    // tables created without a zone map get an empty one, all pages are unknown
+    LOG4CXX_DEBUG(logger, "create " + zmFile);
+  }
+  bufMgr->createFile(zmFile);
+  return openDBFile(dbName, zmFile);
+}
+
+void DBSysCatMgr::dropZoneMap(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "dropZoneMap()");
+  try {
+    bufMgr->dropFile(ZMNAME(dbName, relName));
+  } catch (DBException e) {
+    LOG4CXX_DEBUG(logger, "no zone map for " + relName);
+  }
+}
+
+DBFile &DBSysCatMgr::openFreeSpaceMap(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "openFreeSpaceMap()");
+  string fsmFile(FSMNAME(dbName, relName));
+  try {
+    return openDBFile(dbName, fsmFile);
+  } catch (DBException e) {
+    // tables created without a free-space map get an empty one, DBTable builds it
+    LOG4CXX_DEBUG(logger, "create " + fsmFile);
+  }
+  bufMgr->createFile(fsmFile);
+  return openDBFile(dbName, fsmFile);
+}
+
+void DBSysCatMgr::dropFreeSpaceMap(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "dropFreeSpaceMap()");
+  try {
+    bufMgr->dropFile(FSMNAME(dbName, relName));
+  } catch (DBException e) {
+    LOG4CXX_DEBUG(logger, "no free-space map for " + relName);
+  }
+}
+
+DBFile &DBSysCatMgr::openOverflow(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "openOverflow()");
+  string ovfFile(OVFNAME(dbName, relName));
+  try {
+    return openDBFile(dbName, ovfFile);
+  } catch (DBException e) {
+    LOG4CXX_DEBUG(logger, "create " + ovfFile);
+  }
+  bufMgr->createFile(ovfFile);
+  return openDBFile(dbName, ovfFile);
+}
+
+void DBSysCatMgr::dropOverflow(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "dropOverflow()");
+  try {
+    bufMgr->dropFile(OVFNAME(dbName, relName));
+  } catch (DBException e) {
+    LOG4CXX_DEBUG(logger, "no overflow file for " + relName);
+  }
+}
+
+void DBSysCatMgr::dropStatistics(const string dbName, const string relName) {
+  LOG4CXX_INFO(logger, "dropStatistics()");
+  try {
+    bufMgr->dropFile(STATNAME(dbName, relName));
+  } catch (DBException e) {
+    LOG4CXX_DEBUG(logger, "no statistics for " + relName);
+  }
+}
+
+void DBSysCatMgr::writeStatistics(const string dbName, const string relName, const DBTableStats &stats) {
+  LOG4CXX_INFO(logger, "writeStatistics()");
+  LOG4CXX_DEBUG(logger, "relName: " + relName);
+  LOG4CXX_DEBUG(logger, "stats:\n" + stats.toString("\t"));
+  lock();
+  stack<DBBACB> bacbStack;
+  try {
+    DBRelDef def = getSchemaForTable(dbName, relName);
+    string statFile(STATNAME(dbName, relName));
+    DBFile *file = NULL;
+    try {
+      file = &openDBFile(dbName, statFile);
+    } catch (DBException e) {
+      bufMgr->createFile(statFile);
+      file = &openDBFile(dbName, statFile);
+    }
+    for (BlockNo b = 0; b <= stats.attrs.size(); ++b) {
+      if (b < bufMgr->getBlockCount(*file))
+        bacbStack.push(bufMgr->fixBlock(*file, b, LOCK_EXCLUSIVE));
+      else
+        bacbStack.push(bufMgr->fixNewBlock(*file));
+      char *ptr = bacbStack.top().getDataPtr();
+      memset(ptr, 0, file->getBlockSize());
+      if (b == 0) {
+        statInfoPage *page = (statInfoPage *) ptr;
+        page->rowCnt = stats.rowCnt;
+        page->pageCnt = stats.pageCnt;
+        page->attrCnt = stats.attrs.size();
+      } else {
+        const DBAttrStats &a = stats.attrs[b - 1];
+        size_t keyLen = DBAttrType::getSize4Type(def.attrDef(b - 1).attrType());
+        statAttrPage *page = (statAttrPage *) ptr;
+        page->distinct = a.distinct;
+        page->boundCnt = a.bounds.size();
+        if (sizeof(statAttrPage) + a.bounds.size() * keyLen > file->getBlockSize())
+          throw DBSysCatMgrException("histogram exceeds page");
+        ptr += sizeof(statAttrPage);
+        for (uint i = 0; i < a.bounds.size(); ++i, ptr += keyLen)
+          memcpy(ptr, a.bounds[i].data(), min(keyLen, a.bounds[i].size()));
+      }
+      bacbStack.top().setModified();
+      bufMgr->unfixBlock(bacbStack.top());
+      bacbStack.pop();
+    }
+  } catch (DBException e) {
+    while (bacbStack.empty() == false) {
+      bufMgr->unfixBlock(bacbStack.top());
+      bacbStack.pop();
+    }
+    unlock();
+    throw e;
+  }
+  unlock();
+}
+
+bool DBSysCatMgr::readStatistics(const string dbName, const string relName, DBTableStats &stats) {
+  LOG4CXX_INFO(logger, "readStatistics()");
+  LOG4CXX_DEBUG(logger, "relName: " + relName);
+  lock();
+  stack<DBBACB> bacbStack;
+  try {
+    DBRelDef def = getSchemaForTable(dbName, relName);
+    DBFile *file = NULL;
+    try {
+      file = &openDBFile(dbName, STATNAME(dbName, relName));
+    } catch (DBException e) {
+      LOG4CXX_DEBUG(logger, "not analyzed");
+    }
+    if (file == NULL || bufMgr->getBlockCount(*file) == 0) {
+      unlock();
+      return false;
+    }
+    bacbStack.push(bufMgr->fixBlock(*file, 0, LOCK_SHARED));
+    const statInfoPage *info = (const statInfoPage *) bacbStack.top().getDataPtr();
+    stats.rowCnt = info->rowCnt;
+    stats.pageCnt = info->pageCnt;
+    stats.attrs.assign(info->attrCnt, DBAttrStats());
+    bufMgr->unfixBlock(bacbStack.top());
+    bacbStack.pop();
+    if (stats.attrs.size() != def.attrCnt())
+      throw DBSysCatMgrException("statistics do not match relation");
+
+    for (uint a = 0; a < stats.attrs.size(); ++a) {
+      bacbStack.push(bufMgr->fixBlock(*file, a + 1, LOCK_SHARED));
+      const char *ptr = bacbStack.top().getDataPtr();
+      const statAttrPage *page = (const statAttrPage *) ptr;
+      AttrTypeEnum type = def.attrDef(a).attrType();
+      size_t keyLen = DBAttrType::getSize4Type(type);
+      stats.attrs[a].distinct = page->distinct;
+      ptr += sizeof(statAttrPage);
+      for (uint i = 0; i < page->boundCnt; ++i, ptr += keyLen) {
+        // VARCHAR keys are padded with '\0', which they never contain
+        size_t len = (type == VCHAR) ? strnlen(ptr, keyLen) : keyLen;
+        stats.attrs[a].bounds.push_back(string(ptr, len));
+      }
+      bufMgr->unfixBlock(bacbStack.top());
+      bacbStack.pop();
+    }
+  } catch (DBException e) {
+    while (bacbStack.empty() == false) {
+      bufMgr->unfixBlock(bacbStack.top());
+      bacbStack.pop();
+    }
+    unlock();
+    throw e;
+  }
+  unlock();
+  return true;
+}
+
 void DBSysCatMgr::createIndex(string dbName, const QualifiedName &qname, string indexType) {
   LOG4CXX_INFO(logger, "createIndex()");
   LOG4CXX_DEBUG(logger, "dbName: " + dbName);
@@ -345,6 +627,8 @@ void DBSysCatMgr::createIndex(string dbName, const QualifiedName &qname, string
 
     if (relDef->attrList[pos].isIndexed == true)
       throw DBSysCatMgrException("already indexed");
+    if (relDef->attrList[pos].attrType == VCHAR && relDef->attrList[pos].attrLen > MAX_STR_LEN)
+      throw DBSysCatMgrException("can not index VARCHAR(" + TO_STR(relDef->attrList[pos].attrLen) + ")");
 
     bufMgr->createFile(idxFile);
 
@@ -437,7 +721,7 @@ DBIndex *DBSysCatMgr::openIndex(const string dbName, const QualifiedName &qname,
     DBAttrDef adef = def.attrDef(qname.attributeName);
     if (adef.isIndexed() == false)
       throw DBSysCatMgrException("no such index");
-    DBFile &file = bufMgr->openFile(relFile);
+    DBFile &file = openDBFile(dbName, relFile);
     index = (DBIndex *) getClassForName(adef.indexType(), 5, bufMgr, &file, adef.attrType(), mode, adef.isUnique());
   } catch (DBException e) {
     unlock();
@@ -447,6 +731,26 @@ DBIndex *DBSysCatMgr::openIndex(const string dbName, const QualifiedName &qname,
   return index;
 }
 
+DBTempFile *DBSysCatMgr::createTempFile(const string dbName, const DBRelDef &rel) {
+  LOG4CXX_INFO(logger, "createTempFile()");
+  LOG4CXX_DEBUG(logger, "dbName: " + dbName);
+
+  DBTempFile *tmp = NULL;
+  lock();
+  try {
+    // the file is dropped again by the destructor of DBTempFile
+    string tmpFile(TMPNAME(dbName, TO_STR(tempFileCnt++)));
+    bufMgr->createFile(tmpFile);
+    DBFile &file = openDBFile(dbName, tmpFile);
+    tmp = new DBTempFile(*bufMgr, file, tmpFile, rel);
+  } catch (DBException e) {
+    unlock();
+    throw e;
+  }
+  unlock();
+  return tmp;
+}
+
 
 DBSysCatMgrException::DBSysCatMgrException(const std::string &msg1)
         : DBRuntimeException(msg1) {
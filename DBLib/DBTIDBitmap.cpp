@@ -0,0 +1,415 @@
+#include <hubDB/DBTIDBitmap.h>
+#include <hubDB/DBException.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace HubDB::Types;
+using namespace HubDB::Exception;
+
+static const uint16_t CONTAINER_ARRAY = 0;
+static const uint16_t CONTAINER_BITMAP = 1;
+
+/**
+ * Wortweise Verknüpfung zweier Bitmaps, jeweils 128 Bit pro Schritt mit SSE2
+ */
+static void andWords(uint64_t *dst, const uint64_t *src, size_t n) {
+  size_t i = 0;
+#ifdef __SSE2__
+  for (; i + 2 <= n; i += 2) {
+    __m128i a = _mm_loadu_si128((const __m128i *) (dst + i));
+    __m128i b = _mm_loadu_si128((const __m128i *) (src + i));
+    _mm_storeu_si128((__m128i *) (dst + i), _mm_and_si128(a, b));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] &= src[i];
+  }
+}
+
+static void orWords(uint64_t *dst, const uint64_t *src, size_t n) {
+  size_t i = 0;
+#ifdef __SSE2__
+  for (; i + 2 <= n; i += 2) {
+    __m128i a = _mm_loadu_si128((const __m128i *) (dst + i));
+    __m128i b = _mm_loadu_si128((const __m128i *) (src + i));
+    _mm_storeu_si128((__m128i *) (dst + i), _mm_or_si128(a, b));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] |= src[i];
+  }
+}
+
+static uint countWords(const vector<uint64_t> &words) {
+  uint cnt = 0;
+  for (size_t i = 0; i < words.size(); ++i) {
+    cnt += __builtin_popcountll(words[i]);
+  }
+  return cnt;
+}
+
+bool DBTIDContainer::add(uint slot) {
+  if (slot > 0xFFFF)
+    throw DBException("slot out of range");
+  bool added = false;
+  if (isBitmap()) {
+    if (slot / 64 >= words.size())
+      words.resize(slot / 64 + 1, 0);
+    uint64_t bit = (uint64_t) 1 << (slot % 64);
+    if ((words[slot / 64] & bit) == 0) {
+      words[slot / 64] |= bit;
+      added = true;
+    }
+  } else {
+    vector<uint16_t>::iterator i = lower_bound(slots.begin(), slots.end(), (uint16_t) slot);
+    if (i == slots.end() || *i != slot) {
+      slots.insert(i, (uint16_t) slot);
+      added = true;
+    }
+  }
+  if (added) {
+    ++card;
+    optimize();
+  }
+  return added;
+}
+
+bool DBTIDContainer::remove(uint slot) {
+  bool removed = false;
+  if (isBitmap()) {
+    uint64_t bit = (uint64_t) 1 << (slot % 64);
+    if (slot / 64 < words.size() && (words[slot / 64] & bit) != 0) {
+      words[slot / 64] &= ~bit;
+      removed = true;
+    }
+  } else {
+    vector<uint16_t>::iterator i = lower_bound(slots.begin(), slots.end(), (uint16_t) slot);
+    if (i != slots.end() && *i == slot) {
+      slots.erase(i);
+      removed = true;
+    }
+  }
+  if (removed) {
+    --card;
+    optimize();
+  }
+  return removed;
+}
+
+bool DBTIDContainer::contains(uint slot) const {
+  if (isBitmap()) {
+    return slot / 64 < words.size() && (words[slot / 64] & ((uint64_t) 1 << (slot % 64))) != 0;
+  }
+  return binary_search(slots.begin(), slots.end(), (uint16_t) slot);
+}
+
+void DBTIDContainer::andWith(const DBTIDContainer &ref) {
+  if (isBitmap() && ref.isBitmap()) {
+    size_t n = min(words.size(), ref.words.size());
+    words.resize(n);
+    andWords(&words[0], &ref.words[0], n);
+    card = countWords(words);
+  } else if (isBitmap()) {
+    vector<uint16_t> res;
+    for (size_t i = 0; i < ref.slots.size(); ++i) {
+      if (contains(ref.slots[i]))
+        res.push_back(ref.slots[i]);
+    }
+    words.clear();
+    slots.swap(res);
+    card = slots.size();
+  } else if (ref.isBitmap()) {
+    vector<uint16_t> res;
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (ref.contains(slots[i]))
+        res.push_back(slots[i]);
+    }
+    slots.swap(res);
+    card = slots.size();
+  } else {
+    vector<uint16_t> res;
+    set_intersection(slots.begin(), slots.end(), ref.slots.begin(), ref.slots.end(), back_inserter(res));
+    slots.swap(res);
+    card = slots.size();
+  }
+  optimize();
+}
+
+void DBTIDContainer::orWith(const DBTIDContainer &ref) {
+  if (isBitmap() && ref.isBitmap()) {
+    if (words.size() < ref.words.size())
+      words.resize(ref.words.size(), 0);
+    orWords(&words[0], &ref.words[0], ref.words.size());
+    card = countWords(words);
+  } else if (isBitmap() || ref.isBitmap()) {
+    const vector<uint16_t> &arr = isBitmap() ? ref.slots : slots;
+    vector<uint16_t> tmp(arr);
+    if (!isBitmap())
+      words = ref.words;
+    slots.clear();
+    for (size_t i = 0; i < tmp.size(); ++i) {
+      if (tmp[i] / 64 >= words.size())
+        words.resize(tmp[i] / 64 + 1, 0);
+      words[tmp[i] / 64] |= (uint64_t) 1 << (tmp[i] % 64);
+    }
+    card = countWords(words);
+  } else {
+    vector<uint16_t> res;
+    set_union(slots.begin(), slots.end(), ref.slots.begin(), ref.slots.end(), back_inserter(res));
+    slots.swap(res);
+    card = slots.size();
+  }
+  optimize();
+}
+
+uint DBTIDContainer::extract(uint pos, DBTIDBatch &tids, uint maxTids) const {
+  TID tid;
+  tid.page = page;
+  if (isBitmap()) {
+    size_t w = pos / 64;
+    uint64_t bits = w < words.size() ? words[w] & (~(uint64_t) 0 << (pos % 64)) : 0;
+    while (w < words.size()) {
+      while (bits != 0) {
+        if (tids.size() >= maxTids)
+          return w * 64 + __builtin_ctzll(bits);
+        tid.slot = w * 64 + __builtin_ctzll(bits);
+        tids.push_back(tid);
+        bits &= bits - 1;
+      }
+      if (++w < words.size())
+        bits = words[w];
+    }
+    return words.size() * 64;
+  }
+  for (; pos < slots.size() && tids.size() < maxTids; ++pos) {
+    tid.slot = slots[pos];
+    tids.push_back(tid);
+  }
+  return pos;
+}
+
+size_t DBTIDContainer::encodedSize() const {
+  return sizeof(BlockNo) + 2 * sizeof(uint16_t) +
+         (isBitmap() ? words.size() * sizeof(uint64_t) : slots.size() * sizeof(uint16_t));
+}
+
+char *DBTIDContainer::write(char *ptr) const {
+  uint16_t form = isBitmap() ? CONTAINER_BITMAP : CONTAINER_ARRAY;
+  uint16_t n = isBitmap() ? words.size() : slots.size();
+  memcpy(ptr, &page, sizeof(BlockNo));
+  ptr += sizeof(BlockNo);
+  memcpy(ptr, &form, sizeof(uint16_t));
+  ptr += sizeof(uint16_t);
+  memcpy(ptr, &n, sizeof(uint16_t));
+  ptr += sizeof(uint16_t);
+  if (form == CONTAINER_BITMAP) {
+    memcpy(ptr, &words[0], n * sizeof(uint64_t));
+    ptr += n * sizeof(uint64_t);
+  } else if (n > 0) {
+    memcpy(ptr, &slots[0], n * sizeof(uint16_t));
+    ptr += n * sizeof(uint16_t);
+  }
+  return ptr;
+}
+
+const char *DBTIDContainer::read(const char *ptr) {
+  uint16_t form;
+  uint16_t n;
+  memcpy(&page, ptr, sizeof(BlockNo));
+  ptr += sizeof(BlockNo);
+  memcpy(&form, ptr, sizeof(uint16_t));
+  ptr += sizeof(uint16_t);
+  memcpy(&n, ptr, sizeof(uint16_t));
+  ptr += sizeof(uint16_t);
+  slots.clear();
+  words.clear();
+  if (form == CONTAINER_BITMAP) {
+    words.resize(n);
+    memcpy(&words[0], ptr, n * sizeof(uint64_t));
+    ptr += n * sizeof(uint64_t);
+    card = countWords(words);
+  } else {
+    slots.resize(n);
+    if (n > 0)
+      memcpy(&slots[0], ptr, n * sizeof(uint16_t));
+    ptr += n * sizeof(uint16_t);
+    card = n;
+  }
+  return ptr;
+}
+
+void DBTIDContainer::toBitmap() {
+  words.assign(slots.back() / 64 + 1, 0);
+  for (size_t i = 0; i < slots.size(); ++i) {
+    words[slots[i] / 64] |= (uint64_t) 1 << (slots[i] % 64);
+  }
+  slots.clear();
+}
+
+void DBTIDContainer::toArray() {
+  vector<uint16_t> res;
+  res.reserve(card);
+  for (size_t w = 0; w < words.size(); ++w) {
+    uint64_t bits = words[w];
+    while (bits != 0) {
+      res.push_back(w * 64 + __builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+  words.clear();
+  slots.swap(res);
+}
+
+/**
+ * Wählt die kleinere der beiden Darstellungen
+ */
+void DBTIDContainer::optimize() {
+  if (isBitmap()) {
+    while (!words.empty() && words.back() == 0)
+      words.pop_back();
+    if (card * sizeof(uint16_t) < words.size() * sizeof(uint64_t))
+      toArray();
+  } else if (!slots.empty() &&
+             card * sizeof(uint16_t) > (slots.back() / 64 + 1) * sizeof(uint64_t)) {
+    toBitmap();
+  }
+}
+
+vector<DBTIDContainer>::iterator DBTIDBitmap::findContainer(BlockNo page) {
+  vector<DBTIDContainer>::iterator i = containers.begin();
+  size_t cnt = containers.size();
+  while (cnt > 0) {
+    size_t step = cnt / 2;
+    if ((i + step)->getPage() < page) {
+      i += step + 1;
+      cnt -= step + 1;
+    } else {
+      cnt = step;
+    }
+  }
+  return i;
+}
+
+vector<DBTIDContainer>::const_iterator DBTIDBitmap::findContainer(BlockNo page) const {
+  return const_cast<DBTIDBitmap *>(this)->findContainer(page);
+}
+
+bool DBTIDBitmap::add(const TID &tid) {
+  vector<DBTIDContainer>::iterator i;
+  if (containers.empty() || containers.back().getPage() < tid.page) {
+    containers.push_back(DBTIDContainer(tid.page));
+    i = containers.end() - 1;
+  } else {
+    i = findContainer(tid.page);
+    if (i == containers.end() || i->getPage() != tid.page)
+      i = containers.insert(i, DBTIDContainer(tid.page));
+  }
+  return i->add(tid.slot);
+}
+
+bool DBTIDBitmap::remove(const TID &tid) {
+  vector<DBTIDContainer>::iterator i = findContainer(tid.page);
+  if (i == containers.end() || i->getPage() != tid.page)
+    return false;
+  bool removed = i->remove(tid.slot);
+  if (i->cardinality() == 0)
+    containers.erase(i);
+  return removed;
+}
+
+bool DBTIDBitmap::contains(const TID &tid) const {
+  vector<DBTIDContainer>::const_iterator i = findContainer(tid.page);
+  return i != containers.end() && i->getPage() == tid.page && i->contains(tid.slot);
+}
+
+uint DBTIDBitmap::cardinality() const {
+  uint cnt = 0;
+  for (size_t i = 0; i < containers.size(); ++i) {
+    cnt += containers[i].cardinality();
+  }
+  return cnt;
+}
+
+void DBTIDBitmap::andWith(const DBTIDBitmap &ref) {
+  vector<DBTIDContainer> res;
+  vector<DBTIDContainer>::const_iterator l = containers.begin();
+  vector<DBTIDContainer>::const_iterator r = ref.containers.begin();
+  while (l != containers.end() && r != ref.containers.end()) {
+    if (l->getPage() < r->getPage()) {
+      ++l;
+    } else if (r->getPage() < l->getPage()) {
+      ++r;
+    } else {
+      DBTIDContainer c(*l);
+      c.andWith(*r);
+      if (c.cardinality() > 0)
+        res.push_back(c);
+      ++l;
+      ++r;
+    }
+  }
+  containers.swap(res);
+}
+
+void DBTIDBitmap::orWith(const DBTIDBitmap &ref) {
+  vector<DBTIDContainer> res;
+  vector<DBTIDContainer>::const_iterator l = containers.begin();
+  vector<DBTIDContainer>::const_iterator r = ref.containers.begin();
+  while (l != containers.end() || r != ref.containers.end()) {
+    if (r == ref.containers.end() || (l != containers.end() && l->getPage() < r->getPage())) {
+      res.push_back(*l++);
+    } else if (l == containers.end() || r->getPage() < l->getPage()) {
+      res.push_back(*r++);
+    } else {
+      res.push_back(*l++);
+      res.back().orWith(*r++);
+    }
+  }
+  containers.swap(res);
+}
+
+void DBTIDBitmap::addContainer(const DBTIDContainer &c) {
+  if (c.cardinality() == 0)
+    return;
+  if (containers.empty() || containers.back().getPage() < c.getPage()) {
+    containers.push_back(c);
+    return;
+  }
+  vector<DBTIDContainer>::iterator i = findContainer(c.getPage());
+  if (i != containers.end() && i->getPage() == c.getPage()) {
+    i->orWith(c);
+  } else {
+    containers.insert(i, c);
+  }
+}
+
+bool DBTIDBitmap::nextBatch(Position &pos, DBTIDBatch &tids, uint maxTids) const {
+  tids.clear();
+  while (pos.container < containers.size() && tids.size() < maxTids) {
+    pos.offset = containers[pos.container].extract(pos.offset, tids, maxTids);
+    if (tids.size() < maxTids) {
+      ++pos.container;
+      pos.offset = 0;
+    }
+  }
+  return !tids.empty();
+}
+
+void DBTIDBitmap::toList(DBListTID &tids) const {
+  DBTIDBatch batch;
+  Position pos;
+  while (nextBatch(pos, batch)) {
+    tids.insert(tids.end(), batch.begin(), batch.end());
+  }
+}
+
+string DBTIDBitmap::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBTIDBitmap]" << endl;
+  ss << linePrefix << "containers: " << containers.size() << endl;
+  ss << linePrefix << "cardinality: " << cardinality() << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
@@ -1,4 +1,5 @@
 #include <hubDB/DBTable.h>
+#include <hubDB/DBPageFilter.h>
 #include <hubDB/DBFileBlock.h>
 #include <hubDB/DBException.h>
 
@@ -9,28 +10,47 @@ using namespace HubDB::Exception;
 LoggerPtr DBTable::logger(Logger::getLogger("HubDB.Table.DBTable"));
 
 const BlockNo DBTable::rootBlockNo(0);
+const uint DBTable::CNT_VALID(0x80000000);
 
-DBTable::DBTable(DBBufferMgr &bufMgr, DBFile &file, const DBRelDef &rel, ModType mode) :
+DBTable::DBTable(DBBufferMgr &bufMgr, DBFile &file, DBFile &fsmFile, const DBRelDef &rel, ModType mode, DBFile *zoneFile) :
         bufMgr(bufMgr),
         file(file),
         rel(rel),
         mode(mode),
         slotMaskCnt(1),
-        _sizeOfPage(sizeof(tablePageLayout)) {
+        _sizeOfPage(sizeof(tablePageLayout)),
+        zoneMap(NULL),
+        fsm(bufMgr, fsmFile),
+        uniqueKeysLoaded(false),
+        appendNewPage(false) {
   if (logger != NULL) LOG4CXX_INFO(logger, "DBTable()");
-  slotMaskCnt = tuplesPerPage() / 32 + 1;
-  _sizeOfPage = sizeof(BlockNo) + slotMaskCnt * sizeof(uint);
-  if (logger != NULL) {
-    LOG4CXX_DEBUG(logger, "slotMaskCnt: " + TO_STR(slotMaskCnt));
-    LOG4CXX_DEBUG(logger, "_sizeOfPage: " + TO_STR(_sizeOfPage));
+  // slotted tables (DBSlottedTable) have no slot masks
+  if (rel.isSlotted() == false) {
+    slotMaskCnt = tuplesPerPage() / 32 + 1;
+    _sizeOfPage = sizeof(uint) + slotMaskCnt * sizeof(uint);
+    if (logger != NULL) {
+      LOG4CXX_DEBUG(logger, "slotMaskCnt: " + TO_STR(slotMaskCnt));
+      LOG4CXX_DEBUG(logger, "_sizeOfPage: " + TO_STR(_sizeOfPage));
+    }
+    assert(tuplesPerPage() >= 1);
+  }
+  if (zoneFile != NULL)
+    zoneMap = new DBZoneMap(bufMgr, *zoneFile, rel);
+  // unique attributes with an index are checked by the index itself
+  for (uint i = 0; i < rel.attrCnt(); ++i) {
+    DBAttrDef attr = rel.attrDef(i);
+    if (attr.isUnique() == true && attr.isIndexed() == false)
+      uniqueAttrs.push_back(i);
   }
-  assert(tuplesPerPage() >= 1);
+  uniqueKeys.resize(uniqueAttrs.size());
   bacbStack.push(bufMgr.fixBlock(file, rootBlockNo, mode == READ ? LOCK_SHARED : LOCK_INTWRITE));
 }
 
 DBTable::~DBTable() {
   LOG4CXX_INFO(logger, "~DBTable()");
   unfixBACBs(false);
+  if (zoneMap != NULL)
+    delete zoneMap;
 }
 
 void DBTable::unfixBACBs(bool setDirty) {
@@ -57,7 +77,7 @@ void DBTable::undo() {
 }
 
 uint DBTable::tuplesPerPage() {
-  return (DBFileBlock::getBlockSize() - sizeOfPage()) / rel.tupleSize();
+  return (file.getBlockSize() - sizeOfPage()) / rel.tupleSize();
 }
 
 string DBTable::toString(string linePrefix) {
@@ -79,8 +99,8 @@ void DBTable::initializeTable(DBBufferMgr &bufMgr, DBFile &file) {
   try {
     bacbStack.push(bufMgr.fixNewBlock(file));
     tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
-    memset(page, 0, DBFileBlock::getBlockSize());
-    page->nextFreeBlock = rootBlockNo;
+    memset(page, 0, file.getBlockSize());
+    page->tupleCnt = CNT_VALID;
     bacbStack.top().setModified();
   } catch (DBException e) {
     if (bacbStack.empty() == false)
@@ -91,41 +111,49 @@ void DBTable::initializeTable(DBBufferMgr &bufMgr, DBFile &file) {
   bacbStack.pop();
 }
 
+/**
+ * Unique attributes normally have an index (created with the table) that
+ * rejects duplicates. Only for unique attributes without one the keys of the
+ * table are read once per open table and kept in memory.
+ */
 void DBTable::assertUnique(DBTuple &tuple) {
   LOG4CXX_INFO(logger, "assertUnique()");
   LOG4CXX_DEBUG(logger, "tuple:\n" + tuple.toString("\t"));
-  bool uni[MAX_ATTR_PER_REL];
-  bool check = false;
-  for (uint i = 0; i < rel.attrCnt(); ++i) {
-    DBAttrDef attr = rel.attrDef(i);
-    if (attr.isUnique() == true && attr.isIndexed() == false) {
-      uni[i] = true;
-      check = true;
-    } else {
-      uni[i] = false;
-    }
-  }
-  LOG4CXX_DEBUG(logger, "check: " + TO_STR(check));
-  if (check == false)
+  LOG4CXX_DEBUG(logger, "check: " + TO_STR(uniqueAttrs.size()));
+  if (uniqueAttrs.empty() == true)
     return;
 
-  list<DBTuple> tupleList;
+  if (uniqueKeysLoaded == false)
+    loadUniqueKeys();
+  for (uint u = 0; u < uniqueAttrs.size(); ++u) {
+    if (uniqueKeys[u].count(tuple.getAttrVal(uniqueAttrs[u]).normalizedKey()) > 0)
+      throw DBTableException("unique constraint");
+  }
+}
+
+void DBTable::loadUniqueKeys() {
+  LOG4CXX_INFO(logger, "loadUniqueKeys()");
+  uint attrMask = 0;
+  for (uint u = 0; u < uniqueAttrs.size(); ++u)
+    attrMask |= 1u << uniqueAttrs[u];
+
+  DBListTuple tupleList;
   TID tid;
   tid.page = 0;
   tid.slot = 0;
   do {
     tupleList.clear();
-    tid = readSeqFromTID(tid, 100, tupleList);
+    tid = readSeqFromTID(tid, 100, tupleList, NULL, attrMask);
     LOG4CXX_DEBUG(logger, (string) "read " + TO_STR(tupleList.size()) + " tuples");
-    list<DBTuple>::iterator i = tupleList.begin();
+    DBListTuple::iterator i = tupleList.begin();
     while (i != tupleList.end()) {
-      for (uint c = 0; c < rel.attrCnt(); ++c)
-        if (uni[c] == true && (*i).getAttrVal(c) == tuple.getAttrVal(c))
-          throw DBTableException("unique constraint");
+      for (uint u = 0; u < uniqueAttrs.size(); ++u)
+        uniqueKeys[u].insert((*i).getAttrVal(uniqueAttrs[u]).normalizedKey());
       ++i;
     }
   } while (tupleList.size() == 100);
   assert(bacbStack.size() == 1);
+  uniqueKeysLoaded = true;
 }
 
 void DBTable::insert(DBTuple &tuple) {
@@ -136,63 +164,155 @@ void DBTable::insert(DBTuple &tuple) {
     throw DBTableException("BACB Stack is invalid");
 
   assertUnique(tuple);
+  if (fsm.isBuilt() == false)
+    buildFreeSpaceMap();
 
-  if (bacbStack.top().getLockMode() != LOCK_EXCLUSIVE)
-    bufMgr.upgradeToExclusive(bacbStack.top());
-
-  tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
   uint max = tuplesPerPage();
   LOG4CXX_DEBUG(logger, "max: " + TO_STR(max));
-  uint pos = findFreeSlot(page->slotUsedMask, max);
-  LOG4CXX_DEBUG(logger, "pos: " + TO_STR(pos));
-  BlockNo n = page->nextFreeBlock;
-  while (pos == max && n != rootBlockNo) {
+  uint pos = max;
+  BlockNo n;
+  while (pos == max && fsm.findFree(n) == true) {
     LOG4CXX_DEBUG(logger, "n: " + TO_STR(n));
-    bacbStack.push(bufMgr.fixBlock(file, n, LOCK_EXCLUSIVE));
-    page = (tablePageLayout *) bacbStack.top().getDataPtr();
-    pos = findFreeSlot(page->slotUsedMask, max);
+    fixPage(n);
+    tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
+    if (getTupleCnt(page) < max)
+      pos = findFreeSlot(page->slotUsedMask, max);
     LOG4CXX_DEBUG(logger, "pos: " + TO_STR(pos));
     if (pos == max) {
-      n = page->nextFreeBlock;
-      page->nextFreeBlock = rootBlockNo;
-      bacbStack.top().setModified();
-      bufMgr.unfixBlock(bacbStack.top());
-      bacbStack.pop();
+      // stale entry
+      fsm.setFree(n, false);
+      unfixPage();
     }
   }
-  LOG4CXX_DEBUG(logger, "n: " + TO_STR(n));
-  LOG4CXX_DEBUG(logger, "pos: " + TO_STR(pos));
 
-  if (pos == max) {
+  bool newPage = pos == max;
+  if (newPage == true) {
     bacbStack.push(bufMgr.fixNewBlock(file));
-    page = (tablePageLayout *) bacbStack.top().getDataPtr();
-    memset(page, 0, DBFileBlock::getBlockSize());
-    page->nextFreeBlock = rootBlockNo;
+    memset(bacbStack.top().getDataPtr(), 0, file.getBlockSize());
+    ((tablePageLayout *) bacbStack.top().getDataPtr())->tupleCnt = CNT_VALID;
     pos = 0;
     bacbStack.top().setModified();
   }
 
+  placeTuple(pos, tuple);
+  tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
+  bool free = getTupleCnt(page) < max;
+  if (free == newPage)
+    fsm.setFree(tuple.getTID().page, free);
+  unfixPage();
+
+  assert(bacbStack.size() == 1);
+}
+
+/**
+ * Fixes page blockNo exclusively on top of the stack, the root page stays
+ * fixed and is upgraded instead
+ */
+void DBTable::fixPage(BlockNo blockNo) {
+  if (blockNo != rootBlockNo) {
+    bacbStack.push(bufMgr.fixBlock(file, blockNo, LOCK_EXCLUSIVE));
+  } else if (bacbStack.top().getLockMode() != LOCK_EXCLUSIVE) {
+    bufMgr.upgradeToExclusive(bacbStack.top());
+  }
+}
+
+void DBTable::unfixPage() {
+  if (bacbStack.size() > 1) {
+    bufMgr.unfixBlock(bacbStack.top());
+    bacbStack.pop();
+  }
+}
+
+/**
+ * Enters every page with free slots, for tables written without a free-space map
+ */
+void DBTable::buildFreeSpaceMap() {
+  LOG4CXX_INFO(logger, "buildFreeSpaceMap()");
+  BlockNo cnt = bufMgr.getBlockCount(file);
+  for (BlockNo b = rootBlockNo; b < cnt; ++b) {
+    if (b != rootBlockNo)
+      bacbStack.push(bufMgr.fixBlock(file, b, LOCK_SHARED));
+    bool free = hasFreeSpace(bacbStack.top());
+    if (free == true || b == rootBlockNo)
+      fsm.setFree(b, free);
+    unfixPage();
+  }
+}
+
+bool DBTable::hasFreeSpace(const DBBACB &bacb) {
+  return getTupleCnt((const tablePageLayout *) bacb.getDataPtr()) < tuplesPerPage();
+}
+
+/**
+ * Writes the tuple into slot pos of the page on top of the stack
+ */
+void DBTable::placeTuple(uint pos, DBTuple &tuple) {
   TID t;
   t.page = bacbStack.top().getBlockNo();
   t.slot = pos;
   tuple.setTID(t);
-  page = (tablePageLayout *) bacbStack.top().getDataPtr();
+  tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
+  uint cnt = getTupleCnt(page);
   setSlot(page->slotUsedMask, pos);
+  page->tupleCnt = CNT_VALID | (cnt + 1);
   char *ptr = bacbStack.top().getDataPtr();
   ptr += sizeOfPage();
   ptr += pos * rel.tupleSize();
   tuple.write(ptr);
   bacbStack.top().setModified();
-  if (bacbStack.size() > 1) {
-    bufMgr.unfixBlock(bacbStack.top());
-    bacbStack.pop();
-    page = (tablePageLayout *) bacbStack.top().getDataPtr();
-    page->nextFreeBlock = t.page;
-    bacbStack.top().setModified();
+  for (uint u = 0; u < uniqueKeys.size(); ++u)
+    uniqueKeys[u].insert(tuple.getAttrVal(uniqueAttrs[u]).normalizedKey());
+  if (zoneMap != NULL) {
+    if (zoneMap->isValid(t.page) == true)
+      zoneMap->add(t.page, tuple);
+    else
+      summarizePage(bacbStack.top());
   }
+}
 
-  assert(bacbStack.size() == 1);
+void DBTable::append(DBTuple &tuple) {
+  LOG4CXX_INFO(logger, "append()");
+  LOG4CXX_DEBUG(logger, "tuple:\n" + tuple.toString("\t"));
+
+  assertUnique(tuple);
+
+  uint max = tuplesPerPage();
+  if (bacbStack.size() == 1) {
+    if (fsm.isBuilt() == false)
+      buildFreeSpaceMap();
+    fixPage(bufMgr.getBlockCount(file) - 1);
+    appendNewPage = false;
+  }
 
+  tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
+  uint pos = getTupleCnt(page) < max ? findFreeSlot(page->slotUsedMask, max) : max;
+  if (pos == max) {
+    if (appendNewPage == false)
+      fsm.setFree(bacbStack.top().getBlockNo(), false);
+    unfixPage();
+    bacbStack.push(bufMgr.fixNewBlock(file));
+    memset(bacbStack.top().getDataPtr(), 0, file.getBlockSize());
+    ((tablePageLayout *) bacbStack.top().getDataPtr())->tupleCnt = CNT_VALID;
+    appendNewPage = true;
+    pos = 0;
+  }
+  placeTuple(pos, tuple);
+}
+
+void DBTable::endAppend() {
+  LOG4CXX_INFO(logger, "endAppend()");
+  if (bacbStack.size() == 1 && appendNewPage == false)
+    return;
+
+  bool free = hasFreeSpace(bacbStack.top());
+  // pages filled before are entered already
+  if (appendNewPage == true && free == true)
+    fsm.setFree(bacbStack.top().getBlockNo(), true);
+  else if (appendNewPage == false && free == false)
+    fsm.setFree(bacbStack.top().getBlockNo(), false);
+  unfixPage();
+  appendNewPage = false;
+  assert(bacbStack.size() == 1);
 }
 
 void DBTable::remove(const DBListTID &tidList) {
@@ -200,84 +320,128 @@ void DBTable::remove(const DBListTID &tidList) {
   if (bacbStack.size() != 1)
     throw DBTableException("BACB Stack is invalid");
 
-  if (bacbStack.top().getLockMode() != LOCK_EXCLUSIVE)
-    bufMgr.upgradeToExclusive(bacbStack.top());
+  if (fsm.isBuilt() == false)
+    buildFreeSpaceMap();
 
+  uint max = tuplesPerPage();
   DBListTID::const_iterator i = tidList.begin();
   while (i != tidList.end()) {
     const TID &tid = (*i);
     LOG4CXX_INFO(logger, "tid: " + tid.toString());
 
+    fixPage(tid.page);
     tablePageLayout *page = (tablePageLayout *) bacbStack.top().getDataPtr();
-    BlockNo n = page->nextFreeBlock;
-
-    if (rootBlockNo != tid.page) {
-      bacbStack.push(bufMgr.fixBlock(file, tid.page, LOCK_EXCLUSIVE));
-    }
-
-    page = (tablePageLayout *) bacbStack.top().getDataPtr();
+    uint cnt = getTupleCnt(page);
+    bool full = cnt == max;
 
-    unsetSlot(page->slotUsedMask, tid.slot);
-
-    if (page->nextFreeBlock == rootBlockNo) {
-      page->nextFreeBlock = n;
-      n = bacbStack.top().getBlockNo();
+    if (isSlot(page->slotUsedMask, tid.slot) == true) {
+      if (uniqueKeysLoaded == true) {
+        DBTuple t;
+        t.read(rel, bacbStack.top().getDataPtr() + sizeOfPage() + tid.slot * rel.tupleSize());
+        for (uint u = 0; u < uniqueKeys.size(); ++u)
+          uniqueKeys[u].erase(t.getAttrVal(uniqueAttrs[u]).normalizedKey());
+      }
+      unsetSlot(page->slotUsedMask, tid.slot);
+      --cnt;
     }
+    page->tupleCnt = CNT_VALID | cnt;
+    // Minimum/Maximum werden nicht verkleinert, nur leere Seiten zurückgesetzt
+    if (zoneMap != NULL && cnt == 0)
+      zoneMap->clear(tid.page);
     bacbStack.top().setModified();
 
-    if (bacbStack.size() > 1) {
-      bufMgr.unfixBlock(bacbStack.top());
-      bacbStack.pop();
-      page = (tablePageLayout *) bacbStack.top().getDataPtr();
-      if (n != page->nextFreeBlock) {
-        page->nextFreeBlock = n;
-        bacbStack.top().setModified();
-      }
-    }
+    if (full == true)
+      fsm.setFree(tid.page, true);
+    unfixPage();
     ++i;
   }
 
   assert(bacbStack.size() == 1);
 }
 
-void DBTable::readTIDs(const list<TID> &tids, list<DBTuple> &tupleList) {
+void DBTable::readTIDs(const list<TID> &tids, list<DBTuple> &tupleList, uint attrMask) {
+  DBTIDBatch batch(tids.begin(), tids.end());
+  readTIDs(batch, tupleList, attrMask);
+}
+
+void DBTable::readTIDs(const DBTIDBatch &tids, DBListTuple &tupleList, uint attrMask, bool keepOrder) {
   LOG4CXX_INFO(logger, "readTIDs()");
+  LOG4CXX_DEBUG(logger, "tids: " + TO_STR(tids.size()));
   if (bacbStack.size() != 1)
     throw DBTableException("BACB Stack is invalid");
 
-  list<TID>::const_iterator i = tids.begin();
-  while (i != tids.end()) {
-    const TID &tid = (*i);
-    LOG4CXX_DEBUG(logger, "tid: " + tid.toString());
-    if (tid.page != rootBlockNo)
-      bacbStack.push(bufMgr.fixBlock(file, tid.page, LOCK_SHARED));
+  // positions of the tids in page and slot order
+  vector<uint> order(tids.size());
+  for (uint n = 0; n < order.size(); ++n)
+    order[n] = n;
+  if (is_sorted(tids.begin(), tids.end()) == false)
+    stable_sort(order.begin(), order.end(), [&tids](uint a, uint b) { return tids[a] < tids[b]; });
+
+  vector<BlockNo> pages;
+  for (uint n = 0; n < order.size(); ++n) {
+    if (pages.empty() == true || pages.back() != tids[order[n]].page)
+      pages.push_back(tids[order[n]].page);
+  }
 
-    const char *ptr = bacbStack.top().getDataPtr();
-    tablePageLayout *page = (tablePageLayout *) ptr;
-    if (isSlot(page->slotUsedMask, tid.slot) == true) {
-      DBTuple t;
-      t.setTID(tid);
-      ptr += sizeOfPage();
-      ptr += tid.slot * rel.tupleSize();
-      t.read(rel, ptr);
-      LOG4CXX_DEBUG(logger, "tuple:\n" + t.toString("\t"));
-      tupleList.push_back(t);
-    } else {
-      throw DBTableException("invalid TID");
+  // to keep the caller's order the tuples are appended first and filled page by page
+  size_t oldSize = tupleList.size();
+  vector<DBTuple *> target;
+  if (keepOrder == true) {
+    target.reserve(tids.size());
+    for (uint n = 0; n < tids.size(); ++n) {
+      tupleList.push_back(DBTuple());
+      target.push_back(&tupleList.back());
     }
+  }
 
-    if (tid.page != rootBlockNo) {
-      bufMgr.unfixBlock(bacbStack.top());
-      bacbStack.pop();
+  try {
+    uint p = 0, prefetched = 1;
+    for (uint n = 0; n < order.size(); ++n) {
+      const TID &tid = tids[order[n]];
+      LOG4CXX_DEBUG(logger, "tid: " + tid.toString());
+      if (n == 0 || tid.page != tids[order[n - 1]].page) {
+        unfixPage();
+        for (; prefetched < pages.size() && prefetched <= p + STD_PREFETCH_PAGES; ++prefetched) {
+          if (pages[prefetched] != rootBlockNo)
+            bufMgr.prefetchBlock(file, pages[prefetched]);
+        }
+        if (tid.page != rootBlockNo)
+          bacbStack.push(bufMgr.fixBlock(file, tid.page, LOCK_SHARED));
+        ++p;
+      }
+      if (keepOrder == true) {
+        readTuple(bacbStack.top(), tid, *target[order[n]], attrMask);
+      } else {
+        tupleList.push_back(DBTuple());
+        readTuple(bacbStack.top(), tid, tupleList.back(), attrMask);
+      }
     }
-    ++i;
+    unfixPage();
+  } catch (DBException e) {
+    unfixPage();
+    tupleList.resize(oldSize);
+    throw e;
   }
   assert(bacbStack.size() == 1);
 }
 
+void DBTable::readTuple(const DBBACB &bacb, const TID &tid, DBTuple &tuple, uint attrMask) {
+  const char *ptr = bacb.getDataPtr();
+  const tablePageLayout *page = (const tablePageLayout *) ptr;
+  if (isSlot(page->slotUsedMask, tid.slot) == false)
+    throw DBTableException("invalid TID");
+  tuple.setTID(tid);
+  ptr += sizeOfPage();
+  ptr += tid.slot * rel.tupleSize();
+  tuple.read(rel, ptr, attrMask);
+  LOG4CXX_DEBUG(logger, "tuple:\n" + tuple.toString("\t"));
+}
+
 TID DBTable::readSeqFromTID(TID tid,
                             uint numOfTuples,
-                            list<DBTuple> &tupleList) {
+                            list<DBTuple> &tupleList,
+                            DBListPredicate *where,
+                            uint attrMask) {
   LOG4CXX_INFO(logger, "readSeqFromTID()");
   LOG4CXX_DEBUG(logger, "tid: " + tid.toString());
   LOG4CXX_DEBUG(logger, "numOfTuples: " + TO_STR(numOfTuples));
@@ -285,30 +449,42 @@ TID DBTable::readSeqFromTID(TID tid,
     throw DBTableException("BACB Stack is invalid");
 
   uint max = tuplesPerPage();
+  DBListPredicate none;
+  DBPageFilter filter(rel, where != NULL ? *where : none);
+  vector<uint> mask(slotMaskCnt);
   while (numOfTuples > 0 && tid.page < bufMgr.getBlockCount(file)) {
+    if (where != NULL && zoneMap != NULL && zoneMap->mayMatch(tid.page, *where) == false) {
+      LOG4CXX_DEBUG(logger, "skip page: " + TO_STR(tid.page));
+      ++tid.page;
+      tid.slot = 0;
+      continue;
+    }
     if (tid.page != rootBlockNo)
       bacbStack.push(bufMgr.fixBlock(file, tid.page, LOCK_SHARED));
     const char *ptr = bacbStack.top().getDataPtr();
-    LOG4CXX_DEBUG(logger, "ptr: " + TO_STR((char *) ptr));
     tablePageLayout *page = (tablePageLayout *) ptr;
     ptr += sizeOfPage();
-    if (tid.slot != 0) {
-      ptr += rel.tupleSize() * tid.slot;
-    }
-    LOG4CXX_DEBUG(logger, "ptr: " + TO_STR((char *) ptr));
-
-    for (; tid.slot < max && numOfTuples > 0; ++tid.slot) {
-      LOG4CXX_DEBUG(logger, "ptr: " + TO_STR((char *) ptr));
-      if (isSlot(page->slotUsedMask, tid.slot) == true) {
-        --numOfTuples;
-        DBTuple t;
-        t.setTID(tid);
-        t.read(rel, ptr);
-        LOG4CXX_DEBUG(logger, "tuple:\n" + t.toString("\t"));
-        tupleList.push_back(t);
-        LOG4CXX_DEBUG(logger, "push_back done");
+    if (getTupleCnt(page) > 0) {
+      // the predicates are checked on the page bytes, only matching slots are decoded
+      memcpy(mask.data(), page->slotUsedMask, slotMaskCnt * sizeof(uint));
+      if (filter.empty() == false)
+        filter.filter(ptr, max, mask.data());
+
+      for (uint w = tid.slot / 64; w * 64 < max && numOfTuples > 0; ++w) {
+        uint64_t bits = maskWord(mask.data(), w);
+        if (w == tid.slot / 64)
+          bits &= ~(uint64_t) 0 << (tid.slot % 64);
+        for (; bits != 0 && numOfTuples > 0; bits &= bits - 1) {
+          tid.slot = w * 64 + __builtin_ctzll(bits);
+          --numOfTuples;
+          tupleList.push_back(DBTuple());
+          DBTuple &t = tupleList.back();
+          t.setTID(tid);
+          t.read(rel, ptr + tid.slot * rel.tupleSize(), attrMask);
+          LOG4CXX_DEBUG(logger, "tuple:\n" + t.toString("\t"));
+          ++tid.slot;
+        }
       }
-      ptr += rel.tupleSize();
     }
     LOG4CXX_DEBUG(logger, "finished for");
     if (bacbStack.top().getBlockNo() != rootBlockNo) {
@@ -325,39 +501,74 @@ TID DBTable::readSeqFromTID(TID tid,
   return tid;
 }
 
-uint DBTable::findFreeSlot(uint *slotMask, uint max) {
+void DBTable::summarizePage(const DBBACB &bacb) {
+  LOG4CXX_INFO(logger, "summarizePage()");
+  zoneMap->clear(bacb.getBlockNo());
+  const char *ptr = bacb.getDataPtr();
+  tablePageLayout *page = (tablePageLayout *) ptr;
+  ptr += sizeOfPage();
+  uint max = tuplesPerPage();
+  for (uint w = 0; w * 64 < max; ++w) {
+    for (uint64_t bits = maskWord(page->slotUsedMask, w); bits != 0; bits &= bits - 1) {
+      DBTuple t;
+      t.read(rel, ptr + (w * 64 + __builtin_ctzll(bits)) * rel.tupleSize());
+      zoneMap->add(bacb.getBlockNo(), t);
+    }
+  }
+}
+
+uint DBTable::findFreeSlot(const uint *slotMask, uint max) {
   LOG4CXX_INFO(logger, "findFreeSlot()");
-  LOG4CXX_DEBUG(logger, "slotMask: " + TO_STR(slotMask));
   LOG4CXX_DEBUG(logger, "max: " + TO_STR(max));
 
-  for (uint c = 0; c < slotMaskCnt; ++c) {
-    uint tmp = slotMask[c];
-    for (uint i = 0; i < 32; ++i) {
-      LOG4CXX_DEBUG(logger, "tmp: " + TO_STR(tmp));
-      if ((tmp & 1) == 0)
-        return c * 32 + i;
-      tmp >>= 1;
+  for (uint w = 0; w * 64 < max; ++w) {
+    uint64_t free = ~maskWord(slotMask, w);
+    if (free != 0) {
+      uint pos = w * 64 + __builtin_ctzll(free);
+      return pos < max ? pos : max;
     }
   }
   return max;
 }
 
+/**
+ * Slots 64 * w bis 64 * w + 63; das Wort nach dem letzten Maskenwort gilt als leer
+ */
+uint64_t DBTable::maskWord(const uint *slotMask, uint w) {
+  uint64_t bits = slotMask[2 * w];
+  if (2 * w + 1 < slotMaskCnt)
+    bits |= (uint64_t) slotMask[2 * w + 1] << 32;
+  return bits;
+}
+
+/**
+ * Anzahl belegter Slots; Seiten ohne gültigen Zähler werden gezählt
+ */
+uint DBTable::getTupleCnt(const tablePageLayout *page) {
+  if ((page->tupleCnt & CNT_VALID) != 0)
+    return page->tupleCnt & ~CNT_VALID;
+  uint cnt = 0;
+  for (uint w = 0; 2 * w < slotMaskCnt; ++w)
+    cnt += __builtin_popcountll(maskWord(page->slotUsedMask, w));
+  return cnt;
+}
+
 void DBTable::setSlot(uint *slotMask, uint pos) {
   uint c = pos / 32;
   uint idx = pos % 32;
-  slotMask[c] |= 1 << idx;
+  slotMask[c] |= 1u << idx;
 }
 
 void DBTable::unsetSlot(uint *slotMask, uint pos) {
   uint c = pos / 32;
   uint idx = pos % 32;
-  slotMask[c] &= ~(1 << idx);
+  slotMask[c] &= ~(1u << idx);
 }
 
-bool DBTable::isSlot(uint *slotMask, uint pos) {
+bool DBTable::isSlot(const uint *slotMask, uint pos) {
   uint c = pos / 32;
   uint idx = pos % 32;
-  if ((slotMask[c] & (1 << idx)) == 0) {
+  if ((slotMask[c] & (1u << idx)) == 0) {
     return false;
   } else {
     return true;
@@ -0,0 +1,163 @@
+#include <hubDB/DBTempFile.h>
+#include <hubDB/DBFileBlock.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Table;
+using namespace HubDB::Exception;
+
+LoggerPtr DBTempFile::logger(Logger::getLogger("HubDB.Table.DBTempFile"));
+
+DBTempFile::DBTempFile(DBBufferMgr &bufMgr, DBFile &file, const string &fileName, const DBRelDef &rel) :
+        bufMgr(bufMgr),
+        file(file),
+        fileName(fileName),
+        rel(rel),
+        tupleCnt(0) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBTempFile()");
+  readPos.page = 0;
+  readPos.slot = 0;
+}
+
+DBTempFile::~DBTempFile() {
+  LOG4CXX_INFO(logger, "~DBTempFile()");
+  unfixBACBs();
+  try {
+    bufMgr.dropFile(fileName);
+  } catch (DBException e) {
+    LOG4CXX_ERROR(logger, "can not drop " + fileName + ": " + e.what());
+  }
+}
+
+string DBTempFile::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBTempFile]" << endl;
+  ss << linePrefix << "fileName: " << fileName << endl;
+  ss << linePrefix << "tupleCnt: " << tupleCnt << endl;
+  ss << linePrefix << "pageCapacity: " << pageCapacity() << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+size_t DBTempFile::pageCapacity() const {
+  return file.getBlockSize() - sizeof(tempPageLayout);
+}
+
+void DBTempFile::unfixBACBs() {
+  while (bacbStack.empty() == false) {
+    try {
+      bufMgr.unfixBlock(bacbStack.top());
+    } catch (DBException e) {}
+    bacbStack.pop();
+  }
+}
+
+/**
+ * Hängt ein Tupel (mit seiner TID) an das Ende der Datei an
+ */
+void DBTempFile::append(const DBTuple &tuple) {
+  LOG4CXX_INFO(logger, "append()");
+  uint len = tuple.recordSize(rel) + sizeof(TID);
+  buf.resize(sizeof(len) + len);
+  char *ptr = &buf[0];
+  memcpy(ptr, &len, sizeof(len));
+  ptr = tuple.writeRecord(rel, ptr + sizeof(len));
+  tuple.getTID().write(ptr);
+  writeBytes(&buf[0], buf.size());
+  ++tupleCnt;
+}
+
+/**
+ * Schreibt len Bytes hinter die letzte Seite, volle Seiten werden freigegeben
+ */
+void DBTempFile::writeBytes(const char *ptr, size_t len) {
+  while (len > 0) {
+    if (bacbStack.empty() == false &&
+        ((tempPageLayout *) bacbStack.top().getDataPtr())->used == pageCapacity()) {
+      bufMgr.unfixBlock(bacbStack.top());
+      bacbStack.pop();
+    }
+    if (bacbStack.empty() == true) {
+      bacbStack.push(bufMgr.fixNewBlock(file));
+    }
+    tempPageLayout *page = (tempPageLayout *) bacbStack.top().getDataPtr();
+    size_t n = min(len, pageCapacity() - page->used);
+    memcpy(bacbStack.top().getDataPtr() + sizeof(tempPageLayout) + page->used, ptr, n);
+    page->used += n;
+    ptr += n;
+    len -= n;
+    bacbStack.top().setModified();
+  }
+}
+
+void DBTempFile::rewind() {
+  LOG4CXX_INFO(logger, "rewind()");
+  unfixBACBs();
+  readPos.page = 0;
+  readPos.slot = 0;
+}
+
+/**
+ * Liest len Bytes ab readPos, die Seite des letzten Bytes bleibt fixiert
+ * @return false am Dateiende
+ */
+bool DBTempFile::readBytes(char *ptr, size_t len) {
+  while (len > 0) {
+    if (bacbStack.empty() == true) {
+      if (readPos.page >= bufMgr.getBlockCount(file))
+        return false;
+      bacbStack.push(bufMgr.fixBlock(file, readPos.page, LOCK_SHARED));
+    }
+    const tempPageLayout *page = (const tempPageLayout *) bacbStack.top().getDataPtr();
+    if (readPos.slot == page->used) {
+      bufMgr.unfixBlock(bacbStack.top());
+      bacbStack.pop();
+      ++readPos.page;
+      readPos.slot = 0;
+      continue;
+    }
+    size_t n = min(len, (size_t) (page->used - readPos.slot));
+    memcpy(ptr, bacbStack.top().getDataPtr() + sizeof(tempPageLayout) + readPos.slot, n);
+    readPos.slot += n;
+    ptr += n;
+    len -= n;
+  }
+  return true;
+}
+
+uint DBTempFile::read(uint numOfTuples, DBListTuple &tupleList) {
+  LOG4CXX_INFO(logger, "read()");
+  if (bacbStack.empty() == false)
+    throw DBException("read before rewind");
+
+  uint cnt = 0;
+  try {
+    uint len;
+    while (cnt < numOfTuples && readBytes((char *) &len, sizeof(len)) == true) {
+      // records within the fixed page are decoded in place
+      const tempPageLayout *page = (const tempPageLayout *) bacbStack.top().getDataPtr();
+      const char *ptr;
+      if (page->used - readPos.slot >= len) {
+        ptr = bacbStack.top().getDataPtr() + sizeof(tempPageLayout) + readPos.slot;
+        readPos.slot += len;
+      } else {
+        buf.resize(len);
+        if (readBytes(&buf[0], len) == false)
+          throw DBException("incomplete tuple in " + fileName);
+        ptr = &buf[0];
+      }
+      tupleList.push_back(DBTuple());
+      ptr = tupleList.back().readRecord(rel, ptr);
+      TID t;
+      t.read(ptr);
+      tupleList.back().setTID(t);
+      ++cnt;
+    }
+  } catch (DBException e) {
+    unfixBACBs();
+    throw e;
+  }
+  unfixBACBs();
+  LOG4CXX_DEBUG(logger, "read " + TO_STR(cnt) + " tuples");
+  return cnt;
+}
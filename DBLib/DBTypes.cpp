@@ -1,6 +1,8 @@
 #include <hubDB/DBTypes.h>
 #include <hubDB/DBException.h>
 
+#include <stdint.h>
+
 using namespace HubDB::Types;
 using namespace HubDB::Exception;
 
@@ -49,7 +51,13 @@ size_t DBAttrType::getSize4Type(const AttrTypeEnum t) {
   throw DBException("unknow attribute type " + t);
 }
 
-string DBAttrType::getName4Type(const AttrTypeEnum t) {
+size_t DBAttrType::getKeySize4Type(const AttrTypeEnum t) {
+  if (t == VCHAR)
+    return 0;
+  return getSize4Type(t);
+}
+
+string DBAttrType::getName4Type(const AttrTypeEnum t, uint len) {
   stringstream ss;
   switch (t) {
     case INT:
@@ -59,7 +67,7 @@ string DBAttrType::getName4Type(const AttrTypeEnum t) {
       ss << "Double";
       break;
     case VCHAR:
-      ss << "VarChar(" << DBVCharType::getSize() << ")";
+      ss << "VarChar(" << (len == 0 ? DBVCharType::getSize() : len) << ")";
       break;
     case NONE:
     default:
@@ -89,12 +97,33 @@ DBAttrType *DBAttrType::read(const char *ptr, const AttrTypeEnum t, const char *
     case VCHAR:
       if (ptrNext != NULL)
         *ptrNext = ptr + getSize4Type(t);
-      return new DBVCharType(ptr);
+      return new DBVCharType(ptr, getSize4Type(t));
     default:
       throw DBException("unknow attribute type " + t);
   }
 }
 
+/**
+ * Wie read(), aber im variablen Satzformat (siehe DBTuple::writeRecord())
+ */
+DBAttrType *DBAttrType::readRecord(const char *ptr, const AttrTypeEnum t, const char **ptrNext) {
+  if (t != VCHAR)
+    return read(ptr, t, ptrNext);
+  uint16_t len;
+  memcpy(&len, ptr, sizeof(len));
+  if (ptrNext != NULL)
+    *ptrNext = ptr + sizeof(len) + len;
+  return new DBVCharType(string(ptr + sizeof(len), len));
+}
+
+size_t DBAttrType::getRecordSize(const char *ptr, const AttrTypeEnum t) {
+  if (t != VCHAR)
+    return getSize4Type(t);
+  uint16_t len;
+  memcpy(&len, ptr, sizeof(len));
+  return sizeof(len) + len;
+}
+
 DBAttrType *DBAttrType::import(DataImport &ptr, const AttrTypeEnum t) {
   LOG4CXX_INFO(logger, "import");
   LOG4CXX_DEBUG(logger, DBAttrType::getName4Type(t));
@@ -158,6 +187,19 @@ bool DBIntType::operator<(const DBAttrType &ref) const {
   return false;
 }
 
+// big endian, Vorzeichenbit invertiert
+string DBIntType::normalizedKey() const {
+  uint32_t u = (uint32_t) val ^ 0x80000000u;
+  char key[sizeof(u)];
+  for (uint i = 0; i < sizeof(u); ++i)
+    key[i] = (char) (u >> (8 * (sizeof(u) - 1 - i)));
+  return string(key, sizeof(key));
+}
+
+size_t DBIntType::hashValue() const {
+  return std::hash<int>()(val);
+}
+
 string DBDoubleType::toString(string linePrefix) const {
   stringstream ss;
   ss << linePrefix << "[DBDoubleType]" << endl;
@@ -199,6 +241,22 @@ bool DBDoubleType::operator<(const DBAttrType &ref) const {
   return false;
 }
 
+// big endian, negative Werte komplett invertiert, sonst nur das Vorzeichenbit
+string DBDoubleType::normalizedKey() const {
+  double d = (val == 0.0) ? 0.0 : val; // -0.0 == 0.0
+  uint64_t u;
+  memcpy(&u, &d, sizeof(u));
+  u = (u & 0x8000000000000000ull) ? ~u : (u | 0x8000000000000000ull);
+  char key[sizeof(u)];
+  for (uint i = 0; i < sizeof(u); ++i)
+    key[i] = (char) (u >> (8 * (sizeof(u) - 1 - i)));
+  return string(key, sizeof(key));
+}
+
+size_t DBDoubleType::hashValue() const {
+  return std::hash<double>()((val == 0.0) ? 0.0 : val);
+}
+
 string DBVCharType::toString(string linePrefix) const {
   stringstream ss;
   ss << linePrefix << "[DBVCharType]" << endl;
@@ -219,8 +277,7 @@ ostream &DBVCharType::print(ostream &s, bool align) const {
 bool DBVCharType::operator==(const DBAttrType &ref) const {
   if (typeid(ref) == typeid(*this)) {
     DBVCharType &i = (DBVCharType &) ref;
-    int rc = strcmp(val, i.val);
-    return rc == 0 ? true : false;
+    return val == i.val;
   }
   return false;
 }
@@ -228,7 +285,7 @@ bool DBVCharType::operator==(const DBAttrType &ref) const {
 bool DBVCharType::operator>(const DBAttrType &ref) const {
   if (typeid(ref) == typeid(*this)) {
     DBVCharType &i = (DBVCharType &) ref;
-    int rc = strcmp(val, i.val);
+    int rc = val.compare(i.val);
     return rc > 0 ? true : false;
   }
   return false;
@@ -237,12 +294,28 @@ bool DBVCharType::operator>(const DBAttrType &ref) const {
 bool DBVCharType::operator<(const DBAttrType &ref) const {
   if (typeid(ref) == typeid(*this)) {
     DBVCharType &i = (DBVCharType &) ref;
-    int rc = strcmp(val, i.val);
+    int rc = val.compare(i.val);
     return rc < 0 ? true : false;
   }
   return false;
 }
 
+// string::compare vergleicht wie memcmp vorzeichenlos, kürzere Präfixe zuerst
+string DBVCharType::normalizedKey() const {
+  return val;
+}
+
+size_t DBVCharType::hashValue() const {
+  return std::hash<string>()(val);
+}
+
+char *DBVCharType::writeRecord(char *ptr) const {
+  uint16_t len = val.size();
+  memcpy(ptr, &len, sizeof(len));
+  memcpy(ptr + sizeof(len), val.data(), len);
+  return ptr + sizeof(len) + len;
+}
+
 string DBAttrDef::toString(string linePrefix) const {
   stringstream ss;
   ss << linePrefix << "[DBAttrDef]" << endl;
@@ -284,6 +357,7 @@ string DBRelDef::toString(string linePrefix) const {
   ss << linePrefix << "name: " << relationName() << endl;
   ss << linePrefix << "attrCnt: " << attrCnt() << endl;
   ss << linePrefix << "tupleSize: " << tupleSize() << endl;
+  ss << linePrefix << "slotted: " << boolalpha << isSlotted() << endl;
   for (uint i = 0; i < attrCnt(); ++i) {
     ss << attrDef(i).toString(linePrefix + "\t");
   }
@@ -298,8 +372,7 @@ DBTuple::DBTuple(const DBTuple &ref) {
   vector<DBAttrType *>::const_iterator i = ref.vals.begin();
   LOG4CXX_DEBUG(logger, "vals.size: " + TO_STR(ref.vals.size()));
   while (i != ref.vals.end()) {
-    LOG4CXX_DEBUG(logger, "i:\n" + (*i)->toString("\t"));
-    vals.push_back(DBAttrType::clone(*(*i)));
+    vals.push_back((*i) == NULL ? NULL : DBAttrType::clone(*(*i)));
     ++i;
   }
   LOG4CXX_DEBUG(logger, "this:\n" + toString("\t"));
@@ -328,8 +401,7 @@ DBTuple &DBTuple::operator=(const DBTuple &ref) {
   vector<DBAttrType *>::const_iterator i = ref.vals.begin();
   LOG4CXX_DEBUG(logger, "vals.size: " + TO_STR(ref.vals.size()));
   while (i != ref.vals.end()) {
-    LOG4CXX_DEBUG(logger, "i:\n" + (*i)->toString("\t"));
-    vals.push_back(DBAttrType::clone(*(*i)));
+    vals.push_back((*i) == NULL ? NULL : DBAttrType::clone(*(*i)));
     ++i;
   }
   LOG4CXX_DEBUG(logger, "this:\n" + toString("\t"));
@@ -343,7 +415,8 @@ string DBTuple::toString(string linePrefix) const {
   vector<DBAttrType *>::const_iterator i = vals.begin();
   while (i != vals.end()) {
     ss << linePrefix << "vals[]=";
-    (*i)->print(ss, false);
+    if ((*i) != NULL)
+      (*i)->print(ss, false);
     ss << endl;
     ++i;
   }
@@ -351,9 +424,15 @@ string DBTuple::toString(string linePrefix) const {
   return ss.str();
 }
 
-const char *DBTuple::read(const DBRelDef &relDef, const char *ptr) {
+const char *DBTuple::read(const DBRelDef &relDef, const char *ptr, uint attrMask) {
+  vals.reserve(relDef.attrCnt());
   for (uint i = 0; i < relDef.attrCnt(); ++i) {
-    vals.push_back(DBAttrType::read(ptr, relDef.attrTypeDef(i), &ptr));
+    if ((attrMask & (1u << i)) != 0) {
+      vals.push_back(DBAttrType::read(ptr, relDef.attrTypeDef(i), &ptr));
+    } else {
+      vals.push_back(NULL);
+      ptr += DBAttrType::getSize4Type(relDef.attrTypeDef(i));
+    }
   }
   return ptr;
 }
@@ -367,13 +446,65 @@ char *DBTuple::write(char *ptr) const {
   return ptr;
 }
 
-void DBTuple::appendAttrVal(DBAttrType *val) {
-  vals.push_back(DBAttrType::clone(*val));
+char *DBTuple::write(const DBRelDef &relDef, char *ptr) const {
+  for (uint i = 0; i < relDef.attrCnt(); ++i) {
+    if (hasAttrVal(i) == true) {
+      ptr = vals[i]->write(ptr);
+    } else {
+      size_t size = DBAttrType::getSize4Type(relDef.attrTypeDef(i));
+      memset(ptr, 0, size);
+      ptr += size;
+    }
+  }
+  return ptr;
+}
+
+size_t DBTuple::recordSize(const DBRelDef &relDef) const {
+  size_t size = 0;
+  for (uint i = 0; i < relDef.attrCnt(); ++i) {
+    if (hasAttrVal(i) == true)
+      size += vals[i]->recordSize();
+    else
+      size += relDef.attrTypeDef(i) == VCHAR ? sizeof(uint16_t) : DBAttrType::getSize4Type(relDef.attrTypeDef(i));
+  }
+  return size;
+}
+
+char *DBTuple::writeRecord(const DBRelDef &relDef, char *ptr) const {
+  for (uint i = 0; i < relDef.attrCnt(); ++i) {
+    if (hasAttrVal(i) == true) {
+      ptr = vals[i]->writeRecord(ptr);
+    } else {
+      size_t size = relDef.attrTypeDef(i) == VCHAR ? sizeof(uint16_t) : DBAttrType::getSize4Type(relDef.attrTypeDef(i));
+      memset(ptr, 0, size);
+      ptr += size;
+    }
+  }
+  return ptr;
+}
+
+const char *DBTuple::readRecord(const DBRelDef &relDef, const char *ptr, uint attrMask) {
+  vals.reserve(relDef.attrCnt());
+  for (uint i = 0; i < relDef.attrCnt(); ++i) {
+    if ((attrMask & (1u << i)) != 0) {
+      vals.push_back(DBAttrType::readRecord(ptr, relDef.attrTypeDef(i), &ptr));
+    } else {
+      vals.push_back(NULL);
+      ptr += DBAttrType::getRecordSize(ptr, relDef.attrTypeDef(i));
+    }
+  }
+  return ptr;
+}
+
+void DBTuple::appendAttrVal(const DBAttrType *val) {
+  vals.push_back(val == NULL ? NULL : DBAttrType::clone(*val));
 }
 
 const DBAttrType &DBTuple::getAttrVal(uint pos) const {
   if (pos >= vals.size())
     throw DBOutOfBoundException("invalid pos");
+  if (vals[pos] == NULL)
+    throw DBOutOfBoundException("attribute not read");
   return *vals[pos];
 }
 
@@ -416,6 +547,13 @@ string HubDB::Types::getKnownClassNames(char sep) {
   return ss.str();
 }
 
+string DBSelectItem::toString() const {
+  static const char *names[] = {"", "COUNT", "SUM", "MIN", "MAX", "AVG"};
+  if (func == AGG_NONE)
+    return name.toString();
+  return (string) names[func] + "(" + (star == true ? "*" : name.toString()) + ")";
+}
+
 string HubDB::Types::toString(DBListPredicate &l) {
   stringstream ss;
   DBListPredicate::iterator i = l.begin();
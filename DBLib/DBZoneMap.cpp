@@ -0,0 +1,175 @@
+#include <hubDB/DBZoneMap.h>
+#include <hubDB/DBFileBlock.h>
+#include <hubDB/DBException.h>
+
+using namespace HubDB::Manager;
+using namespace HubDB::Table;
+using namespace HubDB::Exception;
+
+LoggerPtr DBZoneMap::logger(Logger::getLogger("HubDB.Table.DBZoneMap"));
+
+DBZoneMap::DBZoneMap(DBBufferMgr &bufMgr, DBFile &file, const DBRelDef &rel) :
+        bufMgr(bufMgr),
+        file(file),
+        rel(rel) {
+  if (logger != NULL) LOG4CXX_INFO(logger, "DBZoneMap()");
+  assert(entriesPerPage() >= 1);
+}
+
+string DBZoneMap::toString(string linePrefix) const {
+  stringstream ss;
+  ss << linePrefix << "[DBZoneMap]" << endl;
+  ss << linePrefix << "entrySize: " << entrySize() << endl;
+  ss << linePrefix << "entriesPerPage: " << entriesPerPage() << endl;
+  ss << linePrefix << "-----------" << endl;
+  return ss.str();
+}
+
+uint DBZoneMap::entriesPerPage() const {
+  return file.getBlockSize() / entrySize();
+}
+
+/**
+ * Fixiert die Seite der Zone-Map, welche den Eintrag der Tabellenseite page enthält.
+ * Fehlende Seiten werden bei exklusivem Zugriff mit Nullen angelegt.
+ */
+DBBACB DBZoneMap::fixEntry(BlockNo page, DBBCBLockMode mode, char **entry) {
+  LOG4CXX_INFO(logger, "fixEntry()");
+  LOG4CXX_DEBUG(logger, "page: " + TO_STR(page));
+  BlockNo blockNo = page / entriesPerPage();
+  while (bufMgr.getBlockCount(file) <= blockNo) {
+    DBBACB bacb = bufMgr.fixNewBlock(file);
+    bacb.setModified();
+    bufMgr.unfixBlock(bacb);
+  }
+  DBBACB bacb = bufMgr.fixBlock(file, blockNo, mode);
+  *entry = bacb.getDataPtr() + (page % entriesPerPage()) * entrySize();
+  return bacb;
+}
+
+bool DBZoneMap::isValid(BlockNo page) {
+  LOG4CXX_INFO(logger, "isValid()");
+  if (page / entriesPerPage() >= bufMgr.getBlockCount(file))
+    return false;
+  char *ptr;
+  DBBACB bacb = fixEntry(page, LOCK_SHARED, &ptr);
+  bool valid = ((zoneEntryLayout *) ptr)->valid != 0;
+  bufMgr.unfixBlock(bacb);
+  return valid;
+}
+
+void DBZoneMap::clear(BlockNo page) {
+  LOG4CXX_INFO(logger, "clear()");
+  LOG4CXX_DEBUG(logger, "page: " + TO_STR(page));
+  char *ptr;
+  DBBACB bacb = fixEntry(page, LOCK_EXCLUSIVE, &ptr);
+  memset(ptr, 0, entrySize());
+  ((zoneEntryLayout *) ptr)->valid = 1;
+  bacb.setModified();
+  bufMgr.unfixBlock(bacb);
+}
+
+void DBZoneMap::add(BlockNo page, const DBTuple &tuple) {
+  LOG4CXX_INFO(logger, "add()");
+  LOG4CXX_DEBUG(logger, "page: " + TO_STR(page));
+  char *ptr;
+  DBBACB bacb = fixEntry(page, LOCK_EXCLUSIVE, &ptr);
+  zoneEntryLayout *entry = (zoneEntryLayout *) ptr;
+  bool first = entry->tupleCnt == 0;
+  ++entry->tupleCnt;
+  ptr += sizeof(zoneEntryLayout);
+  for (uint i = 0; i < rel.attrCnt(); ++i, ptr += ATTR_SUMMARY_SIZE) {
+    const DBAttrType &val = tuple.getAttrVal(i);
+    switch (rel.attrTypeDef(i)) {
+      case INT: {
+        int v = ((const DBIntType &) val).getVal();
+        int *minMax = (int *) ptr;
+        if (first == true || v < minMax[0]) minMax[0] = v;
+        if (first == true || v > minMax[1]) minMax[1] = v;
+        break;
+      }
+      case DOUBLE: {
+        double v = ((const DBDoubleType &) val).getVal();
+        double *minMax = (double *) ptr;
+        if (first == true || v < minMax[0]) minMax[0] = v;
+        if (first == true || v > minMax[1]) minMax[1] = v;
+        break;
+      }
+      case VCHAR: {
+        uint bits[BLOOM_HASHES];
+        bloomBits(val, bits);
+        uint64_t *bloom = (uint64_t *) ptr;
+        for (uint h = 0; h < BLOOM_HASHES; ++h)
+          bloom[bits[h] / 64] |= (uint64_t) 1 << (bits[h] % 64);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  bacb.setModified();
+  bufMgr.unfixBlock(bacb);
+}
+
+bool DBZoneMap::mayMatch(BlockNo page, DBListPredicate &where) {
+  LOG4CXX_INFO(logger, "mayMatch()");
+  LOG4CXX_DEBUG(logger, "page: " + TO_STR(page));
+  if (page / entriesPerPage() >= bufMgr.getBlockCount(file))
+    return true;
+
+  char *ptr;
+  DBBACB bacb = fixEntry(page, LOCK_SHARED, &ptr);
+  const zoneEntryLayout *entry = (const zoneEntryLayout *) ptr;
+  bool match = true;
+  if (entry->valid == 0) {
+    // unbekannte Seite
+  } else if (entry->tupleCnt == 0) {
+    match = false;
+  } else {
+    DBListPredicate::iterator i = where.begin();
+    while (match == true && i != where.end()) {
+      DBPredicate &p = *i;
+      DBAttrDef adef = rel.attrDef(p.name().attributeName);
+      const char *summary = ptr + sizeof(zoneEntryLayout) + adef.attrPos() * ATTR_SUMMARY_SIZE;
+      const DBAttrType &val = p.val();
+      if (val.type() != adef.attrType()) {
+        // Vergleich unterschiedlicher Typen ist nie erfüllt
+        match = false;
+      } else if (val.type() == INT) {
+        int v = ((const DBIntType &) val).getVal();
+        const int *minMax = (const int *) summary;
+        match = v >= minMax[0] && v <= minMax[1];
+      } else if (val.type() == DOUBLE) {
+        double v = ((const DBDoubleType &) val).getVal();
+        const double *minMax = (const double *) summary;
+        match = v >= minMax[0] && v <= minMax[1];
+      } else if (val.type() == VCHAR) {
+        uint bits[BLOOM_HASHES];
+        bloomBits(val, bits);
+        const uint64_t *bloom = (const uint64_t *) summary;
+        for (uint h = 0; match == true && h < BLOOM_HASHES; ++h)
+          match = (bloom[bits[h] / 64] & ((uint64_t) 1 << (bits[h] % 64))) != 0;
+      }
+      ++i;
+    }
+  }
+  bufMgr.unfixBlock(bacb);
+  LOG4CXX_DEBUG(logger, "match: " + TO_STR(match));
+  return match;
+}
+
+/**
+ * Berechnet die Bitpositionen im Bloom-Filter (FNV-1a mit Double-Hashing)
+ */
+void DBZoneMap::bloomBits(const DBAttrType &val, uint bits[BLOOM_HASHES]) {
+  string s = ((const DBVCharType &) val).getVal();
+  uint32_t h1 = 2166136261u;
+  for (string::size_type i = 0; i < s.size(); ++i) {
+    h1 ^= (unsigned char) s[i];
+    h1 *= 16777619u;
+  }
+  uint32_t h2 = (h1 >> 17) | (h1 << 15);
+  h2 |= 1;
+  for (uint h = 0; h < BLOOM_HASHES; ++h)
+    bits[h] = (h1 + h * h2) % (ATTR_SUMMARY_SIZE * 8);
+}
@@ -0,0 +1,83 @@
+#!/bin/bash
+
+
+# +===========+
+# | Anleitung |
+# +===========+
+#
+#
+# - Server mit dem gewuenschten Querymanager starten
+#   - ./bin/hubDBServer -q DBSimpleQueryMgr
+
+
+# ===================================================================
+
+
+# +===========+
+# | Variablen |
+# +===========+
+
+
+DATABASE='TESTDB'
+TABLE='summen'
+COLUMNS='id INTEGER, wert INTEGER'
+
+
+# ===================================================================
+
+
+cd  ..
+clear
+
+
+# ===================================================================
+
+
+# +=======+
+# | Tests |
+# +=======+
+
+
+# +-------------------+
+# | SUM ueber INT_MAX |
+# +-------------------+
+# SUM ueber INT darf nicht still abgeschnitten werden
+
+summentest() {
+
+echo
+echo "+-----------------------------------------+"
+echo "| SUM ueber INT (Ueberlauf ueber INT_MAX) |"
+echo "+-----------------------------------------+"
+echo "Erwartet:"
+echo "1. SUM = 2147483647"
+echo "2. Fehler \"SUM over INT out of range\""
+echo "3. je Gruppe 2147483647 und 1"
+echo
+
+echo "CREATE DATABASE $DATABASE;
+CONNECT TO $DATABASE;
+CREATE TABLE $TABLE AS ($COLUMNS);
+INSERT INTO $TABLE VALUES (1,2147483647);
+SELECT SUM($TABLE.wert) FROM $TABLE;
+INSERT INTO $TABLE VALUES (2,1);
+SELECT SUM($TABLE.wert) FROM $TABLE;
+SELECT $TABLE.id, SUM($TABLE.wert) FROM $TABLE GROUP BY $TABLE.id;
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+}
+
+
+# ===================================================================
+
+
+# +=====================+
+# | Das "Hauptprogramm" |
+# +=====================+
+
+
+rm -rf $DATABASE
+
+summentest
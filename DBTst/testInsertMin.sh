@@ -0,0 +1,85 @@
+#!/bin/bash
+
+
+# +===========+
+# | Anleitung |
+# +===========+
+#
+#
+# - Server mit dem gewuenschten Querymanager starten
+#   - ./bin/hubDBServer -q DBSimpleQueryMgr
+
+
+# ===================================================================
+
+
+# +===========+
+# | Variablen |
+# +===========+
+
+
+DATABASE='TESTDB'
+TABLE='zeilen'
+COLUMNS='id INTEGER UNIQUE, wert INTEGER'
+
+
+# ===================================================================
+
+
+cd  ..
+clear
+
+
+# ===================================================================
+
+
+# +=======+
+# | Tests |
+# +=======+
+
+
+# +----------------------------+
+# | INSERT mit mehreren Zeilen |
+# +----------------------------+
+# Verletzt eine Zeile mitten im INSERT die Eindeutigkeit, wird keine
+# Zeile des INSERT eingefuegt und kein Indexeintrag bleibt zurueck
+
+zeilentest() {
+
+echo
+echo "+------------------------------------------------+"
+echo "| INSERT mit mehreren Zeilen (Verletzung mitten) |"
+echo "+------------------------------------------------+"
+echo "Erwartet:"
+echo "1. (1,1),(2,2): eingefuegt"
+echo "2. (3,3),(4,4),(2,5),(5,5): Fehler \"Attr already in index\""
+echo "3. Selektion: nur (1,1) und (2,2)"
+echo "4. (3,3),(4,4),(5,5): eingefuegt, COUNT(*) = 5"
+echo
+
+echo "CREATE DATABASE $DATABASE;
+CONNECT TO $DATABASE;
+CREATE TABLE $TABLE AS ($COLUMNS);
+INSERT INTO $TABLE VALUES (1,1),(2,2);
+INSERT INTO $TABLE VALUES (3,3),(4,4),(2,5),(5,5);
+SELECT $TABLE.id, $TABLE.wert FROM $TABLE;
+INSERT INTO $TABLE VALUES (3,3),(4,4),(5,5);
+SELECT COUNT(*) FROM $TABLE;
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+}
+
+
+# ===================================================================
+
+
+# +=====================+
+# | Das "Hauptprogramm" |
+# +=====================+
+
+
+rm -rf $DATABASE
+
+zeilentest
@@ -0,0 +1,142 @@
+#!/bin/bash
+
+
+# +===========+
+# | Anleitung |
+# +===========+
+#
+#
+# - Server mit dem gewuenschten Querymanager starten
+#   - ./bin/hubDBServer -q DBSimpleQueryMgr
+
+
+# ===================================================================
+
+
+# +===========+
+# | Variablen |
+# +===========+
+
+
+DATABASE='TESTDB'
+COLUMNS='id INTEGER, k INTEGER, c INTEGER'
+
+
+# ===================================================================
+
+
+cd  ..
+clear
+
+
+# ===================================================================
+
+
+# +=======+
+# | Tests |
+# +=======+
+
+
+# Tabelle a: 6000 Tupel mit k = id % 50 und c = id % 7,
+# Tabelle b: 3000 Tupel mit k = id % 100 und c = id % 7
+
+erzeugeTupel() {
+seq 0 5999 | awk '{ print $1 "\t" $1 % 50 "\t" $1 % 7 }' > join_a.txt
+seq 0 2999 | awk '{ print $1 "\t" $1 % 100 "\t" $1 % 7 }' > join_b.txt
+}
+
+
+# +-----------------+
+# | Kleine Eingaben |
+# +-----------------+
+# Die kleinere Eingabe passt in den Speicher (Hash-Join); ohne Statistik
+# wird bei wenigen Tupeln der ersten Eingabe der Index von b.k benutzt
+
+jointest() {
+
+echo
+echo "+------------------------------------------+"
+echo "| Hash- und Index-Nested-Loop-Join (klein) |"
+echo "+------------------------------------------+"
+echo "Erwartet:"
+echo "1. Hash join (in memory): COUNT(*) = 180000"
+echo "2. mit a.c = 1 und b.c = 1: COUNT(*) = 3673"
+echo "3. Index auf b.k, a.id = 5: Hash join (index nested-loop join), COUNT(*) = 30"
+echo "4. a.c = 1: Hash join (in memory), COUNT(*) = 25710"
+echo
+
+erzeugeTupel
+
+echo "CREATE DATABASE $DATABASE;
+CONNECT TO $DATABASE;
+CREATE TABLE a AS ($COLUMNS);
+CREATE TABLE b AS ($COLUMNS);
+IMPORT FROM 'join_a.txt' INTO a;
+IMPORT FROM 'join_b.txt' INTO b;
+EXPLAIN ANALYZE SELECT COUNT(*) FROM a JOIN b ON a.k = b.k;
+SELECT COUNT(*) FROM a JOIN b ON a.k = b.k WHERE a.c = 1 AND b.c = 1;
+CREATE INDEX b.k;
+EXPLAIN ANALYZE SELECT COUNT(*) FROM a JOIN b ON a.k = b.k WHERE a.id = 5;
+EXPLAIN ANALYZE SELECT COUNT(*) FROM a JOIN b ON a.k = b.k WHERE a.c = 1;
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+rm -f join_a.txt join_b.txt
+
+}
+
+
+# +-----------------+
+# | Grosse Eingaben |
+# +-----------------+
+# Beide Eingaben ueberschreiten den Speicher des Joins: ohne Index werden
+# beide partitioniert, mit Indexen auf beiden Join-Attributen werden sie
+# in der Reihenfolge der Indexe gemischt (Merge-Join)
+
+grossjointest() {
+
+echo
+echo "+--------------------------------------+"
+echo "| Partitionierter Hash- und Merge-Join |"
+echo "+--------------------------------------+"
+echo "Tupelzahl je Tabelle = $1"
+echo "Erwartet:"
+echo "1. Hash join (16 partitions of both inputs): COUNT(*) = $1"
+echo "2. Indexe auf a.k und b.k: Merge join, COUNT(*) = $1"
+echo
+
+seq 1 $1 | awk '{ print $1 "\t" $1 "\t" $1 % 7 }' > join_a.txt
+seq 1 $1 | awk '{ print $1 "\t" $1 "\t" $1 % 7 }' > join_b.txt
+
+echo "CREATE DATABASE $DATABASE;
+CONNECT TO $DATABASE;
+CREATE TABLE a AS ($COLUMNS);
+CREATE TABLE b AS ($COLUMNS);
+IMPORT FROM 'join_a.txt' INTO a;
+IMPORT FROM 'join_b.txt' INTO b;
+EXPLAIN ANALYZE SELECT COUNT(*) FROM a JOIN b ON a.k = b.k;
+CREATE INDEX a.k;
+CREATE INDEX b.k;
+EXPLAIN ANALYZE SELECT COUNT(*) FROM a JOIN b ON a.k = b.k;
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+rm -f join_a.txt join_b.txt
+
+}
+
+
+# ===================================================================
+
+
+# +=====================+
+# | Das "Hauptprogramm" |
+# +=====================+
+
+
+rm -rf $DATABASE
+
+jointest
+grossjointest 200000
@@ -0,0 +1,99 @@
+#!/bin/bash
+
+
+# +===========+
+# | Anleitung |
+# +===========+
+#
+#
+# - Server mit dem gewuenschten Querymanager starten
+#   - ./bin/hubDBServer -q DBSimpleQueryMgr
+
+
+# ===================================================================
+
+
+# +===========+
+# | Variablen |
+# +===========+
+
+
+DATABASE='TESTDB'
+TABLE='seiten'
+COLUMNS='id INTEGER UNIQUE, wert INTEGER'
+COLUMNS_AB='I:i'
+TUPLES=20000
+
+
+# ===================================================================
+
+
+cd  ..
+clear
+
+
+# ===================================================================
+
+
+# +=======+
+# | Tests |
+# +=======+
+
+
+# +----------------------------+
+# | Seitengroesse je Datenbank |
+# +----------------------------+
+# Tabelle und Indexe belegen mehrere Seiten der gewaehlten Groesse und
+# muessen nach dem erneuten Verbinden unveraendert lesbar sein
+
+seitentest() {
+
+echo
+echo "+-------------------------------+"
+echo "| Seitengroesse einer Datenbank |"
+echo "+-------------------------------+"
+echo "PAGESIZE = $1 Bytes, Tupelzahl = $TUPLES"
+echo "Erwartet:"
+echo "1. $TUPLES von $TUPLES Tupeln importiert"
+echo "2. vor und nach dem erneuten Verbinden je COUNT(*) = $TUPLES,"
+echo "   genau ein Tupel mit id = 5000 und dieselbe Anzahl mit wert = 42"
+echo "3. ANALYZE: $TUPLES Tupel auf mehreren Seiten"
+echo
+
+perl tools/createTestTuple.pl -r $TUPLES -F $COLUMNS_AB -o datafile.txt
+
+echo "CREATE DATABASE $DATABASE PAGESIZE $1;
+CONNECT TO $DATABASE;
+CREATE TABLE $TABLE AS ($COLUMNS);
+CREATE INDEX $TABLE.wert;
+IMPORT FROM 'datafile.txt' INTO $TABLE;
+SELECT COUNT(*) FROM $TABLE;
+SELECT * FROM $TABLE WHERE $TABLE.id = 5000;
+SELECT COUNT(*) FROM $TABLE WHERE $TABLE.wert = 42;
+DISCONNECT;
+CONNECT TO $DATABASE;
+SELECT COUNT(*) FROM $TABLE;
+SELECT * FROM $TABLE WHERE $TABLE.id = 5000;
+SELECT COUNT(*) FROM $TABLE WHERE $TABLE.wert = 42;
+ANALYZE $TABLE;
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+rm -f datafile.txt
+
+}
+
+
+# ===================================================================
+
+
+# +=====================+
+# | Das "Hauptprogramm" |
+# +=====================+
+
+
+rm -rf $DATABASE
+
+seitentest 4096
+seitentest 65536
@@ -0,0 +1,86 @@
+#!/bin/bash
+
+
+# +===========+
+# | Anleitung |
+# +===========+
+#
+#
+# - Server mit dem gewuenschten Querymanager starten
+#   - ./bin/hubDBServer -q DBSimpleQueryMgr
+
+
+# ===================================================================
+
+
+# +===========+
+# | Variablen |
+# +===========+
+
+
+DATABASE='TESTDB'
+TABLE='eindeutig'
+COLUMNS='a INTEGER UNIQUE, b INTEGER UNIQUE, c INTEGER'
+
+
+# ===================================================================
+
+
+cd  ..
+clear
+
+
+# ===================================================================
+
+
+# +=======+
+# | Tests |
+# +=======+
+
+
+# +-----------------------+
+# | Zwei UNIQUE-Attribute |
+# +-----------------------+
+# Scheitert das Einfuegen am zweiten eindeutigen Attribut, darf der
+# Index des ersten keinen Eintrag behalten
+
+eindeutigtest() {
+
+echo
+echo "+------------------------------------------+"
+echo "| Zwei UNIQUE-Attribute (Verletzung bei b) |"
+echo "+------------------------------------------+"
+echo "Erwartet:"
+echo "1. (2,1,2): Fehler \"Attr already in index\""
+echo "2. (2,2,3): eingefuegt"
+echo "3. CREATE INDEX mit unbekanntem Typ: Fehler, (2,3,4) danach weiterhin abgelehnt"
+echo "4. Selektion: (1,1,1) und (2,2,3)"
+echo
+
+echo "CREATE DATABASE $DATABASE;
+CONNECT TO $DATABASE;
+CREATE TABLE $TABLE AS ($COLUMNS);
+INSERT INTO $TABLE VALUES (1,1,1);
+INSERT INTO $TABLE VALUES (2,1,2);
+INSERT INTO $TABLE VALUES (2,2,3);
+CREATE INDEX $TABLE.a TYPE 'DBKeinIndex';
+INSERT INTO $TABLE VALUES (2,3,4);
+SELECT $TABLE.a, $TABLE.b, $TABLE.c FROM $TABLE;
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+}
+
+
+# ===================================================================
+
+
+# +=====================+
+# | Das "Hauptprogramm" |
+# +=====================+
+
+
+rm -rf $DATABASE
+
+eindeutigtest
@@ -0,0 +1,98 @@
+#!/bin/bash
+
+
+# +===========+
+# | Anleitung |
+# +===========+
+#
+#
+# - Server mit dem gewuenschten Querymanager starten
+#   - ./bin/hubDBServer -q DBSimpleQueryMgr
+
+
+# ===================================================================
+
+
+# +===========+
+# | Variablen |
+# +===========+
+
+
+DATABASE='TESTDB'
+TABLE='fest'
+TABLE2='variabel'
+COLUMNS='x VARCHAR(30), y INTEGER, z VARCHAR'
+COLUMNS2='x VARCHAR(5), y INTEGER, z VARCHAR(5), txt VARCHAR(3000)'
+
+
+# ===================================================================
+
+
+cd  ..
+clear
+
+
+# ===================================================================
+
+
+# +=======+
+# | Tests |
+# +=======+
+
+
+# +------------+
+# | VARCHAR(n) |
+# +------------+
+# Laengen ungleich 30 nur im SLOTTED-Format, lange Werte auf Ueberlaufseiten
+
+varchartest() {
+
+LANG1=$(printf 'a%.0s' $(seq 1 1500))
+LANG2=$(printf 'b%.0s' $(seq 1 2999))
+
+echo
+echo "+--------------------------------------+"
+echo "| VARCHAR(n) im festen und im SLOTTED- |"
+echo "| Format, Werte auf Ueberlaufseiten    |"
+echo "+--------------------------------------+"
+echo "Erwartet:"
+echo "1. VARCHAR(5) ohne SLOTTED: Fehler \"VARCHAR(5) requires a SLOTTED table\""
+echo "2. $TABLE: (abc,1,qq) und (de,2,rr)"
+echo "3. ('abcdef',...): Fehler \"value too long for X\""
+echo "4. $TABLE2: (abc,1,qq) und (de,2,rr), COUNT = 1 fuer den langen Wert"
+echo "5. nach Loeschen und Einfuegen: (fg,3,ss) und (de,2,rr), COUNT = 1"
+echo
+
+echo "CREATE DATABASE $DATABASE;
+CONNECT TO $DATABASE;
+CREATE TABLE falsch AS (x VARCHAR(5), y INTEGER);
+CREATE TABLE $TABLE AS ($COLUMNS);
+INSERT INTO $TABLE VALUES ('abc',1,'qq'),('de',2,'rr');
+SELECT $TABLE.x, $TABLE.y, $TABLE.z FROM $TABLE;
+CREATE TABLE $TABLE2 AS ($COLUMNS2) SLOTTED;
+INSERT INTO $TABLE2 VALUES ('abcdef',0,'x','x');
+INSERT INTO $TABLE2 VALUES ('abc',1,'qq','$LANG1'),('de',2,'rr','$LANG2');
+SELECT $TABLE2.x, $TABLE2.y, $TABLE2.z FROM $TABLE2;
+SELECT COUNT(*) FROM $TABLE2 WHERE $TABLE2.txt = '$LANG2';
+DELETE FROM $TABLE2 WHERE $TABLE2.y = 1;
+INSERT INTO $TABLE2 VALUES ('fg',3,'ss','$LANG1');
+SELECT $TABLE2.x, $TABLE2.y, $TABLE2.z FROM $TABLE2;
+SELECT COUNT(*) FROM $TABLE2 WHERE $TABLE2.txt = '$LANG1';
+DISCONNECT;
+DROP DATABASE $DATABASE;
+QUIT;" | hubDBClient $CARGS
+
+}
+
+
+# ===================================================================
+
+
+# +=====================+
+# | Das "Hauptprogramm" |
+# +=====================+
+
+
+rm -rf $DATABASE
+
+varchartest
@@ -0,0 +1,115 @@
+#ifndef DBBLINKINDEX_H_
+#define DBBLINKINDEX_H_
+
+#include <hubDB/DBIndex.h>
+
+namespace HubDB{
+    namespace Index{
+
+        /**
+         * B-Link-Baum nach Lehman und Yao.
+         *
+         * Jeder Knoten besitzt einen Verweis auf seinen rechten Nachbarn und einen
+         * High-Key (obere Schranke seiner Schlüssel). Wird ein Knoten geteilt, sind die
+         * verschobenen Einträge sofort über den rechten Verweis erreichbar; ein Leser, der
+         * einen Schlüssel >= High-Key sucht, geht einfach nach rechts. Daher hält jede
+         * Operation höchstens den Knoten fixiert, den sie gerade liest oder ändert
+         * (beim Teilen zusätzlich die neuen Knoten), und Schreiber in verschiedenen
+         * Blättern behindern sich nicht. Die Wurzel bleibt immer Block 0.
+         *
+         * Schlüssel sind normalisiert (siehe DBAttrType::normalizedKey()), VARCHAR-Schlüssel
+         * mit abschließendem Nullbyte. Bei Indexen mit Duplikaten wird die TID an den
+         * Schlüssel angehängt, so dass alle Schlüssel im Baum eindeutig sind.
+         * Beim Löschen werden Knoten nicht zusammengelegt.
+         *
+         * Seitenlayout: Anzahl Einträge | Ebene (0: Blatt) | rechter Nachbar | Länge High-Key |
+         *   High-Key | Länge Präfix | Präfix | Einträge (Länge Suffix | Suffix | TID bzw. Kindknoten)
+         */
+        class DBBLinkIndex : public DBIndex{
+
+        public:
+            DBBLinkIndex(DBBufferMgr & bufferMgr,
+                         DBFile & file,
+                         enum AttrTypeEnum attrType,
+                         ModType mode,
+                         bool unique);
+            ~DBBLinkIndex();
+            string toString(string linePrefix="") const;
+
+            void initializeIndex();
+            void find(const DBAttrType & val,DBListTID & tids);
+            void insert(const DBAttrType & val,const TID & tid);
+            void insertSorted(const vector<const DBAttrType *> & vals,const vector<TID> & tids);
+            void remove(const DBAttrType & val,const DBListTID & tids);
+
+            void openCursor(const DBAttrType & val);
+            bool nextBatch(DBTIDBatch & tids,uint maxTids = STD_TID_BATCH);
+            void closeCursor();
+
+            bool openOrderedCursor();
+            bool nextOrdered(std::string & key,DBTIDBatch & tids);
+
+            static int registerClass();
+
+        private:
+            struct nodePageLayout{
+                uint countEntries;
+                uint level;
+                BlockNo rightLink;
+                uint highKeyLen;
+            };
+
+            struct NodeEntry{
+                std::string key;
+                TID value; // Blatt: TID, innerer Knoten: Kindknoten in value.page
+                NodeEntry(const std::string & key,const TID & value):key(key),value(value){};
+            };
+
+            struct Node{
+                uint level;
+                BlockNo rightLink;
+                bool hasHighKey;
+                std::string highKey;
+                std::vector<NodeEntry> entries;
+
+                bool isLeaf()const{ return level == 0;};
+                bool beyond(const std::string & key)const{ return hasHighKey && key >= highKey;};
+                uint lowerBound(const std::string & key)const;
+                BlockNo child(const std::string & key)const;
+                size_t encodedSize()const;
+                void write(char * ptr)const;
+                void read(const char * ptr);
+            };
+
+            std::string searchKey(const DBAttrType & val)const;
+            std::string entryKey(const std::string & search,const TID & tid)const;
+
+            BlockNo descend(const std::string & key,uint level,DBBCBLockMode mode,Node & node,stack<BlockNo> * path);
+            BlockNo moveRight(BlockNo blockNo,const std::string & key,DBBCBLockMode mode,Node & node);
+            void fixCursorLeaf(Node & node);
+            void insertEntry(const std::string & key,const TID & value,uint level,stack<BlockNo> & path);
+            std::string split(Node & node,Node & right);
+            void splitRoot(Node & root);
+
+            DBBACB & fixNode(BlockNo blockNo,DBBCBLockMode mode,Node & node);
+            void unfixNode();
+            void unfixBACBs(bool dirty);
+            void checkBacbStackInvariant();
+
+            static LoggerPtr logger;
+            static const BlockNo rootBlockNo;
+            static const BlockNo noLink;
+            static const uint noHighKey;
+
+            stack<DBBACB> bacbStack; // die gerade fixierten Knoten, zwischen zwei Operationen leer
+
+            // Zustand des Cursors: gesuchter Schlüssel, Blatt und kleinster noch nicht gelieferter Schlüssel
+            bool cursorOpen;
+            std::string cursorKey;
+            BlockNo cursorBlockNo;
+            std::string cursorNextKey;
+        };
+    }
+}
+
+#endif /*DBBLINKINDEX_H_*/
@@ -0,0 +1,88 @@
+#ifndef DBBITMAPINDEX_H_
+#define DBBITMAPINDEX_H_
+
+#include <hubDB/DBIndex.h>
+#include <hubDB/DBTIDBitmap.h>
+
+namespace HubDB{
+    namespace Index{
+
+        /**
+         * Bitmap-Index für Attribute mit wenigen verschiedenen Werten.
+         *
+         * Dateilayout:
+         * Block 0 und weitere Verzeichnisseiten: Anzahl Schlüssel | nächste Verzeichnisseite |
+         *   Einträge (Schlüssel | erste Datenseite | letzte Datenseite)
+         * Datenseiten: nächste Datenseite | belegte Bytes | Anzahl Container | Container
+         *
+         * Jeder Schlüssel besitzt eine Kette von Datenseiten, deren Container
+         * (siehe DBTIDContainer) nach Tabellenseite sortiert sind.
+         */
+        class DBBitmapIndex : public DBIndex{
+
+        public:
+            DBBitmapIndex(DBBufferMgr & bufferMgr,
+                          DBFile & file,
+                          enum AttrTypeEnum attrType,
+                          ModType mode,
+                          bool unique);
+            ~DBBitmapIndex();
+            string toString(string linePrefix="") const;
+
+            void initializeIndex();
+            void find(const DBAttrType & val,DBListTID & tids);
+            bool findBitmap(const DBAttrType & val,DBTIDBitmap & tids);
+            void insert(const DBAttrType & val,const TID & tid);
+            void remove(const DBAttrType & val,const DBListTID & tids);
+
+            void openCursor(const DBAttrType & val);
+            bool nextBatch(DBTIDBatch & tids,uint maxTids = STD_TID_BATCH);
+            void closeCursor();
+            uint count(const DBAttrType & val);
+
+            static int registerClass();
+
+        private:
+            struct dirPageLayout{
+                uint keyCnt;
+                BlockNo nextDirBlock;
+            };
+            struct dataPageLayout{
+                BlockNo nextBlock;
+                uint usedBytes;
+                uint containerCnt;
+            };
+
+            size_t dirEntrySize() const { return attrTypeSize + 2 * sizeof(BlockNo); };
+            uint dirEntriesPerPage() const;
+            size_t dataCapacity() const;
+
+            bool findDirEntry(const char * key,BlockNo & dirBlockNo,uint & pos,BlockNo & first,BlockNo & last);
+            void createDirEntry(const char * key,BlockNo & dirBlockNo,uint & pos,BlockNo & first);
+            void setLastBlock(BlockNo dirBlockNo,uint pos,BlockNo last);
+            BlockNo findDataPage(BlockNo first,BlockNo last,BlockNo page);
+            bool hasTIDs(BlockNo first);
+
+            void readContainers(const char * ptr,vector<DBTIDContainer> & containers);
+            void writeContainers(char * ptr,const vector<DBTIDContainer> & containers,uint from,uint to);
+            size_t encodedSize(const vector<DBTIDContainer> & containers,uint from,uint to);
+
+            BlockNo newDataPage();
+
+            DBBACB& fixNonRootBlock(const BlockNo & blockNo, const DBBCBLockMode & mode);
+            void unfixNonRootBlock(const DBBACB & dbbacb);
+            void unfixBACBs(bool dirty);
+            void checkBacbStackInvariant();
+
+            static LoggerPtr logger;
+            static const BlockNo rootBlockNo;
+
+            stack<DBBACB> bacbStack; // Der bacbStack speichert immer den Root-Block der Datei
+
+            DBTIDBitmap cursorBitmap;
+            DBTIDBitmap::Position cursorPos;
+        };
+    }
+}
+
+#endif /*DBBITMAPINDEX_H_*/
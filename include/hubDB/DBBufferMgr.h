@@ -60,7 +60,7 @@ namespace HubDB{
 			void dropFile(const string & name);
 			void dropDirectory(const string & name){fileMgr.dropDirectory(name);};
 			
-			DBFile & openFile(const string & name){return fileMgr.openFile(name);};
+			DBFile & openFile(const string & name,uint blockSize = STD_BLOCKSIZE){return fileMgr.openFile(name,blockSize);};
 			void closeFile(DBFile & file);
 
 			uint getBlockCount(DBFile & file){return fileMgr.getBlockCnt(file);};
@@ -75,6 +75,15 @@ namespace HubDB{
 			 */
 			DBBACB fixBlock(DBFile & file,BlockNo blockNo,DBBCBLockMode mode);
 
+			/**
+			 * Kündigt an, dass der Block bald fixiert wird: das Betriebssystem kann ihn
+			 * schon lesen, während der Aufrufer noch mit anderen Blöcken arbeitet.
+			 * Der Block wird dabei weder fixiert noch in den Bufferpool geladen.
+			 * @param file
+			 * @param blockNo
+			 */
+			void prefetchBlock(DBFile & file,BlockNo blockNo){fileMgr.prefetchFileBlock(file,blockNo);};
+
 			/**
 			 * Zur Anforderung eines neu zu erzeugenden Blocks einer Datei
 			 * @param file
@@ -99,6 +108,13 @@ namespace HubDB{
 			DBBACB upgradeToExclusive(const DBBACB & bacb);
 			const DBBACB downgradeToShared(const DBBACB & bacb);
 
+			/**
+			 * Anzahl der bisher fixierten Blöcke und der dabei von der Platte gelesenen
+			 * (Fehlzugriffe), z.B. für EXPLAIN ANALYZE
+			 */
+			uint getFixCnt() const { return fixCnt;};
+			uint getReadCnt() const { return fileMgr.getReadCnt();};
+
 		protected:
 
       /**
@@ -162,6 +178,7 @@ namespace HubDB{
 
 			DBFileMgr fileMgr;
 			int maxBlockCnt;
+			uint fixCnt;
 			
 		private:
   			static LoggerPtr logger;
@@ -0,0 +1,89 @@
+#ifndef DBBULKLOAD_H_
+#define DBBULKLOAD_H_
+
+#include <hubDB/DBSysCatMgr.h>
+
+using namespace HubDB::Table;
+using namespace HubDB::Index;
+
+namespace HubDB{
+    namespace Manager{
+
+        /**
+         * Massenimport in eine Tabelle (IMPORT, INSERT mit mehreren Zeilen). Tabelle und Indexe werden einmal
+         * geöffnet, die Tupel mit DBTable::append() seitenweise angehängt.
+         *
+         * Die Indexeinträge werden gesammelt und je Index nach Schlüssel sortiert
+         * eingefügt, sobald STD_BULK_INDEX_ENTRIES Einträge vorliegen und in finish().
+         * Werte eindeutiger Attribute werden beim Anhängen im Index und unter den
+         * gesammelten Einträgen gesucht, ein Duplikat wird nicht angehängt.
+         */
+        class DBBulkLoad
+        {
+            struct indexEntry{
+                DBAttrType * val;
+                TID tid;
+            };
+
+        public:
+            DBBulkLoad(DBSysCatMgr & sysCatMgr,const string & dbName,const string & relName);
+
+            /**
+             * Ruft finish() auf, falls das noch nicht geschehen ist, damit die
+             * Indexe auch nach einem Fehler alle angehängten Tupel enthalten
+             */
+            ~DBBulkLoad();
+            string toString(string linePrefix="") const;
+
+            const DBRelDef & getRelDef() const { return rel;};
+
+            /**
+             * Hängt das Tupel an die Tabelle an und setzt seine TID
+             */
+            void append(DBTuple & tuple);
+
+            /**
+             * Gibt die letzte Seite frei und fügt die gesammelten Indexeinträge ein
+             */
+            void finish();
+
+            /**
+             * Nimmt die angehängten Tupel ab dem Tupel Nummer first (ab 0 in der Reihenfolge
+             * von append()) wieder zurück, tuples enthält sie in dieser Reihenfolge mit ihren
+             * TIDs; weitere Tupel am Ende der Liste werden ignoriert. Noch gesammelte
+             * Indexeinträge werden verworfen, bereits eingefügte entfernt und die Tupel aus
+             * der Tabelle gelöscht. Auch ein Index, dessen Einfügen gescheitert ist, verliert
+             * die Einträge der Tupel. Die Tupel vor first bleiben erhalten; ihre Einträge
+             * müssen in allen Indexen stehen (siehe getUnindexedCnt()).
+             */
+            void rollback(const DBListTuple & tuples,uint first = 0);
+
+            uint getCnt() const { return cnt;};
+
+            /**
+             * Anzahl der zuletzt angehängten Tupel, deren Einträge noch nicht in allen
+             * Indexen stehen
+             */
+            uint getUnindexedCnt() const;
+
+        protected:
+            void assertUnique(const DBTuple & tuple);
+            void flushIndexes();
+
+            static LoggerPtr logger;
+            DBTable * table;
+            const DBRelDef rel;
+            vector<uint> attrPos;                       // je Index die Position des Attributs
+            vector<DBIndex *> indexes;
+            vector< vector<indexEntry> > entries;       // je Index die noch nicht eingefügten Einträge
+            vector< unordered_set<string> > pending;    // deren normalisierte Schlüssel (nur eindeutige Indexe)
+            vector<uint> flushed;                       // je Index die Anzahl Tupel, deren Einträge eingefügt sind
+            uint flushing;                              // Index, dessen Einfügen gescheitert ist, sonst indexes.size()
+            uint entryCnt;
+            uint cnt;
+            bool finished;
+        };
+    }
+}
+
+#endif // DBBULKLOAD_H_
@@ -0,0 +1,71 @@
+#ifndef DBEXTERNALSORT_H_
+#define DBEXTERNALSORT_H_
+
+#include <hubDB/DBSysCatMgr.h>
+#include <hubDB/DBTempFile.h>
+
+using namespace HubDB::Table;
+
+namespace HubDB{
+    namespace Manager{
+
+        /**
+         * Externes Sortieren durch Mischen (external merge sort) nach einem Attribut,
+         * auf- oder (desc) absteigend.
+         *
+         * Die Tupel werden mit add() übergeben. Sobald mehr als maxTuples Tupel im
+         * Speicher liegen, werden diese sortiert und als Lauf in eine temporäre Datei
+         * geschrieben. sort() beendet die Eingabe; liegen mehr als STD_SORT_FANIN Läufe
+         * vor, werden jeweils STD_SORT_FANIN Läufe zu einem neuen Lauf gemischt.
+         * read() mischt die verbliebenen Läufe und liefert die Tupel in Sortierreihenfolge.
+         * Passt die gesamte Eingabe in den Speicher, wird keine Datei angelegt.
+         */
+        class DBExternalSort
+        {
+        public:
+            DBExternalSort(DBSysCatMgr & sysCatMgr,const string & dbName,const DBRelDef & rel,uint attrPos,uint maxTuples,bool desc = false);
+            ~DBExternalSort();
+            string toString(string linePrefix="") const;
+
+            void add(const DBTuple & tuple);
+
+            /**
+             * Übernimmt alle Tupel der Liste, die Liste ist danach leer
+             */
+            void add(DBListTuple & tuples);
+
+            /**
+             * Beendet die Eingabe, danach können die Tupel gelesen werden
+             */
+            void sort();
+
+            /**
+             * Liest die nächsten (höchstens numOfTuples) Tupel in Sortierreihenfolge
+             * @return Anzahl gelesener Tupel, 0 am Ende
+             */
+            uint read(uint numOfTuples,DBListTuple & tupleList);
+
+            uint getRunCnt() const { return runs.size();};
+
+        protected:
+            bool less(const DBTuple & a,const DBTuple & b) const;
+            void spillRun(DBListTuple & tuples);
+            void mergeRuns(vector<DBTempFile *> & in,DBTempFile & out);
+            int minRun(vector<DBTempFile *> & in,vector<DBListTuple> & buf);
+
+            static LoggerPtr logger;
+            DBSysCatMgr & sysCatMgr;
+            const string dbName;
+            const DBRelDef rel;
+            const uint attrPos;
+            const uint maxTuples;
+            const bool desc;
+            DBListTuple memTuples;      // noch nicht geschriebene bzw. (ohne Läufe) sortierte Tupel
+            vector<DBTempFile *> runs;  // sortierte Läufe
+            vector<DBListTuple> runBuf; // gelesene, noch nicht gelieferte Tupel je Lauf
+            bool sorted;
+        };
+    }
+}
+
+#endif // DBEXTERNALSORT_H_
@@ -26,9 +26,10 @@ namespace HubDB{
             ~DBFile();
 
             string toString(string linePrefix="")const;
+            uint getBlockSize()const { return blockSize;};
 
         protected:
-            DBFile(const string & fileName);
+            DBFile(const string & fileName,uint blockSize);
 
             bool operator==(const DBFile & ref)const
             {return (fileNum == ref.fileNum) ? true : false;}
@@ -40,6 +41,8 @@ namespace HubDB{
             uint getBlockCnt()const { return blockCnt;};
 
             void setBlockCnt(uint blockCnt);
+            // Hinweis an das Betriebssystem, den Block bald zu lesen
+            void prefetch(BlockNo blockNo)const;
 
             static void create(const string & name,bool isDir);
             static void drop(const string & name,bool isDir);
@@ -49,6 +52,7 @@ namespace HubDB{
             string fileName;
             FileNo fileNum;
             uint blockCnt;
+            uint blockSize;      // Seitengröße der Datenbank, zu der die Datei gehört
         };
     }
     namespace Exception{
@@ -15,10 +15,10 @@ namespace HubDB{
             DBFileBlock(DBFile & file,const BlockNo blockNum);
             string toString(string linePrefix="") const;
             BlockNo getBlockNo() const { return blockNum;};
-            const char * getDataPtr()const { return data;};
-            char * getDataPtr() { return data;};
+            const char * getDataPtr()const { return data.data();};
+            char * getDataPtr() { return data.data();};
             bool operator==(const DBFile&cfile)const { return file==cfile;};
-            static uint getBlockSize(){ return blockSize; };
+            uint getBlockSize()const { return file.getBlockSize(); };
             FileNo getFileNum()const { return file.getFileNum();};
         protected:
             void readFileBlock();
@@ -26,9 +26,8 @@ namespace HubDB{
         private:
             DBFile & file;
             const BlockNo blockNum;
-            char data[STD_BLOCKSIZE];
+            vector<char> data;   // getBlockSize() Bytes, die Seitengröße der Datei
             static LoggerPtr logger;
-            static const uint blockSize;
         };
     }
 }
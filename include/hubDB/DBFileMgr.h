@@ -15,7 +15,7 @@ namespace HubDB{
 		{
 		public:
 			DBFileMgr(bool doThreading):
-				DBManager(doThreading){ if(logger!=NULL) LOG4CXX_INFO(logger,"DBFileMgr()");};
+				DBManager(doThreading),readCnt(0){ if(logger!=NULL) LOG4CXX_INFO(logger,"DBFileMgr()");};
             ~DBFileMgr();
 			string toString(string linePrefix="") const __attribute__ ((pure));
 
@@ -25,22 +25,28 @@ namespace HubDB{
 			void dropFile(const string & name);
 			void dropDirectory(const string & name){DBFile::drop(name.c_str(),true);};
 			
-			DBFile & openFile(const string & name);
+			// eine bereits geöffnete Datei muss dieselbe Seitengröße haben
+			DBFile & openFile(const string & name,uint blockSize = STD_BLOCKSIZE);
 			DBFile * getOpenFile(const string & name);
 			void closeFile(DBFile & file);
 
 			void readFileBlock(DBFileBlock & block);
 			void writeFileBlock(DBFileBlock & block);
+			void prefetchFileBlock(DBFile & file,BlockNo blockNo){file.prefetch(blockNo);};
 			
 			uint getBlockCnt(DBFile & file);
 			void setBlockCnt(DBFile & file,uint cnt);
 
+			// Anzahl der bisher von der Platte gelesenen Blöcke
+			uint getReadCnt() const { return readCnt;};
+
 		private:  			
 			list<DBFile *>::iterator find(const string & fileName);
 
 		private:
   			static LoggerPtr logger;
   			list<DBFile *> fileList;
+  			uint readCnt;
 		};
     }
     namespace Exception{        
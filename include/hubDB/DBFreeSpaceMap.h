@@ -0,0 +1,56 @@
+#ifndef DBFREESPACEMAP_H_
+#define DBFREESPACEMAP_H_
+
+#include <hubDB/DBBufferMgr.h>
+#include <hubDB/DBFile.h>
+
+using namespace HubDB::File;
+using namespace HubDB::Manager;
+
+namespace HubDB{
+    namespace Table{
+
+        /**
+         * Verzeichnis der Tabellenseiten mit freien Plätzen, gespeichert in einer
+         * eigenen Datei neben der Tabellendatei. Jede Blattseite (ab Block 1) enthält
+         * ein Bit je Tabellenseite, Block 0 ein Bit je Blattseite, das gesetzt ist,
+         * solange die Blattseite ein gesetztes Bit enthält. Eine Seite mit freiem
+         * Platz wird so mit zwei Seitenzugriffen gefunden.
+         *
+         * Ein gesetztes Bit ist ein Hinweis: DBTable prüft die Seite und löscht das
+         * Bit, falls sie doch voll ist. Eine leere Datei gilt als nicht aufgebaut
+         * (Tabellen, die ohne das Verzeichnis angelegt wurden), DBTable baut sie
+         * beim ersten Schreiben aus den Seiten auf.
+         */
+        class DBFreeSpaceMap
+        {
+        public:
+            DBFreeSpaceMap(DBBufferMgr & bufMgr,DBFile & file);
+            string toString(string linePrefix="") const;
+
+            bool isBuilt() const { return bufMgr.getBlockCount(file) > 0;};
+
+            /**
+             * Sucht die erste Tabellenseite mit gesetztem Bit
+             * @return false, falls es keine gibt
+             */
+            bool findFree(BlockNo & page);
+
+            void setFree(BlockNo page,bool free);
+
+        protected:
+            uint pagesPerBlock() const;
+            DBBACB fixBlock(BlockNo blockNo,DBBCBLockMode mode);
+            static bool findBit(const uint * bits,uint cnt,uint & pos);
+            static bool getBit(const uint * bits,uint pos);
+            static void setBit(uint * bits,uint pos,bool val);
+
+            static LoggerPtr logger;
+            static const BlockNo summaryBlockNo;
+            DBBufferMgr & bufMgr;
+            DBFile & file;
+        };
+    }
+}
+
+#endif // DBFREESPACEMAP_H_
@@ -0,0 +1,68 @@
+#ifndef DBIMPORTPARSER_H_
+#define DBIMPORTPARSER_H_
+
+#include <hubDB/DBTypes.h>
+
+using namespace HubDB::Types;
+
+namespace HubDB{
+    namespace Manager{
+
+        /**
+         * Liest eine Importdatei (IMPORT): eine Zeile pro Tupel, die Werte durch
+         * Leerraum getrennt, Zeichenketten in Hochkommata.
+         *
+         * Die Datei wird in den Speicher eingeblendet (mmap) und in Abschnitten von
+         * STD_IMPORT_CHUNK Bytes, die an Zeilenenden beginnen, von STD_IMPORT_THREADS
+         * Threads gleichzeitig zerlegt. Während der Aufrufer die Tupel einer Runde
+         * schreibt, werden bereits die Abschnitte der nächsten Runde zerlegt.
+         * next() liefert die Tupel in Dateireihenfolge.
+         *
+         * Eine fehlerhafte Zeile beendet den Import wie bisher mit fscanf(): die Tupel
+         * davor werden geliefert, die übrigen nicht. Eine Zeichenkette ohne Hochkommata
+         * löst nach den Tupeln davor eine Ausnahme aus (siehe DBAttrType::import()).
+         */
+        class DBImportParser
+        {
+            struct chunk{
+                const char * begin;
+                const char * end;
+                const DBRelDef * rel;
+                DBListTuple tuples;
+                bool stop;        // fehlerhafte Zeile, die folgenden werden nicht gelesen
+                string error;     // Meldung einer Ausnahme beim Zerlegen
+                pthread_t thread;
+            };
+
+        public:
+            DBImportParser(const string & fileName,const DBRelDef & rel);
+            ~DBImportParser();
+            string toString(string linePrefix="") const;
+
+            /**
+             * Liefert die Tupel der nächsten Runde, die Liste wird vorher geleert
+             * @return false am Ende der Datei
+             */
+            bool next(DBListTuple & tuples);
+
+        protected:
+            void startRound();
+            void joinRound();
+            static void * parseChunk(void * arg);
+            static bool parseLine(const DBRelDef & rel,const char * p,const char * eol,DBTuple & tuple);
+
+            static LoggerPtr logger;
+            const DBRelDef rel;
+            int fd;
+            const char * data;
+            size_t size;
+            size_t pos;           // Beginn der nächsten Runde
+            vector<chunk> round;  // die gerade zerlegten Abschnitte
+            bool running;
+            bool finished;
+            string error;         // wird beim nächsten Aufruf von next() ausgelöst
+        };
+    }
+}
+
+#endif // DBIMPORTPARSER_H_
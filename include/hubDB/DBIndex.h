@@ -3,6 +3,7 @@
 
 #include <hubDB/DBTypes.h>
 #include <hubDB/DBBufferMgr.h>
+#include <hubDB/DBTIDBitmap.h>
 
 using namespace HubDB::Types;
 using namespace HubDB::Manager;
@@ -76,6 +77,16 @@ namespace HubDB{
              */
             virtual void find(const DBAttrType & val,DBListTID & tids) = 0;
 
+            /**
+             * Liefert die Tupelidentifikatoren zum angegebenen Schlüsselelement als Bitmap.
+             * Nur Indexe, die ihre Einträge als Bitmaps speichern, unterstützen dies;
+             * mehrere solcher Bitmaps können ohne Zugriff auf die Tabelle geschnitten werden.
+             * @param val
+             * @param tids
+             * @return false, falls der Index keine Bitmaps liefern kann
+             */
+            virtual bool findBitmap(const DBAttrType & /*val*/,DBTIDBitmap & /*tids*/){ return false;};
+
             /**
              * Fügt den übergegebenen Tupelidentifikator unter dem angegebenen Schlüsselelement ein.
              * @param val
@@ -83,6 +94,16 @@ namespace HubDB{
              */
             virtual void insert(const DBAttrType & val,const TID & tid) = 0;
 
+            /**
+             * Fügt die Tupelidentifikatoren tids[i] unter den Schlüsselelementen vals[i] ein,
+             * die Einträge sind aufsteigend nach Schlüsselelement sortiert (Massenimport).
+             * Die Standardimplementierung ruft insert() für jeden Eintrag auf.
+             * Scheitert ein Eintrag, werden die bereits eingefügten wieder entfernt.
+             * @param vals
+             * @param tids
+             */
+            virtual void insertSorted(const vector<const DBAttrType *> & vals,const vector<TID> & tids);
+
             /**
              * Entfernt alle übergegebenen Tupelidentifikatoren unter dem angegebenen Schlüsselelement.
              * @param val
@@ -90,6 +111,66 @@ namespace HubDB{
              */
             virtual void remove(const DBAttrType & val,const DBListTID & tid) = 0;
 
+            /**
+             * Öffnet einen Cursor über alle Tupelidentifikatoren, welche unter dem
+             * angegebenen Schlüsselelement indiziert sind. Die TIDs werden danach
+             * stapelweise mit nextBatch() abgeholt, so dass die Trefferliste nie
+             * vollständig im Speicher liegen muss. Ein bereits offener Cursor wird
+             * geschlossen.
+             * Die Standardimplementierung verwendet find() und hält damit alle TIDs
+             * im Speicher; Indexe, die ihre Seiten schrittweise lesen können,
+             * überschreiben sie (DBSeqIndex, DBBLinkIndex, DBBitmapIndex).
+             * @param val
+             */
+            virtual void openCursor(const DBAttrType & val);
+
+            /**
+             * Füllt den übergegebenen Puffer mit bis zu maxTids weiteren
+             * Tupelidentifikatoren des offenen Cursors. Der Puffer wird vorher geleert,
+             * sein Speicher aber wiederverwendet. Innerhalb eines Stapels sind die
+             * TIDs nach Seiten sortiert. Über Stapel hinweg gilt diese Reihenfolge
+             * nur, wenn der Index die TIDs eines Schlüssels geordnet ablegt
+             * (DBBLinkIndex, DBBitmapIndex und die Standardimplementierung); bei
+             * DBSeqIndex kann eine Seite in mehreren Stapeln vorkommen.
+             * @param tids
+             * @param maxTids
+             * @return false, falls der Cursor keine TIDs mehr liefert
+             */
+            virtual bool nextBatch(DBTIDBatch & tids,uint maxTids = STD_TID_BATCH);
+
+            /**
+             * Schließt den Cursor und gibt dessen Zustand frei.
+             */
+            virtual void closeCursor();
+
+            /**
+             * Öffnet einen Cursor über alle Einträge des Indexes in aufsteigender
+             * Reihenfolge der Schlüssel. Die Einträge werden danach schlüsselweise mit
+             * nextOrdered() abgeholt und der Cursor mit closeCursor() geschlossen.
+             * Die Standardimplementierung liefert false, da nicht jeder Index seine
+             * Schlüssel geordnet ablegt (z.B. DBBitmapIndex).
+             * @return false, falls der Index keine geordnete Ausgabe unterstützt
+             */
+            virtual bool openOrderedCursor(){ return false;};
+
+            /**
+             * Liefert den nächsten Schlüssel des geordneten Cursors zusammen mit allen
+             * unter ihm indizierten Tupelidentifikatoren (nach Seiten sortiert).
+             * @param key Rückgabe: normalisierter Schlüssel (siehe DBAttrType::normalizedKey())
+             * @param tids Puffer, wird geleert und gefüllt
+             * @return false, falls keine Schlüssel mehr vorhanden sind
+             */
+            virtual bool nextOrdered(std::string & /*key*/,DBTIDBatch & /*tids*/){ return false;};
+
+            /**
+             * Zählt die Tupelidentifikatoren unter dem angegebenen Schlüsselelement,
+             * ohne auf die Tabelle zuzugreifen (Index-Only-Scan).
+             * Die Standardimplementierung zählt die Stapel des Cursors.
+             * @param val
+             * @return Anzahl der indizierten Tupel
+             */
+            virtual uint count(const DBAttrType & val);
+
             /**
              * Gibt zurück, ob (keine) Duplikate erlaubt sind
              * @return true, falls keine Duplikate erlaubt sind.
@@ -103,6 +184,7 @@ namespace HubDB{
             size_t attrTypeSize;        // Größe des indizierten Attributes
             ModType mode;         // Art des Zugriffs: lesend oder schreibend
             bool unique;          // unique: keine Duplikate im Index erlaubt
+            DBListTID cursorTids; // noch nicht gelieferte TIDs des Standard-Cursors
 
         private:
             static LoggerPtr logger;
@@ -0,0 +1,702 @@
+#ifndef DBOPERATOR_H_
+#define DBOPERATOR_H_
+
+#include <hubDB/DBTable.h>
+#include <hubDB/DBIndex.h>
+#include <hubDB/DBSocket.h>
+#include <hubDB/DBSysCatMgr.h>
+#include <hubDB/DBExternalSort.h>
+
+#include <chrono>
+#include <functional>
+
+using namespace HubDB::Table;
+using namespace HubDB::Index;
+using namespace HubDB::Socket;
+
+namespace HubDB{
+    namespace Manager{
+
+        typedef unordered_multimap<const DBAttrType *,const DBTuple *,hash_AttrType,equal_AttrType> DBJoinHashTable;
+
+        /**
+         * Physischer Operator der Anfrageausführung (Iterator-Modell).
+         *
+         * Operatoren bilden einen Baum; jeder Operator zieht die Zeilen seiner
+         * Kinder mit next() stapelweise nach oben, so dass nie das gesamte
+         * Ergebnis im Speicher liegen muss. Eine Zeile ist ein Tupelpaar, bei
+         * Operatoren über einer Tabelle ist nur das erste Tupel belegt.
+         * Ein Operator besitzt seine Kinder und gibt sie im Destruktor frei.
+         */
+        class DBOperator
+        {
+        public:
+            DBOperator():estRows(-1){};
+            virtual ~DBOperator(){};
+            virtual string toString(string linePrefix="") const = 0;
+
+            /**
+             * Einzeilige Beschreibung des Operators für EXPLAIN
+             */
+            virtual string explain() const = 0;
+
+            /**
+             * Hängt die Zeiger auf die Kinder des Operators an, z.B. um sie für
+             * EXPLAIN ANALYZE durch einen DBProfileOp zu ersetzen
+             */
+            virtual void getInputs(vector<DBOperator **> & /*inputs*/){};
+
+            virtual void open() = 0;
+
+            /**
+             * Liefert den nächsten Stapel von Zeilen
+             * @param rows wird vorher geleert und mit mindestens einer Zeile gefüllt
+             * @return false, falls keine Zeilen mehr vorhanden sind
+             */
+            virtual bool next(DBListJoinTuple & rows) = 0;
+
+            virtual void close() = 0;
+
+            /**
+             * Öffnet den Operator, hängt alle Zeilen an rows an und schließt ihn
+             */
+            void fetchAll(DBListJoinTuple & rows);
+
+            /**
+             * Übertragen die Tupel zwischen Tupelliste und ersten Tupeln der Zeilen,
+             * ohne sie zu kopieren; die Quelle ist danach leer
+             */
+            static void toRows(DBListTuple & tuples,DBListJoinTuple & rows);
+            static void fromRows(DBListJoinTuple & rows,DBListTuple & tuples);
+
+            /**
+             * Beschreibt Zwischentupel mit den angegebenen Attributtypen, z.B. für temporäre Dateien
+             */
+            static void tupleDef(const vector<AttrTypeEnum> & types,RelDefStruct & def);
+
+            /**
+             * Vom Optimierer geschätzte Anzahl Zeilen, negativ falls unbekannt
+             */
+            void setEstimate(double rows){ estRows = rows;};
+
+            /**
+             * explain() gefolgt von der geschätzten Anzahl Zeilen
+             */
+            string describe() const;
+
+            /**
+             * Gibt den Operatorbaum aus, eine Zeile je Operator, Kinder eingerückt
+             */
+            void explainTree(ostream & s,string linePrefix="");
+
+        protected:
+            double estRows;
+        };
+
+        /**
+         * Liefert eine bereits berechnete Liste von Zeilen, z.B. die äußeren Zeilen
+         * eines Index-Nested-Loop-Joins, die DBPartitionedHashJoinOp gelesen hat
+         */
+        class DBListOp : public DBOperator
+        {
+        public:
+            /**
+             * @param source Beschreibung der Herkunft der Zeilen für EXPLAIN
+             */
+            DBListOp(DBListJoinTuple & rows,const string & source="");
+            DBListOp(DBListTuple & tuples,const string & source="");
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void open(){};
+            bool next(DBListJoinTuple & rows);
+            void close(){};
+
+        protected:
+            DBListOp(const string & source);
+
+            DBListJoinTuple data;
+            uint cnt;
+            const string source;
+            bool computed;
+        };
+
+        /**
+         * Wie DBListOp, die Zeilen berechnet aber erst open() mit compute, z.B. mit
+         * DBQueryMgr::selectTuple(); EXPLAIN ohne Ausführung liest so keine Tupel
+         */
+        class DBDeferredOp : public DBListOp
+        {
+        public:
+            DBDeferredOp(const std::function<void(DBListJoinTuple &)> & compute,const string & source);
+            void open();
+            void close(){ data.clear();};
+
+        protected:
+            std::function<void(DBListJoinTuple &)> compute;
+        };
+
+        /**
+         * Sequentielles Lesen einer Tabelle; es werden nur Tupel geliefert, die alle
+         * Prädikate erfüllen (siehe DBTable::readSeqFromTID()). Dekodiert werden
+         * nur die Attribute aus attrMask; die Prädikatattribute müssen enthalten sein.
+         */
+        class DBScanOp : public DBOperator
+        {
+        public:
+            DBScanOp(DBTable & table,const DBListPredicate & where,uint attrMask = ALL_ATTRS);
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close(){};
+
+        protected:
+            static LoggerPtr logger;
+            DBTable & table;
+            DBListPredicate where;
+            const uint attrMask;
+            TID pos;
+            bool eof;
+        };
+
+        /**
+         * Liest die Tupel zu den TIDs eines Index-Cursors; der Operator besitzt den Index
+         */
+        class DBIndexScanOp : public DBOperator
+        {
+        public:
+            DBIndexScanOp(DBTable & table,DBIndex * index,const DBAttrType & val,uint attrMask = ALL_ATTRS);
+            ~DBIndexScanOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            static LoggerPtr logger;
+            DBTable & table;
+            DBIndex * index;
+            DBAttrType * val;
+            const uint attrMask;
+            DBTIDBatch tids;
+        };
+
+        /**
+         * Liest die Tupel zu den TIDs eines (z.B. aus Bitmap-Indexen geschnittenen) Bitmaps
+         */
+        class DBBitmapScanOp : public DBOperator
+        {
+        public:
+            DBBitmapScanOp(DBTable & table,DBTIDBitmap & bitmap,uint attrMask = ALL_ATTRS);
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close(){};
+
+        protected:
+            static LoggerPtr logger;
+            DBTable & table;
+            DBTIDBitmap bitmap;
+            DBTIDBitmap::Position pos;
+            const uint attrMask;
+            DBTIDBatch tids;
+        };
+
+        /**
+         * Liest die Tupel in aufsteigender Reihenfolge der Schlüssel eines geordneten
+         * Indexes (siehe DBIndex::openOrderedCursor()); der Operator besitzt den Index
+         */
+        class DBOrderedIndexScanOp : public DBOperator
+        {
+        public:
+            DBOrderedIndexScanOp(DBTable & table,DBIndex * index,uint attrMask = ALL_ATTRS);
+            ~DBOrderedIndexScanOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            static LoggerPtr logger;
+            DBTable & table;
+            DBIndex * index;
+            const uint attrMask;
+            DBTIDBatch tids;
+        };
+
+        /**
+         * Liest die Tupel temporärer Dateien nacheinander, z.B. die Partitionen eines
+         * Hash-Joins; der Operator besitzt die Dateien und löscht sie im Destruktor
+         */
+        class DBTempScanOp : public DBOperator
+        {
+        public:
+            DBTempScanOp(vector<DBTempFile *> & files,const string & source="");
+            ~DBTempScanOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close(){};
+
+        protected:
+            vector<DBTempFile *> files;
+            const string source;
+            uint filePos;
+        };
+
+        /**
+         * Lässt nur Zeilen durch, deren erstes Tupel alle Prädikate erfüllt,
+         * für die in checkList true steht
+         */
+        class DBFilterOp : public DBOperator
+        {
+        public:
+            DBFilterOp(DBOperator * child,const DBRelDef & def,const DBListPredicate & where,const list<bool> & checkList);
+            ~DBFilterOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+            static bool match(const DBTuple & tuple,DBListPredicate & where,const list<uint> & posList,const list<bool> & checkList);
+
+        protected:
+            static LoggerPtr logger;
+            DBOperator * child;
+            DBListPredicate where;
+            list<uint> posList;
+            list<bool> checkList;
+        };
+
+        /**
+         * Hash-Join im Speicher: open() liest die Eingabe buildSide vollständig in eine
+         * Hashtabelle, die andere Eingabe wird stapelweise gegen sie geprüft
+         */
+        class DBHashJoinOp : public DBOperator
+        {
+        public:
+            DBHashJoinOp(DBOperator * build,DBOperator * probe,uint buildSide,uint attrJoinPos[2]);
+            ~DBHashJoinOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&build); inputs.push_back(&probe);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+            static void buildHashTable(const DBListTuple & build,uint attrPos,DBJoinHashTable & hashTable);
+            static void probeHashTable(DBJoinHashTable & hashTable,uint buildSide,const DBListTuple & probe,uint attrPos,DBListJoinTuple & tuples);
+
+        protected:
+            static LoggerPtr logger;
+            DBOperator * build;
+            DBOperator * probe;
+            const uint buildSide;
+            uint attrJoinPos[2];
+            DBListTuple buildTuples;
+            DBJoinHashTable hashTable;
+        };
+
+        /**
+         * Index-Nested-Loop-Join: die äußere Eingabe wird stapelweise gelesen, die
+         * Join-Werte eines Stapels werden sortiert und je einmal im Index der inneren
+         * Tabelle gesucht; die gefundenen TIDs werden in Seitenreihenfolge gelesen.
+         * Der Operator besitzt den Index.
+         */
+        class DBIndexJoinOp : public DBOperator
+        {
+        public:
+            DBIndexJoinOp(DBOperator * outer,uint inner,DBTable & table,DBIndex * index,uint attrJoinPos[2],const DBListPredicate & innerWhere,uint attrMask = ALL_ATTRS);
+            ~DBIndexJoinOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&outer);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            static LoggerPtr logger;
+            DBOperator * outer;
+            const uint inner;
+            DBTable & table;
+            DBIndex * index;
+            uint attrJoinPos[2];
+            DBListPredicate innerWhere;
+            const uint attrMask;    // zu lesende Attribute der inneren Tabelle
+            list<uint> posList;
+            list<bool> checkList;
+        };
+
+        /**
+         * Hash-Join, dessen Eingaben größer als der Speicher sein dürfen. open() liest
+         * zuerst die Eingabe first: passen ihre Tupel in memTuples(), wird über ihnen die
+         * Hashtabelle gebaut und next() prüft die andere Eingabe stapelweise.
+         * Sonst wird sie nach dem Hashwert des Join-Attributs auf MAX_JOIN_PARTITIONS
+         * temporäre Dateien verteilt (Grace-Hash-Join) und die andere Eingabe gelesen.
+         * Passt diese in den Speicher, werden die Partitionen der ersten gegen sie geprüft,
+         * sonst wird sie ebenso partitioniert und next() verbindet eine Partition nach der
+         * anderen; die kleinere Seite einer Partition bildet die Hashtabelle.
+         * Überschreiten beide Eingaben MAX_JOIN_PARTITIONS Mal den Speicher, werden die
+         * Partitionen stattdessen sortiert und gemischt (DBMergeJoinOp).
+         */
+        class DBPartitionedHashJoinOp : public DBOperator
+        {
+        public:
+            DBPartitionedHashJoinOp(DBOperator * left,DBOperator * right,uint first,DBSysCatMgr & sysCatMgr,const string & dbName,
+                                    const DBRelDef & leftRel,const DBRelDef & rightRel,uint attrJoinPos[2]);
+            ~DBPartitionedHashJoinOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&input[0]); inputs.push_back(&input[1]);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+            /**
+             * Hat die Eingabe first weniger als maxOuter Zeilen, wird mit ihren Werten der
+             * Index des Join-Attributs der anderen Tabelle durchsucht (DBIndexJoinOp) und
+             * die andere Eingabe nicht gelesen. Der Operator übernimmt den Index.
+             */
+            void setIndexJoin(DBTable & table,DBIndex * index,const DBListPredicate & where,uint attrMask,uint maxOuter);
+
+            // Anzahl Tupel, die STD_JOIN_MEM_BLOCKS Seiten fassen
+            static uint memTuples(const DBRelDef & rel);
+
+        protected:
+            bool readInput(uint side);
+            void buildHashTable(uint side);
+            bool nextPartition();
+            void clear();
+            static uint partitionOf(const DBAttrType & val);
+
+            static LoggerPtr logger;
+            DBOperator * input[2];
+            const uint first;
+            DBSysCatMgr & sysCatMgr;
+            const string dbName;
+            vector<DBRelDef> rel;
+            uint attrJoinPos[2];
+            uint maxTuples[2];
+            DBTable * indexTable;           // Index-Nested-Loop-Join, siehe setIndexJoin()
+            DBIndex * index;
+            DBListPredicate indexWhere;
+            uint indexMask;
+            uint maxOuter;
+            bool opened[2];
+            uint cnt[2];                    // gelesene Tupel je Eingabe
+            DBListTuple mem[2];             // Tupel im Speicher je Eingabe
+            vector<DBTempFile *> part[2];   // Partitionen je Eingabe, leer falls im Speicher
+            DBJoinHashTable hashTable;
+            uint buildSide;
+            bool streamed;                  // die andere Eingabe wird direkt geprüft
+            bool perPartition;              // je Partition eine eigene Hashtabelle
+            uint partPos;
+            DBOperator * sub;               // Sort-Merge- bzw. Index-Nested-Loop-Join
+            string strategy;                // gewähltes Verfahren für EXPLAIN ANALYZE
+        };
+
+        /**
+         * Merge-Join zweier Eingaben, deren erste Tupel aufsteigend nach dem Join-Attribut
+         * geordnet sind (z.B. DBSortOp oder DBOrderedIndexScanOp). Im Speicher liegen nur
+         * die Tupel des aktuellen Join-Werts beider Seiten; ihr Kreuzprodukt wird
+         * stapelweise geliefert, so dass auch große Gruppen nicht vollständig als
+         * Ergebnis im Speicher stehen.
+         */
+        class DBMergeJoinOp : public DBOperator
+        {
+        public:
+            DBMergeJoinOp(DBOperator * left,DBOperator * right,uint attrJoinPos[2]);
+            ~DBMergeJoinOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&input[0]); inputs.push_back(&input[1]);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            bool readGroup(uint side);
+            bool matchGroups();
+
+            static LoggerPtr logger;
+            DBOperator * input[2];
+            uint attrJoinPos[2];
+            DBListTuple buf[2];                 // gelesene Tupel nach der aktuellen Gruppe
+            bool eof[2];
+            DBListTuple group[2];               // Tupel des aktuellen Join-Werts
+            DBListTuple::const_iterator pos[2]; // nächstes Paar des Kreuzprodukts
+            bool pending;                       // Kreuzprodukt noch nicht vollständig geliefert
+            bool done;
+        };
+
+        /**
+         * Aggregatfunktion über dem Attribut pos des Tupels side einer Zeile
+         */
+        struct DBAggregate{
+            AggFuncEnum func;
+            uint side;
+            uint pos;           // bei COUNT(*) ohne Bedeutung
+            AttrTypeEnum type;  // Typ des Attributs, NONE bei COUNT(*)
+        };
+
+        /**
+         * Hash-Aggregation: open() liest die Eingabe vollständig und fasst die Zeilen mit
+         * gleichen Werten der Gruppierungsattribute (Paare aus Seite und Attributposition)
+         * zusammen. Das erste Tupel jeder Ergebniszeile enthält die Gruppierungsattribute
+         * gefolgt von den Werten der Aggregatfunktionen; ohne Gruppierungsattribute wird
+         * genau eine Zeile geliefert. SUM, MIN, MAX und AVG über keiner Zeile sind NULL.
+         * Verlässt SUM über INT den Wertebereich von INT, wird eine DBRuntimeException geworfen.
+         *
+         * Liegen so viele Gruppen im Speicher, wie STD_AGG_MEM_BLOCKS Seiten fassen, werden
+         * die Zeilen neuer Gruppen nach dem Hashwert der Gruppe auf MAX_AGG_PARTITIONS
+         * temporäre Dateien verteilt. Diese werden nach Ausgabe der Gruppen im Speicher
+         * einzeln aggregiert und dabei falls nötig erneut partitioniert.
+         */
+        class DBHashAggregateOp : public DBOperator
+        {
+            struct aggState{
+                uint cnt;
+                double sum;         // SUM über DOUBLE, AVG
+                long long intSum;   // SUM über INT
+                DBAttrType * ext;   // MIN, MAX
+            };
+            struct aggGroup{
+                DBTuple key;
+                vector<aggState> states;
+            };
+            struct aggPartition{
+                DBTempFile * file;
+                uint level;
+            };
+
+        public:
+            DBHashAggregateOp(DBOperator * child,DBSysCatMgr & sysCatMgr,const string & dbName,DBRelDef * def[2],
+                              const list<pair<uint,uint> > & groupList,const vector<DBAggregate> & aggList);
+            ~DBHashAggregateOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            void aggregate(const vector<const DBAttrType *> & cols);
+            aggGroup * addGroup(const vector<const DBAttrType *> & cols,const string & key);
+            void finishInput();
+            void spill(const vector<const DBAttrType *> & cols,const string & key);
+            void clearGroups();
+            void dropPartitions(vector<DBTempFile *> & part);
+            bool nextPartition();
+            string groupKey(const vector<const DBAttrType *> & cols) const;
+
+            static LoggerPtr logger;
+            DBOperator * child;
+            DBSysCatMgr & sysCatMgr;
+            const string dbName;
+            vector<pair<uint,uint> > colList;   // gelesene Attribute: Gruppierungsattribute, dann Argumente
+            const uint groupCnt;
+            vector<DBAggregate> aggList;
+            vector<uint> argCol;                // Spalte des Arguments je Aggregatfunktion
+            RelDefStruct colDef;                // Tupelformat der Partitionen
+            uint maxGroups;
+            list<aggGroup> groups;
+            unordered_map<string,aggGroup *> groupIndex;
+            list<aggGroup>::iterator emitPos;
+            uint level;                         // Partitionierungsstufe der aktuellen Eingabe
+            vector<DBTempFile *> spilled;       // Partitionen der aktuellen Eingabe
+            list<aggPartition> pending;         // noch zu aggregierende Partitionen
+        };
+
+        /**
+         * Projektion: das erste Tupel jeder Zeile enthält danach nur die Attribute
+         * aus proList (Paare aus Seite und Attributposition), das zweite ist leer
+         */
+        class DBProjectOp : public DBOperator
+        {
+        public:
+            DBProjectOp(DBOperator * child,const list<pair<uint,uint> > & proList);
+            ~DBProjectOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            DBOperator * child;
+            list<pair<uint,uint> > proList;
+        };
+
+        /**
+         * Sortiert die Zeilen nach dem Attribut attrPos ihres ersten Tupels (siehe
+         * DBExternalSort); open() liest die Eingabe vollständig.
+         * rel beschreibt die ersten Tupel, das zweite Tupel wird nicht übernommen.
+         */
+        class DBSortOp : public DBOperator
+        {
+        public:
+            DBSortOp(DBOperator * child,DBSysCatMgr & sysCatMgr,const string & dbName,const DBRelDef & rel,uint attrPos,bool desc);
+            ~DBSortOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+            // Anzahl Tupel, die STD_SORT_MEM_BLOCKS Seiten fassen
+            static uint memTuples(const DBRelDef & rel);
+
+        protected:
+            static LoggerPtr logger;
+            DBOperator * child;
+            DBSysCatMgr & sysCatMgr;
+            const string dbName;
+            const DBRelDef rel;
+            const uint attrPos;
+            const bool desc;
+            DBExternalSort * sorter;
+        };
+
+        /**
+         * Liefert die ersten limit Zeilen nach dem Attribut attrPos ihres ersten Tupels
+         * sortiert. open() liest die Eingabe vollständig, behält aber nur limit Zeilen
+         * in einem Heap, dessen Wurzel die Zeile ist, die als nächste verdrängt wird.
+         */
+        class DBTopNOp : public DBOperator
+        {
+        public:
+            DBTopNOp(DBOperator * child,uint attrPos,bool desc,uint limit);
+            ~DBTopNOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            bool before(const DBTuple & a,const DBTuple & b) const;
+
+            static LoggerPtr logger;
+            DBOperator * child;
+            const uint attrPos;
+            const bool desc;
+            const uint limit;
+            vector<DBTuple> heap;
+            uint emitPos;
+        };
+
+        /**
+         * Liefert höchstens limit Zeilen seines Kindes; ist die Grenze erreicht,
+         * wird das Kind nicht weiter gelesen
+         */
+        class DBLimitOp : public DBOperator
+        {
+        public:
+            DBLimitOp(DBOperator * child,uint limit);
+            ~DBLimitOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+        protected:
+            DBOperator * child;
+            const uint limit;
+            uint cnt;
+        };
+
+        /**
+         * Schreibt die ersten Tupel der Zeilen seines Kindes auf den Socket.
+         * Sobald mehr als STD_SEND_SIZE Zeichen gepuffert sind, werden sie gesendet,
+         * so dass die ersten Zeilen den Client erreichen, bevor das Ergebnis vollständig ist.
+         */
+        class DBOutputOp : public DBOperator
+        {
+        public:
+            DBOutputOp(DBOperator * child,DBSocket & socket);
+            ~DBOutputOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ inputs.push_back(&child);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+            uint getCnt() const { return cnt;};
+
+        protected:
+            DBOperator * child;
+            DBSocket & socket;
+            uint cnt;
+        };
+
+        /**
+         * Misst für EXPLAIN ANALYZE die fixierten und dabei von der Platte gelesenen
+         * Seiten (siehe DBBufferMgr::getFixCnt()) und die Zeit zwischen start() und
+         * stop(); mehrere Abschnitte werden aufsummiert. Die Zähler gelten für den
+         * gesamten Buffer, parallele Anfragen anderer Clients werden mitgezählt.
+         */
+        class DBProfile
+        {
+        public:
+            DBProfile(DBSysCatMgr & sysCatMgr);
+            string toString(string linePrefix="") const;
+            void start();
+            void stop();
+            string describe() const;
+
+        protected:
+            DBSysCatMgr & sysCatMgr;
+            uint fixCnt;
+            uint readCnt;
+            double msec;
+            uint startFix;
+            uint startRead;
+            std::chrono::steady_clock::time_point startTime;
+        };
+
+        /**
+         * Zählt für EXPLAIN ANALYZE die Zeilen seines Kindes und misst dessen open(),
+         * next() und close(); die Werte enthalten die der Nachfahren des Kindes.
+         * Im Operatorbaum tritt er an die Stelle des Kindes (siehe explain()).
+         */
+        class DBProfileOp : public DBOperator
+        {
+        public:
+            DBProfileOp(DBOperator * child,DBSysCatMgr & sysCatMgr);
+            ~DBProfileOp();
+            string toString(string linePrefix="") const;
+            string explain() const;
+            void getInputs(vector<DBOperator **> & inputs){ child->getInputs(inputs);};
+            void open();
+            bool next(DBListJoinTuple & rows);
+            void close();
+
+            /**
+             * Setzt über jeden Operator des Baums einen DBProfileOp
+             */
+            static void instrument(DBOperator *& op,DBSysCatMgr & sysCatMgr);
+
+        protected:
+            DBOperator * child;
+            DBProfile profile;
+            uint rows;
+            bool opened;
+        };
+    }
+}
+
+#endif // DBOPERATOR_H_
@@ -0,0 +1,53 @@
+#ifndef DBPAGEFILTER_H_
+#define DBPAGEFILTER_H_
+
+#include <hubDB/DBTypes.h>
+
+using namespace HubDB::Types;
+
+namespace HubDB{
+    namespace Table{
+
+        /**
+         * Prüft Gleichheitsprädikate direkt auf den Bytes einer Tabellenseite,
+         * ohne die Tupel zu dekodieren.
+         *
+         * Jedes Attribut liegt in allen Slots an derselben Position. Für jedes Prädikat
+         * vergleicht eine typisierte Schleife ohne Verzweigungen (INT, DOUBLE,
+         * VARCHAR fester Länge) je 32 Slots und erzeugt daraus ein Maskenwort; die
+         * Masken aller Prädikate werden mit der Belegungsmaske der Seite verundet.
+         * Nur die danach gesetzten Slots müssen als DBTuple gelesen werden.
+         */
+        class DBPageFilter
+        {
+            struct predicateLayout{
+                size_t offset;      // Position des Attributs im Slot
+                AttrTypeEnum type;
+                int intVal;
+                double doubleVal;
+                char vcharVal[MAX_STR_LEN]; // mit '\0' aufgefüllt wie auf der Seite
+            };
+
+        public:
+            DBPageFilter(const DBRelDef & rel,DBListPredicate & where);
+            string toString(string linePrefix="") const;
+
+            bool empty() const { return preds.empty();};
+
+            /**
+             * @param slots Beginn des ersten Slots der Seite
+             * @param slotCnt Anzahl Slots der Seite
+             * @param mask Eingabe: Belegungsmaske, Ausgabe: belegte Slots, die alle Prädikate erfüllen
+             */
+            void filter(const char * slots,uint slotCnt,uint * mask) const;
+
+        protected:
+            static LoggerPtr logger;
+            const size_t tupleSize;
+            bool never;             // Prädikat mit falschem Typ, kein Slot passt
+            vector<predicateLayout> preds;
+        };
+    }
+}
+
+#endif // DBPAGEFILTER_H_
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.4.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2019 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -31,8 +31,9 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
 #ifndef YY_YY_USERS_BZCSCHAE_WORKSPACE_DBS2_HUBDB_INCLUDE_HUBDB_DBPARSER_H_INCLUDED
 # define YY_YY_USERS_BZCSCHAE_WORKSPACE_DBS2_HUBDB_INCLUDE_HUBDB_DBPARSER_H_INCLUDED
@@ -44,68 +45,88 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    CREATE = 258,
-    DROP = 259,
-    TABLE = 260,
-    INSERT = 261,
-    INTO = 262,
-    VALUES = 263,
-    SELECT = 264,
-    DELETE = 265,
-    FROM = 266,
-    WHERE = 267,
-    CONNECT = 268,
-    DISCONNECT = 269,
-    EQUALS = 270,
-    STAR = 271,
-    PARA_OPEN = 272,
-    PARA_CLOSE = 273,
-    COMMATA = 274,
-    SEMICOLON = 275,
-    TO = 276,
-    LIST = 277,
-    TABLES = 278,
-    IMPORT = 279,
-    EXPORT = 280,
-    QUIT = 281,
-    APOSTROPHE = 282,
-    INDEX = 283,
-    TYPE = 284,
-    GET = 285,
-    SCHEMA = 286,
-    FOR = 287,
-    DATABASE = 288,
-    INTT = 289,
-    DOUBLET = 290,
-    VARCHAR = 291,
-    AS = 292,
-    IN = 293,
-    DOT = 294,
-    UNIQUE = 295,
-    ON = 296,
-    AND = 297,
-    JOIN = 298,
-    PRINT = 299,
-    STATISTICS = 300,
-    CLASSES = 301,
-    HELP = 302,
-    NUM = 303,
-    REALNUM = 304,
-    DBNAME = 305,
-    STR_VALUE = 306
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    CREATE = 258,                  /* CREATE  */
+    DROP = 259,                    /* DROP  */
+    TABLE = 260,                   /* TABLE  */
+    INSERT = 261,                  /* INSERT  */
+    INTO = 262,                    /* INTO  */
+    VALUES = 263,                  /* VALUES  */
+    SELECT = 264,                  /* SELECT  */
+    DELETE = 265,                  /* DELETE  */
+    FROM = 266,                    /* FROM  */
+    WHERE = 267,                   /* WHERE  */
+    CONNECT = 268,                 /* CONNECT  */
+    DISCONNECT = 269,              /* DISCONNECT  */
+    EQUALS = 270,                  /* EQUALS  */
+    STAR = 271,                    /* STAR  */
+    PARA_OPEN = 272,               /* PARA_OPEN  */
+    PARA_CLOSE = 273,              /* PARA_CLOSE  */
+    COMMATA = 274,                 /* COMMATA  */
+    SEMICOLON = 275,               /* SEMICOLON  */
+    TO = 276,                      /* TO  */
+    LIST = 277,                    /* LIST  */
+    TABLES = 278,                  /* TABLES  */
+    IMPORT = 279,                  /* IMPORT  */
+    EXPORT = 280,                  /* EXPORT  */
+    QUIT = 281,                    /* QUIT  */
+    APOSTROPHE = 282,              /* APOSTROPHE  */
+    INDEX = 283,                   /* INDEX  */
+    TYPE = 284,                    /* TYPE  */
+    GET = 285,                     /* GET  */
+    SCHEMA = 286,                  /* SCHEMA  */
+    FOR = 287,                     /* FOR  */
+    DATABASE = 288,                /* DATABASE  */
+    INTT = 289,                    /* INTT  */
+    DOUBLET = 290,                 /* DOUBLET  */
+    VARCHAR = 291,                 /* VARCHAR  */
+    AS = 292,                      /* AS  */
+    IN = 293,                      /* IN  */
+    DOT = 294,                     /* DOT  */
+    UNIQUE = 295,                  /* UNIQUE  */
+    ON = 296,                      /* ON  */
+    AND = 297,                     /* AND  */
+    JOIN = 298,                    /* JOIN  */
+    PRINT = 299,                   /* PRINT  */
+    STATISTICS = 300,              /* STATISTICS  */
+    CLASSES = 301,                 /* CLASSES  */
+    HELP = 302,                    /* HELP  */
+    COUNTT = 303,                  /* COUNTT  */
+    SUMT = 304,                    /* SUMT  */
+    MINT = 305,                    /* MINT  */
+    MAXT = 306,                    /* MAXT  */
+    AVGT = 307,                    /* AVGT  */
+    GROUP = 308,                   /* GROUP  */
+    BY = 309,                      /* BY  */
+    ORDER = 310,                   /* ORDER  */
+    ASC = 311,                     /* ASC  */
+    DESC = 312,                    /* DESC  */
+    LIMIT = 313,                   /* LIMIT  */
+    ANALYZE = 314,                 /* ANALYZE  */
+    EXPLAIN = 315,                 /* EXPLAIN  */
+    SLOTTED = 316,                 /* SLOTTED  */
+    PAGESIZE = 317,                /* PAGESIZE  */
+    NUM = 318,                     /* NUM  */
+    REALNUM = 319,                 /* REALNUM  */
+    DBNAME = 320,                  /* DBNAME  */
+    STR_VALUE = 321                /* STR_VALUE  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 25 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
+#line 26 "/Users/bzcschae/workspace/dbs2/HubDB/DBLib/DBParser.y"
 
   char * str;
   QualifiedName qName;
@@ -116,11 +137,16 @@ union YYSTYPE
   RelDefStruct relDef;
   DBAttrType * valT;
   DBTuple * tupleT;
+  DBListTuple * listTuple;
   DBListQualifiedName * listString;
+  DBSelectItem selectItem;
+  DBListSelectItem * listSelect;
+  AggFuncEnum aggFunc;
+  DBOrderBy * orderBy;
   DBListPredicate * listPredicate;
   DBJoin * join;
 
-#line 124 "/Users/bzcschae/workspace/dbs2/HubDB/include/hubDB/DBParser.h"
+#line 150 "/Users/bzcschae/workspace/dbs2/HubDB/include/hubDB/DBParser.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -130,6 +156,8 @@ typedef union YYSTYPE YYSTYPE;
 
 
 
+
 int yyparse (yyscan_t scanner, DBQueryMgr& queryMgr);
 
+
 #endif /* !YY_YY_USERS_BZCSCHAE_WORKSPACE_DBS2_HUBDB_INCLUDE_HUBDB_DBPARSER_H_INCLUDED  */
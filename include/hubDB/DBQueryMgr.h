@@ -4,6 +4,7 @@
 #include <hubDB/DBSysCatMgr.h>
 #include <hubDB/DBServerSocket.h>
 #include <hubDB/DBTypes.h>
+#include <hubDB/DBOperator.h>
 
 using namespace HubDB::Socket;
 using namespace HubDB::Types;
@@ -12,6 +13,12 @@ namespace HubDB{
     namespace Manager{
         class DBQueryMgr{
         public:
+            enum ExplainModeEnum{
+                EXPLAIN_NONE,
+                EXPLAIN_PLAN,
+                EXPLAIN_ANALYZE
+            };
+
             DBQueryMgr(DBServerSocket & socket,DBSysCatMgr & sysCatMgr);
             virtual ~DBQueryMgr();
             string toString(string linePrefix="") const;
@@ -19,7 +26,7 @@ namespace HubDB{
 
             void process();
 
-            void createDB(char* dbName);
+            void createDB(char* dbName,uint blockSize = STD_BLOCKSIZE);
             void dropDB(char* dbName);
             void connectTo(char* dbName);
             void disconnect();
@@ -30,10 +37,43 @@ namespace HubDB{
             void createIndex(const QualifiedName & qname,char * type);
             void dropIndex(const QualifiedName & qname);
             bool insertInto(char * table,DBTuple * values,bool print=true);
+            /**
+             * INSERT mit mehreren Zeilen: alle Zeilen werden geprüft, bevor die erste
+             * geschrieben wird, und wie beim IMPORT mit DBBulkLoad angehängt. Schlägt
+             * eine Zeile fehl, werden die bereits eingefügten wieder entfernt.
+             */
+            bool insertInto(char * table,DBListTuple * values,bool print=true);
             void deleteFromTable(char * table,DBListPredicate * where);
             void importTab(char* fileName, char *table);
             void exportTab(char *table,char * fileName);
-            void select(DBListQualifiedName * projection,char * relName,DBJoin * join,DBListPredicate * where);
+            /**
+             * Berechnet die Statistik der Tabelle (Anzahl Tupel und Seiten, verschiedene
+             * Werte und Histogramme je Attribut) und legt sie im Systemkatalog ab.
+             * Die Kostenschätzung der Anfragen verwendet sie, sobald sie vorhanden ist.
+             */
+            void analyzeTable(char * table);
+            /**
+             * Gilt für die nächste Anfrage (SELECT oder DELETE): mit EXPLAIN_PLAN wird
+             * statt des Ergebnisses der Operatorbaum ausgegeben, mit EXPLAIN_ANALYZE wird
+             * die Anfrage ausgeführt und je Operator die gelieferten Zeilen, fixierten
+             * Seiten, Fehlzugriffe im Buffer und die Zeit ausgegeben (siehe DBProfileOp).
+             * Beim Planen werden keine Tupel gelesen, die Operatoren lesen ihre Eingaben
+             * erst beim Öffnen.
+             */
+            void setExplainMode(ExplainModeEnum mode){ explainMode = mode;};
+            /**
+             * Gibt die Zeilen der Anfrage aus. Enthält die Projektion Aggregatfunktionen
+             * oder ist groupBy gesetzt, werden die Zeilen gruppiert (DBHashAggregateOp);
+             * nicht aggregierte Attribute der Projektion müssen dann gruppiert sein.
+             * Mit limit wird nach einem Heap der besten limit Zeilen sortiert (DBTopNOp),
+             * sonst extern (DBSortOp) oder, falls möglich, entlang eines geordneten Indexes.
+             * @param projection NULL für alle Attribute
+             * @param groupBy NULL ohne GROUP BY
+             * @param orderBy NULL ohne ORDER BY
+             * @param limit höchstens so viele Zeilen ausgeben, negativ ohne LIMIT
+             */
+            void select(DBListSelectItem * projection,char * relName,DBJoin * join,DBListPredicate * where,DBListQualifiedName * groupBy,
+                        DBOrderBy * orderBy,int limit);
 
         protected:
 
@@ -63,12 +103,96 @@ namespace HubDB{
              */
             virtual void selectJoinTuple(DBTable * table[2],uint attrJoinPos[2],DBListPredicate where[2],DBListJoinTuple & tuples) = 0;
 
+            /**
+             * Erzeugt den Operatorbaum, der die Tupel der Tabelle liefert, welche
+             * alle Selektionsprädikate erfüllen. Die Standardimplementierung
+             * berechnet das Ergebnis beim Öffnen mit selectTuple() vollständig
+             * (DBDeferredOp); da selectTuple() ganze Tupel liefert, ignoriert sie
+             * attrMask. table und where müssen bis zur Freigabe gültig bleiben.
+             * Der Aufrufer gibt den Operator frei.
+             * @param table
+             * @param where
+             * @param attrMask Positionen der Attribute, die der Aufrufer benötigt; die übrigen
+             * Attribute muss der Operator nicht dekodieren (siehe DBTuple::read())
+             * @return Operator, dessen Zeilen nur das erste Tupel belegen
+             */
+            virtual DBOperator * scanOperator(DBTable * table,DBListPredicate & where,uint attrMask = ALL_ATTRS);
+
+            /**
+             * Erzeugt den Operatorbaum, der die Paare von Join-Partner-Tupeln liefert
+             * (siehe selectJoinTuple()). Die Standardimplementierung berechnet das
+             * Ergebnis beim Öffnen mit selectJoinTuple() vollständig und ignoriert attrMask.
+             * Der Aufrufer gibt den Operator frei.
+             * @param table
+             * @param attrJoinPos
+             * @param where
+             * @param attrMask je Tabelle die benötigten Attribute (siehe scanOperator())
+             * @return Operator, dessen Zeilen Tupelpaare (links, rechts) sind
+             */
+            virtual DBOperator * joinOperator(DBTable * table[2],uint attrJoinPos[2],DBListPredicate where[2],uint attrMask[2]);
+
+            /**
+             * Erzeugt einen Operator wie scanOperator(), der die Tupel aber aufsteigend
+             * nach dem Attribut an Position attrPos liefert, ohne sie zu sortieren
+             * (z.B. entlang eines geordneten Indexes). Die Standardimplementierung liest
+             * einen geordneten Index auf dem Attribut mit DBOrderedIndexScanOp, sofern kein
+             * Prädikat über einen Index schneller beantwortet werden kann.
+             * Der Aufrufer gibt den Operator frei.
+             * @param table
+             * @param where
+             * @param attrPos
+             * @param attrMask
+             * @return NULL, falls die Reihenfolge nicht ohne Sortieren hergestellt werden kann
+             */
+            virtual DBOperator * orderedScanOperator(DBTable * table,DBListPredicate & where,uint attrPos,uint attrMask = ALL_ATTRS);
+
+            /**
+             * Beantwortet eine Selektion allein aus dem Index, falls alle Prädikate
+             * das indizierte Attribut an Position attrPos betreffen. Da nur dieses
+             * Attribut ausgegeben wird, genügt die Anzahl der Treffer im Index;
+             * Tabellenseiten werden nicht gelesen.
+             * @param table
+             * @param attrPos
+             * @param where
+             * @param cnt Rückgabe: Anzahl der Treffer
+             * @return false, falls die Selektion nicht aus dem Index beantwortet werden kann
+             */
+            bool selectIndexOnly(DBTable * table,uint attrPos,DBListPredicate & where,uint & cnt);
+
+            /**
+             * Zählt die Tupel der Tabelle allein anhand eines geordneten Indexes
+             * (siehe DBIndex::openOrderedCursor()), ohne Tabellenseiten zu lesen.
+             * @param table
+             * @param cnt Rückgabe: Anzahl der Tupel
+             * @return false, falls kein Attribut der Tabelle einen geordneten Index besitzt
+             */
+            bool countIndexOnly(DBTable * table,uint & cnt);
+
+            /**
+             * Entfernt die Tupel aus der Tabelle und ihren Indexen
+             * @return Anzahl der entfernten Tupel
+             */
+            uint removeTuples(DBTable * table,char * tableName,DBListPredicate * where,DBListTuple & tupleList);
+
+            // füllt den neu angelegten Index des Attributs qname mit den Tupeln der Tabelle
+            void fillIndex(const QualifiedName & qname);
+
+            // prüft Typ und Länge der Werte eines einzufügenden Tupels
+            void checkValues(const DBRelDef & relDef,const DBTuple & value);
+
+            /**
+             * Gibt für EXPLAIN den Plan aus (siehe DBOperator::explainTree()),
+             * bei EXPLAIN_ANALYZE gefolgt von den Kosten des Planens und der Ausführung
+             */
+            void printPlan(ExplainModeEnum explain,const string & plan,const DBProfile & planning,const DBProfile & execution);
+
         protected:
             DBServerSocket & socket;
             DBSysCatMgr & sysCatMgr;
             string connectDB;
             bool isConnected;
             DBBACB * sysCatHdl;
+            ExplainModeEnum explainMode;
 
         private:
             static LoggerPtr logger;
@@ -10,76 +10,102 @@ namespace HubDB{
     namespace Index{
 
         struct IndexEntries {
-            std::shared_ptr<DBAttrType> attr;   // raw Attribute-Data
+            std::string key;          // normalisierter Schlüssel (siehe DBAttrType::normalizedKey())
             std::vector<TID> tidList; // Array of tids
 
-            IndexEntries( std::shared_ptr<DBAttrType> attr, std::vector<TID> tids) :
-              attr(attr), tidList(tids) {
+            IndexEntries( const std::string & key, std::vector<TID> tids) :
+              key(key), tidList(tids) {
             }
 
-            IndexEntries( std::shared_ptr<DBAttrType> attr, TID tids) :
-                    attr(attr) {
+            IndexEntries( const std::string & key, TID tids) :
+                    key(key) {
               tidList.push_back(tids);
             }
         };
 
         struct SequentialIndex {
-            uint countEntries;      // number of entries / position of first free entry
+            uint countEntries;      // number of entries
             std::vector<IndexEntries> entries; // Array of Entries
 
             // File Layout:
-            // Pointer auf erste freie Stelle | Value (DBAttrType) | TID-Liste (#tidsPerEntry)
+            // Anzahl Einträge | Länge Präfix | gemeinsamer Präfix aller Schlüssel der Seite |
+            // Einträge (Länge Suffix | Suffix | Anzahl TIDs | TIDs)
+            //
+            // Bei Schlüsseln fester Länge (keyLen > 0) entfällt die Länge des Suffix,
+            // bei unique-Indexen (tidsPerEntry == 1) die Anzahl der TIDs.
+
+            size_t prefixLength() const {
+              if (entries.empty())
+                return 0;
+              const std::string & first = entries.front().key;
+              const std::string & last = entries.back().key;
+              size_t n = 0;
+              while (n < first.size() && n < last.size() && first[n] == last[n])
+                ++n;
+              return n;
+            }
+
+            size_t encodedSize(size_t keyLen, uint tidsPerEntry) const {
+              size_t prefix = prefixLength();
+              size_t size = sizeof(uint) + 1 + prefix;
+              for (auto & e : entries) {
+                size += (keyLen == 0 ? 1 : 0) + e.key.size() - prefix;
+                size += (tidsPerEntry == 1 ? 0 : 1) + sizeof(TID) * e.tidList.size();
+              }
+              return size;
+            }
 
-            char* write(char* ptr, const AttrTypeEnum& attrType, uint tidsPerEntry) const {
+            char* write(char* ptr, size_t keyLen, uint tidsPerEntry) const {
               uint *count = (uint *) ptr;
               *count = countEntries;
-
-              // Pointer, um eine Position vorrücken
               ptr += sizeof(uint);
 
-              for (auto e : entries) {
-                // Zuerst der Wert
-                const char *ptrNext = 0;
-                ptr = e.attr->write(ptr);
-
-                // Die TID-Liste
-                TID *tidList = (TID *) ptr;
-                uint id = 0;
-                for (auto tid : e.tidList) {
-                  tidList[id] = tid;
-                  id++;
-                }
-                // restlichen Positionen mit invalid füllen
-                for (id; id < tidsPerEntry; id++) {
-                  tidList[id] = invalidTID;
-                }
-
-                ptr += (sizeof(TID) * tidsPerEntry);
+              // der Präfix wird nur einmal pro Seite gespeichert
+              size_t prefix = prefixLength();
+              *ptr++ = (char) prefix;
+              if (prefix > 0) {
+                memcpy(ptr, entries.front().key.data(), prefix);
+                ptr += prefix;
+              }
+
+              for (auto & e : entries) {
+                size_t suffix = e.key.size() - prefix;
+                if (keyLen == 0)
+                  *ptr++ = (char) suffix;
+                memcpy(ptr, e.key.data() + prefix, suffix);
+                ptr += suffix;
+
+                if (tidsPerEntry != 1)
+                  *ptr++ = (char) e.tidList.size();
+                memcpy(ptr, e.tidList.data(), sizeof(TID) * e.tidList.size());
+                ptr += sizeof(TID) * e.tidList.size();
               }
+              return ptr;
             }
 
-            static std::shared_ptr<SequentialIndex> read(const char* ptr, AttrTypeEnum& attrType, uint tidsPerEntry) {
+            static std::shared_ptr<SequentialIndex> read(const char* ptr, size_t keyLen, uint tidsPerEntry) {
               std::shared_ptr<SequentialIndex> s(new SequentialIndex());
 
               s->countEntries = *(uint*) ptr;
               ptr += sizeof(uint);
 
+              size_t prefix = (unsigned char) *ptr++;
+              std::string prefixKey(ptr, prefix);
+              ptr += prefix;
+
+              s->entries.reserve(s->countEntries);
               for (uint i = 0; i < s->countEntries; i++) {
-                std::shared_ptr<DBAttrType> attr(DBAttrType::read(ptr, attrType, &ptr)); // deleted by shared pointer
-
-                TID *tidList = (TID *) ptr;
-                std::vector<TID> tidVector;
-                for (uint id = 0; id < tidsPerEntry; id++) {
-                  if (tidList[id] == invalidTID) {
-                    break;
-                  }
-                  else {
-                    tidVector.push_back(tidList[id]);
-                  }
-                }
-
-                s->entries.push_back(IndexEntries(attr, tidVector)); // moves temporary into vector
-                ptr += sizeof(TID) * tidsPerEntry;
+                size_t suffix = keyLen == 0 ? (unsigned char) *ptr++ : keyLen - prefix;
+                std::string key(prefixKey);
+                key.append(ptr, suffix);
+                ptr += suffix;
+
+                uint cnt = tidsPerEntry == 1 ? 1 : (unsigned char) *ptr++;
+                std::vector<TID> tidVector(cnt);
+                for (uint t = 0; t < cnt; t++)
+                  ptr = tidVector[t].read(ptr);
+
+                s->entries.push_back(IndexEntries(key, tidVector)); // moves temporary into vector
               }
 
               return s;
@@ -104,6 +130,13 @@ namespace HubDB{
             void insert(const DBAttrType & val,const TID & tid);
             void remove(const DBAttrType & valToRemove, const DBListTID & tidsToRemove);
 
+            void openCursor(const DBAttrType & val);
+            bool nextBatch(DBTIDBatch & tids,uint maxTids = STD_TID_BATCH);
+            void closeCursor();
+
+            bool openOrderedCursor();
+            bool nextOrdered(std::string & key,DBTIDBatch & tids);
+
             static int registerClass();
 
         private:
@@ -112,29 +145,37 @@ namespace HubDB{
             // Einträge (TIDs) pro Schlüsseleintrag
             // (maximal MAX_TID_PER_ENTRY or 1 when unique): tidsPerEntry
             const uint tidsPerEntry;
-            bool findFirstPage(const DBAttrType & val,BlockNo & blockNo);
-            uint entriesPerPage()const;
+            const size_t keyLen; // Länge der normalisierten Schlüssel, 0: variabel
+            bool findFirstPage(const std::string & key,BlockNo & blockNo);
+            size_t maxEntrySize()const;
 
             bool isEmpty(const char * ptr);
             void insertEmptyPage(BlockNo blockNo);
             void removeEmptyPage(BlockNo blockNoToRemove);
-            void insertInPage(const DBAttrType & valToInsert, const TID & tidToInsert, BlockNo blockNo);
-            void splitPage(BlockNo &blockNo, uint &posToInsert, bool &unfix);
-            void findFromPage(const DBAttrType & val,BlockNo pos,list<TID> & tidsFound);
-            void removeFromPage(const DBAttrType & valToRemove, list<TID> tidsToRemove, BlockNo startBlockNo);
+            void insertInPage(const std::string & keyToInsert, const TID & tidToInsert, BlockNo blockNo);
+            void splitPage(BlockNo &blockNo, SequentialIndex & index);
+            void findFromPage(const std::string & key,BlockNo pos,list<TID> & tidsFound);
+            void removeFromPage(const std::string & keyToRemove, list<TID> tidsToRemove, BlockNo startBlockNo);
             void unfixBACBs(bool dirty);
 
             DBBACB& fixNonRootBlock(const BlockNo & blockNo, const DBBCBLockMode & mode);
             void unfixNonRootBlock(const DBBACB & dbbacb);
 
             void checkBacbStackInvariant();
-            size_t getEntrySize() const;
 
             static LoggerPtr logger;
             static const BlockNo rootBlockNo;
 
             stack<DBBACB> bacbStack; // Der bacbStack speichert immer den Root-Block der Datei
 
+            // Zustand des Cursors: gesuchter Schlüssel, aktuelle Seite,
+            // aktueller Eintrag auf dieser Seite und Position in dessen TID-Liste
+            bool cursorOpen;
+            std::string cursorKey;
+            BlockNo cursorBlockNo;
+            uint cursorEntry;
+            uint cursorTidPos;
+
 
         };
     }
@@ -15,7 +15,25 @@ namespace HubDB{
 
             static int registerClass();
 
+        protected:
+            DBOperator * scanOperator(DBTable * table,DBListPredicate & where,uint attrMask = ALL_ATTRS);
+            DBOperator * joinOperator(DBTable * table[2],uint attrJoinPos[2],DBListPredicate where[2],uint attrMask[2]);
+
         private:
+            enum JoinAlgoEnum{
+                JOIN_INDEX_MERGE,
+                JOIN_INDEX_NESTED_LOOP,
+                JOIN_HASH
+            };
+
+            double accessPath(DBTable * table,DBListPredicate & where,const DBTableStats & stats,vector<DBPredicate *> & indexPreds,double & estRows);
+            DBOperator * indexAccess(DBTable * table,DBListPredicate & where,uint attrMask,const vector<DBPredicate *> & indexPreds);
+            JoinAlgoEnum joinPlan(DBTable * table[2],uint attrJoinPos[2],DBListPredicate where[2],const DBTableStats stats[2],uint & side,double & estRows);
+            static double fetchCost(double pages,double rows);
+            static double indexCost(double rows,uint blockSize);
+            void fetchTuples(DBTable * table,DBListPredicate & where,uint attrMask,DBListTuple & tuples);
+            DBOperator * indexMergeJoin(DBTable * table[2],uint attrJoinPos[2],uint attrMask[2]);
+
             static LoggerPtr logger;
         };
     }
@@ -0,0 +1,107 @@
+#ifndef DBSLOTTEDTABLE_H_
+#define DBSLOTTEDTABLE_H_
+
+#include <hubDB/DBTable.h>
+
+namespace HubDB{
+    namespace Table{
+
+        /**
+         * Tabelle mit Sätzen variabler Länge (CREATE TABLE ... SLOTTED).
+         *
+         * Jede Seite enthält nach dem Seitenkopf ein Slotverzeichnis, die Sätze
+         * wachsen vom Seitenende nach vorn. VarChar-Werte belegen nur ihre Länge
+         * (siehe DBTuple::writeRecord()). Die TID eines Tupels ist seine Seite und
+         * sein Slot; gelöschte Sätze hinterlassen Lücken, die beim Einfügen durch
+         * Verschieben der Sätze innerhalb der Seite zusammengefasst werden.
+         *
+         * Ein Satz ist höchstens maxRecordSize() Bytes lang. Längere Tupel lagern
+         * ihre längsten VarChar-Werte in eine Überlaufdatei aus, wo sie als Kette
+         * von Seiten stehen; im Satz bleibt nur ein Verweis.
+         *
+         * Satzformat: hat Überlaufwerte (1 Byte) | Attribute, ein ausgelagerter
+         * Wert ist OVERFLOW_LEN (2 Byte) | overflowRef
+         */
+        class DBSlottedTable : public DBTable
+        {
+            struct slottedPageLayout{
+                uint tupleCnt;       // belegte Slots
+                uint slotCnt;        // Einträge im Slotverzeichnis
+                uint dataStart;      // erstes Byte der Sätze
+                uint freeBytes;      // freie Bytes einschließlich der Lücken gelöschter Sätze
+            };
+
+            struct slotEntry{
+                uint16_t offset;     // 0: Slot ist frei
+                uint16_t len;
+            };
+
+            struct overflowRef{
+                uint len;
+                BlockNo first;
+            };
+
+            // Block 0 der Überlaufdatei, freie Seiten bilden eine Kette
+            struct overflowInfoPage{
+                BlockNo freeList;    // 0: keine freie Seite
+            };
+
+            // gefolgt von len Zeichen des Werts
+            struct overflowPageLayout{
+                BlockNo next;        // 0: letzte Seite der Kette
+                uint len;
+            };
+
+        public:
+            DBSlottedTable(DBBufferMgr & bufMgr,DBFile & file,DBFile & fsmFile,DBFile & overflowFile,const DBRelDef & rel,ModType mode,DBFile * zoneFile = NULL);
+
+            static void initializeTable(DBBufferMgr & bufMgr,DBFile & file);
+
+            /**
+             * Fügt das Tupel auf einer Seite ein, die laut DBFreeSpaceMap Platz für
+             * einen Satz maximaler Länge hat, sonst auf der letzten Seite, falls es
+             * dort Platz findet, sonst auf einer neuen Seite
+             */
+            void insert(DBTuple & tuple);
+            void remove(const DBListTID & tidList);
+            void append(DBTuple & tuple);
+
+            /**
+             * Wie DBTable::readSeqFromTID(), die Prädikate werden auf den dekodierten
+             * Tupeln geprüft; dazu werden auch ihre Attribute dekodiert
+             */
+            TID readSeqFromTID(TID tid,
+                               uint numOfTuples,
+                               DBListTuple & tupleList,
+                               DBListPredicate * where = NULL,
+                               uint attrMask = ALL_ATTRS);
+
+            // Schätzung für die Kostenrechnung, VarChar-Werte mit höchstens MAX_STR_LEN Zeichen
+            uint tuplesPerPage();
+
+        protected:
+            size_t maxRecordSize();
+            bool hasFreeSpace(const DBBACB & bacb);
+            static void initPage(char * ptr,uint blockSize);
+            bool hasRoom(const char * ptr,size_t len);
+            uint placeRecord(DBTuple & tuple);
+            void compactPage(char * ptr);
+            const char * getRecord(const char * ptr,uint slot);
+            void encode(const DBTuple & tuple);
+            void decode(const char * ptr,DBTuple & tuple,uint attrMask);
+            void readTuple(const DBBACB & bacb,const TID & tid,DBTuple & tuple,uint attrMask);
+            void summarizePage(const DBBACB & bacb);
+            BlockNo writeOverflow(const string & val);
+            string readOverflow(const overflowRef & ref);
+            void freeOverflow(const char * rec);
+            void freeChain(BlockNo first);
+
+            static const uint16_t OVERFLOW_LEN;
+            static LoggerPtr logger;
+            DBFile & overflowFile;
+            vector<char> rec;    // zuletzt kodierter Satz
+        };
+    }
+}
+
+#endif // DBSLOTTEDTABLE_H_
@@ -0,0 +1,95 @@
+#ifndef DBSTATISTICS_H_
+#define DBSTATISTICS_H_
+
+#include <hubDB/DBTypes.h>
+
+#include <stdint.h>
+
+using namespace HubDB::Types;
+
+namespace HubDB{
+    namespace Manager{
+
+        /**
+         * Schätzt die Anzahl verschiedener Werte mit HyperLogLog. Jeder Hashwert wählt
+         * mit seinen oberen HLL_REGISTER_BITS Bits ein Register, das die längste
+         * Folge führender Nullen der übrigen Bits speichert.
+         */
+        class DBHyperLogLog
+        {
+        public:
+            DBHyperLogLog();
+            void add(size_t hash);
+            double estimate() const;
+
+        protected:
+            vector<uint8_t> registers;
+        };
+
+        /**
+         * Statistik eines Attributs: geschätzte Anzahl verschiedener Werte und ein
+         * Histogramm gleicher Tiefe. Die Grenzen sind normalisierte Schlüssel
+         * (siehe DBAttrType::normalizedKey()); bounds[0] ist das Minimum, bounds[b+1]
+         * die obere Grenze von Eimer b. Jeder Eimer enthält gleich viele Tupel.
+         */
+        struct DBAttrStats{
+            uint distinct;
+            vector<string> bounds;
+        };
+
+        /**
+         * Statistik einer Tabelle, von ANALYZE berechnet und im Systemkatalog abgelegt
+         */
+        class DBTableStats
+        {
+        public:
+            DBTableStats():rowCnt(0),pageCnt(0){};
+            string toString(string linePrefix="") const;
+
+            /**
+             * Anzahl Tupel, hochgerechnet auf die aktuelle Seitenzahl der Tabelle
+             */
+            double rows(uint curPageCnt) const;
+
+            /**
+             * Geschätzter Anteil der Tupel mit dem Wert val im Attribut attrPos.
+             * Ein Wert, der Grenze mehrerer Eimer ist, ist häufig; sonst wird
+             * Gleichverteilung über die verschiedenen Werte angenommen.
+             */
+            double selectivity(uint attrPos,const DBAttrType & val) const;
+
+            /**
+             * Geschätzter Anteil der Tupel, die alle Prädikate erfüllen (unabhängig angenommen)
+             */
+            double selectivity(const DBRelDef & rel,DBListPredicate & where) const;
+
+            uint rowCnt;
+            uint pageCnt;
+            vector<DBAttrStats> attrs;
+        };
+
+        /**
+         * Berechnet die Statistik einer Tabelle in einem Durchlauf: die Anzahl
+         * verschiedener Werte mit je einem DBHyperLogLog pro Attribut, die Histogramme
+         * aus einer Stichprobe (reservoir sampling) von STAT_SAMPLE_TUPLES Tupeln.
+         */
+        class DBStatsCollector
+        {
+        public:
+            DBStatsCollector(const DBRelDef & rel);
+            void add(const DBTuple & tuple);
+            void finish(uint pageCnt,DBTableStats & stats);
+
+        protected:
+            uint64_t nextRandom();
+
+            const uint attrCnt;
+            uint rowCnt;
+            uint64_t seed;
+            vector<DBHyperLogLog> hll;
+            vector< vector<string> > sample;   // je Attribut die Schlüssel der Stichprobe
+        };
+    }
+}
+
+#endif // DBSTATISTICS_H_
@@ -7,6 +7,9 @@
 #include <hubDB/DBTypes.h>
 #include <hubDB/DBIndex.h>
 #include <hubDB/DBTable.h>
+#include <hubDB/DBSlottedTable.h>
+#include <hubDB/DBTempFile.h>
+#include <hubDB/DBStatistics.h>
 
 using namespace HubDB::Types;
 using namespace HubDB::Manager;
@@ -22,15 +25,37 @@ namespace HubDB{
                 uint blockSize;
             };
 
+            // Statistikdatei: erste Seite, danach eine Seite pro Attribut
+            struct statInfoPage{
+                uint rowCnt;
+                uint pageCnt;
+                uint attrCnt;
+            };
+
+            // gefolgt von boundCnt Grenzen zu je DBAttrType::getSize4Type() Bytes
+            struct statAttrPage{
+                uint distinct;
+                uint boundCnt;
+            };
+
         public:
             DBSysCatMgr (bool doMonitor,string bufferMgrName,bool doThreading);
             ~DBSysCatMgr ( );
             string toString(string linePrefix="") const;
 
-            void createDB(string dbName);
+            /**
+             * Legt die Datenbank mit der Seitengröße blockSize an; alle Dateien ihrer
+             * Tabellen und Indexe verwenden diese Seitengröße, der Systemkatalog
+             * selbst immer STD_BLOCKSIZE
+             */
+            void createDB(string dbName,uint blockSize = STD_BLOCKSIZE);
             void dropDB(string dbName);
             void disconnect(DBBACB * hdl);
+            // prüft auch, ob die Seitengröße der Datenbank unterstützt wird
             DBBACB * connectTo(string dbName);
+            uint getBlockSize(const string dbName);
+            // Zweierpotenz von STD_BLOCKSIZE bis MAX_BLOCKSIZE
+            static bool isValidBlockSize(uint blockSize);
             void listTables(string dbName,list<string> & tableNames);
             DBRelDef getSchemaForTable (const string dbName,string relationName );
 
@@ -42,15 +67,43 @@ namespace HubDB{
             void dropIndex(string dbName,const QualifiedName & qname);
             DBIndex * openIndex(const string dbName,const QualifiedName & qname,ModType mode);
 
+            DBTempFile * createTempFile(const string dbName,const DBRelDef & rel);
+
+            /**
+             * Legt die Statistik einer Tabelle (siehe ANALYZE) in einer eigenen Datei
+             * neben der Tabelle ab; eine vorhandene Statistik wird überschrieben.
+             */
+            void writeStatistics(const string dbName,const string relName,const DBTableStats & stats);
+
+            /**
+             * @return false, falls die Tabelle noch nicht analysiert wurde
+             */
+            bool readStatistics(const string dbName,const string relName,DBTableStats & stats);
+
             bool doMonitor(){ return DBMonitorMgr::getMonitorPtr()!= NULL ? true : false;};
 
+            // Zähler des Buffer-Managers (siehe DBBufferMgr::getFixCnt())
+            uint getFixCnt() const { return bufMgr->getFixCnt();};
+            uint getReadCnt() const { return bufMgr->getReadCnt();};
+
         protected:
 
-            void initialize(DBFile & file);
+            void initialize(DBFile & file,uint blockSize);
+            // öffnet eine Datei der Datenbank mit deren Seitengröße
+            DBFile & openDBFile(const string dbName,const string fileName);
+            DBFile & openZoneMap(const string dbName,const string relName);
+            void dropZoneMap(const string dbName,const string relName);
+            DBFile & openFreeSpaceMap(const string dbName,const string relName);
+            void dropFreeSpaceMap(const string dbName,const string relName);
+            DBFile & openOverflow(const string dbName,const string relName);
+            void dropOverflow(const string dbName,const string relName);
+            void dropStatistics(const string dbName,const string relName);
 
             static LoggerPtr logger;
             static const BlockNo rootBlockNo;
             DBBufferMgr * bufMgr;
+            uint tempFileCnt;
+            map<string,uint> blockSizes;  // Seitengröße je Datenbank, gemerkt bei connectTo()
         };
     }
     namespace Exception{
@@ -0,0 +1,100 @@
+#ifndef DBTIDBITMAP_H_
+#define DBTIDBITMAP_H_
+
+#include <hubDB/DBTypes.h>
+
+#include <stdint.h>
+
+namespace HubDB{
+    namespace Types{
+
+        /**
+         * Ein Container enthält alle Slots einer Tabellenseite (wie bei Roaring-Bitmaps).
+         * Wenige Slots werden als sortiertes Array gespeichert, viele als Bitmap aus
+         * 64-Bit-Worten. Es wird jeweils die kleinere Darstellung gewählt.
+         */
+        class DBTIDContainer{
+        public:
+            DBTIDContainer(BlockNo page=0):page(page),card(0){};
+
+            BlockNo getPage()const{ return page;};
+            uint cardinality()const{ return card;};
+            bool isBitmap()const{ return !words.empty();};
+
+            bool add(uint slot);
+            bool remove(uint slot);
+            bool contains(uint slot)const;
+
+            void andWith(const DBTIDContainer & ref);
+            void orWith(const DBTIDContainer & ref);
+
+            /**
+             * Schreibt die Slots ab Position pos (Index im Array bzw. Bitnummer)
+             * als TIDs in den Puffer, bis dieser maxTids Einträge enthält.
+             * @return Position, an der weitergelesen werden muss
+             */
+            uint extract(uint pos,DBTIDBatch & tids,uint maxTids)const;
+
+            // Seitenformat: page | form (0: Array, 1: Bitmap) | Anzahl | Slots bzw. Worte
+            size_t encodedSize()const;
+            char * write(char * ptr)const;
+            const char * read(const char * ptr);
+
+        private:
+            void toBitmap();
+            void toArray();
+            void optimize();
+
+            BlockNo page;
+            uint card;
+            vector<uint16_t> slots;   // Array-Container (sortiert)
+            vector<uint64_t> words;   // Bitmap-Container
+        };
+
+        /**
+         * Komprimierte Menge von Tupelidentifikatoren: ein Container pro Tabellenseite,
+         * nach Seitennummer sortiert. Schnittmenge und Vereinigung arbeiten containerweise,
+         * Bitmap-Container werden wortweise (mit SSE2, falls verfügbar) verknüpft.
+         * Die TIDs werden in Seitenreihenfolge geliefert.
+         */
+        class DBTIDBitmap{
+        public:
+            struct Position{
+                size_t container;
+                uint offset;
+                Position():container(0),offset(0){};
+            };
+
+            bool add(const TID & tid);
+            bool remove(const TID & tid);
+            bool contains(const TID & tid)const;
+
+            bool empty()const{ return containers.empty();};
+            uint cardinality()const;
+            void clear(){ containers.clear();};
+            void swap(DBTIDBitmap & ref){ containers.swap(ref.containers);};
+
+            void andWith(const DBTIDBitmap & ref);
+            void orWith(const DBTIDBitmap & ref);
+
+            /**
+             * Fügt einen Container hinzu. Gibt es bereits einen Container für
+             * dieselbe Seite, werden beide vereinigt.
+             */
+            void addContainer(const DBTIDContainer & c);
+
+            bool nextBatch(Position & pos,DBTIDBatch & tids,uint maxTids = STD_TID_BATCH)const;
+            void toList(DBListTID & tids)const;
+
+            string toString(string linePrefix="")const;
+
+        private:
+            vector<DBTIDContainer>::iterator findContainer(BlockNo page);
+            vector<DBTIDContainer>::const_iterator findContainer(BlockNo page)const;
+
+            vector<DBTIDContainer> containers;
+        };
+    }
+}
+
+#endif /*DBTIDBITMAP_H_*/
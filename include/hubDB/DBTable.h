@@ -3,6 +3,8 @@
 
 #include <hubDB/DBBufferMgr.h>
 #include <hubDB/DBFile.h>
+#include <hubDB/DBZoneMap.h>
+#include <hubDB/DBFreeSpaceMap.h>
 
 using namespace HubDB::File;
 using namespace HubDB::Manager;
@@ -13,52 +15,108 @@ namespace HubDB{
         class DBTable
         {
             struct tablePageLayout{
-                BlockNo nextFreeBlock;
+                uint tupleCnt;       // CNT_VALID | belegte Slots, ohne CNT_VALID unbekannt (ältere Seiten)
                 uint slotUsedMask[1];
             };
 
         public:
-            DBTable(DBBufferMgr & bufMgr,DBFile & file,const DBRelDef & rel,ModType mode);
-            ~DBTable();
+            DBTable(DBBufferMgr & bufMgr,DBFile & file,DBFile & fsmFile,const DBRelDef & rel,ModType mode,DBFile * zoneFile = NULL);
+            virtual ~DBTable();
             string toString(string linePrefix="");
 
             static void initializeTable(DBBufferMgr & bufMgr,DBFile & file);
 
-            void insert(DBTuple & tuple);
-
-            void remove(const DBListTID & tidList);
-
-            void readTIDs(const DBListTID & tids,DBListTuple & tupleList);
-
-            TID readSeqFromTID(TID tid,
+            /**
+             * Fügt das Tupel auf einer Seite ein, die laut DBFreeSpaceMap freien Platz
+             * hat, sonst auf einer neuen Seite. Die Wurzelseite wird nur exklusiv
+             * gesperrt, wenn das Tupel auf ihr liegt.
+             */
+            virtual void insert(DBTuple & tuple);
+
+            virtual void remove(const DBListTID & tidList);
+
+            /**
+             * Hängt das Tupel für einen Massenimport an: die zuletzt beschriebene
+             * Seite bleibt fixiert und wird der Reihe nach gefüllt, danach wird eine
+             * neue Seite angelegt. Freie Plätze älterer Seiten werden nicht gesucht.
+             * endAppend() gibt die Seite wieder frei, vorher sind insert(), remove()
+             * und das Lesen der Tabelle nicht erlaubt.
+             */
+            virtual void append(DBTuple & tuple);
+            void endAppend();
+
+            /**
+             * Liest die Tupel zu den TIDs; dekodiert werden nur die Attribute,
+             * deren Position in attrMask gesetzt ist (siehe DBTuple::read())
+             */
+            void readTIDs(const DBListTID & tids,DBListTuple & tupleList,uint attrMask = ALL_ATTRS);
+
+            /**
+             * Wie oben. Die TIDs werden nach Seiten sortiert gelesen, jede Seite wird
+             * nur einmal fixiert; die nächsten STD_PREFETCH_PAGES Seiten werden
+             * vorher mit DBBufferMgr::prefetchBlock() angekündigt. Mit keepOrder
+             * stehen die Tupel in der Reihenfolge der TIDs, sonst nach Seite und Slot.
+             */
+            void readTIDs(const DBTIDBatch & tids,DBListTuple & tupleList,uint attrMask = ALL_ATTRS,bool keepOrder = true);
+
+            /**
+             * Liest sequentiell ab tid. Ist where angegeben, werden Seiten übersprungen,
+             * auf denen laut Zone-Map kein Tupel alle Prädikate erfüllen kann, und nur
+             * Tupel geliefert, die alle Prädikate erfüllen (geprüft auf den Seitenbytes,
+             * siehe DBPageFilter). Weniger als numOfTuples Tupel werden nur am Ende geliefert.
+             * Dekodiert werden nur die Attribute, deren Position in attrMask gesetzt ist.
+             */
+            virtual TID readSeqFromTID(TID tid,
                                uint numOfTuples,
-                               DBListTuple & tupleList);
+                               DBListTuple & tupleList,
+                               DBListPredicate * where = NULL,
+                               uint attrMask = ALL_ATTRS);
 
-            uint tuplesPerPage();
+            virtual uint tuplesPerPage();
             uint getPageCnt() const { return bufMgr.getBlockCount(file); }
+            uint getBlockSize() const { return file.getBlockSize(); }
 
             void undo();
 
             const DBRelDef & getRelDef(){return rel;};
 
         protected:
-            uint findFreeSlot(uint * slotMask,uint max);
+            uint findFreeSlot(const uint * slotMask,uint max);
+            uint64_t maskWord(const uint * slotMask,uint w);
+            uint getTupleCnt(const tablePageLayout * page);
             uint slotMaskCnt;
             size_t _sizeOfPage;
             void unfixBACBs(bool dirty);
             void assertUnique(DBTuple & tuple);
+            void placeTuple(uint pos,DBTuple & tuple);
+            void loadUniqueKeys();
             void setSlot(uint * slotMask,uint pos);
             void unsetSlot(uint * slotMask,uint pos);
-            bool isSlot(uint * slotMask,uint pos);
+            bool isSlot(const uint * slotMask,uint pos);
             size_t sizeOfPage(){ return _sizeOfPage;};
+            void summarizePage(const DBBACB & bacb);
+            // Seite mit freiem Platz, deren Bit in der DBFreeSpaceMap gesetzt wird
+            virtual bool hasFreeSpace(const DBBACB & bacb);
+            void buildFreeSpaceMap();
+            // dekodiert das Tupel zu tid aus der fixierten Seite bacb
+            virtual void readTuple(const DBBACB & bacb,const TID & tid,DBTuple & tuple,uint attrMask);
+            void fixPage(BlockNo blockNo);
+            void unfixPage();
 
             static const BlockNo rootBlockNo;
+            static const uint CNT_VALID;
             static LoggerPtr logger;
             DBBufferMgr & bufMgr;
             DBFile & file;
             const DBRelDef rel;
             stack<DBBACB> bacbStack;
             const ModType mode;
+            DBZoneMap * zoneMap;
+            DBFreeSpaceMap fsm;
+            vector<uint> uniqueAttrs;                    // eindeutige Attribute ohne Index
+            vector< unordered_set<string> > uniqueKeys;  // deren normalisierte Schlüssel
+            bool uniqueKeysLoaded;                       // erst beim ersten insert() gelesen
+            bool appendNewPage;                          // append() hat die fixierte Seite angelegt
         };
     }
     namespace Exception{
@@ -0,0 +1,72 @@
+#ifndef DBTEMPFILE_H_
+#define DBTEMPFILE_H_
+
+#include <hubDB/DBBufferMgr.h>
+#include <hubDB/DBFile.h>
+
+using namespace HubDB::File;
+using namespace HubDB::Manager;
+
+namespace HubDB{
+    namespace Table{
+
+        /**
+         * Temporäre Datei für Zwischenergebnisse (z.B. Partitionen eines Hash-Joins).
+         *
+         * Tupel werden nur angehängt und anschließend sequentiell gelesen; alle Seiten
+         * laufen über den Buffermanager. Beim Anhängen bleibt nur die letzte Seite
+         * fixiert, beim Lesen keine. Der Destruktor löscht die Datei.
+         *
+         * Die Tupel stehen im variablen Satzformat (siehe DBTuple::writeRecord())
+         * hintereinander und dürfen über Seitengrenzen reichen, so dass auch lange
+         * VarChar-Werte nicht abgeschnitten werden.
+         *
+         * Seitenlayout: belegte Bytes | (Länge | Tupel | TID)*
+         */
+        class DBTempFile
+        {
+            struct tempPageLayout{
+                uint used;
+            };
+
+        public:
+            DBTempFile(DBBufferMgr & bufMgr,DBFile & file,const string & fileName,const DBRelDef & rel);
+            ~DBTempFile();
+            string toString(string linePrefix="") const;
+
+            void append(const DBTuple & tuple);
+
+            /**
+             * Beendet das Schreiben, der nächste Aufruf von read() beginnt beim ersten Tupel
+             */
+            void rewind();
+
+            /**
+             * Liest die nächsten (höchstens numOfTuples) Tupel
+             * @return Anzahl gelesener Tupel, 0 am Dateiende
+             */
+            uint read(uint numOfTuples,DBListTuple & tupleList);
+
+            uint getTupleCnt() const { return tupleCnt;};
+            const DBRelDef & getRelDef() const { return rel;};
+
+        protected:
+            size_t pageCapacity() const;
+            void writeBytes(const char * ptr,size_t len);
+            bool readBytes(char * ptr,size_t len);
+            void unfixBACBs();
+
+            static LoggerPtr logger;
+            DBBufferMgr & bufMgr;
+            DBFile & file;
+            const string fileName;
+            const DBRelDef rel;
+            stack<DBBACB> bacbStack;
+            uint tupleCnt;
+            TID readPos;        // Seite und Byte auf der Seite
+            vector<char> buf;   // Satz, der über eine Seitengrenze reicht
+        };
+    }
+}
+
+#endif // DBTEMPFILE_H_
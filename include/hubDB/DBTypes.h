@@ -17,7 +17,9 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <list>
+#include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <map>
 #include <stack>
 #include <typeinfo>
@@ -32,18 +34,39 @@ using namespace log4cxx;
 const int  STD_PORT = 6666;
 const uint STD_SOCKET_BUFFER_SIZE = 512;
 const uint STD_LISTEN_CNT = 6;
-const uint STD_BLOCKSIZE = 1024;
+const uint STD_BLOCKSIZE = 1024; // Seitengröße des Systemkatalogs und neuer Datenbanken ohne PAGESIZE
+const uint MAX_BLOCKSIZE = 65536;
 const uint STD_BUFFER_BLOCKS = 50;
 const uint MAX_THREADS = 5;
 const string STD_HOST = "localhost";
 const string DEFAULT_BUFMGR = "DBRandomBufferMgr";
-const string DEFAULT_IDXTYPE = "DBSeqIndex";
+const string DEFAULT_IDXTYPE = "DBBLinkIndex";
 const string DEFAULT_QUERYEXEC = "DBSimpleQueryMgr";
 const string FILE_SEP = "/";
 const bool DEFAULT_MONITOR_STAT = true;
 const bool DEFAULT_THREAD_STAT = true;
 const uint MAX_STR_LEN = 30;
+const uint MAX_VCHAR_LEN = 8000; // größtes n von VARCHAR(n), n ungleich MAX_STR_LEN nur in DBSlottedTable
 const uint MAX_ATTR_PER_REL = 10;
+const uint STD_SCAN_BATCH = 100;
+const uint STD_TID_BATCH = 128;
+const uint STD_PREFETCH_PAGES = 8; // Seiten, die DBTable::readTIDs() vor der aktuellen beim Betriebssystem anfordert
+const uint STD_JOIN_MEM_BLOCKS = 256;
+const uint MAX_JOIN_PARTITIONS = 16;
+const uint STD_AGG_MEM_BLOCKS = 256;
+const uint MAX_AGG_PARTITIONS = 16;
+const uint STD_SORT_FANIN = 16;
+const uint STD_SORT_MEM_BLOCKS = 256;
+const uint STD_BULK_INDEX_ENTRIES = 100000; // gesammelte Indexeinträge beim Massenimport (siehe DBBulkLoad)
+const uint STD_IMPORT_THREADS = 4; // Threads, die eine Importdatei zerlegen (siehe DBImportParser)
+const uint STD_IMPORT_CHUNK = 1 << 20; // Bytes je Thread und Runde
+const uint STAT_BUCKETS = 16;
+const uint STAT_SAMPLE_TUPLES = 10000;
+const uint HLL_REGISTER_BITS = 10;
+const uint COST_INDEX_PROBE = 3;  // Seiten je Indexzugriff
+const uint COST_RANDOM_PAGE = 2;  // Kosten einer Seite bei wahlfreiem Zugriff, relativ zum Scan
+const uint STD_SEND_SIZE = 65536;
+const uint ALL_ATTRS = (uint) -1; // Bitmaske aller Attributpositionen (siehe DBTuple::read())
 
 typedef unsigned int uint;
 typedef int FileNo;
@@ -78,6 +101,7 @@ namespace HubDB{
         };
 
         typedef list< TID > DBListTID;
+        typedef vector< TID > DBTIDBatch;
 
         string toString(DBListTID & l);
 
@@ -103,12 +127,22 @@ namespace HubDB{
             virtual string toString(string linePrefix="") const;
             virtual AttrTypeEnum type()const =0;
             virtual char * write(char * ptr)const =0;
+            // Länge und Schreiben im variablen Satzformat (siehe DBTuple::writeRecord())
+            virtual size_t recordSize()const { return getSize4Type(type());};
+            virtual char * writeRecord(char * ptr)const { return write(ptr);};
             virtual ostream & print(ostream & s,bool align=true) const = 0;
             virtual void exportToFile(FILE * file) const = 0;
+            // Schlüssel, dessen byteweiser Vergleich (memcmp) der Ordnung der Werte entspricht
+            virtual string normalizedKey() const = 0;
+            // Hashwert, gleiche Werte liefern gleiche Hashwerte
+            virtual size_t hashValue() const = 0;
             static DBAttrType * read(const char * ptr,const AttrTypeEnum t,const char ** ptrNext = NULL);
+            static DBAttrType * readRecord(const char * ptr,const AttrTypeEnum t,const char ** ptrNext = NULL);
+            static size_t getRecordSize(const char * ptr,const AttrTypeEnum t); // Länge des Werts bei ptr im variablen Satzformat
             static DBAttrType * import(DataImport & ptr,const AttrTypeEnum t);
             static size_t getSize4Type(const AttrTypeEnum type);
-            static string getName4Type(const AttrTypeEnum t);
+            static size_t getKeySize4Type(const AttrTypeEnum type); // 0: variable Länge
+            static string getName4Type(const AttrTypeEnum t,uint len = 0); // len: n von VARCHAR(n)
             static DBAttrType * clone(const DBAttrType & ref);
         };
 
@@ -129,6 +163,8 @@ namespace HubDB{
             static size_t getSize(){return sizeof(int);};
             ostream & print(ostream & s,bool align=true) const;
             void exportToFile(FILE * file)const{fprintf(file,"%d",val);};
+            string normalizedKey()const;
+            size_t hashValue()const;
         protected:
             int val;
         };
@@ -149,27 +185,53 @@ namespace HubDB{
             static size_t getSize(){return sizeof(double);};
             ostream & print(ostream & s,bool align=true) const;
             void exportToFile(FILE * file)const{fprintf(file,"%g",val);};
+            string normalizedKey()const;
+            size_t hashValue()const;
         protected:
             double val;
         };
 
         class DBVCharType : public DBAttrType{
         public:
-            DBVCharType(const char * ptr){strncpy(val,ptr,getSize());val[getSize()]='\0';};
-            DBVCharType(const DBVCharType & ref){memcpy(val,ref.val,getSize());val[getSize()]='\0';};
-            DBVCharType operator=(const DBVCharType & ref){memcpy(val,ref.val,getSize());val[getSize()]='\0'; return *this;};
+            DBVCharType(const char * ptr):val(ptr){};
+            // höchstens len Zeichen, endet vorher an '\0' (festes Format auf der Seite)
+            DBVCharType(const char * ptr,size_t len):val(ptr,strnlen(ptr,len)){};
+            DBVCharType(const string & val):val(val){};
+            DBVCharType(const DBVCharType & ref):val(ref.val){};
+            DBVCharType operator=(const DBVCharType & ref){val = ref.val; return *this;};
             string toString(string linePrefix="") const;
             bool operator==(const DBAttrType & ref)const;
             bool operator<(const DBAttrType & ref)const;
             bool operator>(const DBAttrType & ref)const;
             AttrTypeEnum type()const{ return VCHAR;};
             string getVal()const {return val;};
-            char * write(char * ptr)const{ memcpy(ptr,val,getSize()); return ptr + getSize();};
+            // festes Format: getSize() Zeichen, mit '\0' aufgefüllt, längere Werte werden abgeschnitten
+            char * write(char * ptr)const{ memset(ptr,0,getSize()); memcpy(ptr,val.data(),min(val.size(),getSize())); return ptr + getSize();};
+            // variables Format: Länge (2 Byte) und Zeichen
+            size_t recordSize()const { return sizeof(uint16_t) + val.size();};
+            char * writeRecord(char * ptr)const;
             static size_t getSize(){return MAX_STR_LEN;};
             ostream & print(ostream & s,bool align=true) const;
-            void exportToFile(FILE * file)const{fprintf(file,"'%s'",val);};
+            void exportToFile(FILE * file)const{fprintf(file,"'%s'",val.c_str());};
+            string normalizedKey()const;
+            size_t hashValue()const;
         protected:
-            char val[MAX_STR_LEN+1];
+            string val;
+        };
+
+        /**
+         * Hash-Funktion und Vergleich für Attributwerte (z.B. als Schlüssel eines Hash-Joins)
+         */
+        struct hash_AttrType {
+            std::size_t operator()(const DBAttrType * val) const {
+              return val->hashValue();
+            }
+        };
+
+        struct equal_AttrType {
+            bool operator()(const DBAttrType * a,const DBAttrType * b) const {
+              return *a == *b;
+            }
         };
 
         typedef list<DBAttrType*> DBListAttrType;
@@ -207,6 +269,7 @@ namespace HubDB{
             uint attrCnt;
             uint tupleSize;
             AttrDefStruct attrList[MAX_ATTR_PER_REL];
+            bool isSlotted;      // Tabellenformat DBSlottedTable, false bei älteren Tabellen
         };
 
         class DBRelDef{
@@ -217,6 +280,7 @@ namespace HubDB{
             string relationName()const {return relation.relationName;};
             uint attrCnt() const { return relation.attrCnt;};
             uint tupleSize()const {return relation.tupleSize;};
+            bool isSlotted()const {return relation.isSlotted;};
 
             DBAttrDef attrDef(string attrName)const ;
             DBAttrDef attrDef(uint pos)const;
@@ -232,11 +296,31 @@ namespace HubDB{
             ~DBTuple();
             DBTuple(const DBTuple & ref);
 
-            const char * read(const DBRelDef & relDef,const char * ptr);
+            /**
+             * Liest die Attribute, deren Position in attrMask gesetzt ist; die übrigen
+             * werden übersprungen und dürfen nicht mit getAttrVal() abgefragt werden
+             */
+            const char * read(const DBRelDef & relDef,const char * ptr,uint attrMask = ALL_ATTRS);
             char * write(char * ptr)const;
+            // schreibt nicht gelesene Attribute mit 0
+            char * write(const DBRelDef & relDef,char * ptr)const;
+
+            /**
+             * Variables Satzformat (Zwischenergebnisse, DBSlottedTable): Integer und
+             * Double wie write(), VarChar mit 2 Byte Länge und den Zeichen ohne
+             * Auffüllung. Nicht gelesene Attribute werden als 0 bzw. leer geschrieben.
+             */
+            size_t recordSize(const DBRelDef & relDef)const;
+            char * writeRecord(const DBRelDef & relDef,char * ptr)const;
+            const char * readRecord(const DBRelDef & relDef,const char * ptr,uint attrMask = ALL_ATTRS);
 
             const DBAttrType & getAttrVal(uint pos)const;
-            void appendAttrVal(DBAttrType * val);
+            // hängt eine Kopie von val an, NULL für einen fehlenden Wert
+            void appendAttrVal(const DBAttrType * val);
+            uint getAttrCnt()const{ return vals.size();};
+            bool hasAttrVal(uint pos)const{ return pos < vals.size() && vals[pos] != NULL;};
+            // tauscht die Attributwerte ohne sie zu kopieren
+            void swap(DBTuple & ref){ vals.swap(ref.vals); std::swap(tid,ref.tid);};
             string toString(string linePrefix="") const;
             void setTID(const TID & t){tid = t;};
             TID getTID()const {return tid;};
@@ -258,14 +342,38 @@ namespace HubDB{
 
         typedef list< QualifiedName > DBListQualifiedName;
 
+        enum AggFuncEnum{
+            AGG_NONE,
+            AGG_COUNT,
+            AGG_SUM,
+            AGG_MIN,
+            AGG_MAX,
+            AGG_AVG
+        };
+
+        // Element der SELECT-Liste: Attribut oder Aggregatfunktion über einem Attribut
+        struct DBSelectItem{
+            AggFuncEnum func;
+            bool star;          // COUNT(*), name ist dann ohne Bedeutung
+            QualifiedName name;
+            string toString()const;
+        };
+
+        typedef list< DBSelectItem > DBListSelectItem;
+
+        struct DBOrderBy{
+            DBSelectItem item;  // Attribut bzw. Aggregatfunktion der SELECT-Liste
+            bool desc;
+        };
+
         class DBPredicate{
         public:
             DBPredicate(const DBPredicate & ref):val_(NULL),name_(ref.name_){ val_ = DBAttrType::clone(*ref.val_);};
             DBPredicate(DBAttrType * valR,QualifiedName name):val_(NULL),name_(name){ val_ = DBAttrType::clone(*valR);};
             ~DBPredicate(){ if(val_!=NULL) delete val_;};
-            const DBAttrType & val(){ return *val_;};
-            const QualifiedName & name(){ return name_;};
-            string toString(){ stringstream ss; ss << name_.toString()<<"="; val_->print(ss,false); return ss.str();};
+            const DBAttrType & val() const { return *val_;};
+            const QualifiedName & name() const { return name_;};
+            string toString() const { stringstream ss; ss << name_.toString()<<"="; val_->print(ss,false); return ss.str();};
 
         private:
             DBAttrType * val_;
@@ -0,0 +1,65 @@
+#ifndef DBZONEMAP_H_
+#define DBZONEMAP_H_
+
+#include <hubDB/DBBufferMgr.h>
+#include <hubDB/DBFile.h>
+
+#include <stdint.h>
+
+using namespace HubDB::File;
+using namespace HubDB::Manager;
+
+namespace HubDB{
+    namespace Table{
+
+        /**
+         * Zusammenfassung jeder Seite einer Tabelle, gespeichert in einer eigenen Datei
+         * neben der Tabellendatei. Für INTEGER- und DOUBLE-Attribute werden Minimum und
+         * Maximum gespeichert, für VARCHAR-Attribute ein Bloom-Filter mit 128 Bit.
+         * Ein Scan kann damit Seiten überspringen, die ein Gleichheitsprädikat nicht
+         * erfüllen können.
+         *
+         * Einträge ohne Zusammenfassung (z.B. von Seiten, die vor Anlegen der Datei
+         * geschrieben wurden) gelten als unbekannt und werden nie übersprungen.
+         * Beim Löschen werden Minimum/Maximum nicht verkleinert; erst wenn eine Seite
+         * leer ist, wird ihr Eintrag zurückgesetzt.
+         */
+        class DBZoneMap
+        {
+            struct zoneEntryLayout{
+                uint valid;
+                uint tupleCnt;
+            };
+
+            static const size_t ATTR_SUMMARY_SIZE = 16;
+            static const uint BLOOM_HASHES = 3;
+
+        public:
+            DBZoneMap(DBBufferMgr & bufMgr,DBFile & file,const DBRelDef & rel);
+            string toString(string linePrefix="") const;
+
+            bool isValid(BlockNo page);
+            void clear(BlockNo page);
+            void add(BlockNo page,const DBTuple & tuple);
+
+            /**
+             * Prüft, ob auf der Seite Tupel liegen können, welche alle Prädikate erfüllen.
+             * @return false, falls die Seite übersprungen werden kann
+             */
+            bool mayMatch(BlockNo page,DBListPredicate & where);
+
+        protected:
+            size_t entrySize() const { return sizeof(zoneEntryLayout) + rel.attrCnt() * ATTR_SUMMARY_SIZE; };
+            uint entriesPerPage() const;
+            DBBACB fixEntry(BlockNo page,DBBCBLockMode mode,char ** entry);
+            static void bloomBits(const DBAttrType & val,uint bits[BLOOM_HASHES]);
+
+            static LoggerPtr logger;
+            DBBufferMgr & bufMgr;
+            DBFile & file;
+            const DBRelDef rel;
+        };
+    }
+}
+
+#endif // DBZONEMAP_H_